@@ -12,6 +12,10 @@
 * on splines, including GetNearestDistance which returns the nearest position on a
 * spline for a given position in space.
 *
+* FindNearestDistance does the same using a precomputed polyline of the spline, and
+* can be benchmarked against GetNearestDistance with the
+* grip.BenchmarkNearestSplineDistance console command.
+*
 ***********************************************************************************/
 
 #include "ai/advancedsplinecomponent.h"
@@ -57,9 +61,352 @@ void UAdvancedSplineComponent::PostInitialize()
 		UpdateSpline();
 	}
 
+	BuildPolyline();
 	CalculateSections();
 }
 
+/**
+* Metric for the nearest point on a spline to a location, using squared distances.
+*
+* The location and points are in the local space of the spline, but distances are
+* measured in world units by applying the scale of the spline's transform to each
+* axis, so that a non-uniformly scaled spline still gives the nearest point in the
+* world rather than the nearest in its local space.
+***********************************************************************************/
+
+struct FSplineLocationMetric
+{
+	FSplineLocationMetric(const FVector& location, const FVector& scale)
+		: Location(location)
+		, Scale(scale)
+	{ }
+
+	// Get the metric for a point.
+	float Point(const FVector& point) const
+	{ return ((Location - point) * Scale).SizeSquared(); }
+
+	// Get the lower bound of the metric for a box.
+	float Box(const FBox& box) const
+	{ return ((box.Min - Location).ComponentMax(Location - box.Max).ComponentMax(FVector::ZeroVector) * Scale).SizeSquared(); }
+
+	// Get the metric for the nearest point on a segment between the ratios minRatio and maxRatio, returning that ratio.
+	float Segment(const FVector& point0, const FVector& point1, float minRatio, float maxRatio, float& ratio) const
+	{
+		FVector difference = point1 - point0;
+		FVector weightedDifference = difference * Scale * Scale;
+		float sizeSquared = FVector::DotProduct(difference, weightedDifference);
+
+		ratio = (sizeSquared > KINDA_SMALL_NUMBER) ? FMath::Clamp(FVector::DotProduct(Location - point0, weightedDifference) / sizeSquared, minRatio, maxRatio) : minRatio;
+
+		return Point(point0 + difference * ratio);
+	}
+
+	// The location to measure against.
+	FVector Location;
+
+	// The scale of the spline's transform, to measure in world units.
+	FVector Scale;
+};
+
+/**
+* Metric for the nearest point on a spline to a plane, using absolute distances.
+***********************************************************************************/
+
+struct FSplinePlaneMetric
+{
+	FSplinePlaneMetric(const FVector& location, const FVector& direction)
+		: Location(location)
+		, Direction(direction)
+	{ }
+
+	// Get the signed distance of a point from the plane.
+	float SignedDistance(const FVector& point) const
+	{ return FVector::DotProduct(point - Location, Direction); }
+
+	// Get the metric for a point.
+	float Point(const FVector& point) const
+	{ return FMath::Abs(SignedDistance(point)); }
+
+	// Get the lower bound of the metric for a box.
+	float Box(const FBox& box) const
+	{ return FMath::Max(0.0f, FMath::Abs(SignedDistance(box.GetCenter())) - FVector::DotProduct(box.GetExtent(), Direction.GetAbs())); }
+
+	// Get the metric for the nearest point on a segment between the ratios minRatio and maxRatio, returning that ratio.
+	float Segment(const FVector& point0, const FVector& point1, float minRatio, float maxRatio, float& ratio) const
+	{
+		float distance0 = SignedDistance(FMath::Lerp(point0, point1, minRatio));
+		float distance1 = SignedDistance(FMath::Lerp(point0, point1, maxRatio));
+
+		if (distance0 * distance1 <= 0.0f &&
+			distance0 != distance1)
+		{
+			// The segment crosses the plane, so find where.
+
+			ratio = FMath::Lerp(minRatio, maxRatio, distance0 / (distance0 - distance1));
+
+			return 0.0f;
+		}
+
+		ratio = (FMath::Abs(distance0) <= FMath::Abs(distance1)) ? minRatio : maxRatio;
+
+		return FMath::Min(FMath::Abs(distance0), FMath::Abs(distance1));
+	}
+
+	// The location of the plane.
+	FVector Location;
+
+	// The normal of the plane.
+	FVector Direction;
+};
+
+/**
+* Find the nearest distance along the polyline between startDistance and
+* endDistance, using a metric for a point, segment or box.
+*
+* The distances are unwrapped, so may lie outside of the length of the spline
+* for closed loops, and the result is returned unwrapped too. The group bounds of
+* the segments in range are measured first, and then the groups are searched in
+* order of the nearest bound first, skipping any group whose bound is further than
+* the nearest segment found so far.
+***********************************************************************************/
+
+template <typename Metric>
+float FSplinePolyline::FindNearestDistance(const Metric& metric, float startDistance, float endDistance, bool closedLoop, float& nearestValue) const
+{
+	struct FGroupRange
+	{
+		int32 FirstSegment;
+		int32 LastSegment;
+		float Bound;
+	};
+
+	int32 numSegments = Points.Num() - 1;
+	int32 firstSegment = 0;
+	int32 lastSegment = 0;
+
+	GetSegmentRange(startDistance, endDistance, closedLoop, firstSegment, lastSegment);
+
+	// Split the segments in range into the groups that they belong to.
+
+	TArray<FGroupRange, TInlineAllocator<64>> groups;
+
+	for (int32 segment = firstSegment; segment <= lastSegment; )
+	{
+		int32 index = ((segment % numSegments) + numSegments) % numSegments;
+		int32 group = index / SegmentsPerGroup;
+		int32 last = FMath::Min(lastSegment, segment + (FMath::Min((group + 1) * SegmentsPerGroup, numSegments) - 1 - index));
+
+		groups.Emplace(FGroupRange{ segment, last, metric.Box(GroupBounds[group]) });
+
+		segment = last + 1;
+	}
+
+	groups.Sort([] (const FGroupRange& object1, const FGroupRange& object2)
+		{
+			return object1.Bound < object2.Bound;
+		});
+
+	float nearestDistance = startDistance;
+
+	nearestValue = -1.0f;
+
+	for (const FGroupRange& group : groups)
+	{
+		if (nearestValue >= 0.0f &&
+			group.Bound >= nearestValue)
+		{
+			// All of the remaining groups are further away than the nearest segment found.
+
+			break;
+		}
+
+		SearchSegments(metric, group.FirstSegment, group.LastSegment, startDistance, endDistance, nearestDistance, nearestValue);
+	}
+
+	return nearestDistance;
+}
+
+/**
+* Find the nearest distances along the polyline for a batch of searches in a single
+* walk along it, using a metric for a point, segment or box.
+*
+* The searches are sorted by their first segment, and the groups are then walked
+* once in order along the polyline, each search being tested against the groups
+* that its range overlaps, skipping any group whose bound is further than the
+* nearest segment found so far for that search. Searches close together along the
+* spline therefore share the walk over the groups and points between them.
+***********************************************************************************/
+
+template <typename Metric>
+void FSplinePolyline::FindNearestDistances(TArrayView<FSplinePolylineSearch<Metric>> searches, bool closedLoop) const
+{
+	if (searches.Num() == 0)
+	{
+		return;
+	}
+
+	int32 numSegments = Points.Num() - 1;
+	TArray<int32, TInlineAllocator<64>> order;
+	TArray<int32, TInlineAllocator<64>> active;
+
+	order.Reserve(searches.Num());
+
+	for (int32 i = 0; i < searches.Num(); i++)
+	{
+		FSplinePolylineSearch<Metric>& search = searches[i];
+
+		GetSegmentRange(search.StartDistance, search.EndDistance, closedLoop, search.FirstSegment, search.LastSegment);
+
+		search.NearestDistance = search.StartDistance;
+		search.NearestValue = -1.0f;
+
+		order.Emplace(i);
+	}
+
+	order.Sort([&searches] (int32 index1, int32 index2)
+		{
+			return searches[index1].FirstSegment < searches[index2].FirstSegment;
+		});
+
+	int32 next = 0;
+	int32 segment = searches[order[0]].FirstSegment;
+
+	while (next < order.Num() ||
+		active.Num() > 0)
+	{
+		if (active.Num() == 0)
+		{
+			// Skip over any gap between the searches.
+
+			segment = FMath::Max(segment, searches[order[next]].FirstSegment);
+		}
+
+		// Find the run of segments from here to the end of the group that contains it.
+
+		int32 index = ((segment % numSegments) + numSegments) % numSegments;
+		int32 group = index / SegmentsPerGroup;
+		int32 last = segment + (FMath::Min((group + 1) * SegmentsPerGroup, numSegments) - 1 - index);
+
+		while (next < order.Num() &&
+			searches[order[next]].FirstSegment <= last)
+		{
+			active.Emplace(order[next++]);
+		}
+
+		for (int32 i = 0; i < active.Num(); )
+		{
+			FSplinePolylineSearch<Metric>& search = searches[active[i]];
+			int32 firstSegment = FMath::Max(segment, search.FirstSegment);
+			int32 lastSegment = FMath::Min(last, search.LastSegment);
+
+			if (firstSegment <= lastSegment &&
+				(search.NearestValue < 0.0f || search.SearchMetric.Box(GroupBounds[group]) < search.NearestValue))
+			{
+				SearchSegments(search.SearchMetric, firstSegment, lastSegment, search.StartDistance, search.EndDistance, search.NearestDistance, search.NearestValue);
+			}
+
+			if (search.LastSegment <= last)
+			{
+				active.RemoveAtSwap(i);
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		segment = last + 1;
+	}
+}
+
+/**
+* Get the range of segments, unwrapped for closed loops, that lie between
+* startDistance and endDistance.
+***********************************************************************************/
+
+void FSplinePolyline::GetSegmentRange(float startDistance, float endDistance, bool closedLoop, int32& firstSegment, int32& lastSegment) const
+{
+	int32 numSegments = Points.Num() - 1;
+
+	firstSegment = FMath::FloorToInt(startDistance / SegmentLength);
+	lastSegment = FMath::FloorToInt(endDistance / SegmentLength);
+
+	if (closedLoop == false)
+	{
+		firstSegment = FMath::Clamp(firstSegment, 0, numSegments - 1);
+		lastSegment = FMath::Clamp(lastSegment, 0, numSegments - 1);
+	}
+	else
+	{
+		lastSegment = FMath::Min(lastSegment, firstSegment + numSegments - 1);
+	}
+}
+
+/**
+* Find the nearest point on a run of segments within a single group to a metric, if
+* it's nearer than that already found.
+***********************************************************************************/
+
+template <typename Metric>
+void FSplinePolyline::SearchSegments(const Metric& metric, int32 firstSegment, int32 lastSegment, float startDistance, float endDistance, float& nearestDistance, float& nearestValue) const
+{
+	int32 numSegments = Points.Num() - 1;
+
+	for (int32 segment = firstSegment; segment <= lastSegment; segment++)
+	{
+		int32 index = ((segment % numSegments) + numSegments) % numSegments;
+		float segmentDistance = segment * SegmentLength;
+		float minRatio = FMath::Clamp((startDistance - segmentDistance) / SegmentLength, 0.0f, 1.0f);
+		float maxRatio = FMath::Clamp((endDistance - segmentDistance) / SegmentLength, minRatio, 1.0f);
+		float ratio = 0.0f;
+		float value = metric.Segment(Points[index], Points[index + 1], minRatio, maxRatio, ratio);
+
+		if (nearestValue < 0.0f ||
+			nearestValue > value)
+		{
+			nearestValue = value;
+			nearestDistance = segmentDistance + ratio * SegmentLength;
+		}
+	}
+}
+
+/**
+* Build the polyline used for finding the nearest distance along the spline.
+***********************************************************************************/
+
+void UAdvancedSplineComponent::BuildPolyline()
+{
+	float length = GetSplineLength();
+	int32 numSegments = FMath::Max(1, FMath::CeilToInt(length / FMathEx::MetersToCentimeters(PolylinePointMeters)));
+	int32 numGroups = (numSegments + FSplinePolyline::SegmentsPerGroup - 1) / FSplinePolyline::SegmentsPerGroup;
+
+	Polyline.Length = length;
+	Polyline.SegmentLength = length / numSegments;
+	Polyline.Points.Reset(numSegments + 1);
+	Polyline.GroupBounds.Reset(numGroups);
+
+	for (int32 i = 0; i <= numSegments; i++)
+	{
+		float inputKey = SplineCurves.ReparamTable.Eval(FMath::Min(i * Polyline.SegmentLength, length), 0.0f);
+
+		Polyline.Points.Emplace(SplineCurves.Position.Eval(inputKey, FVector::ZeroVector));
+	}
+
+	for (int32 group = 0; group < numGroups; group++)
+	{
+		int32 first = group * FSplinePolyline::SegmentsPerGroup;
+		int32 last = FMath::Min(first + FSplinePolyline::SegmentsPerGroup, numSegments);
+		FBox bounds(ForceInit);
+
+		for (int32 i = first; i <= last; i++)
+		{
+			bounds += Polyline.Points[i];
+		}
+
+		Polyline.GroupBounds.Emplace(bounds);
+	}
+}
+
 /**
 * Find the nearest distance along a spline to a given world location.
 * The fewer iterations and samples you use the faster it will be, but also the less
@@ -229,6 +576,211 @@ float UAdvancedSplineComponent::GetNearestDistance(FVector planeLocation, FVecto
 	return resultDistance;
 }
 
+/**
+* Search for the nearest distance along the spline using a metric for a point,
+* segment or box in local space.
+*
+* The polyline is searched first, and the result refined with a golden section
+* search against the spline itself over the segments either side of it.
+***********************************************************************************/
+
+template <typename Metric>
+float UAdvancedSplineComponent::SearchNearestDistance(const Metric& metric, float startDistance, float endDistance, float accuracy) const
+{
+	float nearestValue = 0.0f;
+
+	ClampSearchRange(startDistance, endDistance);
+
+	float nearestDistance = Polyline.FindNearestDistance(metric, startDistance, endDistance, IsClosedLoop(), nearestValue);
+
+	return RefineNearestDistance(metric, nearestDistance, startDistance, endDistance, accuracy);
+}
+
+/**
+* Clamp the distances to search between along the spline, accounting for whether
+* it's open or closed.
+***********************************************************************************/
+
+void UAdvancedSplineComponent::ClampSearchRange(float& startDistance, float& endDistance) const
+{
+	float splineLength = Polyline.Length;
+
+	if (endDistance <= 0.0f)
+	{
+		endDistance = splineLength;
+	}
+
+	if (startDistance > endDistance)
+	{
+		Swap(startDistance, endDistance);
+	}
+
+	if (IsClosedLoop() == false)
+	{
+		startDistance = FMath::Clamp(startDistance, 0.0f, splineLength);
+		endDistance = FMath::Clamp(endDistance, 0.0f, splineLength);
+	}
+	else if (endDistance - startDistance >= splineLength)
+	{
+		startDistance = 0.0f;
+		endDistance = splineLength;
+	}
+}
+
+/**
+* Refine a nearest distance found on the polyline against the spline itself, using
+* a golden section search with a metric for a point in local space.
+***********************************************************************************/
+
+template <typename Metric>
+float UAdvancedSplineComponent::RefineNearestDistance(const Metric& metric, float nearestDistance, float startDistance, float endDistance, float accuracy) const
+{
+	float splineLength = Polyline.Length;
+
+	auto evaluate = [this, &metric, splineLength] (float distance)
+	{
+		float inputKey = SplineCurves.ReparamTable.Eval(ClampDistanceAgainstLength(distance, splineLength), 0.0f);
+
+		return metric.Point(SplineCurves.Position.Eval(inputKey, FVector::ZeroVector));
+	};
+
+	// The polyline cuts the corners of the spline, so the nearest distance along the spline
+	// itself will be within a segment either side of that found on the polyline.
+
+	static const float goldenRatio = 0.618034f;
+
+	float minDistance = FMath::Max(nearestDistance - Polyline.SegmentLength, startDistance);
+	float maxDistance = FMath::Min(nearestDistance + Polyline.SegmentLength, endDistance);
+	float distance0 = maxDistance - (maxDistance - minDistance) * goldenRatio;
+	float distance1 = minDistance + (maxDistance - minDistance) * goldenRatio;
+	float value0 = evaluate(distance0);
+	float value1 = evaluate(distance1);
+
+	accuracy = FMath::Max(accuracy, 0.01f);
+
+	while (maxDistance - minDistance > accuracy)
+	{
+		if (value0 < value1)
+		{
+			maxDistance = distance1;
+			distance1 = distance0;
+			value1 = value0;
+			distance0 = maxDistance - (maxDistance - minDistance) * goldenRatio;
+			value0 = evaluate(distance0);
+		}
+		else
+		{
+			minDistance = distance0;
+			distance0 = distance1;
+			value0 = value1;
+			distance1 = minDistance + (maxDistance - minDistance) * goldenRatio;
+			value1 = evaluate(distance1);
+		}
+	}
+
+	float refinedDistance = (value0 < value1) ? distance0 : distance1;
+
+	if (FMath::Min(value0, value1) > evaluate(nearestDistance))
+	{
+		refinedDistance = nearestDistance;
+	}
+
+	return ClampDistanceAgainstLength(refinedDistance, splineLength);
+}
+
+/**
+* Find the nearest distance along a spline to a given world location, to within
+* accuracy, using the precomputed polyline.
+***********************************************************************************/
+
+float UAdvancedSplineComponent::FindNearestDistance(const FVector& location, float startDistance, float endDistance, float accuracy) const
+{
+	float splineLength = GetSplineLength();
+
+	if (Polyline.IsValidFor(splineLength) == false)
+	{
+		float range = ((endDistance <= 0.0f) ? splineLength : endDistance) - startDistance;
+
+		return GetNearestDistance(location, startDistance, endDistance, 5, GetNumSamplesForRange(range, 5, accuracy), 0.0f);
+	}
+
+	const FTransform& transform = GetComponentTransform();
+
+	return SearchNearestDistance(FSplineLocationMetric(transform.InverseTransformPosition(location), transform.GetScale3D()), startDistance, endDistance, accuracy);
+}
+
+/**
+* Find the nearest distance along a spline to a given plane location and direction,
+* to within accuracy, using the precomputed polyline.
+***********************************************************************************/
+
+float UAdvancedSplineComponent::FindNearestDistance(const FVector& planeLocation, const FVector& planeDirection, float startDistance, float endDistance, float accuracy) const
+{
+	float splineLength = GetSplineLength();
+
+	if (Polyline.IsValidFor(splineLength) == false)
+	{
+		float range = ((endDistance <= 0.0f) ? splineLength : endDistance) - startDistance;
+
+		return GetNearestDistance(planeLocation, planeDirection, startDistance, endDistance, 5, GetNumSamplesForRange(range, 5, accuracy), 0.0f);
+	}
+
+	const FTransform& transform = GetComponentTransform();
+
+	return SearchNearestDistance(FSplinePlaneMetric(transform.InverseTransformPosition(planeLocation), transform.InverseTransformVector(planeDirection).GetSafeNormal()), startDistance, endDistance, accuracy);
+}
+
+/**
+* Find the nearest distances along a spline for a batch of queries in a single
+* pass, to within accuracy, using the precomputed polyline.
+*
+* Each query is searched within its range around its distance, normally the
+* last result for the object making the query. The queries are found on the
+* polyline in a single walk along it, and then each is refined against the spline
+* itself. The results match making each query with FindNearestDistance, other than
+* where two segments of the polyline are exactly as near as each other.
+***********************************************************************************/
+
+void UAdvancedSplineComponent::FindNearestDistances(TArrayView<FSplineNearestQuery> queries, float accuracy) const
+{
+	float splineLength = GetSplineLength();
+
+	if (Polyline.IsValidFor(splineLength) == false)
+	{
+		for (FSplineNearestQuery& query : queries)
+		{
+			query.Distance = FindNearestDistance(query.Location, query.Distance - query.Range, query.Distance + query.Range, accuracy);
+		}
+	}
+	else
+	{
+		const FTransform& transform = GetComponentTransform();
+		FVector scale = transform.GetScale3D();
+		TArray<FSplinePolylineSearch<FSplineLocationMetric>, TInlineAllocator<64>> searches;
+
+		searches.Reserve(queries.Num());
+
+		for (const FSplineNearestQuery& query : queries)
+		{
+			float startDistance = query.Distance - query.Range;
+			float endDistance = query.Distance + query.Range;
+
+			ClampSearchRange(startDistance, endDistance);
+
+			searches.Emplace(FSplineLocationMetric(transform.InverseTransformPosition(query.Location), scale), startDistance, endDistance);
+		}
+
+		Polyline.FindNearestDistances(MakeArrayView(searches), IsClosedLoop());
+
+		for (int32 i = 0; i < queries.Num(); i++)
+		{
+			const FSplinePolylineSearch<FSplineLocationMetric>& search = searches[i];
+
+			queries[i].Distance = RefineNearestDistance(search.SearchMetric, search.NearestDistance, search.StartDistance, search.EndDistance, accuracy);
+		}
+	}
+}
+
 /**
 * Get the distance between two points on a spline (accounting for looped splines).
 * Subtracting distance1 from distance0, notionally if you want an unsigned result.
@@ -584,3 +1136,151 @@ float UAdvancedSplineComponent::GetDistanceLeft(float distance, float start, flo
 #pragma endregion CameraCinematics
 
 #pragma endregion NavigationSplines
+
+#if !UE_BUILD_SHIPPING
+
+/**
+* Benchmark FindNearestDistance against GetNearestDistance, for all of the advanced
+* splines in the world, for both local queries around a known distance and queries
+* over the entire length of a spline.
+***********************************************************************************/
+
+static void BenchmarkNearestSplineDistance(const TArray<FString>& args, UWorld* world)
+{
+	int32 numQueries = (args.Num() > 0) ? FMath::Max(FCString::Atoi(*args[0]), 1) : 10000;
+	float accuracy = 1.0f;
+	int32 numIterations = 5;
+
+	for (TObjectIterator<UAdvancedSplineComponent> splineItr; splineItr; ++splineItr)
+	{
+		UAdvancedSplineComponent* spline = *splineItr;
+
+		if (spline->GetWorld() != world ||
+			spline->GetNumberOfSplinePoints() < 2)
+		{
+			continue;
+		}
+
+		float length = spline->GetSplineLength();
+		FRandomStream random(1);
+		TArray<FSplineNearestQuery> queries;
+		TArray<float> oldDistances;
+		TArray<float> newDistances;
+
+		// Generate queries scattered up to 10m around the spline, with ranges that
+		// match those used by the AI when following splines.
+
+		queries.Reserve(numQueries);
+
+		for (int32 i = 0; i < numQueries; i++)
+		{
+			float distance = random.FRandRange(0.0f, length);
+			float movementSize = random.FRandRange(100.0f, 25.0f * 100.0f);
+			FVector location = spline->GetWorldLocationAtDistanceAlongSpline(distance) + random.GetUnitVector() * random.FRandRange(0.0f, 10.0f * 100.0f);
+
+			queries.Emplace(FSplineNearestQuery(location, spline->ClampDistance(distance + random.FRandRange(-movementSize, movementSize)), movementSize * GRIP_SPLINE_MOVEMENT_MULTIPLIER));
+		}
+
+		auto measure = [spline, &queries] (const TArray<float>& oldDistances, const TArray<float>& newDistances, float& meanError, float& maxError, int32& numWorse)
+		{
+			meanError = maxError = 0.0f;
+			numWorse = 0;
+
+			for (int32 i = 0; i < queries.Num(); i++)
+			{
+				float oldAway = (queries[i].Location - spline->GetWorldLocationAtDistanceAlongSpline(oldDistances[i])).Size();
+				float newAway = (queries[i].Location - spline->GetWorldLocationAtDistanceAlongSpline(newDistances[i])).Size();
+				float error = newAway - oldAway;
+
+				meanError += error;
+				maxError = FMath::Max(maxError, error);
+				numWorse += (error > 1.0f) ? 1 : 0;
+			}
+
+			meanError /= FMath::Max(1, queries.Num());
+		};
+
+		float meanError = 0.0f;
+		float maxError = 0.0f;
+		int32 numWorse = 0;
+
+		// Local queries.
+
+		oldDistances.Reset(numQueries);
+		newDistances.Reset(numQueries);
+
+		double startTime = FPlatformTime::Seconds();
+
+		for (const FSplineNearestQuery& query : queries)
+		{
+			float t0 = query.Distance - query.Range;
+			float t1 = query.Distance + query.Range;
+
+			oldDistances.Emplace(spline->GetNearestDistance(query.Location, t0, t1, numIterations, spline->GetNumSamplesForRange(t1 - t0, numIterations, accuracy)));
+		}
+
+		double oldSeconds = FPlatformTime::Seconds() - startTime;
+
+		startTime = FPlatformTime::Seconds();
+
+		for (const FSplineNearestQuery& query : queries)
+		{
+			newDistances.Emplace(spline->FindNearestDistance(query.Location, query.Distance - query.Range, query.Distance + query.Range, accuracy));
+		}
+
+		double newSeconds = FPlatformTime::Seconds() - startTime;
+
+		TArray<FSplineNearestQuery> batch = queries;
+
+		startTime = FPlatformTime::Seconds();
+
+		spline->FindNearestDistances(batch, accuracy);
+
+		double batchSeconds = FPlatformTime::Seconds() - startTime;
+		int32 numMismatches = 0;
+
+		for (int32 i = 0; i < queries.Num(); i++)
+		{
+			numMismatches += (batch[i].Distance != newDistances[i]) ? 1 : 0;
+		}
+
+		measure(oldDistances, newDistances, meanError, maxError, numWorse);
+
+		UE_LOG(GripLog, Display, TEXT("%s (%dm) local: GetNearestDistance %.3fms, FindNearestDistance %.3fms (%.2fx), batched %.3fms, %d batch mismatches, mean error %.2fcm, max error %.2fcm, %d worse by over 1cm"), *spline->ActorName, FMath::RoundToInt(length / 100.0f), oldSeconds * 1000.0, newSeconds * 1000.0, oldSeconds / FMath::Max(newSeconds, 0.000001), batchSeconds * 1000.0, numMismatches, meanError, maxError, numWorse);
+
+		// Queries over the entire length of the spline.
+
+		oldDistances.Reset(numQueries);
+		newDistances.Reset(numQueries);
+
+		startTime = FPlatformTime::Seconds();
+
+		for (const FSplineNearestQuery& query : queries)
+		{
+			oldDistances.Emplace(spline->GetNearestDistance(query.Location, 0.0f, 0.0f, numIterations, spline->GetNumSamplesForRange(length, numIterations, accuracy)));
+		}
+
+		oldSeconds = FPlatformTime::Seconds() - startTime;
+
+		startTime = FPlatformTime::Seconds();
+
+		for (const FSplineNearestQuery& query : queries)
+		{
+			newDistances.Emplace(spline->FindNearestDistance(query.Location, 0.0f, 0.0f, accuracy));
+		}
+
+		newSeconds = FPlatformTime::Seconds() - startTime;
+
+		measure(oldDistances, newDistances, meanError, maxError, numWorse);
+
+		UE_LOG(GripLog, Display, TEXT("%s (%dm) whole: GetNearestDistance %.3fms, FindNearestDistance %.3fms (%.2fx), mean error %.2fcm, max error %.2fcm, %d worse by over 1cm"), *spline->ActorName, FMath::RoundToInt(length / 100.0f), oldSeconds * 1000.0, newSeconds * 1000.0, oldSeconds / FMath::Max(newSeconds, 0.000001), meanError, maxError, numWorse);
+	}
+}
+
+static FAutoConsoleCommand BenchmarkNearestSplineDistanceCommand(
+	TEXT("grip.BenchmarkNearestSplineDistance"),
+	TEXT("Benchmark FindNearestDistance against GetNearestDistance for the splines in the world.\n")
+	TEXT("  Optionally pass the number of queries to make per spline."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkNearestSplineDistance));
+
+#endif // !UE_BUILD_SHIPPING
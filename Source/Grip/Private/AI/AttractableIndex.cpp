@@ -0,0 +1,248 @@
+/**
+*
+* Attractable index.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* An index of the attractables in a level ordered by their distance along the
+* master racing spline, used by the AI bots to look for targets of opportunity.
+*
+***********************************************************************************/
+
+#include "ai/attractableindex.h"
+#include "ai/pursuitsplinecomponent.h"
+#include "ai/pursuitsplineactor.h"
+#include "pickups/pickup.h"
+#include "system/attractable.h"
+#include "algo/binarysearch.h"
+
+/**
+* Console variable for using the attractable index.
+***********************************************************************************/
+
+TAutoConsoleVariable<int32> CVarAttractableIndex(
+	TEXT("grip.AttractableIndex"),
+	1,
+	TEXT("Use the index of attractables along the master racing spline when bots look for targets of opportunity.\n")
+	TEXT("  0: Off, examine every attractable\n")
+	TEXT("  1: On\n"),
+	ECVF_Default);
+
+// The distance along the master racing spline behind a location to look for
+// attractables, as a ratio of their attraction distance range. Attractables level
+// with a vehicle on a curve can be measured a little behind it.
+static const float AttractableWindowBehind = 0.5f;
+
+// The distance along the master racing spline ahead of a location to look for
+// attractables, as a ratio of their attraction distance range. This is more than
+// the range as the distance around a curve is longer than the distance across it.
+static const float AttractableWindowAhead = 1.5f;
+
+/**
+* Is the index to be used rather than examining every attractable?
+***********************************************************************************/
+
+bool FAttractableIndex::IsEnabled()
+{
+	return CVarAttractableIndex.GetValueOnGameThread() != 0;
+}
+
+/**
+* Refresh the index from the attractables if they've changed since it was built.
+*
+* The attractables register themselves with the game mode as they start play,
+* which can be before the master racing spline has been determined, so the index
+* is built on first use after that, and rebuilt whenever an attractable is added
+* or removed.
+***********************************************************************************/
+
+void FAttractableIndex::Refresh(const TMap<AActor*, IAttractableInterface*>& attractables, UPursuitSplineComponent* masterRacingSpline)
+{
+	if (Dirty == false &&
+		MasterRacingSpline == masterRacingSpline)
+	{
+		return;
+	}
+
+	Entries.Reset(attractables.Num());
+
+	MasterRacingSpline = nullptr;
+	MaxRange = 0.0f;
+	Dirty = false;
+
+	if (masterRacingSpline == nullptr)
+	{
+		return;
+	}
+
+	MasterRacingSpline = masterRacingSpline;
+	SplineLength = masterRacingSpline->GetSplineLength();
+	ClosedLoop = masterRacingSpline->IsClosedLoop();
+
+	for (const TPair<AActor*, IAttractableInterface*>& attractable : attractables)
+	{
+		if (attractable.Value != nullptr &&
+			GRIP_OBJECT_VALID(attractable.Key) == true)
+		{
+			FEntry& entry = Entries.AddDefaulted_GetRef();
+			FVector location = attractable.Value->GetAttractionLocation();
+
+			entry.Actor = attractable.Key;
+			entry.Attractable = attractable.Value;
+			entry.DistanceAlong = GetMasterDistance(attractable.Key, location);
+			entry.Range = attractable.Value->GetAttractionDistanceRange();
+
+			MaxRange = FMath::Max(MaxRange, entry.Range);
+		}
+	}
+
+	Entries.Sort([] (const FEntry& object1, const FEntry& object2)
+		{
+			return object1.DistanceAlong < object2.DistanceAlong;
+		});
+}
+
+/**
+* Get the distance of an attractable along the master racing spline.
+*
+* This is measured through the pursuit spline nearest to the attractable, mapped
+* onto the master racing spline, in the same way as the vehicles measure their own
+* distance along it. Measuring directly against the master racing spline would
+* give different distances wherever the track branches away from it.
+***********************************************************************************/
+
+float FAttractableIndex::GetMasterDistance(AActor* actor, const FVector& location) const
+{
+	TWeakObjectPtr<UPursuitSplineComponent> pursuitSpline;
+	float distanceAway = 0.0f;
+	float distanceAlong = 0.0f;
+	APickup* pickup = Cast<APickup>(actor);
+
+	if (pickup != nullptr &&
+		GRIP_POINTER_VALID(pickup->NearestPursuitSpline) == true)
+	{
+		pursuitSpline = pickup->NearestPursuitSpline;
+		distanceAlong = pursuitSpline->GetNearestDistance(location, 0.0f, 0.0f, 5, 100);
+	}
+	else
+	{
+		APursuitSplineActor::FindNearestPursuitSpline(location, FVector::ZeroVector, actor->GetWorld(), pursuitSpline, distanceAway, distanceAlong, EPursuitSplineType::General, false, false, true, true);
+	}
+
+	if (GRIP_POINTER_VALID(pursuitSpline) == true)
+	{
+		return pursuitSpline->GetMasterDistanceAtDistanceAlongSpline(distanceAlong, SplineLength);
+	}
+	else
+	{
+		return MasterRacingSpline->GetNearestDistance(location, 0.0f, 0.0f, 5, 100);
+	}
+}
+
+/**
+* Get the attractables that may be in range of a distance along the master racing
+* spline.
+*
+* This is a conservative test, and the attractables found still need to be checked
+* with IsAttractorInRange.
+***********************************************************************************/
+
+void FAttractableIndex::FindAttractables(float distanceAlong, TArray<FAttractable, TInlineAllocator<16>>& attractables) const
+{
+	attractables.Reset();
+
+	if (MasterRacingSpline == nullptr ||
+		Entries.Num() == 0)
+	{
+		return;
+	}
+
+	float fromDistance = distanceAlong - (MaxRange * AttractableWindowBehind);
+	float toDistance = distanceAlong + (MaxRange * AttractableWindowAhead);
+
+	if (ClosedLoop == false ||
+		toDistance - fromDistance >= SplineLength)
+	{
+		AddEntriesBetween(fromDistance, toDistance, distanceAlong, attractables);
+	}
+	else
+	{
+		// Split the window where it wraps around the start of the spline.
+
+		if (fromDistance < 0.0f)
+		{
+			AddEntriesBetween(fromDistance + SplineLength, SplineLength, distanceAlong, attractables);
+		}
+		else if (toDistance > SplineLength)
+		{
+			AddEntriesBetween(0.0f, toDistance - SplineLength, distanceAlong, attractables);
+		}
+
+		AddEntriesBetween(FMath::Max(fromDistance, 0.0f), FMath::Min(toDistance, SplineLength), distanceAlong, attractables);
+	}
+}
+
+/**
+* Add the entries with distances between two points along the master racing
+* spline, without wrapping.
+***********************************************************************************/
+
+void FAttractableIndex::AddEntriesBetween(float fromDistance, float toDistance, float distanceAlong, TArray<FAttractable, TInlineAllocator<16>>& attractables) const
+{
+	int32 first = Algo::LowerBoundBy(Entries, fromDistance, [] (const FEntry& entry)
+		{
+			return entry.DistanceAlong;
+		});
+
+	for (int32 i = first; i < Entries.Num(); i++)
+	{
+		const FEntry& entry = Entries[i];
+
+		if (entry.DistanceAlong > toDistance)
+		{
+			// All of the remaining entries are beyond the window.
+
+			break;
+		}
+
+		// Now narrow the window down to the range of this particular attractable.
+
+		float offset = entry.DistanceAlong - distanceAlong;
+
+		if (ClosedLoop == true)
+		{
+			if (offset > SplineLength * 0.5f)
+			{
+				offset -= SplineLength;
+			}
+			else if (offset < SplineLength * -0.5f)
+			{
+				offset += SplineLength;
+			}
+		}
+
+		if (offset >= -entry.Range * AttractableWindowBehind &&
+			offset <= entry.Range * AttractableWindowAhead)
+		{
+			attractables.Emplace(entry.Actor, entry.Attractable);
+		}
+	}
+}
+
+/**
+* Clear the index.
+***********************************************************************************/
+
+void FAttractableIndex::Reset()
+{
+	Entries.Reset();
+
+	MasterRacingSpline = nullptr;
+	SplineLength = 0.0f;
+	ClosedLoop = false;
+	MaxRange = 0.0f;
+	Dirty = true;
+}
@@ -0,0 +1,809 @@
+/**
+*
+* Navigation cache.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A compact, versioned binary file of the navigation data that's otherwise derived
+* from the pursuit splines every time a level is started.
+*
+***********************************************************************************/
+
+#include "ai/navigationcache.h"
+
+#if GRIP_NAVIGATION_CACHE
+
+#include "ai/pursuitsplinecomponent.h"
+#include "ai/pursuitsplineactor.h"
+#include "system/worldfilter.h"
+#include "game/globalgamestate.h"
+#include "gamemodes/playgamemode.h"
+#include "hal/platformfilemanager.h"
+#include "async/mappedfilehandle.h"
+#include "misc/filehelper.h"
+#include "algo/binarysearch.h"
+
+/**
+* FNavigationCache statics.
+***********************************************************************************/
+
+// The identifier at the start of a cache file.
+const uint32 FNavigationCache::FileMagic = 0x564e5247;
+
+// The version of the cache file format.
+const int32 FNavigationCache::FileVersion = 2;
+
+// The navigation cache for this process.
+FNavigationCache FNavigationCache::Instance;
+
+static_assert(sizeof(FNavigationCacheHeader) == 32, "Unexpected navigation cache header size");
+static_assert(sizeof(FNavigationCacheEntry) == 48, "Unexpected navigation cache entry size");
+static_assert(sizeof(FPursuitPointExtendedPacked::FDegreesSum) == 24, "Unexpected degrees sum size");
+
+/**
+* Console variable for restoring navigation data from the navigation cache.
+***********************************************************************************/
+
+TAutoConsoleVariable<int32> CVarNavigationCache(
+	TEXT("grip.NavigationCache"),
+	1,
+	TEXT("Restore the navigation data derived from pursuit splines from the navigation cache when a level is loaded.\n")
+	TEXT("  0: Off\n")
+	TEXT("  1: On\n"),
+	ECVF_Default);
+
+/**
+* The layout of the payload of derived data for a spline, each block of which is
+* aligned to 16 bytes from the start of the payload.
+***********************************************************************************/
+
+struct FNavigationCacheLayout
+{
+	FNavigationCacheLayout(const FNavigationCacheEntry& entry)
+	{
+		uint32 numPoints = (uint32)entry.NumPoints;
+
+		Quaternions = 0;
+		SignedCurvatureSums = Align(Quaternions + (numPoints * QuaternionSize), 16);
+		UnsignedCurvatureSums = Align(SignedCurvatureSums + ((numPoints + 1) * DegreesSumSize), 16);
+		MasterSplineDistances = Align(UnsignedCurvatureSums + ((numPoints + 1) * DegreesSumSize), 16);
+		StraightSections = Align(MasterSplineDistances + ((entry.HasMasterDistances != 0) ? numPoints * FloatSize : 0), 16);
+		DroneSections = Align(StraightSections + ((uint32)entry.NumStraightSections * SectionSize), 16);
+		Size = Align(DroneSections + ((uint32)entry.NumDroneSections * SectionSize), 16);
+	}
+
+	// The offset of the orientation of each extended point, as 4 floats.
+	uint32 Quaternions = 0;
+
+	// The offset of the running sums of the signed curvature.
+	uint32 SignedCurvatureSums = 0;
+
+	// The offset of the running sums of the unsigned curvature.
+	uint32 UnsignedCurvatureSums = 0;
+
+	// The offset of the master spline distance of each extended point, if present.
+	uint32 MasterSplineDistances = 0;
+
+	// The offset of the straight sections, as start and end distance pairs.
+	uint32 StraightSections = 0;
+
+	// The offset of the drone sections, as start and end distance pairs.
+	uint32 DroneSections = 0;
+
+	// The size of the payload.
+	uint32 Size = 0;
+
+	// The size of a stored float.
+	static const uint32 FloatSize = sizeof(float);
+
+	// The size of a stored quaternion.
+	static const uint32 QuaternionSize = 4 * FloatSize;
+
+	// The size of a stored degrees sum.
+	static const uint32 DegreesSumSize = sizeof(FPursuitPointExtendedPacked::FDegreesSum);
+
+	// The size of a stored section.
+	static const uint32 SectionSize = 2 * FloatSize;
+};
+
+/**
+* Add a value to a running checksum.
+***********************************************************************************/
+
+template <typename T>
+static uint32 AddToChecksum(uint32 checksum, const T& value)
+{
+	return FCrc::MemCrc32(&value, sizeof(T), checksum);
+}
+
+/**
+* Add the points of an interpolation curve to a running checksum, field by field as
+* the points have padding in them.
+***********************************************************************************/
+
+template <typename T>
+static uint32 AddCurveToChecksum(uint32 checksum, const FInterpCurve<T>& curve)
+{
+	checksum = AddToChecksum(checksum, (uint8)curve.bIsLooped);
+	checksum = AddToChecksum(checksum, curve.LoopKeyOffset);
+
+	for (const FInterpCurvePoint<T>& point : curve.Points)
+	{
+		checksum = AddToChecksum(checksum, point.InVal);
+		checksum = AddToChecksum(checksum, point.OutVal);
+		checksum = AddToChecksum(checksum, point.ArriveTangent);
+		checksum = AddToChecksum(checksum, point.LeaveTangent);
+		checksum = AddToChecksum(checksum, (uint8)point.InterpMode);
+	}
+
+	return checksum;
+}
+
+/**
+* Copy sections from a payload.
+***********************************************************************************/
+
+static void CopySections(const uint8* data, int32 numSections, TArray<FSplineSection>& sections)
+{
+	const float* distances = (const float*)data;
+
+	sections.Reset(numSections);
+
+	for (int32 i = 0; i < numSections; i++)
+	{
+		sections.Emplace(FSplineSection(distances[i * 2], distances[i * 2 + 1]));
+	}
+}
+
+/**
+* Restore the derived data of a pursuit spline from the cache, returning false if
+* it's not present or out of date.
+*
+* This needs to be called before the spline computes any of that data itself. The
+* orientations of the extended points are written back into their serialized data
+* so that it stays authoritative, and everything else goes straight into the
+* packed data and sections.
+***********************************************************************************/
+
+bool FNavigationCache::Restore(UPursuitSplineComponent* spline)
+{
+	UWorld* world = spline->GetWorld();
+
+	if (world == nullptr ||
+		world->IsGameWorld() == false ||
+		spline->PursuitSplineParent == nullptr ||
+		CVarNavigationCache.GetValueOnGameThread() == 0)
+	{
+		return false;
+	}
+
+	Open(world);
+
+	uint32 key = CalculateKey(spline);
+	const FNavigationCacheEntry* entry = FindEntry(key);
+
+	if (entry == nullptr)
+	{
+		return false;
+	}
+
+	TArray<FPursuitPointExtendedData>& pointData = spline->PursuitSplineParent->PointExtendedData;
+
+	if (entry->NumPoints != pointData.Num() ||
+		entry->SourceChecksum != CalculateSourceChecksum(spline))
+	{
+		UE_LOG(GripLogPursuitSplines, Warning, TEXT("Navigation cache is out of date for pursuit spline %s, rebuild it with grip.BuildNavigationCache"), *spline->ActorName);
+
+		return false;
+	}
+
+	const uint8* payload = GetPayload(*entry);
+
+	if (payload == nullptr)
+	{
+		return false;
+	}
+
+	FNavigationCacheLayout layout(*entry);
+	int32 numPoints = entry->NumPoints;
+	const float* quaternions = (const float*)(payload + layout.Quaternions);
+
+	for (int32 i = 0; i < numPoints; i++)
+	{
+		const float* quaternion = quaternions + (i * 4);
+
+		pointData[i].Quaternion = FQuat(quaternion[0], quaternion[1], quaternion[2], quaternion[3]);
+	}
+
+	FPursuitPointExtendedPacked& packedData = spline->PursuitSplineParent->PackedExtendedData;
+
+	packedData.Pack(pointData, false);
+
+	packedData.SignedCurvatureSums.SetNumUninitialized(numPoints + 1);
+	packedData.UnsignedCurvatureSums.SetNumUninitialized(numPoints + 1);
+
+	FMemory::Memcpy(packedData.SignedCurvatureSums.GetData(), payload + layout.SignedCurvatureSums, (numPoints + 1) * FNavigationCacheLayout::DegreesSumSize);
+	FMemory::Memcpy(packedData.UnsignedCurvatureSums.GetData(), payload + layout.UnsignedCurvatureSums, (numPoints + 1) * FNavigationCacheLayout::DegreesSumSize);
+
+	CopySections(payload + layout.StraightSections, entry->NumStraightSections, spline->StraightSections);
+	CopySections(payload + layout.DroneSections, entry->NumDroneSections, spline->DroneSections);
+
+	RestoredKeys.Emplace(key);
+
+	return true;
+}
+
+/**
+* Restore the master spline distances of a complete set of pursuit splines from the
+* cache, returning false if they're not all present or up to date.
+*
+* Master spline distances depend upon how all of the splines for a navigation layer
+* connect to one another, so they're only restored if the cache was written for the
+* same navigation layer, master racing spline and links between the splines, and
+* every spline has been restored from it, which means none of them have changed.
+***********************************************************************************/
+
+bool FNavigationCache::RestoreMasterSplineDistances(const TArray<UPursuitSplineComponent*>& splines, const UPursuitSplineComponent* masterRacingSpline, const FString& navigationLayer)
+{
+	if (Header == nullptr ||
+		Header->NavigationLayerCrc != FCrc::StrCrc32(*navigationLayer) ||
+		Header->NumMasteredSplines != splines.Num() ||
+		CVarNavigationCache.GetValueOnGameThread() == 0)
+	{
+		return false;
+	}
+
+	if (Header->NetworkChecksum != CalculateNetworkChecksum(splines, masterRacingSpline))
+	{
+		UE_LOG(GripLogPursuitSplines, Warning, TEXT("Navigation cache is out of date for the links between pursuit splines, rebuild it with grip.BuildNavigationCache"));
+
+		return false;
+	}
+
+	TArray<const FNavigationCacheEntry*> entries;
+
+	entries.Reserve(splines.Num());
+
+	for (UPursuitSplineComponent* spline : splines)
+	{
+		uint32 key = CalculateKey(spline);
+		const FNavigationCacheEntry* entry = FindEntry(key);
+
+		if (entry == nullptr ||
+			entry->HasMasterDistances == 0 ||
+			RestoredKeys.Contains(key) == false)
+		{
+			return false;
+		}
+
+		entries.Emplace(entry);
+	}
+
+	for (int32 i = 0; i < splines.Num(); i++)
+	{
+		UPursuitSplineComponent* spline = splines[i];
+		const FNavigationCacheEntry* entry = entries[i];
+		const uint8* payload = GetPayload(*entry);
+
+		if (payload == nullptr)
+		{
+			return false;
+		}
+
+		FNavigationCacheLayout layout(*entry);
+		const float* distances = (const float*)(payload + layout.MasterSplineDistances);
+		TArray<FPursuitPointExtendedData>& pointData = spline->PursuitSplineParent->PointExtendedData;
+
+		for (int32 j = 0; j < entry->NumPoints; j++)
+		{
+			pointData[j].MasterSplineDistance = distances[j];
+		}
+
+		spline->MasterDistanceClass = entry->MasterDistanceClass;
+		spline->PursuitSplineParent->PackedExtendedData.PackMasterSplineDistances(pointData);
+	}
+
+	UE_LOG(GripLogPursuitSplines, Log, TEXT("Master spline distances restored from the navigation cache for %d pursuit splines"), splines.Num());
+
+	return true;
+}
+
+/**
+* Open the cache file for the map loaded into a world, if it's not already open.
+*
+* The file is memory-mapped where the platform supports it, and just read into
+* memory where it doesn't.
+***********************************************************************************/
+
+void FNavigationCache::Open(UWorld* world)
+{
+	FString filename = GetFilename(world);
+
+	if (Filename == filename)
+	{
+		return;
+	}
+
+	Close();
+
+	Filename = filename;
+
+	IPlatformFile& platformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (platformFile.FileExists(*Filename) == false)
+	{
+		UE_LOG(GripLogPursuitSplines, Log, TEXT("No navigation cache found at %s"), *Filename);
+
+		return;
+	}
+
+	int64 fileSize = 0;
+
+	MappedHandle = platformFile.OpenMapped(*Filename);
+
+	if (MappedHandle != nullptr)
+	{
+		MappedRegion = MappedHandle->MapRegion(0, MappedHandle->GetFileSize());
+	}
+
+	if (MappedRegion != nullptr)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		fileSize = MappedRegion->GetMappedSize();
+	}
+	else if (FFileHelper::LoadFileToArray(Contents, *Filename) == true)
+	{
+		Data = Contents.GetData();
+		fileSize = Contents.Num();
+	}
+
+	const FNavigationCacheHeader* header = (const FNavigationCacheHeader*)Data;
+
+	if (Data == nullptr ||
+		fileSize < (int64)sizeof(FNavigationCacheHeader) ||
+		header->Magic != FileMagic ||
+		header->Version != FileVersion ||
+		header->FileSize != (uint32)fileSize ||
+		header->NumSplines < 0 ||
+		(int64)sizeof(FNavigationCacheHeader) + ((int64)header->NumSplines * sizeof(FNavigationCacheEntry)) > fileSize ||
+		header->EntriesCrc != FCrc::MemCrc32(Data + sizeof(FNavigationCacheHeader), header->NumSplines * (int32)sizeof(FNavigationCacheEntry)))
+	{
+		UE_LOG(GripLogPursuitSplines, Warning, TEXT("Navigation cache %s isn't a valid cache file of version %d"), *Filename, FileVersion);
+
+		Close();
+
+		// Keep the filename so that we don't try to open the same bad file again.
+
+		Filename = filename;
+
+		return;
+	}
+
+	Header = header;
+	Entries = (const FNavigationCacheEntry*)(Data + sizeof(FNavigationCacheHeader));
+
+	UE_LOG(GripLogPursuitSplines, Log, TEXT("Navigation cache %s opened with %d pursuit splines (%s)"), *Filename, Header->NumSplines, (MappedRegion != nullptr) ? TEXT("mapped") : TEXT("read"));
+}
+
+/**
+* Close the cache, unmapping its file.
+***********************************************************************************/
+
+void FNavigationCache::Close()
+{
+	delete MappedRegion;
+	delete MappedHandle;
+
+	MappedRegion = nullptr;
+	MappedHandle = nullptr;
+	Data = nullptr;
+	Header = nullptr;
+	Entries = nullptr;
+
+	Contents.Empty();
+	RestoredKeys.Empty();
+	Filename.Empty();
+}
+
+/**
+* Find the entry for a key, or nullptr if there isn't one.
+***********************************************************************************/
+
+const FNavigationCacheEntry* FNavigationCache::FindEntry(uint32 key) const
+{
+	if (Header == nullptr)
+	{
+		return nullptr;
+	}
+
+	int32 index = Algo::LowerBoundBy(TArrayView<const FNavigationCacheEntry>(Entries, Header->NumSplines), key, [] (const FNavigationCacheEntry& entry)
+		{
+			return entry.Key;
+		});
+
+	return (index < Header->NumSplines && Entries[index].Key == key) ? &Entries[index] : nullptr;
+}
+
+/**
+* Get the payload for an entry, or nullptr if it fails its checksum.
+***********************************************************************************/
+
+const uint8* FNavigationCache::GetPayload(const FNavigationCacheEntry& entry) const
+{
+	if (entry.NumPoints < 0 ||
+		entry.NumStraightSections < 0 ||
+		entry.NumDroneSections < 0 ||
+		FNavigationCacheLayout(entry).Size != entry.PayloadSize ||
+		(uint64)entry.PayloadOffset + entry.PayloadSize > Header->FileSize)
+	{
+		UE_LOG(GripLogPursuitSplines, Warning, TEXT("Navigation cache %s has a malformed entry"), *Filename);
+
+		return nullptr;
+	}
+
+	const uint8* payload = Data + entry.PayloadOffset;
+
+	if (FCrc::MemCrc32(payload, entry.PayloadSize) != entry.PayloadCrc)
+	{
+		UE_LOG(GripLogPursuitSplines, Warning, TEXT("Navigation cache %s has a corrupt entry"), *Filename);
+
+		return nullptr;
+	}
+
+	return payload;
+}
+
+/**
+* Get the filename of the cache file for the map loaded into a world.
+***********************************************************************************/
+
+FString FNavigationCache::GetFilename(UWorld* world)
+{
+	FString mapName = UWorld::RemovePIEPrefix(world->GetMapName());
+
+	return FPaths::Combine(FPaths::ProjectContentDir(), TEXT("Navigation"), mapName + TEXT(".gripnav"));
+}
+
+/**
+* Get the key identifying a spline from its actor and component names.
+***********************************************************************************/
+
+uint32 FNavigationCache::CalculateKey(const UPursuitSplineComponent* spline)
+{
+	return FCrc::StrCrc32(*spline->GetName(), FCrc::StrCrc32(*spline->PursuitSplineParent->GetName()));
+}
+
+/**
+* Calculate the checksum of the source data the derived data of a spline is computed
+* from.
+*
+* That's the shape of the spline in world space and the serialized extended point
+* data, excepting the orientations and master spline distances which are derived.
+***********************************************************************************/
+
+uint32 FNavigationCache::CalculateSourceChecksum(const UPursuitSplineComponent* spline)
+{
+	uint32 checksum = 0;
+	const FTransform& transform = spline->GetComponentTransform();
+
+	checksum = AddCurveToChecksum(checksum, spline->SplineCurves.Position);
+	checksum = AddCurveToChecksum(checksum, spline->SplineCurves.Rotation);
+	checksum = AddCurveToChecksum(checksum, spline->SplineCurves.Scale);
+	checksum = AddToChecksum(checksum, transform.GetLocation());
+	checksum = AddToChecksum(checksum, transform.GetRotation());
+	checksum = AddToChecksum(checksum, transform.GetScale3D());
+	checksum = AddToChecksum(checksum, (uint8)spline->IsClosedLoop());
+
+	for (const FPursuitPointExtendedData& point : spline->PursuitSplineParent->PointExtendedData)
+	{
+		checksum = AddToChecksum(checksum, point.Distance);
+		checksum = AddToChecksum(checksum, point.MaxTunnelDiameter);
+		checksum = AddToChecksum(checksum, point.RawWeatherAllowed);
+		checksum = AddToChecksum(checksum, point.UseWeatherAllowed);
+		checksum = AddToChecksum(checksum, point.CurvatureIndex);
+		checksum = AddToChecksum(checksum, point.RawGroundIndex);
+		checksum = AddToChecksum(checksum, point.UseGroundIndex);
+		checksum = AddToChecksum(checksum, point.RawGroundOffset);
+		checksum = AddToChecksum(checksum, point.UseGroundOffset);
+		checksum = AddToChecksum(checksum, (uint8)point.OpenLeft);
+		checksum = AddToChecksum(checksum, (uint8)point.OpenRight);
+		checksum = AddToChecksum(checksum, point.EnvironmentDistances.Num());
+		checksum = FCrc::MemCrc32(point.EnvironmentDistances.GetData(), point.EnvironmentDistances.Num() * (int32)sizeof(float), checksum);
+	}
+
+	return checksum;
+}
+
+/**
+* Calculate the checksum of the master racing spline and the links between a set of
+* splines that master spline distances are computed from.
+*
+* The splines are identified by their keys and visited in key order, and their links
+* sorted, so the checksum doesn't depend on the order they're found in the world.
+***********************************************************************************/
+
+uint32 FNavigationCache::CalculateNetworkChecksum(const TArray<UPursuitSplineComponent*>& splines, const UPursuitSplineComponent* masterRacingSpline)
+{
+	struct FLinkRecord
+	{
+		uint32 Key;
+		float ThisDistance;
+		float NextDistance;
+		uint8 ForwardLink;
+	};
+
+	typedef TPair<uint32, const UPursuitSplineComponent*> FKeyedSpline;
+
+	TArray<FKeyedSpline> keyedSplines;
+
+	keyedSplines.Reserve(splines.Num());
+
+	for (const UPursuitSplineComponent* spline : splines)
+	{
+		keyedSplines.Emplace(CalculateKey(spline), spline);
+	}
+
+	keyedSplines.Sort([] (const FKeyedSpline& object1, const FKeyedSpline& object2)
+		{
+			return object1.Key < object2.Key;
+		});
+
+	uint32 checksum = AddToChecksum(0, (masterRacingSpline != nullptr) ? CalculateKey(masterRacingSpline) : 0u);
+	TArray<FLinkRecord> links;
+
+	for (const FKeyedSpline& keyedSpline : keyedSplines)
+	{
+		const UPursuitSplineComponent* spline = keyedSpline.Value;
+
+		links.Reset();
+
+		for (const FSplineLink& link : spline->SplineLinks)
+		{
+			links.Emplace(FLinkRecord{ (link.Spline.IsValid() == true) ? CalculateKey(link.Spline.Get()) : 0u, link.ThisDistance, link.NextDistance, (uint8)link.ForwardLink });
+		}
+
+		links.Sort([] (const FLinkRecord& object1, const FLinkRecord& object2)
+			{
+				if (object1.Key != object2.Key)
+				{
+					return object1.Key < object2.Key;
+				}
+
+				if (object1.ThisDistance != object2.ThisDistance)
+				{
+					return object1.ThisDistance < object2.ThisDistance;
+				}
+
+				if (object1.NextDistance != object2.NextDistance)
+				{
+					return object1.NextDistance < object2.NextDistance;
+				}
+
+				return object1.ForwardLink < object2.ForwardLink;
+			});
+
+		checksum = AddToChecksum(checksum, keyedSpline.Key);
+		checksum = AddToChecksum(checksum, (uint8)spline->DeadStart);
+		checksum = AddToChecksum(checksum, (uint8)spline->DeadEnd);
+		checksum = AddToChecksum(checksum, links.Num());
+
+		for (const FLinkRecord& link : links)
+		{
+			checksum = AddToChecksum(checksum, link.Key);
+			checksum = AddToChecksum(checksum, link.ThisDistance);
+			checksum = AddToChecksum(checksum, link.NextDistance);
+			checksum = AddToChecksum(checksum, link.ForwardLink);
+		}
+	}
+
+	return checksum;
+}
+
+#if WITH_EDITOR
+
+/**
+* Write the cache file for the map loaded into a world, from its pursuit splines
+* once the level has started.
+*
+* The level needs to have started so that all of the derived data, and especially
+* the master spline distances, have been computed.
+***********************************************************************************/
+
+bool FNavigationCache::Write(UWorld* world)
+{
+	UGlobalGameState* gameState = UGlobalGameState::GetGlobalGameState(world);
+	FString navigationLayer = (gameState != nullptr) ? gameState->TransientGameState.NavigationLayer : FString();
+	APlayGameMode* gameMode = APlayGameMode::Get(world);
+	TArray<UPursuitSplineComponent*> splines;
+	TArray<UPursuitSplineComponent*> masteredSplines;
+	TArray<FNavigationCacheEntry> entries;
+
+	for (TActorIterator<APursuitSplineActor> actorItr(world); actorItr; ++actorItr)
+	{
+		bool validForLayer = (gameState != nullptr) ? FWorldFilter::IsValid(*actorItr, gameState) : FWorldFilter::IsValid(*actorItr, FName(*navigationLayer));
+		TArray<UActorComponent*> components;
+
+		(*actorItr)->GetComponents(UPursuitSplineComponent::StaticClass(), components);
+
+		// Only actors with a usable spline are included in the master spline distance
+		// calculations, so match that here.
+
+		bool usable = components.ContainsByPredicate([] (UActorComponent* component) { return Cast<UPursuitSplineComponent>(component)->GetNumberOfSplinePoints() > 1; });
+
+		for (UActorComponent* component : components)
+		{
+			UPursuitSplineComponent* spline = Cast<UPursuitSplineComponent>(component);
+
+			if (spline->PursuitSplineParent == nullptr)
+			{
+				continue;
+			}
+
+			FNavigationCacheEntry entry;
+
+			entry.Key = CalculateKey(spline);
+
+			if (entries.ContainsByPredicate([&entry] (const FNavigationCacheEntry& other) { return other.Key == entry.Key; }) == true)
+			{
+				UE_LOG(GripLogPursuitSplines, Warning, TEXT("Pursuit spline %s has a duplicate key and can't be cached"), *spline->ActorName);
+
+				continue;
+			}
+
+			const FPursuitPointExtendedPacked& packedData = spline->GetPackedExtendedData();
+
+			entry.SourceChecksum = CalculateSourceChecksum(spline);
+			entry.NumPoints = packedData.Num();
+			entry.NumStraightSections = spline->StraightSections.Num();
+			entry.NumDroneSections = spline->DroneSections.Num();
+			entry.MasterDistanceClass = spline->MasterDistanceClass;
+			entry.HasMasterDistances = (validForLayer == true && usable == true && spline->HasMasterSplineDistances() == true) ? 1 : 0;
+
+			if (entry.HasMasterDistances != 0)
+			{
+				masteredSplines.Emplace(spline);
+			}
+
+			splines.Emplace(spline);
+			entries.Emplace(entry);
+		}
+	}
+
+	// Lay the file out with the entries sorted by key, followed by the payloads.
+
+	TArray<int32> order;
+
+	for (int32 i = 0; i < entries.Num(); i++)
+	{
+		order.Emplace(i);
+	}
+
+	order.Sort([&entries] (int32 object1, int32 object2)
+		{
+			return entries[object1].Key < entries[object2].Key;
+		});
+
+	uint32 offset = Align((uint32)(sizeof(FNavigationCacheHeader) + (entries.Num() * sizeof(FNavigationCacheEntry))), 16);
+
+	for (int32 index : order)
+	{
+		FNavigationCacheEntry& entry = entries[index];
+
+		entry.PayloadOffset = offset;
+		entry.PayloadSize = FNavigationCacheLayout(entry).Size;
+
+		offset += entry.PayloadSize;
+	}
+
+	TArray<uint8> data;
+
+	data.SetNumZeroed(offset);
+
+	FNavigationCacheHeader* header = (FNavigationCacheHeader*)data.GetData();
+	FNavigationCacheEntry* sortedEntries = (FNavigationCacheEntry*)(data.GetData() + sizeof(FNavigationCacheHeader));
+
+	for (int32 i = 0; i < order.Num(); i++)
+	{
+		FNavigationCacheEntry& entry = entries[order[i]];
+		UPursuitSplineComponent* spline = splines[order[i]];
+		const FPursuitPointExtendedPacked& packedData = spline->GetPackedExtendedData();
+		FNavigationCacheLayout layout(entry);
+		uint8* payload = data.GetData() + entry.PayloadOffset;
+		float* quaternions = (float*)(payload + layout.Quaternions);
+
+		for (int32 j = 0; j < entry.NumPoints; j++)
+		{
+			const FQuat& quaternion = packedData.Quaternions[j];
+
+			quaternions[j * 4 + 0] = quaternion.X;
+			quaternions[j * 4 + 1] = quaternion.Y;
+			quaternions[j * 4 + 2] = quaternion.Z;
+			quaternions[j * 4 + 3] = quaternion.W;
+		}
+
+		FMemory::Memcpy(payload + layout.SignedCurvatureSums, packedData.SignedCurvatureSums.GetData(), (entry.NumPoints + 1) * FNavigationCacheLayout::DegreesSumSize);
+		FMemory::Memcpy(payload + layout.UnsignedCurvatureSums, packedData.UnsignedCurvatureSums.GetData(), (entry.NumPoints + 1) * FNavigationCacheLayout::DegreesSumSize);
+
+		if (entry.HasMasterDistances != 0)
+		{
+			FMemory::Memcpy(payload + layout.MasterSplineDistances, packedData.MasterSplineDistances.GetData(), entry.NumPoints * sizeof(float));
+		}
+
+		float* straightSections = (float*)(payload + layout.StraightSections);
+
+		for (int32 j = 0; j < entry.NumStraightSections; j++)
+		{
+			straightSections[j * 2 + 0] = spline->StraightSections[j].StartDistance;
+			straightSections[j * 2 + 1] = spline->StraightSections[j].EndDistance;
+		}
+
+		float* droneSections = (float*)(payload + layout.DroneSections);
+
+		for (int32 j = 0; j < entry.NumDroneSections; j++)
+		{
+			droneSections[j * 2 + 0] = spline->DroneSections[j].StartDistance;
+			droneSections[j * 2 + 1] = spline->DroneSections[j].EndDistance;
+		}
+
+		entry.PayloadCrc = FCrc::MemCrc32(payload, entry.PayloadSize);
+
+		sortedEntries[i] = entry;
+	}
+
+	header->Magic = FileMagic;
+	header->Version = FileVersion;
+	header->FileSize = offset;
+	header->NumSplines = entries.Num();
+	header->NumMasteredSplines = masteredSplines.Num();
+	header->NavigationLayerCrc = FCrc::StrCrc32(*navigationLayer);
+	header->NetworkChecksum = CalculateNetworkChecksum(masteredSplines, (gameMode != nullptr) ? gameMode->MasterRacingSpline.Get() : nullptr);
+	header->EntriesCrc = FCrc::MemCrc32(sortedEntries, entries.Num() * (int32)sizeof(FNavigationCacheEntry));
+
+	// The file may be mapped from loading this level, so close it before overwriting it.
+
+	FString filename = GetFilename(world);
+
+	Instance.Close();
+
+	if (FFileHelper::SaveArrayToFile(data, *filename) == true)
+	{
+		UE_LOG(GripLogPursuitSplines, Display, TEXT("Navigation cache of %d pursuit splines written to %s, %d bytes"), entries.Num(), *filename, data.Num());
+
+		return true;
+	}
+	else
+	{
+		UE_LOG(GripLogPursuitSplines, Error, TEXT("Navigation cache could not be written to %s"), *filename);
+
+		return false;
+	}
+}
+
+/**
+* Write the navigation cache for the level that's currently being played.
+***********************************************************************************/
+
+static void BuildNavigationCache(const TArray<FString>& args, UWorld* world)
+{
+	if (world == nullptr ||
+		world->IsGameWorld() == false)
+	{
+		UE_LOG(GripLogPursuitSplines, Warning, TEXT("The navigation cache can only be built once a level has started"));
+
+		return;
+	}
+
+	FNavigationCache::Write(world);
+}
+
+static FAutoConsoleCommand BuildNavigationCacheCommand(
+	TEXT("grip.BuildNavigationCache"),
+	TEXT("Write the navigation cache for the level that's currently being played, for its pursuit splines to be restored from when it's next loaded."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BuildNavigationCache));
+
+#endif // WITH_EDITOR
+
+#endif // GRIP_NAVIGATION_CACHE
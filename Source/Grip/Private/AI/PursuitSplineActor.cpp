@@ -18,6 +18,7 @@
 #include "system/worldfilter.h"
 #include "game/globalgamestate.h"
 #include "gamemodes/playgamemode.h"
+#include "algo/sort.h"
 
 /**
 * Construct pursuit spline.
@@ -260,10 +261,11 @@ void APursuitSplineActor::OnObjectSelected(UObject* object)
 
 struct FSplineDistance2
 {
-	FSplineDistance2(UPursuitSplineComponent* spline, float distanceAway, float distanceAlong)
+	FSplineDistance2(UPursuitSplineComponent* spline, float distanceAway, float distanceAlong, int32 splineIndex = INDEX_NONE)
 		: Spline(spline)
 		, DistanceAway(distanceAway)
 		, DistanceAlong(distanceAlong)
+		, SplineIndex(splineIndex)
 	{ }
 
 	// The spline.
@@ -274,6 +276,9 @@ struct FSplineDistance2
 
 	// The distance along the spline.
 	float DistanceAlong = 0.0f;
+
+	// The index of the spline in the pursuit spline index, if any.
+	int32 SplineIndex = INDEX_NONE;
 };
 
 /**
@@ -284,123 +289,331 @@ bool APursuitSplineActor::EstablishPursuitSplineLinks(UPursuitSplineComponent* t
 {
 	check(targetSpline != nullptr);
 
-	float minDistance = MinDistanceForSplineLinksSquared;
 	TArray<UActorComponent*> splines;
 
 	GetComponents(UPursuitSplineComponent::StaticClass(), splines);
 
-	int32 numIterations = 5;
-
 	for (UActorComponent* component : splines)
 	{
 		UPursuitSplineComponent* splineComponent = Cast<UPursuitSplineComponent>(component);
 
 		if (splineComponent != targetSpline)
 		{
-			// Determine if the end points in this spline fall on the spline we're potentially attaching to.
+			AddSplineLinks(splineComponent, targetSpline, FindSplineLink(splineComponent, targetSpline, true, true));
+		}
+	}
 
-			// The length of the spline.
+	return true;
+}
 
-			float length = targetSpline->GetSplineLength();
-			float thisLength = splineComponent->GetSplineLength();
+/**
+* Find how the end points of a spline link onto a target spline, only reading the
+* splines so it's thread-safe.
+*
+* Either end can be excluded from the test when it's already known to be too far
+* away from the target spline to link onto it.
+***********************************************************************************/
+
+FSplineLinkCandidate APursuitSplineActor::FindSplineLink(const UPursuitSplineComponent* splineComponent, const UPursuitSplineComponent* targetSpline, bool testStart, bool testEnd)
+{
+	FSplineLinkCandidate candidate;
+	float minDistance = MinDistanceForSplineLinksSquared;
+	int32 numIterations = 5;
 
-			// The world position of this spline's start point.
+	// Determine if the end points in this spline fall on the spline we're potentially attaching to.
 
-			FVector from0 = splineComponent->GetWorldLocationAtDistanceAlongSpline(0.0f);
+	// The length of the spline.
 
-			// Distance along the target spline of this spline's start point.
+	float length = targetSpline->GetSplineLength();
+	float thisLength = splineComponent->GetSplineLength();
 
-			float distance0 = targetSpline->GetNearestDistance(from0, 0.0f, length, numIterations, targetSpline->GetNumSamplesForRange(length, numIterations, 1.0f, 100), 1.0f);
+	if (testStart == true)
+	{
+		// The world position of this spline's start point.
 
-			// Position on the target spline of this spline's start point.
+		FVector from0 = splineComponent->GetWorldLocationAtDistanceAlongSpline(0.0f);
 
-			FVector to0 = targetSpline->GetWorldLocationAtDistanceAlongSpline(distance0);
+		// Distance along the target spline of this spline's start point.
 
-			// The world position of this spline's end point.
+		float distance0 = targetSpline->GetNearestDistance(from0, 0.0f, length, numIterations, targetSpline->GetNumSamplesForRange(length, numIterations, 1.0f, 100), 1.0f);
 
-			FVector from1 = splineComponent->GetWorldLocationAtDistanceAlongSpline(thisLength);
+		// Position on the target spline of this spline's start point.
 
-			// Distance along the target spline of this spline's end point.
+		FVector to0 = targetSpline->GetWorldLocationAtDistanceAlongSpline(distance0);
 
-			float distance1 = targetSpline->GetNearestDistance(from1, 0.0f, length, numIterations, targetSpline->GetNumSamplesForRange(length, numIterations, 1.0f, 100), 1.0f);
+		// See if this spline's start point is in range of the target spline.
 
-			// Position on the target spline of this spline's end point.
+		bool thisStartPointConnected = ((from0 - to0).SizeSquared() < minDistance); // May be true for looped splines - probably untrue but harmless if true.
 
-			FVector to1 = targetSpline->GetWorldLocationAtDistanceAlongSpline(distance1);
+		if (thisStartPointConnected == true)
+		{
+			FVector direction0 = targetSpline->GetWorldDirectionAtDistanceAlongSpline(FMath::Clamp(distance0, 1.0f, length - 1.0f));
+			FVector direction1 = splineComponent->GetWorldDirectionAtDistanceAlongSpline(FMath::Clamp(0.0f, 1.0f, thisLength - 1.0f));
 
-			// See if this spline's end points are in range of the target spline.
+			thisStartPointConnected &= (FVector::DotProduct(direction0, direction1) > 0.0f);
+		}
 
-			bool thisStartPointConnected = ((from0 - to0).SizeSquared() < minDistance); // May be true for looped splines - probably untrue but harmless if true.
-			bool thisEndPointConnected = (((from1 - to1).SizeSquared() < minDistance) && (splineComponent->IsClosedLoop() == false)); // Will never be true for looped splines.
+		candidate.StartConnected = thisStartPointConnected;
+		candidate.StartDistance = distance0;
+	}
 
-			if (thisStartPointConnected == true)
-			{
-				FVector direction0 = targetSpline->GetWorldDirectionAtDistanceAlongSpline(FMath::Clamp(distance0, 1.0f, length - 1.0f));
-				FVector direction1 = splineComponent->GetWorldDirectionAtDistanceAlongSpline(FMath::Clamp(0.0f, 1.0f, thisLength - 1.0f));
+	if (testEnd == true &&
+		splineComponent->IsClosedLoop() == false)
+	{
+		// The world position of this spline's end point.
 
-				thisStartPointConnected &= (FVector::DotProduct(direction0, direction1) > 0.0f);
-			}
+		FVector from1 = splineComponent->GetWorldLocationAtDistanceAlongSpline(thisLength);
 
-			if (thisEndPointConnected == true)
-			{
-				FVector direction0 = targetSpline->GetWorldDirectionAtDistanceAlongSpline(FMath::Clamp(distance1, 1.0f, length - 1.0f));
-				FVector direction1 = splineComponent->GetWorldDirectionAtDistanceAlongSpline(FMath::Clamp(thisLength, 1.0f, thisLength - 1.0f));
+		// Distance along the target spline of this spline's end point.
 
-				thisEndPointConnected &= (FVector::DotProduct(direction0, direction1) > 0.0f);
-			}
+		float distance1 = targetSpline->GetNearestDistance(from1, 0.0f, length, numIterations, targetSpline->GetNumSamplesForRange(length, numIterations, 1.0f, 100), 1.0f);
 
-			// If any of the end points are in range of the target spline, then add links in here.
-			// Here we're grafting splineComponent onto spline, and of course the other way around. Note
-			// that this will only happen once for each link on each spline as there is a check for
-			// duplicates on AddSplineLink.
+		// Position on the target spline of this spline's end point.
 
-			if (thisStartPointConnected == true)
-			{
-				// So the start point on splineComponent is connected to targetSpline.
+		FVector to1 = targetSpline->GetWorldLocationAtDistanceAlongSpline(distance1);
 
-				// Add the start (0) of this spline onto the target spline at the found distance.
+		// See if this spline's end point is in range of the target spline, which will never be true for looped splines.
 
-				targetSpline->AddSplineLink(FSplineLink(splineComponent, distance0, 0.0f, true));
+		bool thisEndPointConnected = ((from1 - to1).SizeSquared() < minDistance);
 
-				// Add the found distance of target spline onto the start (0) of this spline (because
-				// it was the start of the this spline).
+		if (thisEndPointConnected == true)
+		{
+			FVector direction0 = targetSpline->GetWorldDirectionAtDistanceAlongSpline(FMath::Clamp(distance1, 1.0f, length - 1.0f));
+			FVector direction1 = splineComponent->GetWorldDirectionAtDistanceAlongSpline(FMath::Clamp(thisLength, 1.0f, thisLength - 1.0f));
 
-				splineComponent->AddSplineLink(FSplineLink(targetSpline, 0.0f, distance0, false));
-			}
+			thisEndPointConnected &= (FVector::DotProduct(direction0, direction1) > 0.0f);
+		}
 
-			if (thisEndPointConnected == true)
-			{
-				// So the end point on splineComponent is connected to targetSpline.
+		candidate.EndConnected = thisEndPointConnected;
+		candidate.EndDistance = distance1;
+	}
+
+	return candidate;
+}
+
+/**
+* Add the links found between the end points of a spline and a target spline.
+***********************************************************************************/
+
+void APursuitSplineActor::AddSplineLinks(UPursuitSplineComponent* splineComponent, UPursuitSplineComponent* targetSpline, const FSplineLinkCandidate& candidate)
+{
+	// If any of the end points are in range of the target spline, then add links in here.
+	// Here we're grafting splineComponent onto spline, and of course the other way around. Note
+	// that this will only happen once for each link on each spline as there is a check for
+	// duplicates on AddSplineLink.
+
+	if (candidate.StartConnected == true)
+	{
+		// So the start point on splineComponent is connected to targetSpline.
+
+		// Add the start (0) of this spline onto the target spline at the found distance.
+
+		targetSpline->AddSplineLink(FSplineLink(splineComponent, candidate.StartDistance, 0.0f, true));
+
+		// Add the found distance of target spline onto the start (0) of this spline (because
+		// it was the start of the this spline).
+
+		splineComponent->AddSplineLink(FSplineLink(targetSpline, 0.0f, candidate.StartDistance, false));
+	}
+
+	if (candidate.EndConnected == true)
+	{
+		float thisLength = splineComponent->GetSplineLength();
+
+		// So the end point on splineComponent is connected to targetSpline.
+
+		// Add the end (thisLength) of this spline onto the target spline at the found distance.
+
+		targetSpline->AddSplineLink(FSplineLink(splineComponent, candidate.EndDistance, thisLength, false));
+
+		// Add the found distance of target spline onto the end (thisLength) of this spline
+		// (because it was the end of the this spline).
+
+		splineComponent->AddSplineLink(FSplineLink(targetSpline, thisLength, candidate.EndDistance, true));
+	}
+
+	// Sort the links according to the distance they're connected to this spline at.
+
+	splineComponent->SplineLinks.Sort([](const FSplineLink& object1, const FSplineLink& object2) { return object1.ThisDistance < object2.ThisDistance; });
+
+	splineComponent->DeadStart = false;
+	splineComponent->DeadEnd = false;
+
+	if (splineComponent->IsClosedLoop() == false)
+	{
+		if (splineComponent->SplineLinks.Num() > 0)
+		{
+			splineComponent->DeadStart = (splineComponent->SplineLinks[0].ThisDistance > 100.0f);
+			splineComponent->DeadEnd = (splineComponent->SplineLinks[splineComponent->SplineLinks.Num() - 1].ThisDistance < splineComponent->GetSplineLength() - 100.0f);
+		}
+	}
+}
+
+/**
+* Calculate the bounds of the sections of a spline, for quickly rejecting end points
+* that can't link onto it.
+***********************************************************************************/
+
+void APursuitSplineActor::CalculateSplineLinkBounds(const UPursuitSplineComponent* spline, TArray<FBox>& bounds)
+{
+	// The length of each section, the number of samples taken along each section to
+	// determine its bounds, and the margin added to those bounds to account for the
+	// curvature between samples and the range within which links are made.
+
+	const int32 numSamples = 10;
+	const float sectionLength = 50.0f * 100.0f;
+	const float boundsMargin = 2.0f * 100.0f + FMath::Sqrt(MinDistanceForSplineLinksSquared);
+	float length = spline->GetSplineLength();
+
+	bounds.Reset();
+
+	for (float distance = 0.0f; distance < length; distance += sectionLength)
+	{
+		float endDistance = FMath::Min(distance + sectionLength, length);
+		FBox box(ForceInit);
+
+		for (int32 i = 0; i <= numSamples; i++)
+		{
+			box += spline->GetWorldLocationAtDistanceAlongSpline(FMath::Lerp(distance, endDistance, (float)i / (float)numSamples));
+		}
+
+		bounds.Emplace(box.ExpandBy(boundsMargin));
+	}
+}
 
-				// Add the end (thisLength) of this spline onto the target spline at the found distance.
+/**
+* Is a location close enough to a spline to possibly link onto it, given the bounds
+* of its sections?
+***********************************************************************************/
 
-				targetSpline->AddSplineLink(FSplineLink(splineComponent, distance1, thisLength, false));
+bool APursuitSplineActor::IsWithinSplineLinkRange(const FVector& location, const TArray<FBox>& bounds)
+{
+	for (const FBox& box : bounds)
+	{
+		if (box.IsInsideOrOn(location) == true)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
 
-				// Add the found distance of target spline onto the end (thisLength) of this spline
-				// (because it was the end of the this spline).
+/**
+* Calculate a hash of the spline data that the links between splines are
+* established from, never returning 0.
+***********************************************************************************/
+
+uint32 APursuitSplineActor::CalculateSplineLinksHash(const TArray<APursuitSplineActor*>& splineActors, const UPursuitSplineComponent* masterRacingSpline)
+{
+	// Change the version whenever the way links are established changes.
 
-				splineComponent->AddSplineLink(FSplineLink(targetSpline, thisLength, distance1, true));
+	const uint32 version = 1;
+	uint32 hash = FCrc::MemCrc32(&version, sizeof(version));
+
+	hash = FCrc::MemCrc32(&MinDistanceForSplineLinksSquared, sizeof(float), hash);
+
+	if (masterRacingSpline != nullptr &&
+		masterRacingSpline->GetOwner() != nullptr)
+	{
+		hash = FCrc::StrCrc32(*masterRacingSpline->GetOwner()->GetName(), hash);
+	}
+
+	for (APursuitSplineActor* splineActor : splineActors)
+	{
+		TArray<UActorComponent*> splines;
+
+		splineActor->GetComponents(UPursuitSplineComponent::StaticClass(), splines);
+
+		hash = FCrc::StrCrc32(*splineActor->GetName(), hash);
+
+		for (UActorComponent* component : splines)
+		{
+			UPursuitSplineComponent* spline = Cast<UPursuitSplineComponent>(component);
+			int32 numPoints = spline->GetNumberOfSplinePoints();
+			bool closedLoop = spline->IsClosedLoop();
+
+			hash = FCrc::MemCrc32(&numPoints, sizeof(numPoints), hash);
+			hash = FCrc::MemCrc32(&closedLoop, sizeof(closedLoop), hash);
+
+			for (int32 i = 0; i < numPoints; i++)
+			{
+				FVector point[3] =
+				{
+					spline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World),
+					spline->GetArriveTangentAtSplinePoint(i, ESplineCoordinateSpace::World),
+					spline->GetLeaveTangentAtSplinePoint(i, ESplineCoordinateSpace::World)
+				};
+
+				hash = FCrc::MemCrc32(point, sizeof(point), hash);
 			}
+		}
+	}
+
+	return FMath::Max(hash, 1u);
+}
 
-			// Sort the links according to the distance they're connected to this spline at.
+/**
+* Save the links from the splines of this actor with the level.
+***********************************************************************************/
+
+void APursuitSplineActor::SaveSplineLinks(uint32 hash)
+{
+	TArray<UActorComponent*> splines;
+
+	GetComponents(UPursuitSplineComponent::StaticClass(), splines);
 
-			splineComponent->SplineLinks.Sort([](const FSplineLink& object1, const FSplineLink& object2) { return object1.ThisDistance < object2.ThisDistance; });
+	Modify();
 
-			splineComponent->DeadStart = false;
-			splineComponent->DeadEnd = false;
+	SavedSplineLinks.Reset();
+	SavedSplineLinksHash = hash;
 
-			if (splineComponent->IsClosedLoop() == false)
+	for (UActorComponent* component : splines)
+	{
+		UPursuitSplineComponent* spline = Cast<UPursuitSplineComponent>(component);
+		FSavedSplineLinks& savedLinks = SavedSplineLinks.AddDefaulted_GetRef();
+
+		savedLinks.Spline = spline;
+		savedLinks.DeadStart = spline->DeadStart;
+		savedLinks.DeadEnd = spline->DeadEnd;
+
+		for (const FSplineLink& link : spline->SplineLinks)
+		{
+			FSavedSplineLink& savedLink = savedLinks.Links.AddDefaulted_GetRef();
+
+			savedLink.Spline = link.Spline.Get();
+			savedLink.ThisDistance = link.ThisDistance;
+			savedLink.NextDistance = link.NextDistance;
+			savedLink.ForwardLink = link.ForwardLink;
+		}
+	}
+}
+
+/**
+* Restore the links from the splines of this actor that were saved with the level.
+***********************************************************************************/
+
+void APursuitSplineActor::RestoreSplineLinks() const
+{
+	for (const FSavedSplineLinks& savedLinks : SavedSplineLinks)
+	{
+		UPursuitSplineComponent* spline = savedLinks.Spline;
+
+		if (spline != nullptr)
+		{
+			spline->SplineLinks.Reset();
+			spline->DeadStart = savedLinks.DeadStart;
+			spline->DeadEnd = savedLinks.DeadEnd;
+
+			for (const FSavedSplineLink& savedLink : savedLinks.Links)
 			{
-				if (splineComponent->SplineLinks.Num() > 0)
+				if (savedLink.Spline != nullptr)
 				{
-					splineComponent->DeadStart = (splineComponent->SplineLinks[0].ThisDistance > 100.0f);
-					splineComponent->DeadEnd = (splineComponent->SplineLinks[splineComponent->SplineLinks.Num() - 1].ThisDistance < splineComponent->GetSplineLength() - 100.0f);
+					spline->SplineLinks.Emplace(FSplineLink(savedLink.Spline, savedLink.ThisDistance, savedLink.NextDistance, savedLink.ForwardLink));
 				}
 			}
 		}
 	}
-
-	return true;
 }
 
 /**
@@ -415,6 +628,11 @@ bool APursuitSplineActor::Build(bool fromMenu)
 
 	GetComponents(UPursuitSplineComponent::StaticClass(), splines);
 
+	// The point data may have been changed, so pack it again before the splines
+	// calculate their sections from it, and rebuild the optimum speeds for querying.
+
+	PackedExtendedData.Pack(PointExtendedData);
+
 	for (UActorComponent* component : splines)
 	{
 		UPursuitSplineComponent* spline = Cast<UPursuitSplineComponent>(component);
@@ -422,16 +640,86 @@ bool APursuitSplineActor::Build(bool fromMenu)
 		spline->Build(fromMenu, false, false);
 	}
 
+	for (UActorComponent* component : splines)
+	{
+		Cast<UPursuitSplineComponent>(component)->BuildOptimumSpeedTable();
+	}
+
 	return true;
 }
 
 #pragma region AINavigation
 
+/**
+* Determine how far a location is from a pursuit spline, for finding the nearest
+* pursuit spline.
+*
+* Returns false if the spline isn't suitable.
+***********************************************************************************/
+
+static bool MeasurePursuitSpline(UPursuitSplineComponent* splineComponent, const FVector& location, UPursuitSplineComponent* masterSpline, float masterSplineLength, float masterDistance, EPursuitSplineType type, bool matchMasterDistanceAlong, bool allowDeadStarts, bool allowDeadEnds, float minMatchingDistance, int32 splineIndex, TArray<FSplineDistance2>& sortedSplines)
+{
+	if ((allowDeadStarts == true || splineComponent->DeadStart == false) &&
+		(allowDeadEnds == true || splineComponent->DeadEnd == false))
+	{
+		if (splineComponent->Enabled == true &&
+			splineComponent->Type == type &&
+			splineComponent->GetNumberOfSplinePoints() > 1)
+		{
+			float distance = 0.0f;
+			float maxMatchingDistance = 250.0f * 100.0f;
+
+			if (masterSpline == splineComponent &&
+				matchMasterDistanceAlong == true)
+			{
+				// This is the master spline and we're looking to match a master distance
+				// so we can focus our search to a small area.
+
+				distance = splineComponent->GetNearestDistance(location, masterDistance - maxMatchingDistance * 2.0f, masterDistance + maxMatchingDistance * 2.0f);
+			}
+			else if (matchMasterDistanceAlong == true)
+			{
+				distance = splineComponent->GetNearestDistanceToMasterDistance(masterDistance);
+			}
+			else
+			{
+				distance = splineComponent->GetNearestDistance(location);
+			}
+
+			FVector difference = location - splineComponent->GetWorldLocationAtDistanceAlongSpline(distance);
+
+			if (matchMasterDistanceAlong == true)
+			{
+				float thisMasterDistance = splineComponent->GetMasterDistanceAtDistanceAlongSpline(distance, masterSplineLength);
+				float distanceDifference = masterSpline->GetDistanceDifference(masterDistance, thisMasterDistance);
+				float maxDistance = FMath::Max(minMatchingDistance, maxMatchingDistance);
+
+				if (distanceDifference > maxDistance)
+				{
+					return false;
+				}
+			}
+
+			sortedSplines.Emplace(FSplineDistance2(splineComponent, difference.Size(), distance, splineIndex));
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /**
 * Find the nearest pursuit spline to a world space location.
 *
 * If you opt to matchMasterDistanceAlong then you need to provide that distance
 * in distanceAlong.
+*
+* If the pursuit spline index has been built then we search it with an increasing
+* radius, only measuring the splines that have a segment within that radius. Any
+* splines measured to be within the radius are guaranteed to be closer than all of
+* the splines not yet measured, so we can check those for visibility before
+* widening the search, and eventually measuring all of the splines if we must.
 ***********************************************************************************/
 
 bool APursuitSplineActor::FindNearestPursuitSpline(const FVector& location, const FVector& direction, UWorld* world, TWeakObjectPtr<UPursuitSplineComponent>& pursuitSpline, float& distanceAway, float& distanceAlong, EPursuitSplineType type, bool visibleOnly, bool matchMasterDistanceAlong, bool allowDeadStarts, bool allowDeadEnds, float minMatchingDistance)
@@ -455,84 +743,99 @@ bool APursuitSplineActor::FindNearestPursuitSpline(const FVector& location, cons
 	distanceAway = -1.0f;
 	pursuitSpline.Reset();
 
+	FPursuitSplineIndex& splineIndex = gameMode->PursuitSplineIndex;
 	TArray<FSplineDistance2> sortedSplines;
+	TArray<bool> gathered;
+	TArray<int32> splinesInRange;
+	bool allMeasured = (splineIndex.IsBuilt() == false);
+	float radius = FPursuitSplineIndex::CellSize;
+	int32 numChecked = 0;
 
-	for (APursuitSplineActor* splineActor : gameMode->GetPursuitSplines())
+	if (allMeasured == true)
 	{
-		TArray<UActorComponent*> splines;
+		// There's no index so just measure every spline.
 
-		splineActor->GetComponents(UPursuitSplineComponent::StaticClass(), splines);
-
-		for (UActorComponent* component : splines)
+		for (APursuitSplineActor* splineActor : gameMode->GetPursuitSplines())
 		{
-			UPursuitSplineComponent* splineComponent = Cast<UPursuitSplineComponent>(component);
+			TArray<UActorComponent*> splines;
 
-			if ((allowDeadStarts == true || splineComponent->DeadStart == false) &&
-				(allowDeadEnds == true || splineComponent->DeadEnd == false))
+			splineActor->GetComponents(UPursuitSplineComponent::StaticClass(), splines);
+
+			for (UActorComponent* component : splines)
 			{
-				if (splineComponent->Enabled == true &&
-					splineComponent->Type == type &&
-					splineComponent->GetNumberOfSplinePoints() > 1)
-				{
-					float distance = 0.0f;
-					float maxMatchingDistance = 250.0f * 100.0f;
+				MeasurePursuitSpline(Cast<UPursuitSplineComponent>(component), location, masterSpline, masterSplineLength, masterDistance, type, matchMasterDistanceAlong, allowDeadStarts, allowDeadEnds, minMatchingDistance, INDEX_NONE, sortedSplines);
+			}
+		}
+	}
 
-					if (masterSpline == splineComponent &&
-						matchMasterDistanceAlong == true)
-					{
-						// This is the master spline and we're looking to match a master distance
-						// so we can focus our search to a small area.
+	FCollisionQueryParams queryParams(TEXT("SplineEnvironmentSensor"), false, nullptr);
 
-						distance = splineComponent->GetNearestDistance(location, masterDistance - maxMatchingDistance * 2.0f, masterDistance + maxMatchingDistance * 2.0f);
-					}
-					else if (matchMasterDistanceAlong == true)
-					{
-						distance = splineComponent->GetNearestDistanceToMasterDistance(masterDistance);
-					}
-					else
-					{
-						distance = splineComponent->GetNearestDistance(location);
-					}
+	while (true)
+	{
+		if (allMeasured == false)
+		{
+			// Measure the splines that have come into range of the search.
 
-					FVector difference = location - splineComponent->GetWorldLocationAtDistanceAlongSpline(distance);
+			splinesInRange.Reset();
 
-					if (matchMasterDistanceAlong == true)
+			if (radius > FPursuitSplineIndex::MaxQueryRadius)
+			{
+				gathered.SetNumZeroed(splineIndex.GetNumSplines());
+
+				for (int32 i = 0; i < splineIndex.GetNumSplines(); i++)
+				{
+					if (gathered[i] == false)
 					{
-						float thisMasterDistance = splineComponent->GetMasterDistanceAtDistanceAlongSpline(distance, masterSplineLength);
-						float distanceDifference = masterSpline->GetDistanceDifference(masterDistance, thisMasterDistance);
-						float maxDistance = FMath::Max(minMatchingDistance, maxMatchingDistance);
-
-						if (distanceDifference > maxDistance)
-						{
-							continue;
-						}
+						splinesInRange.Emplace(i);
 					}
-
-					sortedSplines.Emplace(FSplineDistance2(splineComponent, difference.Size(), distance));
 				}
+
+				allMeasured = true;
+			}
+			else
+			{
+				splineIndex.GatherSplinesWithinRange(location, radius, gathered, splinesInRange);
+			}
+
+			for (int32 index : splinesInRange)
+			{
+				MeasurePursuitSpline(splineIndex.GetSpline(index), location, masterSpline, masterSplineLength, masterDistance, type, matchMasterDistanceAlong, allowDeadStarts, allowDeadEnds, minMatchingDistance, index, sortedSplines);
 			}
 		}
-	}
 
-	FCollisionQueryParams queryParams(TEXT("SplineEnvironmentSensor"), false, nullptr);
+		// Sort the splines not yet checked for visibility.
 
-	sortedSplines.Sort([](const FSplineDistance2& object1, const FSplineDistance2& object2)
-		{
-			return object1.DistanceAway < object2.DistanceAway;
-		});
+		Algo::Sort(MakeArrayView(sortedSplines.GetData() + numChecked, sortedSplines.Num() - numChecked), [] (const FSplineDistance2& object1, const FSplineDistance2& object2)
+			{
+				return object1.DistanceAway < object2.DistanceAway;
+			});
 
-	while (true)
-	{
-		FHitResult hit;
+		// Check the splines that are definitely nearer than any we've yet to measure.
 
-		for (FSplineDistance2& sortedSpline : sortedSplines)
+		float maxDistanceAway = (allMeasured == true) ? BIG_NUMBER : radius;
+
+		for (; numChecked < sortedSplines.Num() && sortedSplines[numChecked].DistanceAway <= maxDistanceAway; numChecked++)
 		{
-			float sortedLength = sortedSpline.Spline->GetSplineLength();
-			FVector splineLocation = sortedSpline.Spline->GetWorldLocationAtDistanceAlongSpline(sortedSpline.DistanceAlong);
+			FSplineDistance2& sortedSpline = sortedSplines[numChecked];
+			bool visible = (visibleOnly == false || sortedSpline.Spline->IsWorldLocationWithinRange(sortedSpline.DistanceAlong, location) == true);
 
-			if (visibleOnly == false ||
-				sortedSpline.Spline->IsWorldLocationWithinRange(sortedSpline.DistanceAlong, location) == true ||
-				world->LineTraceSingleByChannel(hit, location, splineLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false)
+			if (visible == false)
+			{
+				FVector splineLocation = sortedSpline.Spline->GetWorldLocationAtDistanceAlongSpline(sortedSpline.DistanceAlong);
+
+				if (sortedSpline.SplineIndex != INDEX_NONE)
+				{
+					visible = splineIndex.IsSplineVisible(world, location, sortedSpline.SplineIndex, sortedSpline.DistanceAlong, splineLocation);
+				}
+				else
+				{
+					FHitResult hit;
+
+					visible = (world->LineTraceSingleByChannel(hit, location, splineLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false);
+				}
+			}
+
+			if (visible == true)
 			{
 				// Return this spline to the caller as it now meets our conditions.
 
@@ -544,18 +847,25 @@ bool APursuitSplineActor::FindNearestPursuitSpline(const FVector& location, cons
 			}
 		}
 
-		if (visibleOnly == true)
+		if (allMeasured == true)
 		{
-			// Fallback to invisible splines if possible.
-
-			visibleOnly = false;
-		}
-		else
-		{
-			// Otherwise we already did the invisible splines so break out.
-
 			break;
 		}
+
+		radius *= 2.0f;
+	}
+
+	// Fallback to invisible splines if possible, which is simply the nearest spline.
+
+	visibleOnly = false;
+
+	if (sortedSplines.Num() > 0)
+	{
+		pursuitSpline = sortedSplines[0].Spline;
+		distanceAlong = sortedSplines[0].DistanceAlong;
+		distanceAway = sortedSplines[0].DistanceAway;
+
+		return visibleOnly;
 	}
 
 	// If we couldn't find a suitable spline that you were close to then simply use the master
@@ -20,6 +20,7 @@
 #include "kismet/kismetmateriallibrary.h"
 #include "system/mathhelpers.h"
 #include "gamemodes/playgamemode.h"
+#include "ai/navigationcache.h"
 
 DEFINE_LOG_CATEGORY(GripLogPursuitSplines);
 
@@ -159,6 +160,227 @@ float FPursuitPointExtendedData::DifferenceInDegrees(int32 indexFrom, int32 inde
 	return FMath::Abs(FMathEx::GetUnsignedDegreesDifference(angleFrom, angleTo));
 }
 
+/**
+* Pack the extended point data into this structure, optionally without summing the
+* curvature, for when the sums are restored from the navigation cache.
+***********************************************************************************/
+
+void FPursuitPointExtendedPacked::Pack(const TArray<FPursuitPointExtendedData>& pointData, bool sumCurvature)
+{
+	int32 numPoints = pointData.Num();
+
+	Distances.SetNumUninitialized(numPoints);
+	MasterSplineDistances.SetNumUninitialized(numPoints);
+	MaxTunnelDiameters.SetNumUninitialized(numPoints);
+	UseWeatherAllowed.SetNumUninitialized(numPoints);
+	UseGroundIndices.SetNumUninitialized(numPoints);
+	OpenEdges.SetNumUninitialized(numPoints);
+	RawGroundOffsets.SetNumUninitialized(numPoints);
+	UseGroundOffsets.SetNumUninitialized(numPoints);
+	Quaternions.SetNumUninitialized(numPoints);
+	EnvironmentDistances.SetNumUninitialized(numPoints * FPursuitPointExtendedData::NumDistances);
+
+	for (int32 i = 0; i < numPoints; i++)
+	{
+		const FPursuitPointExtendedData& point = pointData[i];
+
+		Distances[i] = point.Distance;
+		MasterSplineDistances[i] = point.MasterSplineDistance;
+		MaxTunnelDiameters[i] = point.MaxTunnelDiameter;
+		UseWeatherAllowed[i] = point.UseWeatherAllowed;
+		UseGroundIndices[i] = (uint8)FMath::Clamp(point.UseGroundIndex, 0, FPursuitPointExtendedData::NumDistances - 1);
+		OpenEdges[i] = point.OpenLeft || point.OpenRight;
+		RawGroundOffsets[i] = point.RawGroundOffset;
+		UseGroundOffsets[i] = point.UseGroundOffset;
+		Quaternions[i] = point.Quaternion;
+
+		// Points without environment data, which shouldn't really happen, are given
+		// unknown distances, the same as for samples that didn't hit anything.
+
+		float* distances = EnvironmentDistances.GetData() + (i * FPursuitPointExtendedData::NumDistances);
+
+		if (point.EnvironmentDistances.Num() == FPursuitPointExtendedData::NumDistances)
+		{
+			FMemory::Memcpy(distances, point.EnvironmentDistances.GetData(), FPursuitPointExtendedData::NumDistances * sizeof(float));
+		}
+		else
+		{
+			for (int32 j = 0; j < FPursuitPointExtendedData::NumDistances; j++)
+			{
+				distances[j] = -1.0f;
+			}
+		}
+	}
+
+	if (sumCurvature == false)
+	{
+		return;
+	}
+
+	// Sum the curvature between each point and the next so that the curvature over
+	// any number of points can be had from just two lookups. The last difference
+	// wraps around to the first point, and is only used for closed loops.
+
+	SignedCurvatureSums.SetNumUninitialized(numPoints + 1);
+	UnsignedCurvatureSums.SetNumUninitialized(numPoints + 1);
+
+	FDegreesSum signedSum;
+	FDegreesSum unsignedSum;
+
+	SignedCurvatureSums[0] = signedSum;
+	UnsignedCurvatureSums[0] = unsignedSum;
+
+	for (int32 i = 0; i < numPoints; i++)
+	{
+		FRotator r0 = Quaternions[i].Rotator();
+		FRotator r1 = Quaternions[(i + 1) % numPoints].Rotator();
+		FRotator signedDifference = FMathEx::GetSignedDegreesDifference(r0, r1);
+		FRotator unsignedDifference = FMathEx::GetUnsignedDegreesDifference(r0, r1);
+
+		signedSum.Pitch += signedDifference.Pitch;
+		signedSum.Yaw += signedDifference.Yaw;
+		signedSum.Roll += signedDifference.Roll;
+
+		unsignedSum.Pitch += unsignedDifference.Pitch;
+		unsignedSum.Yaw += unsignedDifference.Yaw;
+		unsignedSum.Roll += unsignedDifference.Roll;
+
+		SignedCurvatureSums[i + 1] = signedSum;
+		UnsignedCurvatureSums[i + 1] = unsignedSum;
+	}
+}
+
+/**
+* Get the sum of the degrees difference between each point and the next over a
+* number of points from a starting point.
+*
+* This gives the same result as stepping along the points and summing the degrees
+* difference at each step, wrapping around for closed loops and stopping at the
+* last point otherwise.
+***********************************************************************************/
+
+FRotator FPursuitPointExtendedPacked::GetCurvatureOverPoints(int32 index, int32 numPoints, bool closedLoop, bool absolute) const
+{
+	const TArray<FDegreesSum>& sums = (absolute == true) ? UnsignedCurvatureSums : SignedCurvatureSums;
+	int32 numSums = Num();
+	double pitch = 0.0;
+	double yaw = 0.0;
+	double roll = 0.0;
+
+	auto addRange = [&] (int32 from, int32 to)
+	{
+		pitch += sums[to].Pitch - sums[from].Pitch;
+		yaw += sums[to].Yaw - sums[from].Yaw;
+		roll += sums[to].Roll - sums[from].Roll;
+	};
+
+	if (closedLoop == true)
+	{
+		int32 numLoops = numPoints / numSums;
+		int32 end = index + (numPoints % numSums);
+
+		pitch = sums[numSums].Pitch * numLoops;
+		yaw = sums[numSums].Yaw * numLoops;
+		roll = sums[numSums].Roll * numLoops;
+
+		if (end <= numSums)
+		{
+			addRange(index, end);
+		}
+		else
+		{
+			addRange(index, numSums);
+			addRange(0, end - numSums);
+		}
+	}
+	else
+	{
+		int32 end = FMath::Min(index + numPoints, numSums - 1);
+
+		if (end > index)
+		{
+			addRange(index, end);
+		}
+	}
+
+	return FRotator((float)pitch, (float)yaw, (float)roll);
+}
+
+/**
+* Build the table from a list of values.
+***********************************************************************************/
+
+void FRangeMinimumTable::Build(const TArray<float>& values)
+{
+	NumValues = values.Num();
+
+	if (NumValues == 0)
+	{
+		Minimums.Empty();
+		return;
+	}
+
+	int32 numLevels = FMath::FloorLog2(NumValues) + 1;
+
+	Minimums.SetNumUninitialized(numLevels * NumValues);
+
+	FMemory::Memcpy(Minimums.GetData(), values.GetData(), NumValues * sizeof(float));
+
+	for (int32 level = 1; level < numLevels; level++)
+	{
+		const float* last = Minimums.GetData() + ((level - 1) * NumValues);
+		float* minimums = Minimums.GetData() + (level * NumValues);
+		int32 half = 1 << (level - 1);
+
+		for (int32 i = 0; i + (half << 1) <= NumValues; i++)
+		{
+			minimums[i] = FMath::Min(last[i], last[i + half]);
+		}
+	}
+}
+
+/**
+* Pack just the master spline distances from the extended point data.
+***********************************************************************************/
+
+void FPursuitPointExtendedPacked::PackMasterSplineDistances(const TArray<FPursuitPointExtendedData>& pointData)
+{
+	if (Num() != pointData.Num())
+	{
+		Pack(pointData);
+	}
+	else
+	{
+		for (int32 i = 0; i < pointData.Num(); i++)
+		{
+			MasterSplineDistances[i] = pointData[i].MasterSplineDistance;
+		}
+	}
+}
+
+/**
+* Interpolate between two blocks of environment distances, where negative
+* distances are unknown, into a third block with some padding added.
+*
+* This is written without branches so that the compiler can vectorize it.
+***********************************************************************************/
+
+static void InterpolateEnvironmentDistances(const float* distances0, const float* distances1, float ratio, float unknown, float padding, float* result)
+{
+	for (int32 i = 0; i < FPursuitPointExtendedData::NumDistances; i++)
+	{
+		float d0 = distances0[i];
+		float d1 = distances1[i];
+		float d2 = d0 + ((d1 - d0) * ratio);
+
+		d2 = (d1 >= 0.0f) ? d2 : d0;
+		d2 = (d0 >= 0.0f) ? d2 : d1;
+		d2 = (d2 >= 0.0f) ? d2 : unknown;
+
+		result[i] = d2 + padding;
+	}
+}
+
 /**
 * Get the average tunnel diameter over a set distance.
 ***********************************************************************************/
@@ -195,7 +417,7 @@ float FRouteFollower::GetTunnelDiameterOverDistance(float distance, float overDi
 
 float UPursuitSplineComponent::GetTunnelDiameterOverDistance(float distance, float overDistance, int32 direction, bool minimum) const
 {
-	if (PursuitSplineParent->PointExtendedData.Num() < 2)
+	if (GetPackedExtendedData().Num() < 2)
 	{
 		return 0.0f;
 	}
@@ -248,7 +470,7 @@ float UPursuitSplineComponent::GetTunnelDiameterOverDistance(float distance, flo
 
 float UPursuitSplineComponent::GetTunnelDiameterAtDistanceAlongSpline(float distance) const
 {
-	if (PursuitSplineParent->PointExtendedData.Num() < 2)
+	if (GetPackedExtendedData().Num() < 2)
 	{
 		return 0.0f;
 	}
@@ -259,8 +481,9 @@ float UPursuitSplineComponent::GetTunnelDiameterAtDistanceAlongSpline(float dist
 
 	GetExtendedPointKeys(distance, thisKey, nextKey, ratio);
 
-	float v0 = PursuitSplineParent->PointExtendedData[thisKey].MaxTunnelDiameter;
-	float v1 = PursuitSplineParent->PointExtendedData[nextKey].MaxTunnelDiameter;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
+	float v0 = packedData.MaxTunnelDiameters[thisKey];
+	float v1 = packedData.MaxTunnelDiameters[nextKey];
 
 	const float notATunnel = 100.0f * 100.0f;
 
@@ -328,6 +551,30 @@ void UPursuitSplineComponent::Build(bool fromMenu, bool performChecks, bool bare
 
 void UPursuitSplineComponent::PostInitialize()
 {
+
+#if GRIP_NAVIGATION_CACHE
+	// Restore the orientations, curvature and sections from the navigation cache if
+	// it's up to date for this spline, in which case CalculateSections won't need
+	// to do anything.
+
+	NavigationCached = FNavigationCache::Get().Restore(this);
+#endif // GRIP_NAVIGATION_CACHE
+
+	// Pack the extended point data first, as that's what the sections are calculated
+	// from in Build.
+
+	if (NavigationCached == false)
+	{
+		TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
+
+		for (FPursuitPointExtendedData& point : pursuitPointExtendedData)
+		{
+			point.Quaternion = GetQuaternionAtDistanceAlongSpline(point.Distance, ESplineCoordinateSpace::World);
+		}
+
+		PursuitSplineParent->PackedExtendedData.Pack(pursuitPointExtendedData);
+	}
+
 	Build(false, false, true, nullptr);
 
 	Super::PostInitialize();
@@ -336,12 +583,7 @@ void UPursuitSplineComponent::PostInitialize()
 
 	ensureMsgf(numPoints > 1, TEXT("Not enough points on a pursuit spline"));
 
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
-
-	for (FPursuitPointExtendedData& point : pursuitPointExtendedData)
-	{
-		point.Quaternion = GetQuaternionAtDistanceAlongSpline(point.Distance, ESplineCoordinateSpace::World);
-	}
+	BuildOptimumSpeedTable();
 }
 
 /**
@@ -350,7 +592,7 @@ void UPursuitSplineComponent::PostInitialize()
 
 float UPursuitSplineComponent::GetMasterDistanceAtDistanceAlongSpline(float distance, float masterSplineLength) const
 {
-	if (PursuitSplineParent->PointExtendedData.Num() < 2)
+	if (GetPackedExtendedData().Num() < 2)
 	{
 		return 0.0f;
 	}
@@ -361,8 +603,9 @@ float UPursuitSplineComponent::GetMasterDistanceAtDistanceAlongSpline(float dist
 
 	GetExtendedPointKeys(distance, thisKey, nextKey, ratio);
 
-	float v0 = PursuitSplineParent->PointExtendedData[thisKey].MasterSplineDistance;
-	float v1 = PursuitSplineParent->PointExtendedData[nextKey].MasterSplineDistance;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
+	float v0 = packedData.MasterSplineDistances[thisKey];
+	float v1 = packedData.MasterSplineDistances[nextKey];
 
 	ensureMsgf(v0 != -1.0f && v1 != -1.0f, TEXT("Bad master spline distance"));
 
@@ -407,8 +650,8 @@ float UPursuitSplineComponent::GetMasterDistanceAtDistanceAlongSpline(float dist
 
 void UPursuitSplineComponent::GetExtendedPointKeys(float distance, int32& key0, int32& key1, float& ratio) const
 {
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
-	int32 numIndices = pursuitPointExtendedData.Num();
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
+	int32 numIndices = packedData.Num();
 
 	if (numIndices > 1)
 	{
@@ -422,24 +665,24 @@ void UPursuitSplineComponent::GetExtendedPointKeys(float distance, int32& key0,
 
 		ratio = distance / pointLength;
 
-		key0 = ThisExtendedKey(pursuitPointExtendedData, ratio);
-		key1 = NextExtendedKey(pursuitPointExtendedData, ratio);
+		key0 = ThisExtendedKey(numIndices, ratio);
+		key1 = NextExtendedKey(numIndices, ratio);
 
 		int32 attempts = 2;
 
 		while (attempts-- > 0)
 		{
-			FPursuitPointExtendedData& p0 = pursuitPointExtendedData[key0];
+			float d0 = packedData.Distances[key0];
 
-			if (distance < p0.Distance)
+			if (distance < d0)
 			{
-				key0 = BindExtendedKey(pursuitPointExtendedData, key0 - 1);
-				key1 = BindExtendedKey(pursuitPointExtendedData, key1 - 1);
+				key0 = BindExtendedKey(numIndices, key0 - 1);
+				key1 = BindExtendedKey(numIndices, key1 - 1);
 			}
-			else if (distance - p0.Distance > pointLength * 1.5f)
+			else if (distance - d0 > pointLength * 1.5f)
 			{
-				key0 = BindExtendedKey(pursuitPointExtendedData, key0 + 1);
-				key1 = BindExtendedKey(pursuitPointExtendedData, key1 + 1);
+				key0 = BindExtendedKey(numIndices, key0 + 1);
+				key1 = BindExtendedKey(numIndices, key1 + 1);
 			}
 			else
 			{
@@ -447,9 +690,7 @@ void UPursuitSplineComponent::GetExtendedPointKeys(float distance, int32& key0,
 			}
 		}
 
-		FPursuitPointExtendedData& p0 = pursuitPointExtendedData[key0];
-
-		ratio = (distance - p0.Distance) / pointLength;
+		ratio = (distance - packedData.Distances[key0]) / pointLength;
 		ratio = FMath::Clamp(ratio, 0.0f, 1.0f);
 
 		ensure(key0 >= 0 && key0 < numIndices);
@@ -511,6 +752,8 @@ bool UPursuitSplineComponent::CalculateMasterSplineDistances(UPursuitSplineCompo
 
 					MasterDistanceClass = dataClass;
 
+					PursuitSplineParent->PackedExtendedData.PackMasterSplineDistances(pursuitPointExtendedData);
+
 					result = true;
 				}
 				else
@@ -813,6 +1056,8 @@ bool UPursuitSplineComponent::CalculateMasterSplineDistances(UPursuitSplineCompo
 
 						MasterDistanceClass = dataClass;
 
+						PursuitSplineParent->PackedExtendedData.PackMasterSplineDistances(pursuitPointExtendedData);
+
 						result = true;
 					}
 				}
@@ -838,6 +1083,8 @@ bool UPursuitSplineComponent::CalculateMasterSplineDistances(UPursuitSplineCompo
 
 						MasterDistanceClass = dataClass;
 
+						PursuitSplineParent->PackedExtendedData.PackMasterSplineDistances(pursuitPointExtendedData);
+
 						result = true;
 					}
 				}
@@ -960,6 +1207,13 @@ void UPursuitSplineComponent::ApplyComponentInstanceData(FPursuitSplineInstanceD
 
 void UPursuitSplineComponent::CalculateSections()
 {
+	if (NavigationCached == true)
+	{
+		// The sections were restored from the navigation cache.
+
+		return;
+	}
+
 	Super::CalculateSections();
 
 #pragma region CameraCinematics
@@ -1117,12 +1371,63 @@ TArray<FPursuitPointData>& UPursuitSplineComponent::GetPursuitPointData() const
 }
 
 /**
-* The extended point data, referenced from the parent actor.
+* The packed extended point data for querying at run-time, referenced from the
+* parent actor.
+*
+* This may be read from worker threads so it must never be modified here. It's
+* packed in PostInitialize and whenever the extended point data is written after
+* that, by APursuitSplineActor::Build, CalculateMasterSplineDistances and the
+* navigation cache. Outside of the Editor it's all that remains of the extended
+* point data once the game mode has set up the splines.
+***********************************************************************************/
+
+const FPursuitPointExtendedPacked& UPursuitSplineComponent::GetPackedExtendedData() const
+{
+	return PursuitSplineParent->PackedExtendedData;
+}
+
+/**
+* The table of optimum speeds at each point for querying at run-time, referenced
+* from the parent actor.
+*
+* This is built eagerly in PostInitialize and whenever the parent actor is built, so
+* the table is never modified here and may be read from worker threads.
+***********************************************************************************/
+
+const FRangeMinimumTable& UPursuitSplineComponent::GetOptimumSpeedTable() const
+{
+	return PursuitSplineParent->OptimumSpeedTable;
+}
+
+/**
+* Build the table of optimum speeds at each point.
+*
+* Points without an optimum speed are stored as the maximum speed of 1000kph, and
+* closed loops have the first point repeated at the end to match the input key of
+* the end of the spline.
 ***********************************************************************************/
 
-TArray<FPursuitPointExtendedData>& UPursuitSplineComponent::GetPursuitPointExtendedData() const
+void UPursuitSplineComponent::BuildOptimumSpeedTable()
 {
-	return PursuitSplineParent->PointExtendedData;
+	const TArray<FPursuitPointData>& pointData = PursuitSplineParent->PointData;
+	TArray<float> speeds;
+
+	speeds.Reserve(pointData.Num() + 1);
+
+	for (const FPursuitPointData& point : pointData)
+	{
+		float speed = FMath::Min(point.OptimumSpeed, 1000.0f);
+
+		speeds.Emplace((speed == 0.0f) ? 1000.0f : speed);
+	}
+
+	if (IsClosedLoop() == true &&
+		speeds.Num() > 0)
+	{
+		speeds.Emplace(speeds[0]);
+	}
+
+	PursuitSplineParent->OptimumSpeedTable.Build(speeds);
 }
 
 #pragma region AINavigation
@@ -1175,12 +1480,10 @@ bool FRouteFollower::CheckBranchConnection(UWorld* world, const FVector& positio
 		(position - SwitchLocation).Size() > atDistance)
 	{
 		float accuracy = 1.0f;
-		int32 numIterations = 5;
-
 		float t0 = LastDistance - atDistance;
 		float t1 = LastDistance + atDistance;
 
-		float d = LastSpline->GetNearestDistance(position, t0, t1, numIterations, LastSpline->GetNumSamplesForRange(t1 - t0, numIterations, accuracy));
+		float d = LastSpline->FindNearestDistance(position, t0, t1, accuracy);
 		FVector pl = LastSpline->GetWorldLocationAtDistanceAlongSpline(d);
 		FVector pt = ThisSpline->GetWorldLocationAtDistanceAlongSpline(ThisDistance);
 
@@ -1214,7 +1517,7 @@ bool FRouteFollower::CheckBranchConnection(UWorld* world, const FVector& positio
 * a regular basis to correct the drift.
 ***********************************************************************************/
 
-void FRouteFollower::EstimateThis(const FVector& position, const FVector& movement, float movementSize, int32 numIterations, float accuracy)
+void FRouteFollower::EstimateThis(const FVector& position, const FVector& movement, float movementSize, float accuracy)
 {
 	if (GRIP_POINTER_VALID(ThisSpline) == true)
 	{
@@ -1227,7 +1530,7 @@ void FRouteFollower::EstimateThis(const FVector& position, const FVector& moveme
 
 		ThisDistance = ThisSpline->ClampDistance(ThisDistance + splineMovement);
 
-		SwitchSplineAtJunction(position, movementSize, numIterations, accuracy);
+		SwitchSplineAtJunction(position, movementSize, accuracy);
 	}
 }
 
@@ -1235,19 +1538,19 @@ void FRouteFollower::EstimateThis(const FVector& position, const FVector& moveme
 * Determine where we are along the current spline.
 ***********************************************************************************/
 
-void FRouteFollower::DetermineThis(const FVector& position, float movementSize, int32 numIterations, float accuracy)
+void FRouteFollower::DetermineThis(const FVector& position, float movementSize, float accuracy)
 {
 	if (GRIP_POINTER_VALID(ThisSpline) == true)
 	{
-		// Do some intelligent nearest point detection that optimizes the number of
-		// samples taken to achieve that.
+		// Search around where we last were along the spline, within a range of how far
+		// we've moved since.
 
 		float t0 = ThisDistance - (movementSize * GRIP_SPLINE_MOVEMENT_MULTIPLIER);
 		float t1 = ThisDistance + (movementSize * GRIP_SPLINE_MOVEMENT_MULTIPLIER);
 
-		ThisDistance = ThisSpline->GetNearestDistance(position, t0, t1, numIterations, ThisSpline->GetNumSamplesForRange(t1 - t0, numIterations, accuracy));
+		ThisDistance = ThisSpline->FindNearestDistance(position, t0, t1, accuracy);
 
-		SwitchSplineAtJunction(position, movementSize, numIterations, accuracy);
+		SwitchSplineAtJunction(position, movementSize, accuracy);
 	}
 }
 
@@ -1539,7 +1842,7 @@ bool FRouteFollower::ChooseNextSpline(TWeakObjectPtr<UPursuitSplineComponent>& p
 				// designed to do.
 
 				float amount = 0.0f;
-				float probability = FMath::FRand() * totalProbability;
+				float probability = APlayGameMode::SimulationRandom.FRand() * totalProbability;
 
 				for (FSplineLink& link : connectedSplines)
 				{
@@ -1577,7 +1880,7 @@ bool FRouteFollower::ChooseNextSpline(TWeakObjectPtr<UPursuitSplineComponent>& p
 * Switch to a new spline if we've passed the switch distance for it.
 ***********************************************************************************/
 
-void FRouteFollower::SwitchSplineAtJunction(const FVector& position, float movementSize, int32 numIterations, float accuracy)
+void FRouteFollower::SwitchSplineAtJunction(const FVector& position, float movementSize, float accuracy)
 {
 	// So now we know where we are, determine if a new pursuit spline is necessary.
 	// We will have identified this already because we aim ahead of where the car
@@ -1604,7 +1907,7 @@ void FRouteFollower::SwitchSplineAtJunction(const FVector& position, float movem
 					float t1 = link.NextDistance + (movementSize * GRIP_SPLINE_MOVEMENT_MULTIPLIER);
 
 					ThisSpline = NextSpline;
-					ThisDistance = ThisSpline->GetNearestDistance(position, t0, t1, numIterations, ThisSpline->GetNumSamplesForRange(t1 - t0, numIterations, accuracy));
+					ThisDistance = ThisSpline->FindNearestDistance(position, t0, t1, accuracy);
 					DecidedDistance = -1.0f;
 
 					break;
@@ -1675,7 +1978,7 @@ bool UPursuitSplineComponent::GetCarefulDrivingAtDistanceAlongSpline(float dista
 		return true;
 	}
 
-	if (PursuitSplineParent->PointExtendedData.Num() < 2)
+	if (GetPackedExtendedData().Num() < 2)
 	{
 		return false;
 	}
@@ -1686,13 +1989,9 @@ bool UPursuitSplineComponent::GetCarefulDrivingAtDistanceAlongSpline(float dista
 
 	GetExtendedPointKeys(distance, thisKey, nextKey, ratio);
 
-	FPursuitPointExtendedData& p0 = PursuitSplineParent->PointExtendedData[thisKey];
-	FPursuitPointExtendedData& p1 = PursuitSplineParent->PointExtendedData[nextKey];
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	bool v0 = p0.OpenLeft || p0.OpenRight;
-	bool v1 = p1.OpenLeft || p1.OpenRight;
-
-	return v0 || v1;
+	return packedData.OpenEdges[thisKey] || packedData.OpenEdges[nextKey];
 }
 
 /**
@@ -1850,9 +2149,9 @@ float UPursuitSplineComponent::GetClearance(float distance, FVector location, FV
 
 	clearanceAngle = FMath::Min(clearanceAngle, 180.0f);
 
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	if (pursuitPointExtendedData.Num() < 2)
+	if (packedData.Num() < 2)
 	{
 		return 0.0f;
 	}
@@ -1895,46 +2194,24 @@ float UPursuitSplineComponent::GetClearance(float distance, FVector location, FV
 
 	GetExtendedPointKeys(distance, thisKey, nextKey, ratio);
 
-	FPursuitPointExtendedData& p0 = pursuitPointExtendedData[thisKey];
-	FPursuitPointExtendedData& p1 = pursuitPointExtendedData[nextKey];
+	MS_ALIGN(16) float distances[FPursuitPointExtendedData::NumDistances] GCC_ALIGN(16);
 
-	float distances[FPursuitPointExtendedData::NumDistances];
+	InterpolateEnvironmentDistances(packedData.GetEnvironmentDistances(thisKey), packedData.GetEnvironmentDistances(nextKey), ratio, UnlimitedSplineDistance, padding, distances);
 
 	static bool sinCosComputed = false;
-	static float angles[FPursuitPointExtendedData::NumDistances];
 	static FVector2D sinCos[FPursuitPointExtendedData::NumDistances];
 
-	for (int32 i = 0; i < FPursuitPointExtendedData::NumDistances; i++)
+	if (sinCosComputed == false)
 	{
-		float d0 = p0.EnvironmentDistances[i];
-		float d1 = p1.EnvironmentDistances[i];
-		float d2 = UnlimitedSplineDistance;
-
-		if (d0 >= 0.0f &&
-			d1 >= 0.0f)
+		for (int32 i = 0; i < FPursuitPointExtendedData::NumDistances; i++)
 		{
-			d2 = FMath::Lerp(d0, d1, ratio);
-		}
-		else if (d0 >= 0.0f)
-		{
-			d2 = d0;
-		}
-		else if (d1 >= 0.0f)
-		{
-			d2 = d1;
-		}
-
-		distances[i] = d2 + padding;
-
-		if (sinCosComputed == false)
-		{
-			angles[i] = ((float)i / (float)FPursuitPointExtendedData::NumDistances) * PI * 2.0f;
+			float angle = ((float)i / (float)FPursuitPointExtendedData::NumDistances) * PI * 2.0f;
 
-			FMath::SinCos(&sinCos[i].X, &sinCos[i].Y, angles[i]);
+			FMath::SinCos(&sinCos[i].X, &sinCos[i].Y, angle);
 		}
-	}
 
-	sinCosComputed = true;
+		sinCosComputed = true;
+	}
 
 	// Do a line segment intersection test with a line from the location to somewhere known for sure
 	// to be outside of the spline area, against all the lines that form the edges of the spline area.
@@ -2006,7 +2283,7 @@ TArray<float> UPursuitSplineComponent::GetClearances(float distance) const
 {
 	TArray<float> result;
 
-	if (PursuitSplineParent->PointExtendedData.Num() < 2)
+	if (GetPackedExtendedData().Num() < 2)
 	{
 		return result;
 	}
@@ -2017,31 +2294,11 @@ TArray<float> UPursuitSplineComponent::GetClearances(float distance) const
 
 	GetExtendedPointKeys(distance, thisKey, nextKey, ratio);
 
-	FPursuitPointExtendedData& p0 = PursuitSplineParent->PointExtendedData[thisKey];
-	FPursuitPointExtendedData& p1 = PursuitSplineParent->PointExtendedData[nextKey];
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	for (int32 i = 0; i < FPursuitPointExtendedData::NumDistances; i++)
-	{
-		int32 index = i;
-		float d0 = p0.EnvironmentDistances[index];
-		float d1 = p1.EnvironmentDistances[index];
-		float d2 = -1.0f;
+	result.SetNumUninitialized(FPursuitPointExtendedData::NumDistances);
 
-		if (d0 >= 0.0f && d1 >= 0.0f)
-		{
-			d2 = FMath::Lerp(d0, d1, ratio);
-		}
-		else if (d0 >= 0.0f)
-		{
-			d2 = d0;
-		}
-		else if (d1 >= 0.0f)
-		{
-			d2 = d1;
-		}
-
-		result.Emplace(d2);
-	}
+	InterpolateEnvironmentDistances(packedData.GetEnvironmentDistances(thisKey), packedData.GetEnvironmentDistances(nextKey), ratio, -1.0f, 0.0f, result.GetData());
 
 	return result;
 }
@@ -2075,7 +2332,6 @@ float FRouteFollower::GetMinimumOptimumSpeedOverDistance(float distance, float&
 
 float UPursuitSplineComponent::GetMinimumOptimumSpeedOverDistance(float distance, float& overDistance, int32 direction) const
 {
-	float minimumSpeed = 1000.0f;
 	float length = GetSplineLength();
 	float endDistance = distance + (overDistance * direction);
 
@@ -2083,25 +2339,74 @@ float UPursuitSplineComponent::GetMinimumOptimumSpeedOverDistance(float distance
 	{
 		endDistance = ClampDistanceAgainstLength(endDistance, length);
 		overDistance -= FMath::Abs(endDistance - distance);
+		distance = ClampDistanceAgainstLength(distance, length);
+
+		return GetMinimumOptimumSpeedBetweenDistances(FMath::Min(distance, endDistance), FMath::Max(distance, endDistance));
 	}
 	else
 	{
 		overDistance = 0.0f;
+
+		float span = FMath::Abs(endDistance - distance);
+
+		distance = ClampDistanceAgainstLength(distance, length);
+
+		if (span >= length)
+		{
+			// The whole of the loop is covered.
+
+			return GetMinimumOptimumSpeedBetweenDistances(0.0f, length);
+		}
+
+		float startDistance = (direction >= 0) ? distance : distance - span;
+
+		endDistance = startDistance + span;
+
+		if (startDistance < 0.0f)
+		{
+			// Wrapped around the start of the loop.
+
+			return FMath::Min(GetMinimumOptimumSpeedBetweenDistances(startDistance + length, length), GetMinimumOptimumSpeedBetweenDistances(0.0f, endDistance));
+		}
+		else if (endDistance > length)
+		{
+			// Wrapped around the end of the loop.
+
+			return FMath::Min(GetMinimumOptimumSpeedBetweenDistances(startDistance, length), GetMinimumOptimumSpeedBetweenDistances(0.0f, endDistance - length));
+		}
+		else
+		{
+			return GetMinimumOptimumSpeedBetweenDistances(startDistance, endDistance);
+		}
 	}
+}
 
-	float iterationDistance = FMathEx::MetersToCentimeters(ExtendedPointMeters);
-	int32 numIterations = FMath::CeilToInt(FMath::Abs(endDistance - distance) / iterationDistance);
+/**
+* Get the minimum optimum speed of the spline in kph between two distances, where
+* the start is before the end.
+*
+* The optimum speed is interpolated linearly between the points of the spline, so
+* the minimum over a range is either at one of its ends or at one of the points
+* within it, the minimum of which comes from the range minimum table. Points
+* without an optimum speed are treated as the maximum speed of 1000kph.
+***********************************************************************************/
 
-	for (int32 i = 0; i <= numIterations; i++)
+float UPursuitSplineComponent::GetMinimumOptimumSpeedBetweenDistances(float startDistance, float endDistance) const
+{
+	float s0 = GetOptimumSpeedAtDistanceAlongSpline(startDistance);
+	float s1 = GetOptimumSpeedAtDistanceAlongSpline(endDistance);
+	float minimumSpeed = FMath::Min((s0 > 0.0f) ? s0 : 1000.0f, (s1 > 0.0f) ? s1 : 1000.0f);
+	const FRangeMinimumTable& speeds = GetOptimumSpeedTable();
+
+	if (speeds.Num() > 0)
 	{
-		float optimumSpeed = GetOptimumSpeedAtDistanceAlongSpline(distance);
+		int32 firstKey = FMath::Max(FMath::FloorToInt(SplineCurves.ReparamTable.Eval(startDistance, 0.0f)) + 1, 0);
+		int32 lastKey = FMath::Min(FMath::CeilToInt(SplineCurves.ReparamTable.Eval(endDistance, 0.0f)) - 1, speeds.Num() - 1);
 
-		if (optimumSpeed > 0.0f)
+		if (firstKey <= lastKey)
 		{
-			minimumSpeed = FMath::Min(minimumSpeed, optimumSpeed);
+			minimumSpeed = FMath::Min(minimumSpeed, speeds.GetMinimum(firstKey, lastKey));
 		}
-
-		distance = ClampDistanceAgainstLength(distance + (iterationDistance * direction), length);
 	}
 
 	return minimumSpeed;
@@ -2239,7 +2544,7 @@ FVector UPursuitSplineComponent::GetWorldClosestPosition(float distance, bool ra
 
 FVector UPursuitSplineComponent::GetWorldClosestOffset(float distance, bool raw) const
 {
-	if (PursuitSplineParent->PointExtendedData.Num() < 2)
+	if (GetPackedExtendedData().Num() < 2)
 	{
 		return FVector::ZeroVector;
 	}
@@ -2250,11 +2555,11 @@ FVector UPursuitSplineComponent::GetWorldClosestOffset(float distance, bool raw)
 
 	GetExtendedPointKeys(distance, thisKey, nextKey, ratio);
 
-	FPursuitPointExtendedData& p0 = PursuitSplineParent->PointExtendedData[thisKey];
-	FPursuitPointExtendedData& p1 = PursuitSplineParent->PointExtendedData[nextKey];
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
+	const TArray<FVector>& groundOffsets = (raw == true) ? packedData.RawGroundOffsets : packedData.UseGroundOffsets;
 
-	FVector d0 = (raw == true) ? p0.RawGroundOffset : p0.UseGroundOffset;
-	FVector d1 = (raw == true) ? p1.RawGroundOffset : p1.UseGroundOffset;
+	FVector d0 = groundOffsets[thisKey];
+	FVector d1 = groundOffsets[nextKey];
 
 	FVector d2 = FVector::ZeroVector;
 
@@ -2370,7 +2675,7 @@ float UPursuitSplineComponent::GetNearestDistanceToMasterDistance(float masterDi
 
 FQuat UPursuitSplineComponent::GetWorldSpaceQuaternionAtDistanceAlongSpline(float distance) const
 {
-	if (PursuitSplineParent->PointExtendedData.Num() < 2)
+	if (GetPackedExtendedData().Num() < 2)
 	{
 		return FQuat::Identity;
 	}
@@ -2381,9 +2686,9 @@ FQuat UPursuitSplineComponent::GetWorldSpaceQuaternionAtDistanceAlongSpline(floa
 
 	GetExtendedPointKeys(distance, key0, key1, ratio);
 
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	return FQuat::Slerp(pursuitPointExtendedData[key0].Quaternion, pursuitPointExtendedData[key1].Quaternion, ratio);
+	return FQuat::Slerp(packedData.Quaternions[key0], packedData.Quaternions[key1], ratio);
 }
 
 /**
@@ -2392,7 +2697,7 @@ FQuat UPursuitSplineComponent::GetWorldSpaceQuaternionAtDistanceAlongSpline(floa
 
 FVector UPursuitSplineComponent::GetWorldSpaceUpVectorAtDistanceAlongSpline(float distance) const
 {
-	if (PursuitSplineParent->PointExtendedData.Num() < 2)
+	if (GetPackedExtendedData().Num() < 2)
 	{
 		return FVector::UpVector;
 	}
@@ -2403,9 +2708,9 @@ FVector UPursuitSplineComponent::GetWorldSpaceUpVectorAtDistanceAlongSpline(floa
 
 	GetExtendedPointKeys(distance, key0, key1, ratio);
 
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	FQuat quaternion = FQuat::Slerp(pursuitPointExtendedData[key0].Quaternion, pursuitPointExtendedData[key1].Quaternion, ratio);
+	FQuat quaternion = FQuat::Slerp(packedData.Quaternions[key0], packedData.Quaternions[key1], ratio);
 
 	return quaternion.GetAxisZ();
 }
@@ -2443,9 +2748,9 @@ FRotator FRouteFollower::GetCurvatureOverDistance(float distance, float& overDis
 
 FRotator UPursuitSplineComponent::GetCurvatureOverDistance(float distance, float& overDistance, int32 direction, const FQuat& withRespectTo, bool absolute) const
 {
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	if (pursuitPointExtendedData.Num() < 2)
+	if (packedData.Num() < 2)
 	{
 		return FRotator::ZeroRotator;
 	}
@@ -2470,11 +2775,20 @@ FRotator UPursuitSplineComponent::GetCurvatureOverDistance(float distance, float
 	float iterationDistance = FMathEx::MetersToCentimeters(ExtendedPointMeters);
 	FQuat invWithRespectTo = withRespectTo.Inverse();
 	int32 numIterations = FMath::CeilToInt(FMath::Abs(endDistance - distance) / iterationDistance);
-	int32 numPoints = pursuitPointExtendedData.Num();
+	int32 numPoints = packedData.Num();
 
 	GetExtendedPointKeys(distance, key0, key1, ratio);
 
-	FRotator lastRotation = (invWithRespectTo * pursuitPointExtendedData[key0].Quaternion).Rotator();
+	if (transform == false)
+	{
+		// Without a rotation to respect, the curvature comes straight from the sums
+		// baked into the packed data. With one, the degrees differences in that space
+		// can't be summed in advance, so we have to step along the points.
+
+		return packedData.GetCurvatureOverPoints(key0, numIterations, IsClosedLoop(), absolute);
+	}
+
+	FRotator lastRotation = (invWithRespectTo * packedData.Quaternions[key0]).Rotator();
 
 	for (int32 i = 0; i < numIterations; i++)
 	{
@@ -2487,7 +2801,7 @@ FRotator UPursuitSplineComponent::GetCurvatureOverDistance(float distance, float
 
 		// Get the rotation at this sample point, with respect to another rotation if given.
 
-		FQuat quaternion = pursuitPointExtendedData[key0].Quaternion;
+		FQuat quaternion = packedData.Quaternions[key0];
 		FRotator rotation = (transform == true) ? (invWithRespectTo * quaternion).Rotator() : quaternion.Rotator();
 
 		// Now calculate and sum the angular differences between this sample and the last.
@@ -2659,7 +2973,9 @@ bool UPursuitSplineComponent::RewindToSafeGround(float& distance, float& initial
 {
 	initialSpeed = 100.0f;
 
-	if (PursuitSplineParent->PointExtendedData.Num() < 2)
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
+
+	if (packedData.Num() < 2)
 	{
 		return true;
 	}
@@ -2667,7 +2983,6 @@ bool UPursuitSplineComponent::RewindToSafeGround(float& distance, float& initial
 	int32 thisKey = 0;
 	int32 nextKey = 0;
 	float ratio = 0.0f;
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
 
 	UE_LOG(GripTeleportationLog, Log, TEXT("Looking for level ground from %d on spline %s"), (int32)distance, *ActorName);
 
@@ -2679,10 +2994,10 @@ bool UPursuitSplineComponent::RewindToSafeGround(float& distance, float& initial
 
 	do
 	{
-		FPursuitPointExtendedData& p0 = pursuitPointExtendedData[thisKey];
+		float thisDistance = packedData.Distances[thisKey];
 		float minCurvatureLength = 250.0f;
 		float curvatureLength = minCurvatureLength * 100.0f;
-		FRotator curvature = GetCurvatureOverDistance(p0.Distance, curvatureLength, 1, FQuat::Identity, false);
+		FRotator curvature = GetCurvatureOverDistance(thisDistance, curvatureLength, 1, FQuat::Identity, false);
 
 		if (curvature.Pitch < 25.0f)
 		{
@@ -2690,13 +3005,13 @@ bool UPursuitSplineComponent::RewindToSafeGround(float& distance, float& initial
 
 			float continuousLength = minCurvatureLength * 100.0f;
 
-			if (GetContinuousSurfaceOverDistance(p0.Distance, continuousLength, 1) == true)
+			if (GetContinuousSurfaceOverDistance(thisDistance, continuousLength, 1) == true)
 			{
 				// And it doesn't swap driving surfaces.
 
-				UE_LOG(GripTeleportationLog, Log, TEXT("Found good ground at %d"), (int32)p0.Distance);
+				UE_LOG(GripTeleportationLog, Log, TEXT("Found good ground at %d"), (int32)thisDistance);
 
-				distance = p0.Distance;
+				distance = thisDistance;
 
 				// Add in an adjustment to the speed to take into account upward curvature.
 
@@ -2758,7 +3073,7 @@ bool UPursuitSplineComponent::RewindToSafeGround(float& distance, float& initial
 				break;
 			}
 
-			thisKey += pursuitPointExtendedData.Num();
+			thisKey += packedData.Num();
 		}
 	}
 	while (thisKey != nextKey);
@@ -2776,9 +3091,9 @@ bool UPursuitSplineComponent::GetContinuousSurfaceOverDistance(float distance, f
 {
 	bool continuous = true;
 
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	if (pursuitPointExtendedData.Num() < 2)
+	if (packedData.Num() < 2)
 	{
 		return continuous;
 	}
@@ -2806,18 +3121,16 @@ bool UPursuitSplineComponent::GetContinuousSurfaceOverDistance(float distance, f
 	GetExtendedPointKeys(endDistance, thisKey, nextKey, ratio);
 
 	int32 key1 = (direction < 0) ? thisKey : nextKey;
-	int32 numKeys = pursuitPointExtendedData.Num();
+	int32 numKeys = packedData.Num();
 
 	for (int32 i = key0; i != key1;)
 	{
-		FPursuitPointExtendedData& p0 = pursuitPointExtendedData[i];
-		FPursuitPointExtendedData& p1 = pursuitPointExtendedData[FMath::Clamp(i + direction, 0, numKeys - 1)];
-
-		float degrees = FPursuitPointExtendedData::DifferenceInDegrees(p0.UseGroundIndex, p1.UseGroundIndex);
+		float degrees = FPursuitPointExtendedData::DifferenceInDegrees(packedData.UseGroundIndices[i], packedData.UseGroundIndices[FMath::Clamp(i + direction, 0, numKeys - 1)]);
+		float groundDistance = packedData.GetGroundDistance(i);
 
 		if (degrees > 45.0f ||
-			p0.EnvironmentDistances[p0.UseGroundIndex] < 0.0f ||
-			p0.EnvironmentDistances[p0.UseGroundIndex] > 25.0f * 100.0f)
+			groundDistance < 0.0f ||
+			groundDistance > 25.0f * 100.0f)
 		{
 			// If the change in degrees is too rapid or the nearest surface is more than 25 meters away,
 			// then this isn't a continuous surface.
@@ -2882,9 +3195,7 @@ float FRouteFollower::GetClearanceOverDistance(float distance, float& overDistan
 
 float UPursuitSplineComponent::GetClearanceOverDistance(float distance, float& overDistance, int32 direction, FVector worldLocation, FVector splineOffset, float clearanceAngle) const
 {
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
-
-	if (pursuitPointExtendedData.Num() < 2)
+	if (GetPackedExtendedData().Num() < 2)
 	{
 		return 0.0f;
 	}
@@ -2938,8 +3249,8 @@ TArray<FSplineSection> UPursuitSplineComponent::GetSurfaceSections() const
 
 	bool broken = false;
 	bool nowBroken = false;
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
-	int32 numKeys = pursuitPointExtendedData.Num();
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
+	int32 numKeys = packedData.Num();
 
 	TArray<FSplineSection> sections;
 
@@ -2949,28 +3260,29 @@ TArray<FSplineSection> UPursuitSplineComponent::GetSurfaceSections() const
 
 	for (i = 0; i < numKeys; i++)
 	{
-		FPursuitPointExtendedData& p0 = pursuitPointExtendedData[i];
+		float groundDistance = packedData.GetGroundDistance(i);
+		const FVector& useGroundOffset = packedData.UseGroundOffsets[i];
 
 		// If ground is 25m or more away, or there's a 5m or more difference
 		// in the course of one 10m length, then consider the surface broken.
 
 		nowBroken = false;
 
-		if (p0.EnvironmentDistances[p0.UseGroundIndex] < 0.0f ||
-			p0.EnvironmentDistances[p0.UseGroundIndex] > 25.0f * 100.0f)
+		if (groundDistance < 0.0f ||
+			groundDistance > 25.0f * 100.0f)
 		{
 			nowBroken = true;
 		}
 		else if (i != 0)
 		{
-			if (FVector::DotProduct(groundOffset, p0.UseGroundOffset) < 0.0f ||
-				(groundOffset - p0.UseGroundOffset).Size() > 5.0f * 100.0f)
+			if (FVector::DotProduct(groundOffset, useGroundOffset) < 0.0f ||
+				(groundOffset - useGroundOffset).Size() > 5.0f * 100.0f)
 			{
 				nowBroken = true;
 			}
 		}
 
-		groundOffset = p0.UseGroundOffset;
+		groundOffset = useGroundOffset;
 
 		if (nowBroken == false)
 		{
@@ -2985,7 +3297,7 @@ TArray<FSplineSection> UPursuitSplineComponent::GetSurfaceSections() const
 			{
 				if (i - 1 > firstKey)
 				{
-					sections.Emplace(FSplineSection(pursuitPointExtendedData[firstKey].Distance, pursuitPointExtendedData[i - 1].Distance));
+					sections.Emplace(FSplineSection(packedData.Distances[firstKey], packedData.Distances[i - 1]));
 				}
 			}
 		}
@@ -2999,7 +3311,7 @@ TArray<FSplineSection> UPursuitSplineComponent::GetSurfaceSections() const
 
 		if (firstKey < i)
 		{
-			sections.Emplace(FSplineSection(pursuitPointExtendedData[firstKey].Distance, pursuitPointExtendedData[i].Distance));
+			sections.Emplace(FSplineSection(packedData.Distances[firstKey], packedData.Distances[i]));
 		}
 	}
 
@@ -3014,9 +3326,9 @@ bool UPursuitSplineComponent::GetSurfaceBreakOverDistance(float distance, float&
 {
 	bool broken = false;
 
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	if (pursuitPointExtendedData.Num() < 2)
+	if (packedData.Num() < 2)
 	{
 		return broken;
 	}
@@ -3049,15 +3361,16 @@ bool UPursuitSplineComponent::GetSurfaceBreakOverDistance(float distance, float&
 	GetExtendedPointKeys(endDistance, thisKey, nextKey, ratio);
 
 	int32 key1 = (direction < 0) ? thisKey : nextKey;
-	int32 numKeys = pursuitPointExtendedData.Num();
+	int32 numKeys = packedData.Num();
 	FVector groundOffset = FVector::ZeroVector;
 
 	for (int32 i = key0; i != key1;)
 	{
-		FPursuitPointExtendedData& p0 = pursuitPointExtendedData[i];
+		float groundDistance = packedData.GetGroundDistance(i);
+		const FVector& useGroundOffset = packedData.UseGroundOffsets[i];
 
-		if (p0.EnvironmentDistances[p0.UseGroundIndex] < 0.0f ||
-			p0.EnvironmentDistances[p0.UseGroundIndex] > 25.0f * 100.0f)
+		if (groundDistance < 0.0f ||
+			groundDistance > 25.0f * 100.0f)
 		{
 			broken = true;
 			break;
@@ -3065,15 +3378,15 @@ bool UPursuitSplineComponent::GetSurfaceBreakOverDistance(float distance, float&
 
 		if (i != key0)
 		{
-			if (FVector::DotProduct(groundOffset, p0.UseGroundOffset) < 0.0f ||
-				(groundOffset - p0.UseGroundOffset).Size() > 5.0f * 100.0f)
+			if (FVector::DotProduct(groundOffset, useGroundOffset) < 0.0f ||
+				(groundOffset - useGroundOffset).Size() > 5.0f * 100.0f)
 			{
 				broken = true;
 				break;
 			}
 		}
 
-		groundOffset = p0.UseGroundOffset;
+		groundOffset = useGroundOffset;
 
 		if (direction < 0)
 		{
@@ -3103,9 +3416,9 @@ bool UPursuitSplineComponent::GetGroundedOverDistance(float distance, float& ove
 {
 	bool grounded = true;
 
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	if (pursuitPointExtendedData.Num() < 2)
+	if (packedData.Num() < 2)
 	{
 		return grounded;
 	}
@@ -3133,14 +3446,14 @@ bool UPursuitSplineComponent::GetGroundedOverDistance(float distance, float& ove
 	GetExtendedPointKeys(endDistance, thisKey, nextKey, ratio);
 
 	int32 key1 = (direction < 0) ? thisKey : nextKey;
-	int32 numKeys = pursuitPointExtendedData.Num();
+	int32 numKeys = packedData.Num();
 
 	for (int32 i = key0; i != key1;)
 	{
-		FPursuitPointExtendedData& p0 = pursuitPointExtendedData[i];
+		float groundDistance = packedData.GetEnvironmentDistances(i)[FPursuitPointExtendedData::NumDistances >> 1];
 
-		if (p0.EnvironmentDistances[FPursuitPointExtendedData::NumDistances >> 1] < 0.0f ||
-			p0.EnvironmentDistances[FPursuitPointExtendedData::NumDistances >> 1] > 100.0f * 100.0f)
+		if (groundDistance < 0.0f ||
+			groundDistance > 100.0f * 100.0f)
 		{
 			grounded = false;
 			break;
@@ -3173,20 +3486,20 @@ TArray<float> UPursuitSplineComponent::GetClearancesFromSurface() const
 {
 	TArray<float> clearances;
 
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
-	int32 numKeys = pursuitPointExtendedData.Num();
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
+	int32 numKeys = packedData.Num();
 
 	for (int32 i = 0; i < numKeys; i++)
 	{
-		FPursuitPointExtendedData& p0 = pursuitPointExtendedData[i];
+		const float* distances = packedData.GetEnvironmentDistances(i);
 		float clearance = 0.0f;
-		int32 center = p0.UseGroundIndex;
-		float d0 = p0.EnvironmentDistances[center];
+		int32 center = packedData.UseGroundIndices[i];
+		float d0 = distances[center];
 
 		clearance += (d0 > 0.0f) ? d0 : UnlimitedSplineDistance;
 
-		center = (p0.UseGroundIndex + (FPursuitPointExtendedData::NumDistances >> 1)) % FPursuitPointExtendedData::NumDistances;
-		d0 = p0.EnvironmentDistances[center];
+		center = (packedData.UseGroundIndices[i] + (FPursuitPointExtendedData::NumDistances >> 1)) % FPursuitPointExtendedData::NumDistances;
+		d0 = distances[center];
 
 		clearance += (d0 > 0.0f) ? d0 : UnlimitedSplineDistance;
 
@@ -3203,9 +3516,9 @@ TArray<float> UPursuitSplineComponent::GetClearancesFromSurface() const
 
 float UPursuitSplineComponent::GetClearance(float distance, FVector splineOffset, float clearanceAngle) const
 {
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	if (pursuitPointExtendedData.Num() < 2)
+	if (packedData.Num() < 2)
 	{
 		return 0.0f;
 	}
@@ -3216,8 +3529,9 @@ float UPursuitSplineComponent::GetClearance(float distance, FVector splineOffset
 
 	GetExtendedPointKeys(distance, thisKey, nextKey, ratio);
 
-	FPursuitPointExtendedData& p0 = pursuitPointExtendedData[thisKey];
-	FPursuitPointExtendedData& p1 = pursuitPointExtendedData[nextKey];
+	MS_ALIGN(16) float distances[FPursuitPointExtendedData::NumDistances] GCC_ALIGN(16);
+
+	InterpolateEnvironmentDistances(packedData.GetEnvironmentDistances(thisKey), packedData.GetEnvironmentDistances(nextKey), ratio, -1.0f, 0.0f, distances);
 
 	// The angle in radians of the location we've been given compared to the spline's center.
 
@@ -3262,24 +3576,7 @@ float UPursuitSplineComponent::GetClearance(float distance, FVector splineOffset
 
 			index = (index < 0) ? FPursuitPointExtendedData::NumDistances + index : index % FPursuitPointExtendedData::NumDistances;
 
-			float d0 = p0.EnvironmentDistances[index];
-			float d1 = p1.EnvironmentDistances[index];
-			float d2 = -1.0f;
-
-			if (d0 >= 0.0f && d1 >= 0.0f)
-			{
-				d2 = FMath::Lerp(d0, d1, ratio);
-			}
-			else if (d0 >= 0.0f)
-			{
-				d2 = d0;
-			}
-			else if (d1 >= 0.0f)
-			{
-				d2 = d1;
-			}
-
-			d3[j] = d2;
+			d3[j] = distances[index];
 		}
 
 		float d = -1.0f;
@@ -3316,9 +3613,9 @@ float UPursuitSplineComponent::GetClearance(float distance, FVector splineOffset
 bool UPursuitSplineComponent::GetWeatherAllowedOverDistance(float distance, float& overDistance, int32 direction) const
 {
 	bool weatherAllowed = true;
-	TArray<FPursuitPointExtendedData>& pursuitPointExtendedData = PursuitSplineParent->PointExtendedData;
+	const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData();
 
-	if (pursuitPointExtendedData.Num() < 2)
+	if (packedData.Num() < 2)
 	{
 		return weatherAllowed;
 	}
@@ -3346,13 +3643,11 @@ bool UPursuitSplineComponent::GetWeatherAllowedOverDistance(float distance, floa
 	GetExtendedPointKeys(endDistance, thisKey, nextKey, ratio);
 
 	int32 key1 = (direction < 0) ? thisKey : nextKey;
-	int32 numKeys = pursuitPointExtendedData.Num();
+	int32 numKeys = packedData.Num();
 
 	for (int32 i = key0; i != key1;)
 	{
-		FPursuitPointExtendedData& p0 = pursuitPointExtendedData[i];
-
-		if (p0.UseWeatherAllowed < 1.0f - KINDA_SMALL_NUMBER)
+		if (packedData.UseWeatherAllowed[i] < 1.0f - KINDA_SMALL_NUMBER)
 		{
 			weatherAllowed = false;
 			break;
@@ -0,0 +1,203 @@
+/**
+*
+* Pursuit spline spatial index.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A uniform grid over the segments of all of the pursuit splines in a level, used
+* to quickly reduce the number of splines that need to be examined when looking
+* for the nearest spline to a point in space. It also caches line of sight tests
+* between small cells in world space and points along the splines.
+*
+***********************************************************************************/
+
+#include "ai/pursuitsplineindex.h"
+#include "ai/pursuitsplineactor.h"
+#include "system/mathhelpers.h"
+#include "gamemodes/basegamemode.h"
+
+/**
+* FPursuitSplineIndex statics.
+***********************************************************************************/
+
+// The size of the cells in the index grid, in centimeters.
+const float FPursuitSplineIndex::CellSize = 50.0f * 100.0f;
+
+// The largest radius to query the index with before falling back to examining every spline.
+const float FPursuitSplineIndex::MaxQueryRadius = 800.0f * 100.0f;
+
+// The size of the cells used for caching line of sight tests, in centimeters.
+const float FPursuitSplineIndex::LineOfSightCellSize = 5.0f * 100.0f;
+
+// The maximum number of line of sight tests to cache before flushing the cache.
+const int32 FPursuitSplineIndex::MaxLineOfSightTests = 16384;
+
+/**
+* Build the index from the pursuit spline actors in a level.
+***********************************************************************************/
+
+void FPursuitSplineIndex::Build(const TArray<APursuitSplineActor*>& splineActors)
+{
+	Clear();
+
+	// The number of samples taken along each segment to determine its bounds, and the
+	// margin added to those bounds to account for the curvature between samples.
+
+	const int32 numSamples = 4;
+	const float boundsMargin = 1.0f * 100.0f;
+	const float segmentLength = FMathEx::MetersToCentimeters(UAdvancedSplineComponent::ExtendedPointMeters);
+
+	for (APursuitSplineActor* splineActor : splineActors)
+	{
+		TArray<UActorComponent*> splines;
+
+		splineActor->GetComponents(UPursuitSplineComponent::StaticClass(), splines);
+
+		for (UActorComponent* component : splines)
+		{
+			UPursuitSplineComponent* spline = Cast<UPursuitSplineComponent>(component);
+
+			if (spline->GetNumberOfSplinePoints() > 1)
+			{
+				int32 splineIndex = Splines.Emplace(spline);
+				float length = spline->GetSplineLength();
+
+				// Break the spline into segments between the extended points.
+
+				for (float distance = 0.0f; distance < length; distance += segmentLength)
+				{
+					float endDistance = FMath::Min(distance + segmentLength, length);
+					FBox bounds(ForceInit);
+
+					for (int32 i = 0; i <= numSamples; i++)
+					{
+						bounds += spline->GetWorldLocationAtDistanceAlongSpline(FMath::Lerp(distance, endDistance, (float)i / (float)numSamples));
+					}
+
+					bounds = bounds.ExpandBy(boundsMargin);
+
+					int32 segmentIndex = Segments.Emplace(FSegment(bounds, splineIndex));
+
+					// Add the segment to every grid cell that its bounds overlap.
+
+					FIntPoint minCell = GetCell(bounds.Min);
+					FIntPoint maxCell = GetCell(bounds.Max);
+
+					for (int32 x = minCell.X; x <= maxCell.X; x++)
+					{
+						for (int32 y = minCell.Y; y <= maxCell.Y; y++)
+						{
+							Cells.FindOrAdd(FIntPoint(x, y)).Emplace(segmentIndex);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	UE_LOG(GripLogPursuitSplines, Log, TEXT("Pursuit spline index built with %d splines, %d segments and %d cells"), Splines.Num(), Segments.Num(), Cells.Num());
+}
+
+/**
+* Clear the index.
+***********************************************************************************/
+
+void FPursuitSplineIndex::Clear()
+{
+	Splines.Empty();
+	Segments.Empty();
+	Cells.Empty();
+	LineOfSightCache.Empty();
+}
+
+/**
+* Gather the indices of the splines that have a segment within a radius of a
+* location, that haven't already been gathered. No spline that isn't gathered will
+* be closer to the location than the radius.
+***********************************************************************************/
+
+void FPursuitSplineIndex::GatherSplinesWithinRange(const FVector& location, float radius, TArray<bool>& gathered, TArray<int32>& splines) const
+{
+	float radiusSquared = radius * radius;
+	FIntPoint minCell = GetCell(location - FVector(radius, radius, 0.0f));
+	FIntPoint maxCell = GetCell(location + FVector(radius, radius, 0.0f));
+
+	gathered.SetNumZeroed(Splines.Num());
+
+	for (int32 x = minCell.X; x <= maxCell.X; x++)
+	{
+		for (int32 y = minCell.Y; y <= maxCell.Y; y++)
+		{
+			const TArray<int32>* segments = Cells.Find(FIntPoint(x, y));
+
+			if (segments != nullptr)
+			{
+				for (int32 segmentIndex : *segments)
+				{
+					const FSegment& segment = Segments[segmentIndex];
+
+					if (gathered[segment.SplineIndex] == false &&
+						segment.Bounds.ComputeSquaredDistanceToPoint(location) <= radiusSquared)
+					{
+						gathered[segment.SplineIndex] = true;
+						splines.Emplace(segment.SplineIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+* Is a distance along a spline visible from a location, using the line of sight
+* cache where possible.
+*
+* The cache is keyed on a small cell around the location and the extended point
+* segment of the spline, so the result of the first test made from within a cell
+* is reused for all later tests to the same part of the spline. This makes the
+* result an approximation: the test reused may have been made from anywhere within
+* the same cell, up to the diagonal of LineOfSightCellSize away (8.7m), and to
+* anywhere within the same segment, up to ExtendedPointMeters away along the
+* spline (10m). The collision geometry used for line of sight tests is static, so
+* the cache only needs flushing when it grows too large.
+*
+* This may be called from worker threads, so the cache is guarded, though the
+* line trace itself is made outside of the lock.
+***********************************************************************************/
+
+bool FPursuitSplineIndex::IsSplineVisible(UWorld* world, const FVector& location, int32 splineIndex, float distanceAlong, const FVector& splineLocation)
+{
+	FIntVector cell(FMath::FloorToInt(location.X / LineOfSightCellSize), FMath::FloorToInt(location.Y / LineOfSightCellSize), FMath::FloorToInt(location.Z / LineOfSightCellSize));
+	FLineOfSightKey key(cell, splineIndex, FMath::FloorToInt(distanceAlong / FMathEx::MetersToCentimeters(UAdvancedSplineComponent::ExtendedPointMeters)));
+
+	{
+		FScopeLock lock(&LineOfSightLock);
+
+		const bool* visible = LineOfSightCache.Find(key);
+
+		if (visible != nullptr)
+		{
+			return *visible;
+		}
+	}
+
+	FHitResult hit;
+	FCollisionQueryParams queryParams(TEXT("SplineEnvironmentSensor"), false, nullptr);
+	bool result = (world->LineTraceSingleByChannel(hit, location, splineLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false);
+
+	{
+		FScopeLock lock(&LineOfSightLock);
+
+		if (LineOfSightCache.Num() >= MaxLineOfSightTests)
+		{
+			LineOfSightCache.Reset();
+		}
+
+		LineOfSightCache.Emplace(key, result);
+	}
+
+	return result;
+}
@@ -0,0 +1,117 @@
+/**
+*
+* Camera clip index.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A per-frame index of the camera clipping boxes of all of the vehicles, shared by
+* every camera that needs to be kept out of the vehicles.
+*
+***********************************************************************************/
+
+#include "camera/cameraclipindex.h"
+#include "vehicle/basevehicle.h"
+#include "algo/binarysearch.h"
+
+/**
+* Refresh the index from the vehicles if it's not already been refreshed this frame.
+*
+* The vehicles have all completed their physics by the time the cameras are
+* updated, so their transforms are the same for every camera in the frame.
+***********************************************************************************/
+
+void FCameraClipIndex::Refresh(const TArray<ABaseVehicle*>& vehicles)
+{
+	if (RefreshFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	RefreshFrame = GFrameCounter;
+	MaxSizeX = 0.0f;
+
+	Boxes.Reset(vehicles.Num());
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		FClipBox& box = Boxes.AddDefaulted_GetRef();
+
+		box.Vehicle = vehicle;
+		box.LocalBox = vehicle->CameraClipBox;
+		box.Transform = vehicle->VehicleMesh->GetComponentTransform();
+		box.WorldBounds = box.LocalBox.TransformBy(box.Transform);
+
+		MaxSizeX = FMath::Max(MaxSizeX, box.WorldBounds.Max.X - box.WorldBounds.Min.X);
+	}
+
+	Boxes.Sort([] (const FClipBox& object1, const FClipBox& object2)
+		{
+			return object1.WorldBounds.Min.X < object2.WorldBounds.Min.X;
+		});
+}
+
+/**
+* Clip a segment against the camera clipping boxes of the vehicles, moving its end
+* to the first hit along it.
+***********************************************************************************/
+
+bool FCameraClipIndex::ClipSegment(const FVector& start, FVector& end, const ABaseVehicle* ignoreVehicle) const
+{
+	bool result = false;
+	FBox segmentBounds(start.ComponentMin(end), start.ComponentMax(end));
+
+	// Find the first box that could overlap the segment along X. No box is wider
+	// than MaxSizeX so none before this one can reach the start of the segment.
+
+	float minX = segmentBounds.Min.X - MaxSizeX;
+	int32 first = Algo::LowerBoundBy(Boxes, minX, [] (const FClipBox& box)
+		{
+			return box.WorldBounds.Min.X;
+		});
+
+	for (int32 i = first; i < Boxes.Num(); i++)
+	{
+		const FClipBox& box = Boxes[i];
+
+		if (box.WorldBounds.Min.X > segmentBounds.Max.X)
+		{
+			// All of the remaining boxes are beyond the segment along X.
+
+			break;
+		}
+
+		if (box.Vehicle != ignoreVehicle &&
+			box.WorldBounds.Intersect(segmentBounds) == true)
+		{
+			float hitTime;
+			FVector hitNormal;
+			FVector hitLocation;
+			FVector localStart = box.Transform.InverseTransformPosition(start);
+			FVector localEnd = box.Transform.InverseTransformPosition(end);
+
+			if (FMath::LineExtentBoxIntersection(box.LocalBox, localStart, localEnd, FVector::ZeroVector, hitLocation, hitNormal, hitTime) == true)
+			{
+				end = box.Transform.TransformPosition(hitLocation);
+
+				result = true;
+			}
+		}
+	}
+
+	return result;
+}
+
+/**
+* Clear the index.
+***********************************************************************************/
+
+void FCameraClipIndex::Reset()
+{
+	Boxes.Reset();
+
+	MaxSizeX = 0.0f;
+	RefreshFrame = 0;
+}
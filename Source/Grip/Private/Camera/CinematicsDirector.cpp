@@ -42,6 +42,8 @@ FCinematicsDirector::FCinematicsDirector(UAdvancedCameraComponent* camera)
 
 void FCinematicsDirector::Tick(float deltaSeconds)
 {
+	GRIP_FRAME_PROFILER_SCOPE(CinematicsDirector, INDEX_NONE);
+
 	float clock = Owner->GetWorld()->GetRealTimeSeconds();
 
 	if (LastClock != 0.0f)
@@ -1491,105 +1493,93 @@ bool FCinematicsDirector::IdentifyWeaponEvent(bool highValue)
 	}
 
 	APlayGameMode* gameMode = APlayGameMode::Get(Owner);
-	TArray<FGameEvent>& events = gameMode->GameEvents;
-	float time = gameMode->GetRealTimeClock();
 
-	// Examine the last few game events.
+	UpdateRecentWeaponEvents(gameMode);
 
-	for (int32 i = gameMode->GameEvents.Num() - 1; i >= 0; i--)
-	{
-		FGameEvent& event = events[i];
-
-		if (event.Time < time - 0.25f)
-		{
-			break;
-		}
+	// Examine the last few weapon events to find one that we can watch.
 
-		// Find a weapon event that we can watch.
+	for (int32 i = RecentWeaponEvents.Num() - 1; i >= 0; i--)
+	{
+		const FGameEvent& event = gameMode->GameEvents[RecentWeaponEvents[i]];
+		UCameraPointComponent* cameraPoint = nullptr;
+		ABaseVehicle* vehicle = gameMode->GetVehicleForVehicleIndex(event.LaunchVehicleIndex);
 
-		if (event.EventType == EGameEventType::Used ||
-			event.EventType == EGameEventType::Preparing)
+		if (vehicle != nullptr &&
+			vehicle->IsVehicleDestroyed() == false &&
+			IsVehicleSmoothlyControlled(vehicle) == true)
 		{
-			UCameraPointComponent* cameraPoint = nullptr;
-			ABaseVehicle* vehicle = gameMode->GetVehicleForVehicleIndex(event.LaunchVehicleIndex);
-
-			if (vehicle != nullptr &&
-				vehicle->IsVehicleDestroyed() == false &&
-				IsVehicleSmoothlyControlled(vehicle) == true)
+			if (event.PickupUsed == EPickupType::HomingMissile)
 			{
-				if (event.PickupUsed == EPickupType::HomingMissile)
+				AHomingMissile* missile = vehicle->GetHomingMissile().Get();
+
+				if (missile != nullptr &&
+					missile->Target != nullptr &&
+					missile->Target->IsA<ABaseVehicle>() == true &&
+					missile->HasExploded() == false)
 				{
-					AHomingMissile* missile = vehicle->GetHomingMissile().Get();
+					// Follow a Scorpion missile use.
 
-					if (missile != nullptr &&
-						missile->Target != nullptr &&
-						missile->Target->IsA<ABaseVehicle>() == true &&
-						missile->HasExploded() == false)
+					if ((missile->Target->GetActorLocation() - missile->GetActorLocation()).Size() < 200.0f * 100.0f)
 					{
-						// Follow a Scorpion missile use.
-
-						if ((missile->Target->GetActorLocation() - missile->GetActorLocation()).Size() < 200.0f * 100.0f)
-						{
-							CameraTarget = missile;
+						CameraTarget = missile;
 
-							CreateStockPointCamera();
+						CreateStockPointCamera();
 
-							ABaseGameMode::SleepComponent(CurrentCameraPoint);
-							ABaseGameMode::WakeComponent(StockCameraPoint);
+						ABaseGameMode::SleepComponent(CurrentCameraPoint);
+						ABaseGameMode::WakeComponent(StockCameraPoint);
 
-							GRIP_DETACH(StockCameraPoint);
+						GRIP_DETACH(StockCameraPoint);
 
-							GRIP_ATTACH_AT(StockCameraPoint, vehicle->VehicleMesh, "RootDummy", FVector(-100.0f, 0.0f, 110.0f));
+						GRIP_ATTACH_AT(StockCameraPoint, vehicle->VehicleMesh, "RootDummy", FVector(-100.0f, 0.0f, 110.0f));
 
-							cameraPoint = StockCameraPoint;
-							cameraPoint->ResetOriginal();
-							cameraPoint->Reset();
+						cameraPoint = StockCameraPoint;
+						cameraPoint->ResetOriginal();
+						cameraPoint->Reset();
 
-							SwitchMode(ECinematicCameraMode::CameraPointVehicleToProjectile);
-						}
+						SwitchMode(ECinematicCameraMode::CameraPointVehicleToProjectile);
 					}
 				}
-				else if (highValue == false && event.PickupUsed == EPickupType::GatlingGun)
-				{
-					// Follow a Gatling gun use.
-
-					cameraPoint = FindForeFacingCameraPoint(vehicle);
+			}
+			else if (highValue == false && event.PickupUsed == EPickupType::GatlingGun)
+			{
+				// Follow a Gatling gun use.
 
-					CameraTarget.Reset();
+				cameraPoint = FindForeFacingCameraPoint(vehicle);
 
-					if (cameraPoint == nullptr)
-					{
-						continue;
-					}
+				CameraTarget.Reset();
 
-					SwitchMode(ECinematicCameraMode::CameraPointVehicleToGun);
+				if (cameraPoint == nullptr)
+				{
+					continue;
 				}
 
-				if (cameraPoint != nullptr)
-				{
-					ABaseGameMode::SleepComponent(CurrentCameraPoint);
-					LastCameraTarget.Reset();
-					CurrentVehicle = vehicle;
-					CurrentCameraPoint = cameraPoint;
-					ABaseGameMode::WakeComponent(CurrentCameraPoint);
-					CurrentCameraPoint->Reset();
-					WeaponEventConcluded = false;
+				SwitchMode(ECinematicCameraMode::CameraPointVehicleToGun);
+			}
 
-					LastRotation = CurrentCameraPoint->GetComponentTransform().TransformVector(FVector(1.0f, 0.0f, 0.0f)).ToOrientationRotator();
+			if (cameraPoint != nullptr)
+			{
+				ABaseGameMode::SleepComponent(CurrentCameraPoint);
+				LastCameraTarget.Reset();
+				CurrentVehicle = vehicle;
+				CurrentCameraPoint = cameraPoint;
+				ABaseGameMode::WakeComponent(CurrentCameraPoint);
+				CurrentCameraPoint->Reset();
+				WeaponEventConcluded = false;
 
-					ResetCameraTime();
+				LastRotation = CurrentCameraPoint->GetComponentTransform().TransformVector(FVector(1.0f, 0.0f, 0.0f)).ToOrientationRotator();
 
-					if (CinematicCameraMode == ECinematicCameraMode::CameraPointVehicleToProjectile)
-					{
-						CameraDuration = FMath::FRandRange(4.0f, 6.0f);
-					}
-					else
-					{
-						CameraDuration = FMath::FRandRange(3.0f, 5.0f);
-					}
+				ResetCameraTime();
 
-					return true;
+				if (CinematicCameraMode == ECinematicCameraMode::CameraPointVehicleToProjectile)
+				{
+					CameraDuration = FMath::FRandRange(4.0f, 6.0f);
+				}
+				else
+				{
+					CameraDuration = FMath::FRandRange(3.0f, 5.0f);
 				}
+
+				return true;
 			}
 		}
 	}
@@ -1604,61 +1594,49 @@ bool FCinematicsDirector::IdentifyWeaponEvent(bool highValue)
 bool FCinematicsDirector::IdentifyWeaponLaunches()
 {
 	APlayGameMode* gameMode = APlayGameMode::Get(Owner);
-	TArray<FGameEvent>& events = gameMode->GameEvents;
-	float time = gameMode->GetRealTimeClock();
-
-	// Examine the last few game events.
 
-	for (int32 i = gameMode->GameEvents.Num() - 1; i >= 0; i--)
-	{
-		FGameEvent& event = events[i];
+	UpdateRecentWeaponEvents(gameMode);
 
-		if (event.Time < time - 0.25f)
-		{
-			break;
-		}
+	// Examine the last few weapon events to find one that we can watch.
 
-		// Find a weapon event that we can watch.
+	for (int32 i = RecentWeaponEvents.Num() - 1; i >= 0; i--)
+	{
+		const FGameEvent& event = gameMode->GameEvents[RecentWeaponEvents[i]];
+		ABaseVehicle* vehicle = gameMode->GetVehicleForVehicleIndex(event.LaunchVehicleIndex);
+		AActor* cameraTarget = nullptr;
 
-		if (event.EventType == EGameEventType::Used ||
-			event.EventType == EGameEventType::Preparing)
+		if (vehicle != nullptr &&
+			vehicle == CameraTarget &&
+			vehicle->IsVehicleDestroyed() == false &&
+			IsVehicleSmoothlyControlled(vehicle) == true)
 		{
-			ABaseVehicle* vehicle = gameMode->GetVehicleForVehicleIndex(event.LaunchVehicleIndex);
-			AActor* cameraTarget = nullptr;
+			// Follow a missile use.
 
-			if (vehicle != nullptr &&
-				vehicle == CameraTarget &&
-				vehicle->IsVehicleDestroyed() == false &&
-				IsVehicleSmoothlyControlled(vehicle) == true)
+			if (event.PickupUsed == EPickupType::HomingMissile)
 			{
-				// Follow a missile use.
+				TWeakObjectPtr<AHomingMissile>& missile = vehicle->GetHomingMissile();
 
-				if (event.PickupUsed == EPickupType::HomingMissile)
+				if (GRIP_POINTER_VALID(missile) == true &&
+					missile->Target != nullptr &&
+					missile->Target->IsA<ABaseVehicle>() == true)
 				{
-					TWeakObjectPtr<AHomingMissile>& missile = vehicle->GetHomingMissile();
-
-					if (GRIP_POINTER_VALID(missile) == true &&
-						missile->Target != nullptr &&
-						missile->Target->IsA<ABaseVehicle>() == true)
-					{
-						cameraTarget = missile.Get();
-					}
+					cameraTarget = missile.Get();
 				}
+			}
 
-				if (GRIP_OBJECT_VALID(cameraTarget) == true)
-				{
-					SwitchMode(ECinematicCameraMode::CameraPointVehicleToProjectile);
+			if (GRIP_OBJECT_VALID(cameraTarget) == true)
+			{
+				SwitchMode(ECinematicCameraMode::CameraPointVehicleToProjectile);
 
-					LastCameraTarget = CameraTarget;
-					CameraTarget = cameraTarget;
-					WeaponEventConcluded = false;
+				LastCameraTarget = CameraTarget;
+				CameraTarget = cameraTarget;
+				WeaponEventConcluded = false;
 
-					ResetCameraTime();
+				ResetCameraTime();
 
-					CameraDuration = FMath::FRandRange(4.0f, 6.0f);
+				CameraDuration = FMath::FRandRange(4.0f, 6.0f);
 
-					return true;
-				}
+				return true;
 			}
 		}
 	}
@@ -1666,6 +1644,41 @@ bool FCinematicsDirector::IdentifyWeaponLaunches()
 	return false;
 }
 
+/**
+* Update the recent weapon events from the game events recorded since the last
+* update, discarding those that are now too old to be of interest.
+***********************************************************************************/
+
+void FCinematicsDirector::UpdateRecentWeaponEvents(APlayGameMode* gameMode)
+{
+	TArray<FGameEvent>& events = gameMode->GameEvents;
+
+	for (; NextGameEvent < events.Num(); NextGameEvent++)
+	{
+		FGameEvent& event = events[NextGameEvent];
+
+		if (event.EventType == EGameEventType::Used ||
+			event.EventType == EGameEventType::Preparing)
+		{
+			RecentWeaponEvents.Emplace(NextGameEvent);
+		}
+	}
+
+	float time = gameMode->GetRealTimeClock();
+	int32 numExpired = 0;
+
+	while (numExpired < RecentWeaponEvents.Num() &&
+		events[RecentWeaponEvents[numExpired]].Time < time - 0.25f)
+	{
+		numExpired++;
+	}
+
+	if (numExpired > 0)
+	{
+		RecentWeaponEvents.RemoveAt(0, numExpired, false);
+	}
+}
+
 /**
 * Identify a potential impact event.
 ***********************************************************************************/
@@ -1717,93 +1730,192 @@ bool FCinematicsDirector::IdentifyStaticCamera()
 		// Identifying vehicles on pursuit splines is easy enough - if they're using them and are
 		// within the correct distance range then bam.
 
-		GRIP_GAME_MODE_LIST_FOR_FROM(TrackCameras, cameras, gameMode);
+		float distanceLength = gameMode->MasterRacingSplineLength;
+		UPursuitSplineComponent* masterRacingSpline = gameMode->MasterRacingSpline.Get();
+
+		// Is a camera suitable for use, before looking at the vehicles approaching it?
+
+		auto isCameraSuitable = [this] (AStaticTrackCamera* camera)
+		{
+			// Use the wide-angle cameras less often than the narrow-angle cameras,
+			// and only those looking forwards or backwards along the track.
+
+			return ((camera->Camera->FieldOfView < 45.0f ||
+				(StaticCameraCount & 1) == 1) &&
+				(camera->AngleVsTrack < 45.0f ||
+				camera->AngleVsTrack > 180.0f - 45.0f));
+		};
+
+		// Is a vehicle fast enough and intact enough to be filmed?
+
+		auto isVehicleSuitable = [] (ABaseVehicle* vehicle)
+		{
+			return (vehicle->GetSpeedKPH() > 200.0f &&
+				vehicle->IsVehicleDestroyed() == false);
+		};
+
+		// Measure a vehicle approaching a camera, returning true if it's within the camera's
+		// window along with its time to reach the camera as a ratio of the camera's duration.
 
-		for (AStaticTrackCamera* camera : cameras)
+		auto measureVehicle = [masterRacingSpline, distanceLength] (AStaticTrackCamera* camera, ABaseVehicle* vehicle, float& ratio)
 		{
-			// Use the wide-angle cameras less often than the narrow-angle cameras.
+			TWeakObjectPtr<UPursuitSplineComponent>& vehicleSpline = vehicle->GetAI().RouteFollower.ThisSpline;
 
-			if (camera->Camera->FieldOfView < 45.0f ||
-				(StaticCameraCount & 1) == 1)
+			if (GRIP_POINTER_VALID(camera->LinkedPursuitSpline) == false ||
+				camera->LinkedPursuitSpline == vehicleSpline)
 			{
-				// Looking forwards or backwards along the track.
+				// Iterate the splines linked to this camera and see if it matches the vehicle's spline.
 
-				if (camera->AngleVsTrack < 45.0f ||
-					camera->AngleVsTrack > 180.0f - 45.0f)
+				for (TWeakObjectPtr<UPursuitSplineComponent>& linkedSpline : camera->LinkedPursuitSplines)
 				{
-					int32 numVehicles = 0;
-					float minDistance = 0.0f;
-					float maxDistance = 0.0f;
-					ABaseVehicle* lastVehicle = CurrentVehicle.Get();
-					float distanceLength = gameMode->MasterRacingSplineLength;
-					float targetDistance = camera->DistanceAlongMasterRacingSpline;
+					if (linkedSpline == vehicleSpline)
+					{
+						// Now check the distance from the vehicle to the camera, using spline distances.
 
-					GRIP_GAME_MODE_LIST_FOR_FROM(GetVehicles(), vehicles, gameMode);
+						float distance = vehicle->GetRaceState().DistanceAlongMasterRacingSpline;
+						float speed = vehicle->GetPhysics().VelocityData.Speed;
 
-					for (ABaseVehicle* vehicle : vehicles)
-					{
-						if (vehicle->GetSpeedKPH() > 200.0f &&
-							vehicle->IsVehicleDestroyed() == false)
+						if (camera->HookupDelay != 0.0f)
 						{
-							TWeakObjectPtr<UPursuitSplineComponent>& vehicleSpline = vehicle->GetAI().RouteFollower.ThisSpline;
+							distance = masterRacingSpline->ClampDistanceAgainstLength(distance - (speed * camera->HookupDelay), distanceLength);
+						}
 
-							if (GRIP_POINTER_VALID(camera->LinkedPursuitSpline) == false ||
-								camera->LinkedPursuitSpline == vehicleSpline)
-							{
-								// Iterate the splines linked to this camera and see if it matches the vehicle's spline.
+						float difference = masterRacingSpline->GetDistanceDifference(distance, camera->DistanceAlongMasterRacingSpline, distanceLength, true);
 
-								for (TWeakObjectPtr<UPursuitSplineComponent>& linkedSpline : camera->LinkedPursuitSplines)
-								{
-									if (linkedSpline == vehicleSpline)
-									{
-										// Now check the distance from the vehicle to the camera, using spline distances.
+						// difference is negative if lower than the target distance.
 
-										float distance = vehicle->GetRaceState().DistanceAlongMasterRacingSpline;
-										float speed = vehicle->GetPhysics().VelocityData.Speed;
+						float time = difference / (speed * camera->Duration);
 
-										if (camera->HookupDelay != 0.0f)
-										{
-											distance = gameMode->MasterRacingSpline->ClampDistanceAgainstLength(distance - (speed * camera->HookupDelay), distanceLength);
-										}
+						ratio = -time;
 
-										float difference = gameMode->MasterRacingSpline->GetDistanceDifference(distance, targetDistance, distanceLength, true);
+						return (-time < 1.0f &&
+							difference < 0.0f);
+					}
+				}
+			}
 
-										// difference is negative if lower than the target distance.
+			return false;
+		};
 
-										float time = difference / (speed * camera->Duration);
+		// Select a camera if the vehicles approaching it make for a good shot.
 
-										if (-time < 1.0f &&
-											difference < 0.0f)
-										{
-											numVehicles++;
-											lastVehicle = vehicle;
+		auto selectCamera = [this] (AStaticTrackCamera* camera, int32 numVehicles, float minDistance, float maxDistance, ABaseVehicle* lastVehicle)
+		{
+			if (minDistance > 0.25f &&
+				minDistance < 0.5f &&
+				maxDistance > 0.75f &&
+				numVehicles >= camera->NumberOfVehicles)
+			{
+				camera->ResetCameraHit();
 
-											minDistance = (numVehicles == 1) ? -time : FMath::Min(minDistance, -time);
-											maxDistance = (numVehicles == 1) ? -time : FMath::Max(maxDistance, -time);
-										}
+				StaticCameraCount++;
+				StaticCamera = camera;
+				CurrentVehicle = lastVehicle;
 
-										break;
-									}
-								}
+				ResetCameraTime();
+
+				SwitchMode(ECinematicCameraMode::StaticCamera);
+
+				return true;
+			}
+
+			return false;
+		};
+
+		GRIP_GAME_MODE_LIST_FOR_FROM(GetVehicles(), vehicles, gameMode);
+
+		if (FTrackCameraIndex::IsEnabled() == true &&
+			gameMode->GetTrackCameraIndex().IsBuilt() == true)
+		{
+			// Merge the cameras, sorted on their distance along the master racing spline,
+			// against the vehicles sorted in the same way, so that each camera only
+			// examines the vehicles that are near to it.
+
+			FTrackCameraIndex::FVehicles indexVehicles;
+
+			for (ABaseVehicle* vehicle : vehicles)
+			{
+				if (isVehicleSuitable(vehicle) == true)
+				{
+					indexVehicles.Emplace(vehicle, vehicle->GetRaceState().DistanceAlongMasterRacingSpline, vehicle->GetPhysics().VelocityData.Speed);
+				}
+			}
+
+			TArray<FTrackCameraIndex::FCandidate> candidates;
+
+			gameMode->GetTrackCameraIndex().FindCandidates(indexVehicles, candidates);
+
+			for (const FTrackCameraIndex::FCandidate& candidate : candidates)
+			{
+				AStaticTrackCamera* camera = candidate.Camera;
+
+				if (isCameraSuitable(camera) == true)
+				{
+					int32 numVehicles = 0;
+					int32 lastIndex = -1;
+					float minDistance = 0.0f;
+					float maxDistance = 0.0f;
+					ABaseVehicle* lastVehicle = CurrentVehicle.Get();
+
+					for (int32 index : candidate.Vehicles)
+					{
+						float ratio = 0.0f;
+						ABaseVehicle* vehicle = indexVehicles[index].Vehicle;
+
+						if (measureVehicle(camera, vehicle, ratio) == true)
+						{
+							numVehicles++;
+
+							// Keep the last vehicle in the order of the vehicle list, as it would be without the index.
+
+							if (lastIndex < index)
+							{
+								lastIndex = index;
+								lastVehicle = vehicle;
 							}
+
+							minDistance = (numVehicles == 1) ? ratio : FMath::Min(minDistance, ratio);
+							maxDistance = (numVehicles == 1) ? ratio : FMath::Max(maxDistance, ratio);
 						}
 					}
 
-					if (minDistance > 0.25f &&
-						minDistance < 0.5f &&
-						maxDistance > 0.75f &&
-						numVehicles >= camera->NumberOfVehicles)
+					if (selectCamera(camera, numVehicles, minDistance, maxDistance, lastVehicle) == true)
 					{
-						camera->ResetCameraHit();
+						return true;
+					}
+				}
+			}
+		}
+		else
+		{
+			GRIP_GAME_MODE_LIST_FOR_FROM(TrackCameras, cameras, gameMode);
 
-						StaticCameraCount++;
-						StaticCamera = camera;
-						CurrentVehicle = lastVehicle;
+			for (AStaticTrackCamera* camera : cameras)
+			{
+				if (isCameraSuitable(camera) == true)
+				{
+					int32 numVehicles = 0;
+					float minDistance = 0.0f;
+					float maxDistance = 0.0f;
+					ABaseVehicle* lastVehicle = CurrentVehicle.Get();
 
-						ResetCameraTime();
+					for (ABaseVehicle* vehicle : vehicles)
+					{
+						float ratio = 0.0f;
 
-						SwitchMode(ECinematicCameraMode::StaticCamera);
+						if (isVehicleSuitable(vehicle) == true &&
+							measureVehicle(camera, vehicle, ratio) == true)
+						{
+							numVehicles++;
+							lastVehicle = vehicle;
 
+							minDistance = (numVehicles == 1) ? ratio : FMath::Min(minDistance, ratio);
+							maxDistance = (numVehicles == 1) ? ratio : FMath::Max(maxDistance, ratio);
+						}
+					}
+
+					if (selectCamera(camera, numVehicles, minDistance, maxDistance, lastVehicle) == true)
+					{
 						return true;
 					}
 				}
@@ -2477,7 +2589,7 @@ void FSplineCamera::Tick(float deltaSeconds, bool modeReset)
 
 		if (Target->GetAI().RouteFollower.ThisSpline != Spline)
 		{
-			distance = Spline->GetNearestDistance(Target->GetActorLocation(), 0.0f, 0.0f, 4, 50, 0.0f);
+			distance = Spline->FindNearestDistance(Target->GetActorLocation());
 		}
 
 		float distanceLeft = Spline->GetDistanceLeft(distance, StartDistance, EndDistance);
@@ -2633,7 +2745,7 @@ void FSplineCamera::Tick(float deltaSeconds, bool modeReset)
 			float t1 = TargetDistanceAlongSpline + range;
 
 			LastTargetLocation = targetLocation;
-			TargetDistanceAlongSpline = Spline->GetNearestDistance(targetLocation, t0, t1, 5, Spline->GetNumSamplesForRange(range * 2.0f, 5), 0.0f);
+			TargetDistanceAlongSpline = Spline->FindNearestDistance(targetLocation, t0, t1);
 
 			if (targetSpline != Spline)
 			{
@@ -2854,7 +2966,7 @@ float FSplineCamera::GetSplineDistance(float distanceAlongSpline, const FVector&
 		// Get the nearest distance to the plane at newLocation and direction.
 
 		newLocation = vehicleLocation + direction * offset;
-		offsetDistanceAlongSpline = Spline->GetNearestDistance(newLocation, direction, offsetDistanceAlongSpline - cmsRange, offsetDistanceAlongSpline + cmsRange, 5, Spline->GetNumSamplesForRange(cmsRange * 2.0f, 5), 0.0f);
+		offsetDistanceAlongSpline = Spline->FindNearestDistance(newLocation, direction, offsetDistanceAlongSpline - cmsRange, offsetDistanceAlongSpline + cmsRange);
 
 		// Get the world location at the distance and reproject onto the original plane.
 
@@ -3027,7 +3139,7 @@ void FSplineCamera::SetEndTime(float secondsFromNow, float timeScale)
 
 		if (Target->GetAI().RouteFollower.ThisSpline != Spline)
 		{
-			distance = Spline->GetNearestDistance(Target->GetActorLocation(), 0.0f, 0.0f, 4, 50, 0.0f);
+			distance = Spline->FindNearestDistance(Target->GetActorLocation());
 		}
 
 		float distanceLeft = Spline->GetDistanceLeft(distance, StartDistance, EndDistance);
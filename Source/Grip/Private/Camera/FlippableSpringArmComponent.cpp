@@ -1519,48 +1519,17 @@ bool UFlippableSpringArmComponent::OwnerIsBeingWatched() const
 
 bool UFlippableSpringArmComponent::ClipAgainstVehicles(const FVector& start, FVector& end) const
 {
-	bool result = false;
-	ABaseVehicle* thisVehicle = Cast<ABaseVehicle>(GetAttachmentRootActor());
 	APlayGameMode* playGameMode = APlayGameMode::Get(this);
 
 	if (playGameMode != nullptr)
 	{
-		GRIP_GAME_MODE_LIST_FROM(GetVehicles(), vehicles, playGameMode);
-
-		// Check each of the vehicles in the game against the spring-arm.
-
-		for (ABaseVehicle* vehicle : vehicles)
-		{
-			if (vehicle != thisVehicle)
-			{
-				FBox box = vehicle->CameraClipBox;
-				FVector halfVector = (end - start) * 0.5f;
-				FVector center = start + halfVector;
-				float radius = halfVector.Size();
+		// Check the spring-arm against the vehicles in the game, other than our own,
+		// using the index shared by all of the cameras this frame.
 
-				// If this vehicle is close enough to us to warrant a clip check then do just that.
-
-				if ((vehicle->GetActorLocation() - center).Size() < box.Max.Size() + radius + 200.0f)
-				{
-					float hitTime;
-					FVector hitNormal;
-					FVector hitLocation;
-					const FTransform& transform = vehicle->VehicleMesh->GetComponentTransform();
-					FVector vehicleStart = transform.InverseTransformPosition(start);
-					FVector vehicleEnd = transform.InverseTransformPosition(end);
-
-					if (FMath::LineExtentBoxIntersection(vehicle->CameraClipBox, vehicleStart, vehicleEnd, FVector::ZeroVector, hitLocation, hitNormal, hitTime) == true)
-					{
-						end = transform.TransformPosition(hitLocation);
-
-						result = true;
-					}
-				}
-			}
-		}
+		return playGameMode->GetCameraClipIndex().ClipSegment(start, end, Cast<ABaseVehicle>(GetAttachmentRootActor()));
 	}
 
-	return result;
+	return false;
 }
 
 #pragma endregion VehicleSpringArm
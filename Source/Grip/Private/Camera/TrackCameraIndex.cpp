@@ -0,0 +1,250 @@
+/**
+*
+* Track camera index.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* An index of the static track cameras in a level ordered by their distance along
+* the master racing spline, used by the cinematics director to find cameras that
+* have vehicles approaching them.
+*
+***********************************************************************************/
+
+#include "camera/trackcameraindex.h"
+#include "camera/statictrackcamera.h"
+#include "ai/pursuitsplinecomponent.h"
+
+/**
+* Console variable for using the track camera index.
+***********************************************************************************/
+
+TAutoConsoleVariable<int32> CVarTrackCameraIndex(
+	TEXT("grip.TrackCameraIndex"),
+	1,
+	TEXT("Use the index of track cameras along the master racing spline when looking for a static camera to cut to.\n")
+	TEXT("  0: Off, examine every camera against every vehicle\n")
+	TEXT("  1: On\n"),
+	ECVF_Default);
+
+// The margin added to either side of the window in which a camera looks for
+// vehicles, to absorb rounding in the distances, in centimeters.
+static const float TrackCameraWindowMargin = 1.0f * 100.0f;
+
+/**
+* Is the index to be used rather than examining every camera against every vehicle?
+***********************************************************************************/
+
+bool FTrackCameraIndex::IsEnabled()
+{
+	return CVarTrackCameraIndex.GetValueOnGameThread() != 0;
+}
+
+/**
+* Refresh the index from the track cameras if they've changed since it was built.
+*
+* The track cameras measure their distances along the master racing spline as they
+* start play, so the index is built on first use after that.
+***********************************************************************************/
+
+void FTrackCameraIndex::Refresh(const TArray<AStaticTrackCamera*>& cameras, UPursuitSplineComponent* masterRacingSpline)
+{
+	if (MasterRacingSpline == masterRacingSpline &&
+		NumCameras == cameras.Num())
+	{
+		return;
+	}
+
+	Entries.Reset(cameras.Num());
+
+	MasterRacingSpline = nullptr;
+	NumCameras = cameras.Num();
+	MaxTimeBehind = 0.0f;
+	MaxTimeAhead = 0.0f;
+
+	if (masterRacingSpline == nullptr)
+	{
+		return;
+	}
+
+	MasterRacingSpline = masterRacingSpline;
+	SplineLength = masterRacingSpline->GetSplineLength();
+	ClosedLoop = masterRacingSpline->IsClosedLoop();
+
+	for (int32 i = 0; i < cameras.Num(); i++)
+	{
+		AStaticTrackCamera* camera = cameras[i];
+
+		if (GRIP_OBJECT_VALID(camera) == true)
+		{
+			FEntry& entry = Entries.AddDefaulted_GetRef();
+
+			// A vehicle is looked for when its distance, pushed back by the hookup delay at
+			// its speed, is within the duration of the camera at its speed before the camera.
+			// So the window in raw distance runs from speed * (duration - hookup) behind the
+			// camera to speed * hookup ahead of it.
+
+			entry.Camera = camera;
+			entry.Order = i;
+			entry.DistanceAlong = camera->DistanceAlongMasterRacingSpline;
+			entry.TimeBehind = FMath::Max(camera->Duration - camera->HookupDelay, 0.0f);
+			entry.TimeAhead = FMath::Max(camera->HookupDelay, 0.0f);
+			entry.NumberOfVehicles = FMath::Max(camera->NumberOfVehicles, 1);
+
+			MaxTimeBehind = FMath::Max(MaxTimeBehind, entry.TimeBehind);
+			MaxTimeAhead = FMath::Max(MaxTimeAhead, entry.TimeAhead);
+		}
+	}
+
+	Entries.Sort([] (const FEntry& object1, const FEntry& object2)
+		{
+			return object1.DistanceAlong < object2.DistanceAlong;
+		});
+}
+
+/**
+* Get the track cameras that may have enough vehicles approaching them, in the
+* order of the track cameras the index was built from.
+*
+* The vehicles are sorted on their distance along the master racing spline and
+* merged against the cameras, with a window around each camera sized for the
+* fastest of the vehicles. This is a conservative test, and the vehicles found
+* still need to be checked against the exact window of the camera at their own
+* speed.
+***********************************************************************************/
+
+void FTrackCameraIndex::FindCandidates(const FVehicles& vehicles, TArray<FCandidate>& candidates) const
+{
+	candidates.Reset();
+
+	if (MasterRacingSpline == nullptr ||
+		Entries.Num() == 0 ||
+		vehicles.Num() == 0)
+	{
+		return;
+	}
+
+	// Sort the vehicles on their distance along the master racing spline. On a closed
+	// loop, each vehicle is also placed a lap behind and a lap ahead so that windows
+	// that wrap around the start of the spline don't need to be split.
+
+	typedef TPair<float, int32> FSortedVehicle;
+
+	float maxSpeed = 0.0f;
+	TArray<FSortedVehicle, TInlineAllocator<GRIP_MAX_PLAYERS * 3>> sortedVehicles;
+
+	for (int32 i = 0; i < vehicles.Num(); i++)
+	{
+		const FVehicle& vehicle = vehicles[i];
+
+		maxSpeed = FMath::Max(maxSpeed, vehicle.Speed);
+
+		sortedVehicles.Emplace(vehicle.DistanceAlong, i);
+
+		if (ClosedLoop == true)
+		{
+			sortedVehicles.Emplace(vehicle.DistanceAlong - SplineLength, i);
+			sortedVehicles.Emplace(vehicle.DistanceAlong + SplineLength, i);
+		}
+	}
+
+	sortedVehicles.Sort([] (const FSortedVehicle& object1, const FSortedVehicle& object2)
+		{
+			return object1.Key < object2.Key;
+		});
+
+	float behind = (maxSpeed * MaxTimeBehind) + TrackCameraWindowMargin;
+	float ahead = (maxSpeed * MaxTimeAhead) + TrackCameraWindowMargin;
+
+	// If the window covers a whole lap then a vehicle could be found in it more than
+	// once, so just give every camera all of the vehicles.
+
+	bool wholeLap = (ClosedLoop == true && behind + ahead >= SplineLength);
+
+	// On an open spline, a vehicle pushed back by the hookup delay past the start of the
+	// spline is clamped to the start, and so can be found by any camera whose window
+	// reaches back that far, however far ahead of the window the vehicle really is.
+	// So the window of those cameras is widened back to the start of the spline.
+
+	bool clampedToStart = (ClosedLoop == false && MaxTimeAhead > 0.0f);
+
+	// As both lists are sorted, the start of the window only ever moves forwards
+	// through the vehicles as we move forwards through the cameras, including when
+	// it's widened as that only happens for the cameras nearest the start.
+
+	int32 first = 0;
+
+	for (const FEntry& entry : Entries)
+	{
+		float fromDistance = entry.DistanceAlong - behind;
+		float toDistance = entry.DistanceAlong + ahead;
+
+		if (clampedToStart == true &&
+			entry.DistanceAlong <= behind + ahead)
+		{
+			fromDistance = FMath::Min(fromDistance, 0.0f);
+		}
+
+		while (first < sortedVehicles.Num() &&
+			sortedVehicles[first].Key < fromDistance)
+		{
+			first++;
+		}
+
+		if (entry.NumberOfVehicles > vehicles.Num())
+		{
+			continue;
+		}
+
+		FCandidate candidate;
+
+		if (wholeLap == true)
+		{
+			for (int32 i = 0; i < vehicles.Num(); i++)
+			{
+				candidate.Vehicles.Emplace(i);
+			}
+		}
+		else
+		{
+			for (int32 i = first; i < sortedVehicles.Num() && sortedVehicles[i].Key <= toDistance; i++)
+			{
+				candidate.Vehicles.Emplace(sortedVehicles[i].Value);
+			}
+		}
+
+		if (candidate.Vehicles.Num() >= entry.NumberOfVehicles)
+		{
+			candidate.Camera = entry.Camera;
+			candidate.Order = entry.Order;
+
+			candidates.Emplace(MoveTemp(candidate));
+		}
+	}
+
+	// Return the cameras in their original order, so that the first camera chosen is
+	// the same as it would be without the index.
+
+	candidates.Sort([] (const FCandidate& object1, const FCandidate& object2)
+		{
+			return object1.Order < object2.Order;
+		});
+}
+
+/**
+* Clear the index.
+***********************************************************************************/
+
+void FTrackCameraIndex::Reset()
+{
+	Entries.Reset();
+
+	NumCameras = 0;
+	MasterRacingSpline = nullptr;
+	SplineLength = 0.0f;
+	ClosedLoop = false;
+	MaxTimeBehind = 0.0f;
+	MaxTimeAhead = 0.0f;
+}
@@ -16,6 +16,7 @@
 #include "effects/lightstreakcomponent.h"
 #include "vehicle/flippablevehicle.h"
 #include "uobject/constructorhelpers.h"
+#include "system/frameprofiler.h"
 
 UMaterialInterface* ULightStreakComponent::StandardStreakMaterial = nullptr;
 UMaterialInterface* ULightStreakComponent::StandardFlareMaterial = nullptr;
@@ -98,83 +99,6 @@ namespace LightStreakParameterNames
 	static const FName AlphaFadePowerName("AlphaFadePower");
 };
 
-/**
-* Add a new vertex joint.
-***********************************************************************************/
-
-static int32 AddStreakVertexJoint(TArray<FVector>& vertices, TArray<FVector>& normals, TArray<FVector2D>& uv0, TArray<FColor>& colours, const FVector& location, FVector direction, const FVector& horizontalAxis, float time, float alpha, int32 startIndex, int32 numJointVertices, bool cameraFacing)
-{
-	int32 initialIndex = startIndex;
-
-	direction.Normalize();
-
-	if (vertices.Num() - startIndex >= numJointVertices)
-	{
-		FColor color = FColor::White;
-
-		// Store the direction or tangent in the color so that I can read it in the material.
-
-		color.R = (uint8)((direction.X * 127.0f) + 128.0f);
-		color.G = (uint8)((direction.Y * 127.0f) + 128.0f);
-		color.B = (uint8)((direction.Z * 127.0f) + 128.0f);
-		color.A = (uint8)(alpha * 255.0f);
-
-		FVector normal = horizontalAxis;
-
-		if (cameraFacing == true)
-		{
-			normal = direction.ToOrientationQuat().GetAxisY();
-		}
-
-		for (int32 i = 0; i < numJointVertices; i++)
-		{
-			vertices[startIndex] = location;
-			normals[startIndex] = normal; normal *= -1.0f;
-			uv0[startIndex] = FVector2D(i, time);
-			colours[startIndex] = color;
-
-			// So:
-			// color is the forwards direction of the light streak in world space.
-			// normal is the sideways vector in world space, with no roll applied.
-			// uv0 is the U coordinate combined with the time the point was emitted.
-
-			startIndex++;
-		}
-	}
-
-	if (vertices.Num() - startIndex >= numJointVertices)
-	{
-		for (int32 i = 0; i < numJointVertices; i++)
-		{
-			vertices[startIndex] = location;
-
-			startIndex++;
-		}
-	}
-
-	return startIndex - initialIndex;
-}
-
-/**
-* Setup a vertex joint.
-***********************************************************************************/
-
-static void SetupStreakVertexJoint(TArray<FVector>& vertices, TArray<FVector>& normals, TArray<FVector2D>& uv0, TArray<FColor>& colours, int32 startIndex, int32 numJointVertices, const FVector& location)
-{
-	FVector2D uv = FVector2D(0.0f, 0.0f);
-	FColor color = FColor::White; color.A = 0;
-
-	for (int32 i = 0; i < numJointVertices; i++)
-	{
-		vertices[startIndex] = location;
-		normals[startIndex] = FVector(0.0f, 1.0f, 0.0f);
-		uv0[startIndex] = uv;
-		colours[startIndex] = color;
-
-		startIndex++;
-	}
-}
-
 /**
 * Setup a vertex quad.
 ***********************************************************************************/
@@ -314,13 +238,23 @@ void ULightStreakComponent::InitializeComponent()
 
 			if (Streak == true)
 			{
-				DynamicStreakMaterial = Geometry->CreateDynamicMaterialInstance(index, StreakMaterial);
+				// Create the light streak stuff, which is held in its own ring buffer
+				// geometry so that only the joints that change are uploaded to the GPU.
+
+				StreakGeometry = NewObject<UStreakMeshComponent>(this);
 
-				StreakSectionIndex = index;
+				if (StreakGeometry != nullptr)
+				{
+					StreakGeometry->SetCastShadow(false);
+					StreakGeometry->Initialize(MaxJoints, NumJointVertices, Width, location);
+					StreakGeometry->RegisterComponent();
+
+					DynamicStreakMaterial = StreakGeometry->CreateDynamicMaterialInstance(0, StreakMaterial);
+				}
 
 				if (DynamicStreakMaterial != nullptr)
 				{
-					Geometry->SetMaterial(index, DynamicStreakMaterial);
+					StreakGeometry->SetMaterial(0, DynamicStreakMaterial);
 
 					StreakColour.A = 1.0f;
 					StreakEndColour.A = 1.0f;
@@ -337,47 +271,6 @@ void ULightStreakComponent::InitializeComponent()
 					DynamicStreakMaterial->SetScalarParameterValue(LightStreakParameterNames::CameraFacingName, (CameraFacing == true) ? 1.0f : 0.0f);
 					DynamicStreakMaterial->SetScalarParameterValue(LightStreakParameterNames::AlphaFadePowerName, AlphaFadePower);
 				}
-
-				// Create the light streak stuff.
-
-				int32 numJoints = NumJointsPerSection;
-
-				MaxVertices = numJoints * NumJointVertices;
-
-				Vertices.AddDefaulted(MaxVertices);
-				Normals.AddDefaulted(MaxVertices);
-				UV0.AddDefaulted(MaxVertices);
-				Colours.AddDefaulted(MaxVertices);
-
-				Triangles.Reserve((numJoints - 1) * NumJointVertices * 6);
-
-				for (int32 i = 0; i < numJoints; i++)
-				{
-					SetupStreakVertexJoint(Vertices, Normals, UV0, Colours, i * NumJointVertices, NumJointVertices, location);
-
-					if (i > 0)
-					{
-						int32 i1 = i * NumJointVertices;
-						int32 i0 = i1 - NumJointVertices;
-
-						for (int32 j = 0; j < NumJointVertices - 1; j++)
-						{
-							int32 imask = (j + 1);
-
-							Triangles.Emplace(i1 + j);
-							Triangles.Emplace(i0 + j);
-							Triangles.Emplace(i1 + imask);
-
-							Triangles.Emplace(i0 + j);
-							Triangles.Emplace(i0 + imask);
-							Triangles.Emplace(i1 + imask);
-						}
-					}
-				}
-
-				Geometry->CreateMeshSection(index, Vertices, Triangles, Normals, UV0, Colours, Tangents, false);
-
-				SectionsDisusedAt.Emplace(0.0f);
 			}
 		}
 	}
@@ -386,73 +279,43 @@ void ULightStreakComponent::InitializeComponent()
 }
 
 /**
-* Switch to a new section for adding new points.
+* Build a vertex joint for the streak.
 ***********************************************************************************/
 
-void ULightStreakComponent::SwitchSection(bool reset, bool empty)
+void ULightStreakComponent::BuildStreakJoint(FStreakMeshVertex* vertices, const FVector& location, FVector direction, const FVector& horizontalAxis, float alpha) const
 {
-	int32 numJoints = NumJointsPerSection;
-	FVector location = GetComponentTransform().GetLocation();
+	direction.Normalize();
 
-	SectionsDisusedAt[SectionIndex] = Timer;
+	FColor color = FColor::White;
 
-	int32 i = 0;
+	// Store the direction or tangent in the color so that I can read it in the material.
 
-	for (; i < SectionsDisusedAt.Num(); i++)
-	{
-		if (SectionsDisusedAt[i] < 0.0f)
-		{
-			break;
-		}
-	}
+	color.R = (uint8)((direction.X * 127.0f) + 128.0f);
+	color.G = (uint8)((direction.Y * 127.0f) + 128.0f);
+	color.B = (uint8)((direction.Z * 127.0f) + 128.0f);
+	color.A = (uint8)(alpha * 255.0f);
 
-	bool createSection = i == SectionsDisusedAt.Num();
+	FVector normal = horizontalAxis;
 
-	if (createSection == true)
+	if (CameraFacing == true)
 	{
-		SectionsDisusedAt.Emplace(0.0f);
+		normal = direction.ToOrientationQuat().GetAxisY();
 	}
 
-	int32 lastIndex = StartIndex - NumJointVertices;
-
-	SectionIndex = i;
-	StartIndex = NumJointVertices;
-
-	Geometry->SetMaterial(SectionIndex + StreakSectionIndex, DynamicStreakMaterial);
-
-	if (empty == true)
+	for (int32 i = 0; i < NumJointVertices; i++)
 	{
-		StartIndex = 0;
+		FStreakMeshVertex& vertex = vertices[i];
 
-		for (i = 0; i < numJoints; i++)
-		{
-			SetupStreakVertexJoint(Vertices, Normals, UV0, Colours, i * NumJointVertices, NumJointVertices, location);
-		}
-	}
-	else if (reset == true)
-	{
-		for (i = 0; i < numJoints; i++)
-		{
-			SetupStreakVertexJoint(Vertices, Normals, UV0, Colours, i * NumJointVertices, NumJointVertices, location);
-		}
-	}
-	else
-	{
-		for (i = 0; i < NumJointVertices; i++)
-		{
-			Vertices[i] = Vertices[i + lastIndex];
-			Normals[i] = Normals[i + lastIndex];
-			UV0[i] = UV0[i + lastIndex];
-			Colours[i] = Colours[i + lastIndex];
-		}
+		vertex.Position = location;
+		vertex.Normal = normal; normal *= -1.0f;
+		vertex.UV = FVector2D(i, Timer);
+		vertex.Colour = color;
 
-		for (i = 1; i < numJoints; i++)
-		{
-			SetupStreakVertexJoint(Vertices, Normals, UV0, Colours, i * NumJointVertices, NumJointVertices, location);
-		}
+		// So:
+		// color is the forwards direction of the light streak in world space.
+		// normal is the sideways vector in world space, with no roll applied.
+		// uv0 is the U coordinate combined with the time the point was emitted.
 	}
-
-	Geometry->CreateMeshSection(SectionIndex + StreakSectionIndex, Vertices, Triangles, Normals, UV0, Colours, Tangents, false);
 }
 
 /**
@@ -530,6 +393,15 @@ void UVehicleLightStreakComponent::TickComponent(float deltaSeconds, enum ELevel
 
 void ULightStreakComponent::Update(float deltaSeconds)
 {
+#if GRIP_FRAME_PROFILER
+	// Attribute the time to the vehicle that owns the streak, if any, as streaks are
+	// also used on missiles.
+
+	ABaseVehicle* vehicle = Cast<ABaseVehicle>(GetOwner());
+
+	GRIP_FRAME_PROFILER_SCOPE(LightStreaks, (vehicle != nullptr) ? vehicle->GetVehicleIndex() : INDEX_NONE);
+#endif // GRIP_FRAME_PROFILER
+
 	float alpha = CalculateAlpha();
 	float flareAlpha = alpha;
 
@@ -543,16 +415,11 @@ void ULightStreakComponent::Update(float deltaSeconds)
 	{
 		if (Streak == true)
 		{
-			for (int32 i = 0; i < SectionsDisusedAt.Num(); i++)
+			if (StreakGeometry != nullptr)
 			{
-				if (i != SectionIndex &&
-					SectionsDisusedAt[i] >= 0.0f &&
-					Timer - SectionsDisusedAt[i] > LifeTime)
-				{
-					SectionsDisusedAt[i] = -1.0f;
+				// Once every joint has faded out there's no need to draw the streak at all.
 
-					Geometry->ClearMeshSection(i + StreakSectionIndex);
-				}
+				StreakGeometry->SetDrawn(Timer - LastPointAdded <= LifeTime);
 			}
 
 			bool addJumpPoint = false;
@@ -690,17 +557,13 @@ void ULightStreakComponent::AddPoint(float alpha, bool force)
 				// If we've just jumped a long way then assume the parent object has
 				// teleported or something. In this case, kill the trail and start over.
 
-				for (int32 i = 0; i < SectionsDisusedAt.Num(); i++)
-				{
-					SectionsDisusedAt[i] = -1.0f;
-
-					Geometry->ClearMeshSection(i + StreakSectionIndex);
-				}
-
 				NumPointsAdded = 0;
 				Timer = LastPointAdded = 0.0f;
 
-				SwitchSection(true, false);
+				if (StreakGeometry != nullptr)
+				{
+					StreakGeometry->Reset(location);
+				}
 			}
 			else
 			{
@@ -760,37 +623,29 @@ void ULightStreakComponent::AddPoint(float alpha, bool force)
 
 		FVector horizontalAxis = GetComponentTransform().GetUnitAxis(EAxis::Y);
 
+		FStreakMeshVertex joint[NumJointVertices];
+
+		BuildStreakJoint(joint, location, pointDirection, horizontalAxis, alpha);
+
 		if (extend == true)
 		{
-			int32 lastIndex = StartIndex - NumJointVertices;
-
-			AddStreakVertexJoint(Vertices, Normals, UV0, Colours, location, pointDirection, horizontalAxis, Timer, alpha, lastIndex, NumJointVertices, CameraFacing);
+			// Just move the head joint along, only it needs to be sent to the GPU.
 
-#if GRIP_ENGINE_EXTENDED_MODIFICATIONS
-			Geometry->UpdateMeshSection(SectionIndex + StreakSectionIndex, Vertices, Normals, UV0, Colours, Tangents, lastIndex, numAdded);
-#else
-			Geometry->UpdateMeshSection(SectionIndex + StreakSectionIndex, Vertices, Normals, UV0, Colours, Tangents);
-#endif
+			if (StreakGeometry != nullptr)
+			{
+				StreakGeometry->UpdateHeadJoint(joint);
+			}
 		}
 		else
 		{
-			if (StartIndex >= MaxVertices)
-			{
-				// We're out of space, so start a new section.
+			// Append a new joint to the ring buffer, overwriting the oldest joint
+			// once the buffer is full, which will have long since faded out.
 
-				SwitchSection(false, false);
+			if (StreakGeometry != nullptr)
+			{
+				StreakGeometry->AddJoint(joint, NumPointsAdded > 0);
 			}
 
-			AddStreakVertexJoint(Vertices, Normals, UV0, Colours, location, pointDirection, horizontalAxis, Timer, alpha, StartIndex, NumJointVertices, CameraFacing);
-
-#if GRIP_ENGINE_EXTENDED_MODIFICATIONS
-			Geometry->UpdateMeshSection(SectionIndex + StreakSectionIndex, Vertices, Normals, UV0, Colours, Tangents, StartIndex, numAdded);
-#else
-			Geometry->UpdateMeshSection(SectionIndex + StreakSectionIndex, Vertices, Normals, UV0, Colours, Tangents);
-#endif
-
-			StartIndex += NumJointVertices;
-
 			p2 = p1;
 			p1 = location;
 
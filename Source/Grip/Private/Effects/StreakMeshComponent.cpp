@@ -0,0 +1,591 @@
+/**
+*
+* Streak mesh implementation.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* The geometry for light streaks, held in a fixed-capacity ring buffer of joints
+* and rendered with its own scene proxy so that only the joints that change are
+* uploaded to the GPU.
+*
+***********************************************************************************/
+
+#include "effects/streakmeshcomponent.h"
+#include "primitivesceneproxy.h"
+#include "dynamicmeshbuilder.h"
+#include "localvertexfactory.h"
+#include "rendering/staticmeshvertexbuffer.h"
+#include "rendering/positionvertexbuffer.h"
+#include "rendering/colorvertexbuffer.h"
+#include "materials/material.h"
+
+/**
+* Console variable for logging the bytes uploaded by streak meshes.
+***********************************************************************************/
+
+TAutoConsoleVariable<int32> CVarStreakMeshStats(
+	TEXT("grip.StreakMeshStats"),
+	0,
+	TEXT("Log the bytes uploaded to the GPU by light streak meshes, once per second.\n")
+	TEXT("  0: Off\n")
+	TEXT("  1: On\n"),
+	ECVF_Default);
+
+/**
+* UStreakMeshComponent statics.
+***********************************************************************************/
+
+// The total number of bytes uploaded to the GPU for all streak meshes.
+volatile int64 UStreakMeshComponent::TotalBytesUploaded = 0;
+
+// The total number of bytes uploaded at the start of the current frame.
+int64 UStreakMeshComponent::TotalBytesAtFrameStart = 0;
+
+// The number of bytes uploaded in the last complete frame.
+int64 UStreakMeshComponent::BytesUploadedLastFrame = 0;
+
+// The maximum number of bytes uploaded in a frame since the stats were last logged.
+int64 UStreakMeshComponent::MaxBytesUploadedSinceLog = 0;
+
+// The total number of bytes uploaded when the stats were last logged.
+int64 UStreakMeshComponent::TotalBytesAtLastLog = 0;
+
+// The frame that the upload counters are currently counting.
+uint64 UStreakMeshComponent::UploadFrame = 0;
+
+// The number of frames since the stats were last logged.
+int32 UStreakMeshComponent::FramesSinceLog = 0;
+
+// The time the stats were last logged.
+double UStreakMeshComponent::LastLogTime = 0.0;
+
+#pragma region VehicleLightStreaks
+
+/**
+* An update of a range of joints in a streak mesh, sent to the render thread.
+***********************************************************************************/
+
+struct FStreakMeshUpdate
+{
+	// The first joint to update.
+	int32 FirstJoint = 0;
+
+	// The vertices of the joints to update.
+	TArray<FStreakMeshVertex, TInlineAllocator<4>> Vertices;
+
+	// The quads to update and whether they connect their joints.
+	TArray<TPair<int32, bool>, TInlineAllocator<2>> Quads;
+};
+
+/**
+* Set the indices of the quad between a joint and the joint before it in the ring
+* buffer, collapsing it to nothing if the joints aren't connected.
+***********************************************************************************/
+
+static void SetStreakQuadIndices(uint32* indices, int32 joint, int32 maxJoints, int32 numJointVertices, bool connected)
+{
+	int32 i1 = joint * numJointVertices;
+	int32 i0 = ((joint + maxJoints - 1) % maxJoints) * numJointVertices;
+
+	for (int32 j = 0; j < numJointVertices - 1; j++)
+	{
+		if (connected == true)
+		{
+			int32 imask = (j + 1);
+
+			*indices++ = i1 + j;
+			*indices++ = i0 + j;
+			*indices++ = i1 + imask;
+
+			*indices++ = i0 + j;
+			*indices++ = i0 + imask;
+			*indices++ = i1 + imask;
+		}
+		else
+		{
+			for (int32 i = 0; i < 6; i++)
+			{
+				*indices++ = i1;
+			}
+		}
+	}
+}
+
+/**
+* Convert a streak vertex into a dynamic mesh vertex.
+***********************************************************************************/
+
+static FDynamicMeshVertex ToDynamicMeshVertex(const FStreakMeshVertex& vertex)
+{
+	// This matches the conversion of the procedural mesh component with no tangents
+	// supplied, so that the streak materials see exactly the same vertex data.
+
+	return FDynamicMeshVertex(vertex.Position, FVector(1.0f, 0.0f, 0.0f), vertex.Normal, vertex.UV, vertex.Colour);
+}
+
+/**
+* Lock a range of a vertex buffer and copy the CPU copy of its data into it,
+* returning the number of bytes copied.
+***********************************************************************************/
+
+static int32 UploadVertexRange(FRHIVertexBuffer* buffer, const void* data, int32 stride, int32 firstVertex, int32 numVertices)
+{
+	int32 numBytes = stride * numVertices;
+	void* bufferData = RHILockVertexBuffer(buffer, firstVertex * stride, numBytes, RLM_WriteOnly);
+
+	FMemory::Memcpy(bufferData, (const uint8*)data + firstVertex * stride, numBytes);
+
+	RHIUnlockVertexBuffer(buffer);
+
+	return numBytes;
+}
+
+/**
+* The scene proxy for rendering a streak mesh.
+***********************************************************************************/
+
+class FStreakMeshSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+
+	// Get a hash unique to this type of scene proxy.
+	virtual SIZE_T GetTypeHash() const override
+	{ static size_t uniquePointer; return reinterpret_cast<size_t>(&uniquePointer); }
+
+	// Construct the scene proxy from the current state of a streak mesh, uploading all of it.
+	FStreakMeshSceneProxy(UStreakMeshComponent* component)
+		: FPrimitiveSceneProxy(component)
+		, VertexFactory(GetScene().GetFeatureLevel(), "FStreakMeshSceneProxy")
+		, MaterialRelevance(component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+		, MaxJoints(component->GetMaxJoints())
+		, NumJointVertices(component->GetNumJointVertices())
+		, NumQuadIndices((component->GetNumJointVertices() - 1) * 6)
+		, Drawn(component->IsDrawn())
+	{
+		TArray<FDynamicMeshVertex> vertices;
+
+		vertices.Reserve(component->GetVertices().Num());
+
+		for (const FStreakMeshVertex& vertex : component->GetVertices())
+		{
+			vertices.Emplace(ToDynamicMeshVertex(vertex));
+		}
+
+		VertexBuffers.InitFromDynamicVertex(&VertexFactory, vertices);
+
+		IndexBuffer.Indices.SetNumUninitialized(MaxJoints * NumQuadIndices);
+
+		for (int32 joint = 0; joint < MaxJoints; joint++)
+		{
+			SetStreakQuadIndices(&IndexBuffer.Indices[joint * NumQuadIndices], joint, MaxJoints, NumJointVertices, component->IsJointConnected(joint));
+		}
+
+		BeginInitResource(&VertexBuffers.PositionVertexBuffer);
+		BeginInitResource(&VertexBuffers.StaticMeshVertexBuffer);
+		BeginInitResource(&VertexBuffers.ColorVertexBuffer);
+		BeginInitResource(&IndexBuffer);
+		BeginInitResource(&VertexFactory);
+
+		UStreakMeshComponent::CountUpload(VertexBuffers.PositionVertexBuffer.GetNumVertices() * VertexBuffers.PositionVertexBuffer.GetStride() + VertexBuffers.StaticMeshVertexBuffer.GetTangentSize() + VertexBuffers.StaticMeshVertexBuffer.GetTexCoordSize() + VertexBuffers.ColorVertexBuffer.GetNumVertices() * VertexBuffers.ColorVertexBuffer.GetStride() + IndexBuffer.Indices.Num() * sizeof(uint32));
+
+		Material = component->GetMaterial(0);
+
+		if (Material == nullptr)
+		{
+			Material = UMaterial::GetDefaultMaterial(MD_Surface);
+		}
+	}
+
+	// Destruct the scene proxy, releasing its render resources.
+	virtual ~FStreakMeshSceneProxy()
+	{
+		VertexBuffers.PositionVertexBuffer.ReleaseResource();
+		VertexBuffers.StaticMeshVertexBuffer.ReleaseResource();
+		VertexBuffers.ColorVertexBuffer.ReleaseResource();
+		IndexBuffer.ReleaseResource();
+		VertexFactory.ReleaseResource();
+	}
+
+	// Update a range of joints, uploading only those joints and quads to the GPU.
+	void Update_RenderThread(const FStreakMeshUpdate& update)
+	{
+		check(IsInRenderingThread());
+
+		int32 firstVertex = update.FirstJoint * NumJointVertices;
+		int32 numVertices = update.Vertices.Num();
+
+		for (int32 i = 0; i < numVertices; i++)
+		{
+			FDynamicMeshVertex vertex = ToDynamicMeshVertex(update.Vertices[i]);
+
+			VertexBuffers.PositionVertexBuffer.VertexPosition(firstVertex + i) = vertex.Position;
+			VertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(firstVertex + i, vertex.TangentX.ToFVector(), vertex.GetTangentY(), vertex.TangentZ.ToFVector());
+			VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(firstVertex + i, 0, vertex.TextureCoordinate[0]);
+			VertexBuffers.ColorVertexBuffer.VertexColor(firstVertex + i) = vertex.Color;
+		}
+
+		int64 numBytes = 0;
+
+		if (numVertices > 0)
+		{
+			FPositionVertexBuffer& positions = VertexBuffers.PositionVertexBuffer;
+			FStaticMeshVertexBuffer& attributes = VertexBuffers.StaticMeshVertexBuffer;
+			FColorVertexBuffer& colours = VertexBuffers.ColorVertexBuffer;
+			int32 totalVertices = positions.GetNumVertices();
+
+			numBytes += UploadVertexRange(positions.VertexBufferRHI, positions.GetVertexData(), positions.GetStride(), firstVertex, numVertices);
+			numBytes += UploadVertexRange(attributes.TangentsVertexBuffer.VertexBufferRHI, attributes.GetTangentData(), attributes.GetTangentSize() / totalVertices, firstVertex, numVertices);
+			numBytes += UploadVertexRange(attributes.TexCoordVertexBuffer.VertexBufferRHI, attributes.GetTexCoordData(), attributes.GetTexCoordSize() / totalVertices, firstVertex, numVertices);
+			numBytes += UploadVertexRange(colours.VertexBufferRHI, colours.GetVertexData(), colours.GetStride(), firstVertex, numVertices);
+		}
+
+		for (const TPair<int32, bool>& quad : update.Quads)
+		{
+			int32 firstIndex = quad.Key * NumQuadIndices;
+			int32 quadBytes = NumQuadIndices * sizeof(uint32);
+
+			SetStreakQuadIndices(&IndexBuffer.Indices[firstIndex], quad.Key, MaxJoints, NumJointVertices, quad.Value);
+
+			void* bufferData = RHILockIndexBuffer(IndexBuffer.IndexBufferRHI, firstIndex * sizeof(uint32), quadBytes, RLM_WriteOnly);
+
+			FMemory::Memcpy(bufferData, &IndexBuffer.Indices[firstIndex], quadBytes);
+
+			RHIUnlockIndexBuffer(IndexBuffer.IndexBufferRHI);
+
+			numBytes += quadBytes;
+		}
+
+		UStreakMeshComponent::CountUpload(numBytes);
+	}
+
+	// Set whether the streak is drawn at all.
+	void SetDrawn_RenderThread(bool drawn)
+	{ Drawn = drawn; }
+
+	// Get the mesh elements for rendering the streak in the given views.
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& views, const FSceneViewFamily& viewFamily, uint32 visibilityMap, FMeshElementCollector& collector) const override
+	{
+		if (Drawn == true)
+		{
+			FMaterialRenderProxy* materialProxy = Material->GetRenderProxy();
+
+			for (int32 viewIndex = 0; viewIndex < views.Num(); viewIndex++)
+			{
+				if (visibilityMap & (1 << viewIndex))
+				{
+					FMeshBatch& mesh = collector.AllocateMesh();
+					FMeshBatchElement& element = mesh.Elements[0];
+
+					element.IndexBuffer = &IndexBuffer;
+					element.PrimitiveUniformBuffer = GetUniformBuffer();
+					element.FirstIndex = 0;
+					element.NumPrimitives = IndexBuffer.Indices.Num() / 3;
+					element.MinVertexIndex = 0;
+					element.MaxVertexIndex = VertexBuffers.PositionVertexBuffer.GetNumVertices() - 1;
+
+					mesh.VertexFactory = &VertexFactory;
+					mesh.MaterialRenderProxy = materialProxy;
+					mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+					mesh.Type = PT_TriangleList;
+					mesh.DepthPriorityGroup = SDPG_World;
+					mesh.bCanApplyViewModeOverrides = false;
+
+					collector.AddMesh(viewIndex, mesh);
+				}
+			}
+		}
+	}
+
+	// Get the relevance of the streak to a view.
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* view) const override
+	{
+		FPrimitiveViewRelevance result;
+
+		result.bDrawRelevance = IsShown(view);
+		result.bShadowRelevance = IsShadowCast(view);
+		result.bDynamicRelevance = true;
+		result.bRenderInMainPass = ShouldRenderInMainPass();
+		result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
+		result.bRenderCustomDepth = ShouldRenderCustomDepth();
+
+		MaterialRelevance.SetPrimitiveViewRelevance(result);
+
+		return result;
+	}
+
+	// Can the streak be occluded?
+	virtual bool CanBeOccluded() const override
+	{ return !MaterialRelevance.bDisableDepthTest; }
+
+	// Get the memory footprint of the scene proxy.
+	virtual uint32 GetMemoryFootprint() const override
+	{ return sizeof(*this) + GetAllocatedSize(); }
+
+private:
+
+	// The material to render the streak with.
+	UMaterialInterface* Material = nullptr;
+
+	// The vertex buffers of the streak.
+	FStaticMeshVertexBuffers VertexBuffers;
+
+	// The index buffer of the streak.
+	FDynamicMeshIndexBuffer32 IndexBuffer;
+
+	// The vertex factory of the streak.
+	FLocalVertexFactory VertexFactory;
+
+	// The relevance of the material.
+	FMaterialRelevance MaterialRelevance;
+
+	// The number of joints in the ring buffer.
+	int32 MaxJoints = 0;
+
+	// The number of vertices at each joint.
+	int32 NumJointVertices = 0;
+
+	// The number of indices in the quad between two joints.
+	int32 NumQuadIndices = 0;
+
+	// Is the streak currently being drawn?
+	bool Drawn = true;
+};
+
+#pragma endregion VehicleLightStreaks
+
+/**
+* Construct a streak mesh component.
+***********************************************************************************/
+
+UStreakMeshComponent::UStreakMeshComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	SetGenerateOverlapEvents(false);
+
+	CastShadow = false;
+	bUseAsOccluder = false;
+	Mobility = EComponentMobility::Movable;
+}
+
+#pragma region VehicleLightStreaks
+
+/**
+* Initialize the ring buffer, with every joint collapsed onto a location.
+***********************************************************************************/
+
+void UStreakMeshComponent::Initialize(int32 maxJoints, int32 numJointVertices, float width, const FVector& location)
+{
+	MaxJoints = FMath::Max(maxJoints, 2);
+	NumJointVertices = FMath::Max(numJointVertices, 2);
+	Width = width;
+
+	Vertices.SetNum(MaxJoints * NumJointVertices);
+	Connected.SetNum(MaxJoints);
+
+	Reset(location);
+}
+
+/**
+* Reset the streak, collapsing every joint onto a location.
+*
+* This is rare, normally only when the parent object has teleported, and so the
+* scene proxy is simply recreated with all of the joints.
+***********************************************************************************/
+
+void UStreakMeshComponent::Reset(const FVector& location)
+{
+	FStreakMeshVertex vertex;
+
+	vertex.Position = location;
+
+	for (FStreakMeshVertex& joint : Vertices)
+	{
+		joint = vertex;
+	}
+
+	for (bool& connected : Connected)
+	{
+		connected = false;
+	}
+
+	// The next joint added will be the first in the ring buffer.
+
+	HeadJoint = MaxJoints - 1;
+
+	UpdateStreakBounds();
+	MarkRenderStateDirty();
+}
+
+/**
+* Append a joint to the head of the streak, connecting it to the last head if
+* requested.
+*
+* The quad after the new head joint is collapsed, as that would otherwise connect
+* the head of the streak to its tail, which is the oldest joint in the ring buffer.
+***********************************************************************************/
+
+void UStreakMeshComponent::AddJoint(const FStreakMeshVertex* vertices, bool connect)
+{
+	HeadJoint = (HeadJoint + 1) % MaxJoints;
+
+	FMemory::Memcpy(&Vertices[HeadJoint * NumJointVertices], vertices, NumJointVertices * sizeof(FStreakMeshVertex));
+
+	Connected[HeadJoint] = connect;
+	Connected[(HeadJoint + 1) % MaxJoints] = false;
+
+	SendJoint(HeadJoint, true);
+	UpdateStreakBounds();
+}
+
+/**
+* Replace the joint at the head of the streak.
+***********************************************************************************/
+
+void UStreakMeshComponent::UpdateHeadJoint(const FStreakMeshVertex* vertices)
+{
+	FMemory::Memcpy(&Vertices[HeadJoint * NumJointVertices], vertices, NumJointVertices * sizeof(FStreakMeshVertex));
+
+	SendJoint(HeadJoint, false);
+	UpdateStreakBounds();
+}
+
+/**
+* Set whether the streak is drawn at all, to skip it once it has completely faded.
+***********************************************************************************/
+
+void UStreakMeshComponent::SetDrawn(bool drawn)
+{
+	if (Drawn != drawn)
+	{
+		Drawn = drawn;
+
+		FStreakMeshSceneProxy* proxy = (FStreakMeshSceneProxy*)SceneProxy;
+
+		if (proxy != nullptr)
+		{
+			ENQUEUE_RENDER_COMMAND(SetStreakMeshDrawn)(
+				[proxy, drawn] (FRHICommandListImmediate& commandList)
+				{
+					proxy->SetDrawn_RenderThread(drawn);
+				});
+		}
+	}
+}
+
+/**
+* Send the given joint to the render thread, optionally along with the quads
+* either side of it.
+***********************************************************************************/
+
+void UStreakMeshComponent::SendJoint(int32 joint, bool withQuads)
+{
+	UpdateUploadStats();
+
+	FStreakMeshSceneProxy* proxy = (FStreakMeshSceneProxy*)SceneProxy;
+
+	if (proxy != nullptr)
+	{
+		FStreakMeshUpdate update;
+
+		update.FirstJoint = joint;
+		update.Vertices.Append(&Vertices[joint * NumJointVertices], NumJointVertices);
+
+		if (withQuads == true)
+		{
+			int32 nextJoint = (joint + 1) % MaxJoints;
+
+			update.Quads.Emplace(joint, Connected[joint]);
+			update.Quads.Emplace(nextJoint, Connected[nextJoint]);
+		}
+
+		ENQUEUE_RENDER_COMMAND(UpdateStreakMesh)(
+			[proxy, update] (FRHICommandListImmediate& commandList)
+			{
+				proxy->Update_RenderThread(update);
+			});
+	}
+}
+
+/**
+* Update the bounds of the streak.
+***********************************************************************************/
+
+void UStreakMeshComponent::UpdateStreakBounds()
+{
+	FBox bounds(ForceInit);
+
+	for (const FStreakMeshVertex& vertex : Vertices)
+	{
+		bounds += vertex.Position;
+	}
+
+	bounds = bounds.ExpandBy(Width);
+
+	if (bounds != LocalBounds)
+	{
+		LocalBounds = bounds;
+
+		UpdateBounds();
+		MarkRenderTransformDirty();
+	}
+}
+
+/**
+* Create the scene proxy for rendering the streak.
+***********************************************************************************/
+
+FPrimitiveSceneProxy* UStreakMeshComponent::CreateSceneProxy()
+{
+	return (Vertices.Num() > 0) ? new FStreakMeshSceneProxy(this) : nullptr;
+}
+
+/**
+* Calculate the bounds of the streak.
+***********************************************************************************/
+
+FBoxSphereBounds UStreakMeshComponent::CalcBounds(const FTransform& localToWorld) const
+{
+	return (LocalBounds.IsValid == 0) ? FBoxSphereBounds(localToWorld.GetLocation(), FVector::ZeroVector, 0.0f) : FBoxSphereBounds(LocalBounds.TransformBy(localToWorld));
+}
+
+/**
+* Roll the upload counters over to a new frame if necessary, and log them if
+* requested.
+***********************************************************************************/
+
+void UStreakMeshComponent::UpdateUploadStats()
+{
+	if (UploadFrame != GFrameCounter)
+	{
+		int64 totalBytes = FPlatformAtomics::AtomicRead(&TotalBytesUploaded);
+
+		UploadFrame = GFrameCounter;
+		BytesUploadedLastFrame = totalBytes - TotalBytesAtFrameStart;
+		TotalBytesAtFrameStart = totalBytes;
+		MaxBytesUploadedSinceLog = FMath::Max(MaxBytesUploadedSinceLog, BytesUploadedLastFrame);
+		FramesSinceLog++;
+
+		double time = FPlatformTime::Seconds();
+
+		if (time - LastLogTime >= 1.0)
+		{
+			if (CVarStreakMeshStats.GetValueOnGameThread() != 0)
+			{
+				UE_LOG(GripLog, Log, TEXT("Streak meshes uploaded %lld bytes per frame on average, %lld at most, over %d frames"), (totalBytes - TotalBytesAtLastLog) / FMath::Max(FramesSinceLog, 1), MaxBytesUploadedSinceLog, FramesSinceLog);
+			}
+
+			LastLogTime = time;
+			TotalBytesAtLastLog = totalBytes;
+			MaxBytesUploadedSinceLog = 0;
+			FramesSinceLog = 0;
+		}
+	}
+}
+
+#pragma endregion VehicleLightStreaks
@@ -20,6 +20,7 @@
 
 #include "effects/vehicleimpacteffect.h"
 #include "vehicle/basevehicle.h"
+#include "gamemodes/playgamemode.h"
 
 #pragma region VehicleSurfaceImpacts
 
@@ -35,12 +36,28 @@ void UDrivingSurfaceImpactCharacteristics::SpawnImpact(ABaseVehicle* vehicle, co
 	{
 		// Spawn the visual effect.
 
-		UMovingParticleSystemComponent* component = NewObject<UMovingParticleSystemComponent>(vehicle);
+		APlayGameMode* gameMode = APlayGameMode::Get(vehicle);
+		UMovingParticleSystemComponent* component = nullptr;
+
+		if (gameMode != nullptr)
+		{
+			// The pool reclaims the component once its effect has completed.
+
+			component = gameMode->ObjectPool.AcquireParticleSystem<UMovingParticleSystemComponent>(vehicle, true);
+		}
+		else
+		{
+			component = NewObject<UMovingParticleSystemComponent>(vehicle);
+
+			if (component != nullptr)
+			{
+				component->bAutoDestroy = true;
+			}
+		}
 
 		if (component != nullptr)
 		{
 			component->bAutoActivate = true;
-			component->bAutoDestroy = true;
 			component->Velocity = velocity;
 
 			// Assign the new effect.
@@ -50,13 +67,16 @@ void UDrivingSurfaceImpactCharacteristics::SpawnImpact(ABaseVehicle* vehicle, co
 			component->SetVectorParameter("SurfaceColour", surfaceColor);
 			component->SetVectorParameter("LightColour", lightColor);
 
-			// Don't forget to register the component.
+			// Don't forget to register the component, if it's not been pooled.
 
-			component->RegisterComponent();
+			if (component->IsRegistered() == false)
+			{
+				component->RegisterComponent();
+			}
 
-			// And now activate it.
+			// And now activate it, resetting it in case it's been pooled.
 
-			component->Activate();
+			component->Activate(true);
 		}
 	}
 
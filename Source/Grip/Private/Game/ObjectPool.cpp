@@ -0,0 +1,371 @@
+/**
+*
+* Object pool.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A pool of the actors and particle system components that are otherwise spawned
+* and destroyed over and over again during a game.
+*
+***********************************************************************************/
+
+#include "game/objectpool.h"
+#include "gamemodes/playgamemode.h"
+
+/**
+* Console variable for pooling actors and particle system components.
+***********************************************************************************/
+
+TAutoConsoleVariable<int32> CVarObjectPool(
+	TEXT("grip.ObjectPool"),
+	1,
+	TEXT("Pool the pickup actors and transient particle system components rather than spawning and destroying them.\n")
+	TEXT("  0: Off\n")
+	TEXT("  1: On\n"),
+	ECVF_Default);
+
+/**
+* Is pooling enabled?
+***********************************************************************************/
+
+bool FObjectPool::IsEnabled()
+{
+	return CVarObjectPool.GetValueOnGameThread() != 0;
+}
+
+/**
+* Create a number of actors of a class ahead of time, ready to be acquired from the
+* pool.
+***********************************************************************************/
+
+void FObjectPool::PrewarmActors(UWorld* world, UClass* actorClass, int32 count)
+{
+	if (actorClass != nullptr &&
+		IsEnabled() == true)
+	{
+		FActorSpawnParameters spawnParams;
+
+		spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<TWeakObjectPtr<AActor>>& freeActors = FreeActors.FindOrAdd(actorClass);
+		FPoolStats& stats = Stats.FindOrAdd(actorClass);
+
+		for (int32 i = 0; i < count; i++)
+		{
+			AActor* actor = world->SpawnActor(actorClass, &FVector::ZeroVector, &FRotator::ZeroRotator, spawnParams);
+
+			if (actor != nullptr)
+			{
+				Deactivate(actor);
+
+				PooledActors.Emplace(actor);
+				freeActors.Emplace(actor);
+
+				stats.NumPrewarmed++;
+			}
+		}
+	}
+}
+
+/**
+* Acquire an actor of a class from the pool, spawning a new one if there are none
+* free.
+***********************************************************************************/
+
+AActor* FObjectPool::AcquireActor(UWorld* world, UClass* actorClass, const FVector& location, const FRotator& rotation, const FActorSpawnParameters& spawnParams)
+{
+	if (actorClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (IsEnabled() == false)
+	{
+		return world->SpawnActor(actorClass, &location, &rotation, spawnParams);
+	}
+
+	AActor* actor = nullptr;
+	TArray<TWeakObjectPtr<AActor>>* freeActors = FreeActors.Find(actorClass);
+
+	while (actor == nullptr &&
+		freeActors != nullptr &&
+		freeActors->Num() > 0)
+	{
+		TWeakObjectPtr<AActor> freeActor = freeActors->Pop(false);
+
+		if (GRIP_POINTER_VALID(freeActor) == true)
+		{
+			actor = freeActor.Get();
+		}
+		else
+		{
+			PooledActors.Remove(freeActor);
+		}
+	}
+
+	if (actor != nullptr)
+	{
+		// Bring a free actor back to life where it would have been spawned.
+
+		actor->SetOwner(spawnParams.Owner);
+		actor->SetActorLocationAndRotation(location, rotation, false, nullptr, ETeleportType::TeleportPhysics);
+		actor->SetActorHiddenInGame(false);
+		actor->SetActorEnableCollision(true);
+		actor->SetActorTickEnabled(true);
+
+		RecordAcquisition(actorClass, true);
+	}
+	else
+	{
+		actor = world->SpawnActor(actorClass, &location, &rotation, spawnParams);
+
+		if (actor != nullptr)
+		{
+			PooledActors.Emplace(actor);
+
+			RecordAcquisition(actorClass, false);
+		}
+	}
+
+	return actor;
+}
+
+/**
+* Release an actor back into the pool, it should already have reset its own state.
+***********************************************************************************/
+
+void FObjectPool::ReleaseActor(AActor* actor)
+{
+	if (PooledActors.Contains(actor) == true)
+	{
+		Deactivate(actor);
+
+		FreeActors.FindOrAdd(actor->GetClass()).Emplace(actor);
+
+		FPoolStats& stats = Stats.FindOrAdd(actor->GetClass());
+
+		stats.NumInUse = FMath::Max(0, stats.NumInUse - 1);
+	}
+}
+
+/**
+* Acquire a particle system component for an owner from the pool, creating a new
+* one if there are none free. A transient component is reclaimed automatically
+* once its effect has completed, otherwise it must be released.
+***********************************************************************************/
+
+UParticleSystemComponent* FObjectPool::AcquireParticleSystem(AActor* owner, UClass* componentClass, bool transient)
+{
+	UParticleSystemComponent* component = nullptr;
+
+	if (IsEnabled() == false)
+	{
+		// Without pooling, a transient component just destroys itself once its
+		// effect has completed.
+
+		component = NewObject<UParticleSystemComponent>(owner, componentClass);
+		component->bAutoDestroy = transient;
+
+		return component;
+	}
+
+	TArray<TWeakObjectPtr<UParticleSystemComponent>>* freeComponents = FreeParticleSystems.Find(FParticleSystemKey(owner, componentClass));
+
+	while (component == nullptr &&
+		freeComponents != nullptr &&
+		freeComponents->Num() > 0)
+	{
+		TWeakObjectPtr<UParticleSystemComponent> freeComponent = freeComponents->Pop(false);
+
+		if (GRIP_POINTER_VALID(freeComponent) == true)
+		{
+			component = freeComponent.Get();
+		}
+		else
+		{
+			PooledParticleSystems.Remove(freeComponent);
+		}
+	}
+
+	if (component != nullptr)
+	{
+		RecordAcquisition(componentClass, true);
+	}
+	else
+	{
+		component = NewObject<UParticleSystemComponent>(owner, componentClass);
+
+		PooledParticleSystems.Emplace(component);
+
+		RecordAcquisition(componentClass, false);
+	}
+
+	// The pool is responsible for the lifetime of the component now, so it must never
+	// destroy itself.
+
+	component->bAutoDestroy = false;
+
+	if (transient == true)
+	{
+		ReleasedParticleSystems.Emplace(component);
+	}
+
+	return component;
+}
+
+/**
+* Release a particle system component to be reclaimed once its effect has
+* completed, returning false if it doesn't belong to the pool.
+***********************************************************************************/
+
+bool FObjectPool::ReleaseParticleSystem(UParticleSystemComponent* component)
+{
+	if (PooledParticleSystems.Contains(component) == false)
+	{
+		return false;
+	}
+
+	ReleasedParticleSystems.AddUnique(component);
+
+	return true;
+}
+
+/**
+* Reclaim the particle system components whose effects have completed, called once
+* per frame.
+***********************************************************************************/
+
+void FObjectPool::Tick()
+{
+	for (int32 i = ReleasedParticleSystems.Num() - 1; i >= 0; i--)
+	{
+		TWeakObjectPtr<UParticleSystemComponent> component = ReleasedParticleSystems[i];
+
+		if (GRIP_POINTER_VALID(component) == false)
+		{
+			// The component has been destroyed by its owner, so just forget about it.
+
+			ReleasedParticleSystems.RemoveAtSwap(i, 1, false);
+			PooledParticleSystems.Remove(component);
+		}
+		else if (component->bWasCompleted == true)
+		{
+			ReleasedParticleSystems.RemoveAtSwap(i, 1, false);
+
+			ReclaimParticleSystem(component.Get());
+		}
+	}
+}
+
+/**
+* Log the statistics for each pooled class.
+***********************************************************************************/
+
+void FObjectPool::LogStats() const
+{
+	UE_LOG(GripLog, Display, TEXT("Object pool %s, %d actors and %d particle system components pooled"), (IsEnabled() == true) ? TEXT("enabled") : TEXT("disabled"), PooledActors.Num(), PooledParticleSystems.Num());
+
+	for (const TPair<TWeakObjectPtr<UClass>, FPoolStats>& stats : Stats)
+	{
+		int32 numAcquired = stats.Value.NumHits + stats.Value.NumMisses;
+		FString className = (GRIP_POINTER_VALID(stats.Key) == true) ? stats.Key->GetName() : FString(TEXT("Unloaded class"));
+
+		UE_LOG(GripLog, Display, TEXT("  %s: %d prewarmed, %d hits, %d misses (%0.1f%% hit rate), %d in use, %d peak"), *className, stats.Value.NumPrewarmed, stats.Value.NumHits, stats.Value.NumMisses, (numAcquired > 0) ? stats.Value.NumHits * 100.0f / numAcquired : 0.0f, stats.Value.NumInUse, stats.Value.PeakInUse);
+	}
+}
+
+/**
+* Clear the pool.
+***********************************************************************************/
+
+void FObjectPool::Reset()
+{
+	FreeActors.Empty();
+	PooledActors.Empty();
+	FreeParticleSystems.Empty();
+	PooledParticleSystems.Empty();
+	ReleasedParticleSystems.Empty();
+	Stats.Empty();
+}
+
+/**
+* Record the acquisition of an object from the pool.
+***********************************************************************************/
+
+void FObjectPool::RecordAcquisition(UClass* objectClass, bool hit)
+{
+	FPoolStats& stats = Stats.FindOrAdd(objectClass);
+
+	if (hit == true)
+	{
+		stats.NumHits++;
+	}
+	else
+	{
+		stats.NumMisses++;
+	}
+
+	stats.NumInUse++;
+	stats.PeakInUse = FMath::Max(stats.PeakInUse, stats.NumInUse);
+}
+
+/**
+* Reclaim a particle system component that's completed its effect, ready for reuse.
+***********************************************************************************/
+
+void FObjectPool::ReclaimParticleSystem(UParticleSystemComponent* component)
+{
+	// Return the component to the state it was in when it was first created, so that
+	// nothing leaks through to its next use.
+
+	GRIP_DETACH(component);
+
+	component->SetRelativeTransform(FTransform::Identity);
+	component->SetOwnerNoSee(false);
+	component->InstanceParameters.Reset();
+
+	FreeParticleSystems.FindOrAdd(FParticleSystemKey(component->GetOwner(), component->GetClass())).Emplace(component);
+
+	FPoolStats& stats = Stats.FindOrAdd(component->GetClass());
+
+	stats.NumInUse = FMath::Max(0, stats.NumInUse - 1);
+}
+
+/**
+* Hide an actor and stop it from ticking or colliding while it's in the pool.
+***********************************************************************************/
+
+void FObjectPool::Deactivate(AActor* actor)
+{
+	actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	actor->SetActorHiddenInGame(true);
+	actor->SetActorEnableCollision(false);
+	actor->SetActorTickEnabled(false);
+	actor->SetOwner(nullptr);
+}
+
+#if !UE_BUILD_SHIPPING
+
+/**
+* Log the statistics of the object pool for the game being played.
+***********************************************************************************/
+
+static void LogObjectPoolStats(const TArray<FString>& args, UWorld* world)
+{
+	APlayGameMode* gameMode = APlayGameMode::Get(world);
+
+	if (gameMode != nullptr)
+	{
+		gameMode->ObjectPool.LogStats();
+	}
+}
+
+static FAutoConsoleCommand ObjectPoolStatsCommand(
+	TEXT("grip.ObjectPoolStats"),
+	TEXT("Log the hits, misses and peak usage of each class in the object pool for the game being played."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&LogObjectPoolStats));
+
+#endif // !UE_BUILD_SHIPPING
@@ -396,7 +396,7 @@ void FPlayerRaceState::PlayerComplete(bool setCompletionStatus, bool gameComplet
 			{
 				int32 index = (gameMode->GetNumOpponents() - RacePosition) + 1;
 
-				RaceTime = (index * GRIP_ELIMINATION_SECONDS) + FMath::FRandRange(-0.2f, 0.2f);
+				RaceTime = (index * GRIP_ELIMINATION_SECONDS) + APlayGameMode::SimulationRandom.FRandRange(-0.2f, 0.2f);
 			}
 		}
 	}
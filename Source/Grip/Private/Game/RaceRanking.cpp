@@ -0,0 +1,152 @@
+/**
+*
+* Race ranking.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Incrementally maintained orderings of the players in a race, by race distance
+* for race positions and by eternal race distance for catchup.
+*
+***********************************************************************************/
+
+#include "game/raceranking.h"
+#include "game/playerracestate.h"
+#include "vehicle/basevehicle.h"
+
+/**
+* Bring an ordering up to date with the players that should be in it, keeping the
+* existing order where possible.
+*
+* Players that should no longer be in the ordering are removed from it and those
+* that are new to it are appended to the end, in the order of the vehicles, ready
+* for the insertion sort to move them into place.
+***********************************************************************************/
+
+template <typename Predicate>
+void FRaceRanking::UpdateMembership(FRaceStates& order, const TArray<ABaseVehicle*>& vehicles, Predicate include)
+{
+	order.RemoveAll([&include] (FPlayerRaceState* raceState)
+		{
+			return include(*raceState) == false;
+		});
+
+	int32 numIncluded = 0;
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		if (include(vehicle->GetRaceState()) == true)
+		{
+			numIncluded++;
+		}
+	}
+
+	if (numIncluded != order.Num())
+	{
+		// Only search for the new players when we know there are some, which is rare.
+
+		for (ABaseVehicle* vehicle : vehicles)
+		{
+			FPlayerRaceState* raceState = &vehicle->GetRaceState();
+
+			if (include(*raceState) == true &&
+				order.Contains(raceState) == false)
+			{
+				order.Emplace(raceState);
+			}
+		}
+	}
+}
+
+/**
+* Order the incomplete players by race distance, returning the overtakes made since
+* the last frame.
+*
+* The insertion sort is stable and the ordering is total, breaking ties on the
+* vehicle index, so the result is identical to a full stable sort.
+***********************************************************************************/
+
+const FRaceRanking::FRaceStates& FRaceRanking::UpdateRaceOrder(const TArray<ABaseVehicle*>& vehicles, FOvertakes& overtakes)
+{
+	UpdateMembership(RaceOrder, vehicles, [] (const FPlayerRaceState& raceState)
+		{
+			return raceState.PlayerCompletionState < EPlayerCompletionState::Complete;
+		});
+
+	auto ahead = [] (const FPlayerRaceState* object1, const FPlayerRaceState* object2)
+	{
+		if (object1->RaceDistance == object2->RaceDistance) return object1->PlayerVehicle->VehicleIndex < object2->PlayerVehicle->VehicleIndex; else return object1->RaceDistance > object2->RaceDistance;
+	};
+
+	for (int32 i = 1; i < RaceOrder.Num(); i++)
+	{
+		FPlayerRaceState* raceState = RaceOrder[i];
+		int32 j = i;
+
+		for (; j > 0 && ahead(raceState, RaceOrder[j - 1]) == true; j--)
+		{
+			// Each player we move ahead of is a player that has been overtaken.
+
+			overtakes.Emplace(raceState, RaceOrder[j - 1]);
+
+			RaceOrder[j] = RaceOrder[j - 1];
+		}
+
+		RaceOrder[j] = raceState;
+	}
+
+	return RaceOrder;
+}
+
+/**
+* Order all of the players by eternal race distance, caching the median, minimum
+* and maximum distances.
+***********************************************************************************/
+
+const FRaceRanking::FRaceStates& FRaceRanking::UpdateEternalOrder(const TArray<ABaseVehicle*>& vehicles)
+{
+	UpdateMembership(EternalOrder, vehicles, [] (const FPlayerRaceState& raceState)
+		{
+			return true;
+		});
+
+	for (int32 i = 1; i < EternalOrder.Num(); i++)
+	{
+		FPlayerRaceState* raceState = EternalOrder[i];
+		int32 j = i;
+
+		for (; j > 0 && raceState->EternalRaceDistance > EternalOrder[j - 1]->EternalRaceDistance; j--)
+		{
+			EternalOrder[j] = EternalOrder[j - 1];
+		}
+
+		EternalOrder[j] = raceState;
+	}
+
+	if (EternalOrder.Num() > 0)
+	{
+		MedianEternalDistance = EternalOrder[EternalOrder.Num() >> 1]->EternalRaceDistance;
+		MaxEternalDistance = EternalOrder[0]->EternalRaceDistance;
+		MinEternalDistance = EternalOrder.Last()->EternalRaceDistance;
+	}
+	else
+	{
+		MedianEternalDistance = MinEternalDistance = MaxEternalDistance = 0.0f;
+	}
+
+	return EternalOrder;
+}
+
+/**
+* Clear the rankings.
+***********************************************************************************/
+
+void FRaceRanking::Reset()
+{
+	RaceOrder.Reset();
+	EternalOrder.Reset();
+
+	MedianEternalDistance = MinEternalDistance = MaxEternalDistance = 0.0f;
+}
@@ -0,0 +1,156 @@
+/**
+*
+* Targeting service.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Shared per-frame vehicle targeting data, for selecting the targets of pickups.
+*
+***********************************************************************************/
+
+#include "game/targetingservice.h"
+#include "vehicle/basevehicle.h"
+#include "gamemodes/basegamemode.h"
+
+/**
+* Refresh the distances between the vehicles if they've not already been refreshed
+* this frame.
+***********************************************************************************/
+
+void FTargetingService::Refresh(const TArray<ABaseVehicle*>& vehicles)
+{
+	if (RefreshFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	RefreshFrame = GFrameCounter;
+
+	NumSightQueriesLastFrame = NumSightQueries;
+	NumSightTracesLastFrame = NumSightTraces;
+	NumSightQueries = 0;
+	NumSightTraces = 0;
+
+	int32 numVehicles = vehicles.Num();
+
+	if (NumVehicles != numVehicles)
+	{
+		NumVehicles = numVehicles;
+
+		Pairs.Reset();
+		Pairs.SetNum(numVehicles * numVehicles);
+	}
+
+	// Gather the bulls-eyes first, as they're not free to compute.
+
+	TArray<FVector, TInlineAllocator<GRIP_MAX_PLAYERS>> bullsEyes;
+
+	bullsEyes.SetNumZeroed(numVehicles);
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		if (vehicle->VehicleIndex >= 0 &&
+			vehicle->VehicleIndex < numVehicles)
+		{
+			bullsEyes[vehicle->VehicleIndex] = vehicle->GetTargetBullsEye();
+		}
+	}
+
+	for (int32 i = 0; i < numVehicles; i++)
+	{
+		for (int32 j = i + 1; j < numVehicles; j++)
+		{
+			float distance = (bullsEyes[j] - bullsEyes[i]).Size();
+
+			Pairs[i * numVehicles + j].Distance = distance;
+			Pairs[j * numVehicles + i].Distance = distance;
+		}
+	}
+}
+
+/**
+* Is a vehicle beyond a distance from another vehicle, between their bulls-eyes,
+* this frame?
+***********************************************************************************/
+
+bool FTargetingService::IsBeyond(const ABaseVehicle* from, const ABaseVehicle* to, float distance) const
+{
+	const FTargetingPair* pair = GetPair(from, to);
+
+	return (pair != nullptr && RefreshFrame == GFrameCounter && pair->Distance > distance);
+}
+
+/**
+* Is there a line of sight between two vehicles, cached for a few frames?
+*
+* The trace ignores both of the vehicles, so that only the scenery can block the
+* line of sight.
+***********************************************************************************/
+
+bool FTargetingService::HasLineOfSight(ETargetingSightLine sightLine, ABaseVehicle* from, ABaseVehicle* to, const FVector& fromLocation, const FVector& toLocation)
+{
+	NumSightQueries++;
+
+	FTargetingPair* pair = GetPair(from, to);
+	int32 index = (int32)sightLine;
+
+	if (pair != nullptr &&
+		pair->SightFrame[index] != 0 &&
+		GFrameCounter - pair->SightFrame[index] < SightLineFrames)
+	{
+		return pair->Sight[index];
+	}
+
+	NumSightTraces++;
+
+	FHitResult hitResult;
+	FCollisionQueryParams queryParams((sightLine == ETargetingSightLine::GunVisibility) ? TEXT("GunVisibilityTest") : TEXT("TargetSelection"), sightLine == ETargetingSightLine::GunVisibility, from);
+
+	queryParams.AddIgnoredActor(to);
+
+	bool sight = (from->GetWorld()->LineTraceSingleByChannel(hitResult, fromLocation, toLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false);
+
+	if (pair != nullptr)
+	{
+		// Frame 0 is reserved for never having been traced.
+
+		pair->SightFrame[index] = FMath::Max<uint64>(GFrameCounter, 1);
+		pair->Sight[index] = sight;
+	}
+
+	return sight;
+}
+
+/**
+* Clear the service, normally when the vehicles change.
+***********************************************************************************/
+
+void FTargetingService::Reset()
+{
+	Pairs.Reset();
+
+	NumVehicles = 0;
+	RefreshFrame = 0;
+}
+
+/**
+* Get the pair of vehicles, if the vehicles are known to the service.
+***********************************************************************************/
+
+FTargetingService::FTargetingPair* FTargetingService::GetPair(const ABaseVehicle* from, const ABaseVehicle* to)
+{
+	if (from != nullptr &&
+		to != nullptr &&
+		from->VehicleIndex >= 0 &&
+		from->VehicleIndex < NumVehicles &&
+		to->VehicleIndex >= 0 &&
+		to->VehicleIndex < NumVehicles)
+	{
+		return &Pairs[from->VehicleIndex * NumVehicles + to->VehicleIndex];
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,345 @@
+/**
+*
+* Vehicle significance.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Rank the vehicles each frame by how significant they are to the local cameras,
+* and assign each a tier that throttles or suspends its cosmetic work.
+*
+***********************************************************************************/
+
+#include "game/vehiclesignificance.h"
+#include "vehicle/basevehicle.h"
+
+/**
+* Console variable for vehicle significance.
+***********************************************************************************/
+
+TAutoConsoleVariable<int32> CVarVehicleSignificance(
+	TEXT("grip.VehicleSignificance"),
+	1,
+	TEXT("Throttle the cosmetic work of vehicles according to their significance to the local cameras.\n")
+	TEXT("  0: Off, update all vehicles in full\n")
+	TEXT("  1: On\n"),
+	ECVF_Default);
+
+// The distance within which a vehicle in view is updated in full, in centimeters.
+static const float SignificanceFullDistance = 50.0f * 100.0f;
+
+// The distance within which a vehicle in view is updated at a reduced rate, in centimeters.
+static const float SignificanceReducedDistance = 150.0f * 100.0f;
+
+// The distance within which a vehicle out of view is still updated, as it can quickly come
+// into view from just behind a camera, in centimeters.
+static const float SignificanceNearDistance = 30.0f * 100.0f;
+
+// The distance at which a vehicle's significance has fallen to nothing, in centimeters.
+static const float SignificanceFarDistance = 500.0f * 100.0f;
+
+// The radius around a vehicle used to determine whether it's in view, in centimeters.
+static const float SignificanceVehicleRadius = 5.0f * 100.0f;
+
+// The maximum number of vehicles that aren't being watched to be updated in full.
+static const int32 SignificanceMaxFullVehicles = 4;
+
+/**
+* Is vehicle significance enabled?
+***********************************************************************************/
+
+bool FVehicleSignificance::IsEnabled()
+{
+	return CVarVehicleSignificance.GetValueOnGameThread() != 0;
+}
+
+/**
+* Rank the vehicles against the local camera views and assign their tiers for the
+* next frame.
+*
+* This is called at the end of the frame, once all of the vehicles have ticked, so
+* it also rolls up the costs of the cosmetic work done during the frame.
+***********************************************************************************/
+
+void FVehicleSignificance::Update(const TArray<ABaseVehicle*>& vehicles, TArrayView<const FVehicleSignificanceView> views, const TArray<ABaseVehicle*>& watchedVehicles)
+{
+	// Roll up the costs of the frame just completed.
+
+	float spentCycles = 0.0f;
+	float savedCycles = 0.0f;
+
+	for (FVehicleState& state : Vehicles)
+	{
+		spentCycles += state.Visual.Cycles + state.Audio.Cycles;
+		savedCycles += state.Visual.UpdateCost() + state.Audio.UpdateCost();
+	}
+
+	float millisecondsPerCycle = FPlatformTime::GetSecondsPerCycle() * 1000.0f;
+
+	SpentTime = FMath::Lerp(spentCycles * millisecondsPerCycle, SpentTime, 0.95f);
+	SavedTime = FMath::Lerp(savedCycles * millisecondsPerCycle, SavedTime, 0.95f);
+
+	// Now rank the vehicles against the views.
+
+	bool enabled = (IsEnabled() == true && views.Num() > 0);
+	TArray<ABaseVehicle*, TInlineAllocator<GRIP_MAX_PLAYERS>> rankedVehicles;
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		if (vehicle->VehicleIndex < 0 ||
+			vehicle->VehicleIndex >= GRIP_MAX_PLAYERS)
+		{
+			continue;
+		}
+
+		FVehicleState& state = Vehicles[vehicle->VehicleIndex];
+
+		state.Tier = EVehicleSignificanceTier::Full;
+		state.Significance = 1.0f;
+		state.Distance = 0.0f;
+		state.Visible = true;
+
+		if (enabled == false ||
+			vehicle->LocalPlayerIndex >= 0 ||
+			watchedVehicles.Contains(vehicle) == true)
+		{
+			// Local players and the vehicles being watched are always updated in full.
+
+			continue;
+		}
+
+		// Find the nearest view and whether the vehicle is in any of them, a cone test
+		// against the field of view that's generous for the vertical field of view.
+
+		FVector location = vehicle->GetActorLocation();
+
+		state.Distance = BIG_NUMBER;
+		state.Visible = vehicle->WasRecentlyRendered(0.25f);
+
+		for (const FVehicleSignificanceView& view : views)
+		{
+			FVector difference = location - view.Location;
+			float distance = difference.Size();
+
+			state.Distance = FMath::Min(state.Distance, distance);
+
+			if (state.Visible == false)
+			{
+				if (distance < SignificanceVehicleRadius)
+				{
+					state.Visible = true;
+				}
+				else
+				{
+					float halfAngle = FMath::DegreesToRadians(view.FOV * 0.5f) + FMath::Asin(SignificanceVehicleRadius / distance);
+
+					state.Visible = (halfAngle >= PI || FVector::DotProduct(difference / distance, view.Direction) >= FMath::Cos(halfAngle));
+				}
+			}
+		}
+
+		state.Significance = FMathEx::GetInverseRatio(state.Distance, 0.0f, SignificanceFarDistance);
+
+		if (state.Visible == true)
+		{
+			if (state.Distance < SignificanceFullDistance)
+			{
+				state.Tier = EVehicleSignificanceTier::Full;
+			}
+			else if (state.Distance < SignificanceReducedDistance)
+			{
+				state.Tier = EVehicleSignificanceTier::Reduced;
+			}
+			else
+			{
+				state.Tier = EVehicleSignificanceTier::Minimal;
+			}
+		}
+		else
+		{
+			state.Significance *= 0.25f;
+			state.Tier = (state.Distance < SignificanceNearDistance) ? EVehicleSignificanceTier::Minimal : EVehicleSignificanceTier::Dormant;
+		}
+
+		if (state.Tier == EVehicleSignificanceTier::Full)
+		{
+			rankedVehicles.Emplace(vehicle);
+		}
+	}
+
+	// Limit the number of vehicles that aren't being watched that are updated in full
+	// to the most significant of them.
+
+	if (rankedVehicles.Num() > SignificanceMaxFullVehicles)
+	{
+		rankedVehicles.Sort([this] (const ABaseVehicle& object1, const ABaseVehicle& object2)
+			{
+				return Vehicles[object1.VehicleIndex].Significance > Vehicles[object2.VehicleIndex].Significance;
+			});
+
+		for (int32 i = SignificanceMaxFullVehicles; i < rankedVehicles.Num(); i++)
+		{
+			Vehicles[rankedVehicles[i]->VehicleIndex].Tier = EVehicleSignificanceTier::Reduced;
+		}
+	}
+
+	for (int32& numVehicles : NumVehicles)
+	{
+		numVehicles = 0;
+	}
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		if (vehicle->VehicleIndex >= 0 &&
+			vehicle->VehicleIndex < GRIP_MAX_PLAYERS)
+		{
+			NumVehicles[(int32)Vehicles[vehicle->VehicleIndex].Tier]++;
+		}
+	}
+
+	FrameNumber++;
+}
+
+/**
+* Clear the significance of all vehicles.
+***********************************************************************************/
+
+void FVehicleSignificance::Reset()
+{
+	for (FVehicleState& state : Vehicles)
+	{
+		state = FVehicleState();
+	}
+
+	for (int32& numVehicles : NumVehicles)
+	{
+		numVehicles = 0;
+	}
+
+	SpentTime = 0.0f;
+	SavedTime = 0.0f;
+	FrameNumber = 0;
+}
+
+/**
+* Get the name of a tier.
+***********************************************************************************/
+
+const TCHAR* FVehicleSignificance::GetTierName(EVehicleSignificanceTier tier)
+{
+	switch (tier)
+	{
+	case EVehicleSignificanceTier::Full:
+		return TEXT("Full");
+	case EVehicleSignificanceTier::Reduced:
+		return TEXT("Reduced");
+	case EVehicleSignificanceTier::Minimal:
+		return TEXT("Minimal");
+	case EVehicleSignificanceTier::Dormant:
+		return TEXT("Dormant");
+	default:
+		return TEXT("Unknown");
+	}
+}
+
+/**
+* Get the number of frames between visual updates for a tier, or 0 if suspended.
+***********************************************************************************/
+
+int32 FVehicleSignificance::GetVisualInterval(EVehicleSignificanceTier tier)
+{
+	switch (tier)
+	{
+	case EVehicleSignificanceTier::Reduced:
+		return 2;
+	case EVehicleSignificanceTier::Minimal:
+		return 4;
+	case EVehicleSignificanceTier::Dormant:
+		return 0;
+	default:
+		return 1;
+	}
+}
+
+/**
+* Get the number of frames between audio updates for a tier.
+*
+* Audio is never suspended, as vehicles can be heard when they can't be seen.
+***********************************************************************************/
+
+int32 FVehicleSignificance::GetAudioInterval(EVehicleSignificanceTier tier)
+{
+	switch (tier)
+	{
+	case EVehicleSignificanceTier::Reduced:
+		return 2;
+	case EVehicleSignificanceTier::Minimal:
+		return 4;
+	case EVehicleSignificanceTier::Dormant:
+		return 8;
+	default:
+		return 1;
+	}
+}
+
+/**
+* Advance a channel by a frame, returning the time to update it by or 0 if it's to
+* be skipped. The phase staggers the updates of different vehicles across frames.
+***********************************************************************************/
+
+float FVehicleSignificance::FChannel::Advance(float deltaSeconds, int32 interval, uint32 phase)
+{
+	if (interval == 0)
+	{
+		// The channel is suspended, so don't accumulate any time either as we don't
+		// want a large step when it's resumed.
+
+		Time = 0.0f;
+		Skipped = true;
+
+		return 0.0f;
+	}
+
+	Time += deltaSeconds;
+
+	if (interval > 1 &&
+		(phase % interval) != 0)
+	{
+		Skipped = true;
+
+		return 0.0f;
+	}
+
+	float time = Time;
+
+	Time = 0.0f;
+	Skipped = false;
+
+	return time;
+}
+
+/**
+* Update the cost of a channel at the end of a frame, returning the estimated CPU
+* cycles saved.
+***********************************************************************************/
+
+float FVehicleSignificance::FChannel::UpdateCost()
+{
+	float saved = 0.0f;
+
+	if (Skipped == true)
+	{
+		saved = AverageCycles;
+	}
+	else if (Cycles > 0)
+	{
+		AverageCycles = (AverageCycles == 0.0f) ? (float)Cycles : FMath::Lerp((float)Cycles, AverageCycles, 0.9f);
+	}
+
+	Cycles = 0;
+	Skipped = false;
+
+	return saved;
+}
@@ -14,6 +14,7 @@
 
 #include "gamemodes/playgamemode.h"
 #include "ai/pursuitsplineactor.h"
+#include "ai/navigationcache.h"
 #include "vehicle/basevehicle.h"
 #include "game/globalgamestate.h"
 #include "system/worldfilter.h"
@@ -26,6 +27,7 @@
 #include "components/image.h"
 #include "camera/statictrackcamera.h"
 #include "ui/hudwidget.h"
+#include "async/parallelfor.h"
 
 /**
 * APlayGameMode statics.
@@ -34,6 +36,9 @@
 // The type of widget to use for the single screen UI.
 TSubclassOf<USingleHUDWidget> APlayGameMode::SingleScreenWidgetClass = nullptr;
 
+// The random number stream for everything that affects the simulation of a race.
+FRandomStream APlayGameMode::SimulationRandom;
+
 /**
 * Construct a play game mode.
 ***********************************************************************************/
@@ -61,6 +66,8 @@ APlayGameMode::APlayGameMode()
 
 	FMath::RandInit((int32)FDateTime::Now().ToUnixTimestamp() + (uint64)(this));
 
+	SimulationRandom.Initialize(FMath::Rand());
+
 #pragma region VehiclePickups
 
 	while (NumPickupTypes.Num() < (int32)EPickupType::Num)
@@ -231,12 +238,46 @@ void APlayGameMode::BeginPlay()
 
 	Super::BeginPlay();
 
+#if GRIP_RACE_SIMULATION
+
+	// Start a headless race simulation if one was requested from the command line.
+
+	if (FRaceSimulation::IsRequested() == true)
+	{
+		FRaceSimulation::Get().Start(this);
+	}
+
+#endif // GRIP_RACE_SIMULATION
+
+#if GRIP_RACE_REPLAY
+
+	// Start recording or playing back a race replay if one was requested from the command line.
+
+	if (FRaceReplay::IsRequested() == true)
+	{
+		FRaceReplay::Get().Start(this);
+	}
+
+#endif // GRIP_RACE_REPLAY
+
+#if GRIP_FRAME_PROFILER
+
+	// Start capturing a frame profile for the whole level if one was requested from the command line.
+
+	if (FFrameProfiler::IsRequested() == true)
+	{
+		FFrameProfiler::Get().Start(GetWorld()->GetMapName(), FParse::Param(FCommandLine::Get(), TEXT("GripFrameProfilerTrace")));
+	}
+
+#endif // GRIP_FRAME_PROFILER
+
 	// Create a new single screen widget and add it to the viewport. This is what will
 	// contain all of the HUDs for each player - there is more than one in split-screen
 	// games. It ordinarily contains the pause menu and other full-screen elements too,
 	// but are missing from this stripped implementation.
 
-	if (SingleScreenWidgetClass != nullptr)
+	if (SingleScreenWidgetClass != nullptr &&
+		IsSimulatingRace() == false)
 	{
 		SingleScreenWidget = NewObject<USingleHUDWidget>(this, SingleScreenWidgetClass);
 
@@ -337,7 +378,17 @@ void APlayGameMode::BeginPlay()
 	// to work with, especially regarding race distance.
 
 	BuildPursuitSplines(false, FName(*GlobalGameState->TransientGameState.NavigationLayer), world, GlobalGameState, MasterRacingSpline.Get());
-	EstablishPursuitSplineLinks(false, FName(*GlobalGameState->TransientGameState.NavigationLayer), world, GlobalGameState, MasterRacingSpline.Get());
+	EstablishPursuitSplineLinks(false, FName(*GlobalGameState->TransientGameState.NavigationLayer), world, GlobalGameState, MasterRacingSpline.Get(), false);
+
+#if !WITH_EDITOR
+	// Now the splines are set up, only their packed extended point data is queried, so
+	// release the rest of it. The Editor keeps it for rebuilding the navigation cache.
+
+	for (TActorIterator<APursuitSplineActor> actorItr(world); actorItr; ++actorItr)
+	{
+		actorItr->ReleasePointExtendedData();
+	}
+#endif // !WITH_EDITOR
 
 #pragma region VehicleRaceDistance
 
@@ -382,6 +433,13 @@ void APlayGameMode::BeginPlay()
 	int32 index = 0;
 
 	Vehicles.Empty();
+	RaceRanking.Reset();
+	Targeting.Reset();
+	CameraClipIndex.Reset();
+	PadProximityIndex.Reset();
+	AttractableIndex.Reset();
+	TrackCameraIndex.Reset();
+	VehicleSignificance.Reset();
 
 	// Setup all the vehicles that have already been created in the menu UI
 	// (all local players normally).
@@ -478,9 +536,15 @@ void APlayGameMode::BeginPlay()
 		{
 			if (vehicle->Antigravity == false)
 			{
-				vehicle->GetAI().WillRevOnStartLine = FMath::FRand() <= 0.5f;
+				vehicle->GetAI().WillRevOnStartLine = SimulationRandom.FRand() <= 0.5f;
 			}
 		}
+		else if (IsSimulatingRace() == true)
+		{
+			// Hand the human players over to AI drivers when simulating a race.
+
+			vehicle->SetAIDriver(true);
+		}
 	}
 
 #pragma endregion AIVehicleControl
@@ -541,6 +605,12 @@ void APlayGameMode::BeginPlay()
 
 #pragma endregion CameraCinematics
 
+	// Create the pickups ahead of time so that using them doesn't hitch the game.
+
+	ObjectPool.Reset();
+
+	ABaseVehicle::PrewarmPickups(world, ObjectPool, ObjectPoolPrewarmCount);
+
 	LastOptionsResetTime = GetClock();
 }
 
@@ -552,6 +622,18 @@ void APlayGameMode::EndPlay(const EEndPlayReason::Type endPlayReason)
 {
 	UE_LOG(GripLog, Log, TEXT("APlayGameMode::EndPlay"));
 
+#if GRIP_RACE_SIMULATION
+	FRaceSimulation::Get().Stop();
+#endif // GRIP_RACE_SIMULATION
+
+#if GRIP_RACE_REPLAY
+	FRaceReplay::Get().Stop();
+#endif // GRIP_RACE_REPLAY
+
+#if GRIP_FRAME_PROFILER
+	FFrameProfiler::Get().Stop();
+#endif // GRIP_FRAME_PROFILER
+
 	if (SingleScreenWidget != nullptr)
 	{
 		SingleScreenWidget->RemoveFromViewport();
@@ -562,6 +644,17 @@ void APlayGameMode::EndPlay(const EEndPlayReason::Type endPlayReason)
 
 	ChangeTimeDilation(1.0f, 0.0f);
 
+	PursuitSplineIndex.Clear();
+	GunRounds.Reset();
+	ObjectPool.Reset();
+	AttractableIndex.Reset();
+	TrackCameraIndex.Reset();
+	VehicleSignificance.Reset();
+
+#if GRIP_NAVIGATION_CACHE
+	FNavigationCache::Get().Close();
+#endif // GRIP_NAVIGATION_CACHE
+
 	Super::EndPlay(endPlayReason);
 }
 
@@ -572,6 +665,10 @@ void APlayGameMode::EndPlay(const EEndPlayReason::Type endPlayReason)
 void APlayGameMode::DetermineVehicles()
 {
 	Vehicles.Empty();
+	RaceRanking.Reset();
+	Targeting.Reset();
+	CameraClipIndex.Reset();
+	PadProximityIndex.Reset();
 
 	for (TActorIterator<ABaseVehicle> actorItr(GetWorld()); actorItr; ++actorItr)
 	{
@@ -679,6 +776,16 @@ void APlayGameMode::BuildPursuitSplines(bool check, const FName& navigationLayer
 		}
 	}
 
+	// Build the spatial index used to find the nearest pursuit spline to a location.
+
+	APlayGameMode* gameMode = APlayGameMode::Get(world);
+
+	if (check == false &&
+		gameMode != nullptr)
+	{
+		gameMode->PursuitSplineIndex.Build(gameMode->GetPursuitSplines());
+	}
+
 #pragma endregion NavigationSplines
 
 }
@@ -687,7 +794,7 @@ void APlayGameMode::BuildPursuitSplines(bool check, const FName& navigationLayer
 * Establish all of the links between pursuit splines.
 ***********************************************************************************/
 
-void APlayGameMode::EstablishPursuitSplineLinks(bool check, const FName& navigationLayer, UWorld* world, UGlobalGameState* gameState, UPursuitSplineComponent* masterRacingSpline)
+void APlayGameMode::EstablishPursuitSplineLinks(bool check, const FName& navigationLayer, UWorld* world, UGlobalGameState* gameState, UPursuitSplineComponent* masterRacingSpline, bool saveLinks)
 {
 
 #pragma region NavigationSplines
@@ -731,23 +838,155 @@ void APlayGameMode::EstablishPursuitSplineLinks(bool check, const FName& navigat
 			return object1.GetName() < object2.GetName();
 		});
 
-	// Now go through every spline in the world and establish their links.
+	// Now go through every spline in the world and establish their links, restoring
+	// them from the level instead if they were saved there from the same spline data.
 
-	for (APursuitSplineActor* validSpline0 : validSplines)
+	uint32 linksHash = APursuitSplineActor::CalculateSplineLinksHash(validSplines, masterRacingSpline);
+	bool savedLinks = (validSplines.Num() > 0);
+	bool staleLinks = false;
+
+	for (APursuitSplineActor* validSpline : validSplines)
 	{
-		TArray<UActorComponent*> splines;
+		savedLinks &= (validSpline->SavedSplineLinksHash == linksHash);
+		staleLinks |= (validSpline->SavedSplineLinksHash != 0 && validSpline->SavedSplineLinksHash != linksHash);
+	}
 
-		validSpline0->GetComponents(UPursuitSplineComponent::StaticClass(), splines);
+	if (savedLinks == true &&
+		check == false &&
+		saveLinks == false)
+	{
+		UE_LOG(GripLogPursuitSplines, Log, TEXT("Restoring pursuit spline links saved with the level"));
 
-		for (UActorComponent* component : splines)
+		for (APursuitSplineActor* validSpline : validSplines)
 		{
-			UPursuitSplineComponent* spline = Cast<UPursuitSplineComponent>(component);
+			validSpline->RestoreSplineLinks();
+		}
+	}
+	else
+	{
+		TArray<UPursuitSplineComponent*> splines;
+
+		for (APursuitSplineActor* validSpline : validSplines)
+		{
+			TArray<UActorComponent*> components;
+
+			validSpline->GetComponents(UPursuitSplineComponent::StaticClass(), components);
+
+			for (UActorComponent* component : components)
+			{
+				splines.Emplace(Cast<UPursuitSplineComponent>(component));
+			}
+		}
+
+		// Calculate the bounds of the sections of each spline so that we can quickly
+		// reject the end points of other splines that are too far away to link onto it.
+
+		TArray<TArray<FBox>> splineBounds;
+
+		splineBounds.SetNum(splines.Num());
+
+		ParallelFor(splines.Num(), [&splines, &splineBounds] (int32 index)
+			{
+				APursuitSplineActor::CalculateSplineLinkBounds(splines[index], splineBounds[index]);
+			});
+
+		// Determine the pairs of splines where one may link onto the other, in the same
+		// order as testing every spline against every other.
+
+		struct FSplineLinkPair
+		{
+			int32 SplineIndex;
+			int32 TargetIndex;
+			bool TestStart;
+			bool TestEnd;
+			FSplineLinkCandidate Candidate;
+		};
+
+		TArray<FSplineLinkPair> pairs;
+		TArray<int32> candidatePairs;
+		TArray<FVector> startPoints;
+		TArray<FVector> endPoints;
 
-			for (APursuitSplineActor* validSpline1 : validSplines)
+		for (UPursuitSplineComponent* spline : splines)
+		{
+			startPoints.Emplace(spline->GetWorldLocationAtDistanceAlongSpline(0.0f));
+			endPoints.Emplace(spline->GetWorldLocationAtDistanceAlongSpline(spline->GetSplineLength()));
+		}
+
+		for (int32 targetIndex = 0; targetIndex < splines.Num(); targetIndex++)
+		{
+			for (int32 splineIndex = 0; splineIndex < splines.Num(); splineIndex++)
 			{
-				validSpline1->EstablishPursuitSplineLinks(spline);
+				if (splineIndex != targetIndex)
+				{
+					FSplineLinkPair pair;
+
+					pair.SplineIndex = splineIndex;
+					pair.TargetIndex = targetIndex;
+					pair.TestStart = APursuitSplineActor::IsWithinSplineLinkRange(startPoints[splineIndex], splineBounds[targetIndex]);
+					pair.TestEnd = (splines[splineIndex]->IsClosedLoop() == false && APursuitSplineActor::IsWithinSplineLinkRange(endPoints[splineIndex], splineBounds[targetIndex]));
+
+					if (pair.TestStart == true ||
+						pair.TestEnd == true)
+					{
+						candidatePairs.Emplace(pairs.Num());
+					}
+
+					pairs.Emplace(pair);
+				}
 			}
 		}
+
+		// Find the links for the candidate pairs on worker threads, as this only reads the splines.
+
+		ParallelFor(candidatePairs.Num(), [&splines, &pairs, &candidatePairs] (int32 index)
+			{
+				FSplineLinkPair& pair = pairs[candidatePairs[index]];
+
+				pair.Candidate = APursuitSplineActor::FindSplineLink(splines[pair.SplineIndex], splines[pair.TargetIndex], pair.TestStart, pair.TestEnd);
+			});
+
+		// And then add the links in order on this thread, so that the duplicate rejection
+		// and dead-start / dead-end flags match testing every pair serially.
+
+		for (const FSplineLinkPair& pair : pairs)
+		{
+			APursuitSplineActor::AddSplineLinks(splines[pair.SplineIndex], splines[pair.TargetIndex], pair.Candidate);
+		}
+
+		UE_LOG(GripLogPursuitSplines, Log, TEXT("Established pursuit spline links for %d splines testing %d of %d pairs"), splines.Num(), candidatePairs.Num(), pairs.Num());
+
+		if (staleLinks == true)
+		{
+			// The spline data has changed since the links were saved with the level, so the
+			// master spline distances saved along with them are stale too.
+
+			UE_LOG(GripLogPursuitSplines, Warning, TEXT("Pursuit spline links saved with the level are out of date, rebuild them with grip.SavePursuitSplineLinks"));
+
+			for (APursuitSplineActor* validSpline : validSplines)
+			{
+				for (FPursuitPointExtendedData& point : validSpline->PointExtendedData)
+				{
+					point.MasterSplineDistance = -1.0f;
+				}
+
+				validSpline->PackedExtendedData.PackMasterSplineDistances(validSpline->PointExtendedData);
+			}
+		}
+
+#if WITH_EDITOR
+		if (saveLinks == true)
+		{
+			// Save the links with the level so that they needn't be established at run-time.
+
+			for (APursuitSplineActor* validSpline : validSplines)
+			{
+				validSpline->SaveSplineLinks(linksHash);
+			}
+
+			UE_LOG(GripLogPursuitSplines, Display, TEXT("Pursuit spline links stored for %d spline actors, save the level to keep them"), validSplines.Num());
+		}
+#endif // WITH_EDITOR
 	}
 
 	if (check == true)
@@ -853,7 +1092,36 @@ void APlayGameMode::EstablishPursuitSplineLinks(bool check, const FName& navigat
 
 	// Go through every spline in the world and compute the extended point data.
 
-	if (masterRacingSpline != nullptr)
+	bool masterDistancesRestored = false;
+
+#if GRIP_NAVIGATION_CACHE
+	if (check == false &&
+		gameState != nullptr &&
+		masterRacingSpline != nullptr)
+	{
+		// Restore the master spline distances from the navigation cache if it's up to
+		// date for every one of the splines.
+
+		TArray<UPursuitSplineComponent*> splines;
+
+		for (APursuitSplineActor* validSpline0 : validSplines)
+		{
+			TArray<UActorComponent*> splineComponents;
+
+			validSpline0->GetComponents(UPursuitSplineComponent::StaticClass(), splineComponents);
+
+			for (UActorComponent* component : splineComponents)
+			{
+				splines.Emplace(Cast<UPursuitSplineComponent>(component));
+			}
+		}
+
+		masterDistancesRestored = FNavigationCache::Get().RestoreMasterSplineDistances(splines, masterRacingSpline, gameState->TransientGameState.NavigationLayer);
+	}
+#endif // GRIP_NAVIGATION_CACHE
+
+	if (masterRacingSpline != nullptr &&
+		masterDistancesRestored == false)
 	{
 		// Calculate the master racing spline distances by branching forwards from the master racing spline
 		// onto all of it's connected splines.
@@ -996,6 +1264,39 @@ void APlayGameMode::EstablishPursuitSplineLinks(bool check, const FName& navigat
 
 }
 
+#if WITH_EDITOR
+
+/**
+* Establish the links between the pursuit splines of the level open in the Editor and
+* store them with the level, so they needn't be established when it's played.
+*
+* This has to be run on the Editor world rather than while playing, as that's the
+* level that gets saved. The optional argument is the navigation layer to use.
+***********************************************************************************/
+
+static void SavePursuitSplineLinks(const TArray<FString>& args, UWorld* world)
+{
+	if (world == nullptr ||
+		world->WorldType != EWorldType::Editor)
+	{
+		UE_LOG(GripLogPursuitSplines, Warning, TEXT("Pursuit spline links can only be saved from the Editor when not playing"));
+
+		return;
+	}
+
+	FName navigationLayer = (args.Num() > 0) ? FName(*args[0]) : FName(TEXT(""));
+	UPursuitSplineComponent* masterRacingSpline = APlayGameMode::DetermineMasterRacingSpline(navigationLayer, world, nullptr);
+
+	APlayGameMode::EstablishPursuitSplineLinks(false, navigationLayer, world, nullptr, masterRacingSpline, true);
+}
+
+static FAutoConsoleCommand SavePursuitSplineLinksCommand(
+	TEXT("grip.SavePursuitSplineLinks"),
+	TEXT("Establish the links between the pursuit splines of the level open in the Editor and store them with it, optionally for a given navigation layer."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SavePursuitSplineLinks));
+
+#endif // WITH_EDITOR
+
 /**
 * Do the regular update tick, post update work for this actor, guaranteed to execute
 * after other regular actor ticks.
@@ -1003,12 +1304,26 @@ void APlayGameMode::EstablishPursuitSplineLinks(bool check, const FName& navigat
 
 void APlayGameMode::Tick(float deltaSeconds)
 {
+
+#if GRIP_RACE_SIMULATION
+	FRaceSimulation::Get().Tick(this, deltaSeconds);
+#endif // GRIP_RACE_SIMULATION
+
+#if GRIP_RACE_REPLAY
+	FRaceReplay::Get().Tick(this);
+#endif // GRIP_RACE_REPLAY
+
+	GRIP_RACE_SIMULATION_SCOPE(GameMode);
+
 	float clock = Clock;
 
 	Super::Tick(deltaSeconds);
 
 	FrameTimes.AddValue(GetRealTimeClock(), deltaSeconds);
 
+	GunRounds.Resolve(GetWorld());
+	ObjectPool.Tick();
+
 	if (clock == 0.0f)
 	{
 		LastOptionsResetTime = clock;
@@ -1104,6 +1419,7 @@ void APlayGameMode::QuitGame(bool force)
 
 void APlayGameMode::UpdateRacePositions(float deltaSeconds)
 {
+	GRIP_FRAME_PROFILER_SCOPE(RacePositions, INDEX_NONE);
 
 #pragma region VehicleRaceDistance
 
@@ -1128,15 +1444,9 @@ void APlayGameMode::UpdateRacePositions(float deltaSeconds)
 	int32 firstRacePosition = 0;
 	float meanHumanDistance = 0.0f;
 
-	TArray<FPlayerRaceState*, TInlineAllocator<16>> raceStates;
-
 	for (ABaseVehicle* vehicle : Vehicles)
 	{
-		if (vehicle->GetRaceState().PlayerCompletionState < EPlayerCompletionState::Complete)
-		{
-			raceStates.Emplace(&vehicle->GetRaceState());
-		}
-		else if (vehicle->GetRaceState().PlayerCompletionState == EPlayerCompletionState::Complete)
+		if (vehicle->GetRaceState().PlayerCompletionState == EPlayerCompletionState::Complete)
 		{
 			firstRacePosition = FMath::Max(firstRacePosition, vehicle->GetRaceState().RacePosition + 1);
 		}
@@ -1152,7 +1462,8 @@ void APlayGameMode::UpdateRacePositions(float deltaSeconds)
 		{
 			// If the game is still being played and this vehicle hasn't finished yet.
 
-			if (vehicle->IsAIVehicle() == false)
+			if (vehicle->IsAIVehicle() == false ||
+				IsSimulatingRace() == true)
 			{
 				// If this vehicle is human or we need to wait for all AI bots to finish too,
 				// then signal the game as unfinished.
@@ -1176,50 +1487,63 @@ void APlayGameMode::UpdateRacePositions(float deltaSeconds)
 		GameSequence = EGameSequence::End;
 	}
 
-	if (raceStates.Num() > 0)
+	// Calculate the race position for each player, from the order of the last frame
+	// which is normally still sorted or very nearly so.
+
+	FRaceRanking::FOvertakes overtakes;
+	const FRaceRanking::FRaceStates& raceStates = RaceRanking.UpdateRaceOrder(Vehicles, overtakes);
+	TArray<int32, TInlineAllocator<GRIP_MAX_PLAYERS>> oldRacePositions;
+
+	for (i = 0; i < raceStates.Num(); i++)
 	{
-		// Calculate the race position for each player.
+		oldRacePositions.Emplace(raceStates[i]->RacePosition);
 
-		raceStates.StableSort([] (const FPlayerRaceState& object1, const FPlayerRaceState& object2)
-			{
-				if (object1.RaceDistance == object2.RaceDistance) return object1.PlayerVehicle->VehicleIndex < object2.PlayerVehicle->VehicleIndex; else return object1.RaceDistance > object2.RaceDistance;
-			});
+		if (raceStates[i]->RaceDistance != 0.0f ||
+			GlobalGameState->GamePlaySetup.DrivingMode == EDrivingMode::Elimination)
+		{
+			raceStates[i]->RacePosition = FMath::Min(firstRacePosition++, GRIP_MAX_PLAYERS - 1);
+		}
+	}
+
+	// Broadcast the changes in race position once all of the positions are up to date.
 
+	if (GameSequence == EGameSequence::Play)
+	{
 		for (i = 0; i < raceStates.Num(); i++)
 		{
-			if ((raceStates[i]->PlayerCompletionState < EPlayerCompletionState::Complete) &&
-				(raceStates[i]->RaceDistance != 0.0f || GlobalGameState->GamePlaySetup.DrivingMode == EDrivingMode::Elimination))
+			if (oldRacePositions[i] >= 0 &&
+				oldRacePositions[i] != raceStates[i]->RacePosition)
 			{
-				raceStates[i]->RacePosition = FMath::Min(firstRacePosition++, GRIP_MAX_PLAYERS - 1);
+				RaceRanking.OnRacePositionChanged.Broadcast(raceStates[i]->PlayerVehicle, oldRacePositions[i], raceStates[i]->RacePosition);
 			}
 		}
-	}
 
-	raceStates.Empty(GRIP_MAX_PLAYERS);
+		for (const TPair<FPlayerRaceState*, FPlayerRaceState*>& overtake : overtakes)
+		{
+			if (overtake.Key->RacePosition >= 0 &&
+				overtake.Value->RacePosition >= 0)
+			{
+				RaceRanking.OnVehicleOvertaken.Broadcast(overtake.Key->PlayerVehicle, overtake.Value->PlayerVehicle);
+			}
+		}
+	}
 
 	if (GameSequence >= EGameSequence::Play)
 	{
-		for (ABaseVehicle* vehicle : Vehicles)
-		{
-			raceStates.Emplace(&vehicle->GetRaceState());
-		}
 
 #pragma region VehicleCatchup
 
-		if (raceStates.Num() > 0)
+		const FRaceRanking::FRaceStates& eternalStates = RaceRanking.UpdateEternalOrder(Vehicles);
+
+		if (eternalStates.Num() > 0)
 		{
 			// Now calculate the auto-catchup assistance.
 
-			raceStates.StableSort([] (const FPlayerRaceState& object1, const FPlayerRaceState& object2)
-				{
-					return object1.EternalRaceDistance > object2.EternalRaceDistance;
-				});
-
 			FVehicleCatchupCharacteristics& characteristics = GetDifficultyCharacteristics().VehicleCatchupCharacteristics;
 
 			// Pick the median race distance for all of the players in the race.
 
-			float median = raceStates[raceStates.Num() >> 1]->EternalRaceDistance;
+			float median = RaceRanking.GetMedianEternalDistance();
 
 			if (numHumans == 0)
 			{
@@ -1272,8 +1596,6 @@ void APlayGameMode::UpdateRacePositions(float deltaSeconds)
 				meanHumanDistance = FMath::Max(meanHumanDistance + (centerOffset * 100.0f), 0.0f);
 			}
 
-			float minDistance = -1.0f;
-			float maxDistance = -1.0f;
 			float distanceSpread = characteristics.DistanceSpread * 0.5f;
 
 			for (ABaseVehicle* vehicle : Vehicles)
@@ -1282,16 +1604,6 @@ void APlayGameMode::UpdateRacePositions(float deltaSeconds)
 				bool usingLeadingCatchup = vehicle->GetUsingLeadingCatchup();
 				bool usingTrailingCatchup = vehicle->GetUsingTrailingCatchup();
 
-				if (minDistance < 0.0f)
-				{
-					minDistance = maxDistance = raceState.EternalRaceDistance;
-				}
-				else
-				{
-					minDistance = FMath::Min(minDistance, raceState.EternalRaceDistance);
-					maxDistance = FMath::Max(maxDistance, raceState.EternalRaceDistance);
-				}
-
 				raceState.StockCatchupRatioUnbounded = FMathEx::CentimetersToMeters(raceState.EternalRaceDistance - median) / distanceSpread;
 
 				float delay = characteristics.SpeedChangeDelay * 3.0f;
@@ -2412,7 +2724,8 @@ bool APlayGameMode::ShouldActorLimitCollisionResponse(AActor* actor)
 /**
 * Increase the sound volume of vehicles that are close to the local player.
 * This will be capped at a max overall volume to keep things from getting drowned
-* out.
+* out. The significance of the vehicles is also updated here, as it's determined
+* from the same local camera views.
 ***********************************************************************************/
 
 void APlayGameMode::UpdateVehicleVolumes(float deltaSeconds)
@@ -2422,6 +2735,7 @@ void APlayGameMode::UpdateVehicleVolumes(float deltaSeconds)
 	// Get a list of local player camera locations.
 
 	TArray<FVector, TInlineAllocator<16>> localPositions;
+	TArray<FVehicleSignificanceView, TInlineAllocator<16>> localViews;
 
 	for (ABaseVehicle* vehicle : Vehicles)
 	{
@@ -2432,6 +2746,7 @@ void APlayGameMode::UpdateVehicleVolumes(float deltaSeconds)
 			vehicle->Camera->GetCameraViewNoPostProcessing(0.0f, desiredView);
 
 			localPositions.Emplace(desiredView.Location);
+			localViews.Emplace(desiredView.Location, desiredView.Rotation.Vector(), desiredView.FOV);
 
 			ABaseVehicle* target = vehicle->CameraTarget();
 
@@ -2456,13 +2771,19 @@ void APlayGameMode::UpdateVehicleVolumes(float deltaSeconds)
 			pawn->IsA<ASpectatorPawn>() == true)
 		{
 			localPositions.Empty();
+			localViews.Empty();
 			WatchedVehicles.Empty();
 
 			localPositions.Emplace(pawn->GetActorLocation());
+			localViews.Emplace(pawn->GetActorLocation(), controller->GetControlRotation().Vector(), (controller->PlayerCameraManager != nullptr) ? controller->PlayerCameraManager->GetFOVAngle() : 90.0f);
 		}
 	}
 #endif // !UE_BUILD_SHIPPING
 
+	// Rank the vehicles for their cosmetic work against the same views.
+
+	VehicleSignificance.Update(Vehicles, localViews, WatchedVehicles);
+
 	if (localPositions.Num() > 0)
 	{
 		TArray<ABaseVehicle*, TInlineAllocator<16>> volumeVehicles;
@@ -15,6 +15,7 @@
 #include "vehicle/flippablevehicle.h"
 #include "ui/hudwidget.h"
 #include "gamemodes/basegamemode.h"
+#include "pickups/gunroundbatch.h"
 
 /**
 * Construct a UGunHostInterface.
@@ -49,6 +50,11 @@ void AGatlingGun::EndPlay(const EEndPlayReason::Type endPlayReason)
 {
 	GRIP_DETACH(BarrelSpinAudio);
 
+	if (PlayGameMode != nullptr)
+	{
+		PlayGameMode->GunRounds.RemoveRounds(this);
+	}
+
 	Super::EndPlay(endPlayReason);
 }
 
@@ -88,6 +94,8 @@ void AGatlingGun::Tick(float deltaSeconds)
 				LaunchVehicle->ReleasePickupSlot(PickupSlot);
 
 				DestroyPickup();
+
+				return;
 			}
 		}
 
@@ -144,6 +152,8 @@ void AGatlingGun::Tick(float deltaSeconds)
 					}
 
 					float invFireRate = 1.0f / FireRate;
+					bool targetSelected = false;
+					AActor* frameTarget = Target.Get();
 
 					while (RoundTimer > invFireRate)
 					{
@@ -169,16 +179,26 @@ void AGatlingGun::Tick(float deltaSeconds)
 						FVector surfaceDirection = up * -1.0f;
 						FVector direction = GunHost->GetGunRoundDirection(orientation.GetAxisX());
 						FVector location = GunHost->EjectGunRound((AlternateBarrels == false) ? 0 : RoundLocation, IsCharged());
-						AActor* target = Target.Get();
 						AActor* ignoreTarget = nullptr;
 
-						if (LaunchVehicle != nullptr)
+						if (LaunchVehicle != nullptr &&
+							targetSelected == false)
 						{
-							target = SelectTarget(LaunchPlatform.Get(), nullptr, AutoAiming, weight, false);
+							// Select the target just once for all of the rounds fired this frame.
+
+							frameTarget = SelectTarget(LaunchPlatform.Get(), nullptr, AutoAiming, weight, false);
+							targetSelected = true;
+
+							if (PlayGameMode != nullptr)
+							{
+								PlayGameMode->GunRounds.AddTargetSelection();
+							}
 						}
 
+						AActor* target = frameTarget;
+
 						if (target != nullptr &&
-							FMath::FRand() > HitRatio)
+							APlayGameMode::SimulationRandom.FRand() > HitRatio)
 						{
 							ignoreTarget = target;
 						}
@@ -209,7 +229,7 @@ void AGatlingGun::Tick(float deltaSeconds)
 							// Add sideways offset when trying to hit a target, the close we are to the target, the
 							// more sideways offset we add. The further away, the more it tightens up.
 
-							side *= FMath::FRandRange(-1.0f, 1.0f) * 0.1f / (distance / (20.0f * 100.0f));
+							side *= APlayGameMode::SimulationRandom.FRandRange(-1.0f, 1.0f) * 0.1f / (distance / (20.0f * 100.0f));
 
 							if (ignoreTarget != nullptr)
 							{
@@ -220,7 +240,7 @@ void AGatlingGun::Tick(float deltaSeconds)
 									// We've been told to explicitly miss this target vehicle, so let's aim around it
 									// causing a lot of excitement without actually hitting it.
 
-									side = vehicle->GetSideDirection() * FMath::FRandRange(2.0f * 100.0f, 5.0f * 100.0f) * ((FMath::Rand() & 1) ? 1.0f : -1.0f);
+									side = vehicle->GetSideDirection() * APlayGameMode::SimulationRandom.FRandRange(2.0f * 100.0f, 5.0f * 100.0f) * ((APlayGameMode::SimulationRandom.RandHelper(2) != 0) ? 1.0f : -1.0f);
 									side += vehicle->GetVelocityOrFacingDirection() * FMath::Max(FMathEx::MetersToCentimeters(vehicle->GetSpeedMPS()) * 0.333f, 3.0f * 300.0f);
 
 									direction *= distance;
@@ -229,12 +249,12 @@ void AGatlingGun::Tick(float deltaSeconds)
 						}
 						else
 						{
-							side *= (FMath::FRand() - 0.5f) * 0.2f;
+							side *= (APlayGameMode::SimulationRandom.FRand() - 0.5f) * 0.2f;
 						}
 
 						// Vary the vertical offset just a tiny bit.
 
-						up *= FMath::FRandRange(-0.25f, 0.75f) * 0.01f;
+						up *= APlayGameMode::SimulationRandom.FRandRange(-0.25f, 0.75f) * 0.01f;
 
 						if (ignoreTarget != nullptr)
 						{
@@ -255,146 +275,224 @@ void AGatlingGun::Tick(float deltaSeconds)
 
 						direction.Normalize();
 
-						float time = 0.0f;
-						FVector end = location + (direction * 100.0f * 1000.0f);
+						FGunRound round;
 
-						// Let's see if we hit something.
+						round.Gun = this;
+						round.LaunchPlatform = LaunchPlatform.Get();
+						round.Start = location;
+						round.End = location + (direction * 100.0f * 1000.0f);
+						round.Direction = direction;
+						round.Target = target;
+						round.IgnoreTarget = ignoreTarget;
+						round.LaunchVehicleIndex = launchVehicleIndex;
 
-						if (GetCollision(GetWorld(), location, end, time, ignoreTarget) == true)
+						if (PlayGameMode != nullptr &&
+							FGunRoundBatch::IsEnabled() == true)
 						{
-							USoundCue* hitSound = nullptr;
-							TArray<FVector> hitLocations;
-							TArray<UParticleSystem*> hitParticleSystems;
-							EGameSurface surface = EGameSurface::Default;
-							UPrimitiveComponent* hitComponent = HitResult.GetComponent();
-							FVector impactPoint = FMath::Lerp(location, end, time);
-							FRotator impactRotation = HitResult.ImpactNormal.Rotation();
+							// Add the round to the batch for all of the guns, to be traced along with
+							// all of the other rounds fired this frame and then resolved.
 
-							LastImpact = impactPoint;
+							PlayGameMode->GunRounds.AddRound(round);
+						}
+						else
+						{
+							// Let's see if we hit something.
+
+							round.Hit = GetCollision(GetWorld(), round.Start, round.End, round.Time, ignoreTarget);
 
-							if (HitResult.GetActor()->IsA<ABaseVehicle>() == true)
+							if (round.Hit == true)
 							{
-								// Handle the hitting of a vehicle with a round.
+								round.HitResult = HitResult;
+							}
 
-								NumRoundsHitVehicle++;
+							if (PlayGameMode != nullptr)
+							{
+								PlayGameMode->GunRounds.AddTraces(1);
+							}
 
-								ABaseVehicle* vehicle = Cast<ABaseVehicle>(HitResult.GetActor());
+							ResolveRound(round);
+						}
 
-								if (HitResult.GetActor() == target)
-								{
-									vehicle->ResetAttackTimer();
-								}
+						NumRoundsFired++;
+					}
+				}
+			}
+		}
+	}
+}
 
-								const FTransform& vehicleTransform = vehicle->VehicleMesh->GetComponentTransform();
+/**
+* Resolve a round fired from the gun, applying the result of its trace.
+***********************************************************************************/
 
-								// Ask the vehicle to process a bullet round striking it.
+void AGatlingGun::ResolveRound(const FGunRound& round)
+{
+	if (round.Hit == true)
+	{
+		const FHitResult& hit = round.HitResult;
+		USoundCue* hitSound = nullptr;
+		TArray<FVector> hitLocations;
+		TArray<UParticleSystem*> hitParticleSystems;
+		EGameSurface surface = EGameSurface::Default;
+		UPrimitiveComponent* hitComponent = hit.GetComponent();
+		FVector impactPoint = FMath::Lerp(round.Start, round.End, round.Time);
+		FRotator impactRotation = hit.ImpactNormal.Rotation();
+
+		LastImpact = impactPoint;
+
+		if (hit.GetActor()->IsA<ABaseVehicle>() == true)
+		{
+			// Handle the hitting of a vehicle with a round.
 
-								if (vehicle->BulletRound(RoundForce, HitPoints * ((LaunchVehicle != nullptr) ? LaunchVehicle->GetDamageScale() : 1.0f), launchVehicleIndex, impactPoint, location, IsCharged(), SpinSide) == true)
-								{
-									// We struck the vehicle.
+			NumRoundsHitVehicle++;
 
-									if (LaunchVehicle != nullptr &&
-										LaunchVehicle->IsAccountingClosed() == false)
-									{
-										int32 numPoints = 5;
+			ABaseVehicle* vehicle = Cast<ABaseVehicle>(hit.GetActor());
 
-										if (LaunchVehicle->AddPoints(numPoints, true, vehicle, impactPoint) == true)
-										{
-											NumPoints += numPoints;
+			if (hit.GetActor() == round.Target)
+			{
+				vehicle->ResetAttackTimer();
+			}
 
-											if (HitVehicles.Find(vehicle) == INDEX_NONE)
-											{
-												HitVehicles.Emplace(vehicle);
-											}
-										}
-									}
+			const FTransform& vehicleTransform = vehicle->VehicleMesh->GetComponentTransform();
 
-									surface = EGameSurface::Vehicle;
-								}
+			// Ask the vehicle to process a bullet round striking it.
+
+			if (vehicle->BulletRound(RoundForce, HitPoints * ((LaunchVehicle != nullptr) ? LaunchVehicle->GetDamageScale() : 1.0f), round.LaunchVehicleIndex, impactPoint, round.Start, IsCharged(), SpinSide) == true)
+			{
+				// We struck the vehicle.
+
+				if (LaunchVehicle != nullptr &&
+					LaunchVehicle->IsAccountingClosed() == false)
+				{
+					int32 numPoints = 5;
+
+					if (LaunchVehicle->AddPoints(numPoints, true, vehicle, impactPoint) == true)
+					{
+						NumPoints += numPoints;
+
+						if (HitVehicles.Find(vehicle) == INDEX_NONE)
+						{
+							HitVehicles.Emplace(vehicle);
+						}
+					}
+				}
+
+				surface = EGameSurface::Vehicle;
+			}
 
 #pragma region PickupShield
 
-								else
-								{
-									// We can assume here that we struck the vehicle's shield.
+			else
+			{
+				// We can assume here that we struck the vehicle's shield.
 
-									surface = EGameSurface::Shield;
-									hitComponent = vehicle->VehicleMesh;
+				surface = EGameSurface::Shield;
+				hitComponent = vehicle->VehicleMesh;
 
-									float standardOffset = -300.0f;
-									FVector additionalOffset = vehicle->VehicleShield->RearOffset;
+				float standardOffset = -300.0f;
+				FVector additionalOffset = vehicle->VehicleShield->RearOffset;
 
-									if (vehicleTransform.InverseTransformPosition(impactPoint).X > 0.0f)
-									{
-										standardOffset *= -1.0f;
-										additionalOffset = vehicle->VehicleShield->FrontOffset;
-									}
+				if (vehicleTransform.InverseTransformPosition(impactPoint).X > 0.0f)
+				{
+					standardOffset *= -1.0f;
+					additionalOffset = vehicle->VehicleShield->FrontOffset;
+				}
 
-									if (vehicle->VehicleShield->HitEffect != nullptr)
-									{
-										hitParticleSystems.Emplace(vehicle->VehicleShield->HitEffect);
-										hitLocations.Emplace(additionalOffset);
-									}
+				if (vehicle->VehicleShield->HitEffect != nullptr)
+				{
+					hitParticleSystems.Emplace(vehicle->VehicleShield->HitEffect);
+					hitLocations.Emplace(additionalOffset);
+				}
 
-									if (vehicle->VehicleShield->HitPointEffect != nullptr)
-									{
-										FVector pointOffset = FVector(standardOffset, FMath::FRandRange(-150.0f, 150.0f), FMath::FRandRange(-50.0f, 50.0f));
+				if (vehicle->VehicleShield->HitPointEffect != nullptr)
+				{
+					FVector pointOffset = FVector(standardOffset, FMath::FRandRange(-150.0f, 150.0f), FMath::FRandRange(-50.0f, 50.0f));
 
-										hitParticleSystems.Emplace(vehicle->VehicleShield->HitPointEffect);
-										hitLocations.Emplace(additionalOffset + pointOffset);
-									}
+					hitParticleSystems.Emplace(vehicle->VehicleShield->HitPointEffect);
+					hitLocations.Emplace(additionalOffset + pointOffset);
+				}
 
-									hitSound = vehicle->VehicleShield->HitSound;
-								}
+				hitSound = vehicle->VehicleShield->HitSound;
+			}
 
 #pragma endregion PickupShield
 
-								// Calculate a reflection vector between the incoming round and the vehicle it's
-								// hit to determine how to orient any visual hit effects.
+			// Calculate a reflection vector between the incoming round and the vehicle it's
+			// hit to determine how to orient any visual hit effects.
 
-								FVector strikeNormal = end - location; strikeNormal.Normalize();
-								FVector reflectNormal = FMath::GetReflectionVector(strikeNormal, HitResult.ImpactNormal); reflectNormal.Normalize();
+			FVector strikeNormal = round.End - round.Start; strikeNormal.Normalize();
+			FVector reflectNormal = FMath::GetReflectionVector(strikeNormal, hit.ImpactNormal); reflectNormal.Normalize();
 
-								impactRotation = reflectNormal.Rotation();
-							}
-							else if (HitResult.GetComponent()->IsA<UMeshComponent>() == true)
-							{
-								// Handle the hitting of a mesh component with a round.
+			impactRotation = reflectNormal.Rotation();
+		}
+		else if (hit.GetComponent()->IsA<UMeshComponent>() == true)
+		{
+			// Handle the hitting of a mesh component with a round.
 
-								// If this is a mesh component and it's simulating physics then apply an
-								// impulse to it to push it around.
+			// If this is a mesh component and it's simulating physics then apply an
+			// impulse to it to push it around.
 
-								UMeshComponent* mesh = Cast<UMeshComponent>(HitResult.GetComponent());
+			UMeshComponent* mesh = Cast<UMeshComponent>(hit.GetComponent());
 
-								if (mesh->IsSimulatingPhysics() == true)
-								{
-									mesh->AddImpulseAtLocation(direction * 100.0f * 10000.0f * RoundForce, impactPoint);
-								}
-							}
+			if (mesh->IsSimulatingPhysics() == true)
+			{
+				mesh->AddImpulseAtLocation(round.Direction * 100.0f * 10000.0f * RoundForce, impactPoint);
+			}
+		}
 
-							if (surface == EGameSurface::Default)
-							{
-								surface = (EGameSurface)UGameplayStatics::GetSurfaceType(HitResult);
-							}
+		if (surface == EGameSurface::Default)
+		{
+			surface = (EGameSurface)UGameplayStatics::GetSurfaceType(hit);
+		}
 
-							FVector color = GameState->TransientGameState.MapSurfaceColor * GameState->TransientGameState.MapLightingColor * 0.75f;
+		FVector color = GameState->TransientGameState.MapSurfaceColor * GameState->TransientGameState.MapLightingColor * 0.75f;
 
-							if (LaunchVehicle != nullptr)
-							{
-								color = LaunchVehicle->GetDustColor(true);
-							}
+		if (LaunchVehicle != nullptr)
+		{
+			color = LaunchVehicle->GetDustColor(true);
+		}
 
-							// Process the main audio / visual effects of the round striking a surface.
+		// Process the main audio / visual effects of the round striking a surface.
 
-							BulletHitAnimation(hitComponent, hitParticleSystems, hitLocations, hitSound, impactPoint, impactRotation, surface, color, IsCharged());
-						}
+		BulletHitAnimation(hitComponent, hitParticleSystems, hitLocations, hitSound, impactPoint, impactRotation, surface, color, IsCharged());
+	}
+}
 
-						NumRoundsFired++;
-					}
-				}
-			}
-		}
+/**
+* Reset the pickup to its initial state, ready to be reused from the object pool.
+***********************************************************************************/
+
+void AGatlingGun::ResetPickup()
+{
+	Super::ResetPickup();
+
+	if (BarrelSpinAudio != nullptr)
+	{
+		BarrelSpinAudio->Stop();
 	}
+
+	if (PlayGameMode != nullptr)
+	{
+		PlayGameMode->GunRounds.RemoveRounds(this);
+	}
+
+	Target.Reset();
+	LaunchPlatform.Reset();
+
+	GunHost = nullptr;
+	Duration = GetClass()->GetDefaultObject<AGatlingGun>()->Duration;
+	Timer = 0.0f;
+	RoundTimer = 0.0f;
+	HitRatio = 1.0f;
+	RoundLocation = 0;
+	NumRoundsFired = 0;
+	NumRoundsHitVehicle = 0;
+	LastImpact = FVector::ZeroVector;
+	NumPoints = 0;
+	SpinSide = 0.0f;
+	HaltRounds = false;
+
+	HitVehicles.Reset();
 }
 
 /**
@@ -424,7 +522,7 @@ void AGatlingGun::ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlot,
 		BarrelSpinAudio->Play();
 	}
 
-	SpinSide = (FMath::RandBool() == true) ? +1 : -1;
+	SpinSide = (APlayGameMode::SimulationRandom.RandHelper(2) == 0) ? +1 : -1;
 
 	// Just grab the current best target for the game event created after this
 	// pickup is activated.
@@ -473,7 +571,7 @@ void AGatlingGun::BeginFiring(float hitRatio)
 	RoundTimer = 0.0f;
 	HaltRounds = false;
 	HitRatio = hitRatio;
-	SpinSide = (FMath::RandBool() == true) ? +1 : -1;
+	SpinSide = (APlayGameMode::SimulationRandom.RandHelper(2) == 0) ? +1 : -1;
 }
 
 /**
@@ -505,9 +603,15 @@ AActor* AGatlingGun::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* lau
 
 	GRIP_GAME_MODE_LIST_FOR(GetVehicles(), vehicles, launchPlatform);
 
+	FTargetingService& targeting = gameMode->GetTargeting();
+
 	for (ABaseVehicle* vehicle : vehicles)
 	{
+		// The launch platform is positioned at the bulls-eye of a launch vehicle, so
+		// anything beyond the maximum range can be quickly discounted.
+
 		if ((vehicle != launchVehicle) &&
+			(targeting.IsBeyond(launchVehicle, vehicle, 250.0f * 100.0f) == false) &&
 			(vehicle->IsVehicleDestroyed() == false) &&
 			(speculative == false || vehicle->IsGoodForSmacking() == true) &&
 			((launchVehicle != nullptr && launchVehicle->IsAIVehicle() == false) || vehicle->CanBeAttacked() == true) &&
@@ -579,20 +683,30 @@ float AGatlingGun::EfficacyWeighting(ABaseVehicle* launchVehicle, FPlayerPickupS
 
 		if (targetSelected != nullptr)
 		{
-			FHitResult hitResult;
-			FCollisionQueryParams queryParams(TEXT("GunVisibilityTest"), true);
-
-			queryParams.AddIgnoredActor(launchVehicle);
-			queryParams.AddIgnoredActor(targetSelected);
-
 			FVector position = launchVehicle->GetCenterLocation();
 			ABaseVehicle* vehicle = Cast<ABaseVehicle>(targetSelected);
 			FVector offset = (vehicle != nullptr) ? vehicle->GetSurfaceDirection() * -100.0f : FVector(0.0f, 0.0f, -100.0f);
 			FVector targetPosition = ((vehicle != nullptr) ? vehicle->GetCenterLocation() : targetSelected->GetActorLocation()) + offset;
 
-			if (launchVehicle->GetWorld()->LineTraceSingleByChannel(hitResult, position + launchVehicle->GetSurfaceDirection() * -100.0f, targetPosition, ABaseGameMode::ECC_LineOfSightTest, queryParams) == true)
+			if (vehicle != nullptr)
+			{
+				if (APlayGameMode::Get(launchVehicle)->GetTargeting().HasLineOfSight(ETargetingSightLine::GunVisibility, launchVehicle, vehicle, position + launchVehicle->GetSurfaceDirection() * -100.0f, targetPosition) == false)
+				{
+					weight = 0.0f;
+				}
+			}
+			else
 			{
-				weight = 0.0f;
+				FHitResult hitResult;
+				FCollisionQueryParams queryParams(TEXT("GunVisibilityTest"), true);
+
+				queryParams.AddIgnoredActor(launchVehicle);
+				queryParams.AddIgnoredActor(targetSelected);
+
+				if (launchVehicle->GetWorld()->LineTraceSingleByChannel(hitResult, position + launchVehicle->GetSurfaceDirection() * -100.0f, targetPosition, ABaseGameMode::ECC_LineOfSightTest, queryParams) == true)
+				{
+					weight = 0.0f;
+				}
 			}
 		}
 
@@ -0,0 +1,162 @@
+/**
+*
+* Gun round batch.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A batch of the hitscan rounds fired by all of the Gatling guns in a frame, traced
+* together and then applied to the guns that fired them.
+*
+***********************************************************************************/
+
+#include "pickups/gunroundbatch.h"
+#include "pickups/gatlinggun.h"
+#include "gamemodes/basegamemode.h"
+#include "async/parallelfor.h"
+
+/**
+* Console variable for batching the rounds fired by the Gatling guns.
+***********************************************************************************/
+
+TAutoConsoleVariable<int32> CVarBatchedGunRounds(
+	TEXT("grip.BatchedGunRounds"),
+	2,
+	TEXT("Batch the rounds fired by the Gatling guns each frame and trace them together.\n")
+	TEXT("  0: Off, trace each round as it's fired\n")
+	TEXT("  1: On\n")
+	TEXT("  2: On, tracing the batch in parallel\n"),
+	ECVF_Default);
+
+/**
+* Console variable for logging the number of traces made for gun rounds.
+***********************************************************************************/
+
+TAutoConsoleVariable<int32> CVarGunRoundStats(
+	TEXT("grip.GunRoundStats"),
+	0,
+	TEXT("Log the number of traces and target selections made for gun rounds per second.\n")
+	TEXT("  0: Off\n")
+	TEXT("  1: On\n"),
+	ECVF_Default);
+
+/**
+* Are gun rounds to be added to the batch rather than traced as they're fired?
+***********************************************************************************/
+
+bool FGunRoundBatch::IsEnabled()
+{
+	return CVarBatchedGunRounds.GetValueOnGameThread() != 0;
+}
+
+/**
+* Trace all of the rounds in the batch and apply their results to the guns that
+* fired them.
+*
+* The traces are independent of one another and made against the same state of
+* the world, so they're made in parallel where there's enough of them. The results
+* are then applied serially on the game thread in the order the rounds were fired,
+* as that's where the points are scored and the effects are spawned.
+***********************************************************************************/
+
+void FGunRoundBatch::Resolve(UWorld* world)
+{
+	if (Rounds.Num() > 0)
+	{
+		if (Rounds.Num() >= 2 &&
+			CVarBatchedGunRounds.GetValueOnGameThread() == 2)
+		{
+			ParallelFor(Rounds.Num(), [world, this](int32 index)
+				{
+					Trace(world, Rounds[index]);
+				});
+		}
+		else
+		{
+			for (FGunRound& round : Rounds)
+			{
+				Trace(world, round);
+			}
+		}
+
+		NumTraces += Rounds.Num();
+		NumBatches++;
+
+		for (const FGunRound& round : Rounds)
+		{
+			round.Gun->ResolveRound(round);
+		}
+
+		Rounds.Reset();
+	}
+
+	UpdateStats();
+}
+
+/**
+* Remove any unresolved rounds fired by a gun, normally because it's being
+* destroyed.
+***********************************************************************************/
+
+void FGunRoundBatch::RemoveRounds(AGatlingGun* gun)
+{
+	Rounds.RemoveAll([gun] (const FGunRound& round)
+		{
+			return round.Gun == gun;
+		});
+}
+
+/**
+* Trace a round, thread-safe so that rounds can be traced in parallel.
+***********************************************************************************/
+
+void FGunRoundBatch::Trace(UWorld* world, FGunRound& round)
+{
+	round.Hit = false;
+	round.Time = 0.0f;
+
+	if ((round.End - round.Start).Size() > SMALL_NUMBER)
+	{
+		FCollisionQueryParams queryParams(TEXT("Bullet"), true, round.LaunchPlatform);
+
+		queryParams.bReturnPhysicalMaterial = true;
+
+		if (round.IgnoreTarget != nullptr)
+		{
+			queryParams.AddIgnoredActor(round.IgnoreTarget);
+		}
+
+		if (world->LineTraceSingleByChannel(round.HitResult, round.Start, round.End, ABaseGameMode::ECC_LineOfSightTestIncVehicles, queryParams) == true)
+		{
+			round.Time = round.HitResult.GetComponent() ? round.HitResult.Time : 1.0f;
+			round.Hit = round.HitResult.GetActor() != nullptr;
+		}
+	}
+}
+
+/**
+* Roll the counters over and log them once per second if requested.
+***********************************************************************************/
+
+void FGunRoundBatch::UpdateStats()
+{
+	double time = FPlatformTime::Seconds();
+
+	if (time - LastLogTime >= 1.0)
+	{
+		if (CVarGunRoundStats.GetValueOnGameThread() != 0 &&
+			LastLogTime != 0.0)
+		{
+			float scale = 1.0f / (float)(time - LastLogTime);
+
+			UE_LOG(GripLog, Log, TEXT("Gun rounds made %0.1f traces and %0.1f target selections per second, in %0.1f batches per second"), NumTraces * scale, NumTargetSelections * scale, NumBatches * scale);
+		}
+
+		LastLogTime = time;
+		NumTraces = 0;
+		NumTargetSelections = 0;
+		NumBatches = 0;
+	}
+}
@@ -440,7 +440,7 @@ void AHomingMissile::Ignite()
 	if (DieAt == 0.0f &&
 		RocketDuration > KINDA_SMALL_NUMBER)
 	{
-		DieAt = FMath::FRandRange(RocketDuration, RocketDuration * 1.25f);
+		DieAt = APlayGameMode::SimulationRandom.FRandRange(RocketDuration, RocketDuration * 1.25f);
 	}
 }
 
@@ -576,12 +576,12 @@ void AHomingMissile::Explode(AActor* hitActor, const FHitResult* hitResult)
 
 void AHomingMissile::SetupFalseTarget()
 {
-	RandomDrift.X = FMath::FRandRange(-20.0f, 20.0f);
-	RandomDrift.Y = FMath::FRandRange(0.0f, 10.0f);
+	RandomDrift.X = APlayGameMode::SimulationRandom.FRandRange(-20.0f, 20.0f);
+	RandomDrift.Y = APlayGameMode::SimulationRandom.FRandRange(0.0f, 10.0f);
 
 	MissileMovement->FalseTarget(MissileHost->GetMissileFalseTarget(), RandomDrift);
 
-	DieAt = Timer + 2.5f + (FMath::Rand() & 255) * (2.0f / 255.0f);
+	DieAt = Timer + 2.5f + APlayGameMode::SimulationRandom.RandHelper(256) * (2.0f / 255.0f);
 }
 
 /**
@@ -598,6 +598,7 @@ bool AHomingMissile::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* lau
 	ABaseVehicle* existingVehicle = Cast<ABaseVehicle>(existingTarget);
 	FVector fromDirection = launchPlatform->GetActorQuat().GetAxisX();
 	FVector fromLocation = (launchVehicle != nullptr) ? launchVehicle->GetTargetBullsEye() + (launchVehicle->GetLaunchDirection() * 300.0f) : launchPlatform->GetActorLocation();
+	FTargetingService& targeting = gameMode->GetTargeting();
 
 	targetList.Empty();
 
@@ -613,11 +614,22 @@ bool AHomingMissile::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* lau
 
 		if (weight >= 0.0f)
 		{
-			FCollisionQueryParams queryParams("TargetSelection", false, launchVehicle);
+			bool lineOfSight = false;
 
-			queryParams.AddIgnoredActor(existingTarget);
+			if (existingVehicle != nullptr)
+			{
+				lineOfSight = targeting.HasLineOfSight(ETargetingSightLine::MissileSelection, launchVehicle, existingVehicle, fromLocation, targetLocation);
+			}
+			else
+			{
+				FCollisionQueryParams queryParams("TargetSelection", false, launchVehicle);
+
+				queryParams.AddIgnoredActor(existingTarget);
 
-			if (launchVehicle->GetWorld()->LineTraceSingleByChannel(hitResult, fromLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false)
+				lineOfSight = (launchVehicle->GetWorld()->LineTraceSingleByChannel(hitResult, fromLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false);
+			}
+
+			if (lineOfSight == true)
 			{
 				targetList.Add(existingTarget);
 
@@ -643,7 +655,11 @@ bool AHomingMissile::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* lau
 
 		for (ABaseVehicle* vehicle : vehicles)
 		{
-			if (targetList.Contains(Cast<AActor>(vehicle)) == false)
+			// The launch point is 3m from the bulls-eye of the launch vehicle, so anything
+			// further than that beyond the maximum range can be quickly discounted.
+
+			if (targetList.Contains(Cast<AActor>(vehicle)) == false &&
+				targeting.IsBeyond(launchVehicle, vehicle, (750.0f * 100.0f) + 300.0f) == false)
 			{
 				if ((vehicle != launchVehicle) &&
 					(vehicle->IsVehicleDestroyed() == false) &&
@@ -660,11 +676,7 @@ bool AHomingMissile::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* lau
 					if (thisWeight >= 0.0f &&
 						minCorrection > thisWeight)
 					{
-						FCollisionQueryParams queryParams("TargetSelection", false, launchVehicle);
-
-						queryParams.AddIgnoredActor(vehicle);
-
-						if (launchVehicle->GetWorld()->LineTraceSingleByChannel(hitResult, fromLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false)
+						if (targeting.HasLineOfSight(ETargetingSightLine::MissileSelection, launchVehicle, vehicle, fromLocation, targetLocation) == true)
 						{
 							minCorrection = thisWeight;
 							existingTarget = vehicle;
@@ -1081,7 +1093,7 @@ void AHomingMissile::ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlo
 		float ejectScale = 1.0f - (FMathEx::GetRatio(speed, 0.0f, 400.0f) * 0.75f);
 
 		yaw = 0.0f;
-		pitch = FMath::RandRange(0.3f, 0.3f + (0.3f * ejectScale));
+		pitch = APlayGameMode::SimulationRandom.FRandRange(0.3f, 0.3f + (0.3f * ejectScale));
 
 		if (constrainUp == true)
 		{
@@ -1150,8 +1162,8 @@ void AHomingMissile::Launch(const FVector& location, const FVector& velocity)
 
 	RootComponent->SetWorldLocation(location);
 
-	RandomDrift.X = FMath::FRandRange(-20.0f, 20.0f);
-	RandomDrift.Y = FMath::FRandRange(0.0f, 10.0f);
+	RandomDrift.X = APlayGameMode::SimulationRandom.FRandRange(-20.0f, 20.0f);
+	RandomDrift.Y = APlayGameMode::SimulationRandom.FRandRange(0.0f, 10.0f);
 	IgnitionTime = 0.0f;
 
 	MissileMesh->MoveIgnoreActors.Emplace(LaunchPlatform.Get());
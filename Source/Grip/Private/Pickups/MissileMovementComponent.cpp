@@ -26,9 +26,9 @@ DEFINE_LOG_CATEGORY(GripLogMissile);
 
 UMissileMovementComponent::UMissileMovementComponent()
 {
-	if (FMath::RandBool() == true)
+	if (APlayGameMode::SimulationRandom.RandHelper(2) == 0)
 	{
-		TrackingWobble = FMath::FRandRange(0.5f, 1.0f);
+		TrackingWobble = APlayGameMode::SimulationRandom.FRandRange(0.5f, 1.0f);
 	}
 }
 
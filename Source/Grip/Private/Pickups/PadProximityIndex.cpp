@@ -0,0 +1,235 @@
+/**
+*
+* Pad proximity index.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A static index of the collision volumes of the pickup pads and speed pads, for
+* the vehicles to collect them from.
+*
+***********************************************************************************/
+
+#include "pickups/padproximityindex.h"
+#include "pickups/pickup.h"
+#include "pickups/speedpad.h"
+#include "components/boxcomponent.h"
+#include "components/spherecomponent.h"
+#include "algo/binarysearch.h"
+
+/**
+* Refresh the index from the pads if they've changed since it was built.
+*
+* The pads register themselves with the game mode as they start play, so the index
+* is built on first use after they've all been registered, and rebuilt should that
+* ever change.
+***********************************************************************************/
+
+void FPadProximityIndex::Refresh(const TArray<APickup*>& pickupPads, const TArray<ASpeedPad*>& speedPads)
+{
+	if (NumPickupPads == pickupPads.Num() &&
+		NumSpeedPads == speedPads.Num())
+	{
+		return;
+	}
+
+	NumPickupPads = pickupPads.Num();
+	NumSpeedPads = speedPads.Num();
+	MaxSizeX = 0.0f;
+
+	Volumes.Reset(NumPickupPads + NumSpeedPads);
+
+	for (APickup* pickupPad : pickupPads)
+	{
+		if (GRIP_OBJECT_VALID(pickupPad) == true)
+		{
+			AddVolume(pickupPad->CollisionSphere, pickupPad, nullptr);
+		}
+	}
+
+	for (ASpeedPad* speedPad : speedPads)
+	{
+		if (GRIP_OBJECT_VALID(speedPad) == true)
+		{
+			AddVolume(speedPad->CollisionBox, nullptr, speedPad);
+		}
+	}
+
+	Volumes.Sort([] (const FPadVolume& object1, const FPadVolume& object2)
+		{
+			return object1.WorldBounds.Min.X < object2.WorldBounds.Min.X;
+		});
+}
+
+/**
+* Add the volume of a pad from its collision shape.
+***********************************************************************************/
+
+void FPadProximityIndex::AddVolume(UShapeComponent* shape, APickup* pickupPad, ASpeedPad* speedPad)
+{
+	if (shape == nullptr)
+	{
+		return;
+	}
+
+	FPadVolume& volume = Volumes.AddDefaulted_GetRef();
+
+	volume.PickupPad = pickupPad;
+	volume.SpeedPad = speedPad;
+	volume.Transform = shape->GetComponentTransform();
+	volume.Transform.RemoveScaling();
+
+	USphereComponent* sphere = Cast<USphereComponent>(shape);
+
+	if (sphere != nullptr)
+	{
+		float radius = sphere->GetScaledSphereRadius();
+
+		volume.Sphere = true;
+		volume.Extent = FVector(radius);
+		volume.WorldBounds = FBox::BuildAABB(volume.Transform.GetLocation(), volume.Extent);
+	}
+	else
+	{
+		UBoxComponent* box = Cast<UBoxComponent>(shape);
+
+		volume.Extent = (box != nullptr) ? box->GetScaledBoxExtent() : shape->Bounds.BoxExtent;
+		volume.WorldBounds = FBox(-volume.Extent, volume.Extent).TransformBy(volume.Transform);
+	}
+
+	MaxSizeX = FMath::Max(MaxSizeX, volume.WorldBounds.Max.X - volume.WorldBounds.Min.X);
+}
+
+/**
+* Does a capsule touch a volume?
+*
+* For boxes, the capsule is treated as its axis against the box expanded by its
+* radius, which is slightly generous at the corners of the box.
+***********************************************************************************/
+
+bool FPadProximityIndex::Touches(const FPadVolume& volume, const FPadProximityCapsule& capsule)
+{
+	if (volume.Sphere == true)
+	{
+		float distance = volume.Extent.X + capsule.Radius;
+
+		return FMath::PointDistToSegmentSquared(volume.Transform.GetLocation(), capsule.Start, capsule.End) <= distance * distance;
+	}
+	else
+	{
+		FVector start = volume.Transform.InverseTransformPosition(capsule.Start);
+		FVector end = volume.Transform.InverseTransformPosition(capsule.End);
+		FBox box = FBox(-volume.Extent, volume.Extent).ExpandBy(capsule.Radius);
+
+		if (box.IsInsideOrOn(start) == true ||
+			box.IsInsideOrOn(end) == true)
+		{
+			return true;
+		}
+
+		return (start.Equals(end) == false && FMath::LineBoxIntersection(box, start, end, end - start) == true);
+	}
+}
+
+/**
+* Call a function for each volume touched by any of a set of capsules, once per
+* volume.
+***********************************************************************************/
+
+template <typename F>
+void FPadProximityIndex::ForEachTouchedVolume(TArrayView<const FPadProximityCapsule> capsules, F function) const
+{
+	if (capsules.Num() == 0 ||
+		Volumes.Num() == 0)
+	{
+		return;
+	}
+
+	FBox queryBounds(ForceInit);
+
+	for (const FPadProximityCapsule& capsule : capsules)
+	{
+		queryBounds += FBox(capsule.Start.ComponentMin(capsule.End), capsule.Start.ComponentMax(capsule.End)).ExpandBy(capsule.Radius);
+	}
+
+	// Find the first volume that could overlap the query along X. No volume is wider
+	// than MaxSizeX so none before this one can reach the query.
+
+	int32 first = Algo::LowerBoundBy(Volumes, queryBounds.Min.X - MaxSizeX, [] (const FPadVolume& volume)
+		{
+			return volume.WorldBounds.Min.X;
+		});
+
+	for (int32 i = first; i < Volumes.Num(); i++)
+	{
+		const FPadVolume& volume = Volumes[i];
+
+		if (volume.WorldBounds.Min.X > queryBounds.Max.X)
+		{
+			// All of the remaining volumes are beyond the query along X.
+
+			break;
+		}
+
+		if (volume.WorldBounds.Intersect(queryBounds) == true)
+		{
+			for (const FPadProximityCapsule& capsule : capsules)
+			{
+				if (Touches(volume, capsule) == true)
+				{
+					function(volume);
+					break;
+				}
+			}
+		}
+	}
+}
+
+/**
+* Get the pickup pads touched by any of a set of capsules.
+***********************************************************************************/
+
+void FPadProximityIndex::FindPickupPads(TArrayView<const FPadProximityCapsule> capsules, TArray<APickup*, TInlineAllocator<4>>& pickupPads) const
+{
+	pickupPads.Reset();
+
+	ForEachTouchedVolume(capsules, [&pickupPads] (const FPadVolume& volume)
+		{
+			if (volume.PickupPad != nullptr)
+			{
+				pickupPads.Emplace(volume.PickupPad);
+			}
+		});
+}
+
+/**
+* Get the speed pads touched by any of a set of capsules.
+***********************************************************************************/
+
+void FPadProximityIndex::FindSpeedPads(TArrayView<const FPadProximityCapsule> capsules, TArray<ASpeedPad*, TInlineAllocator<4>>& speedPads) const
+{
+	speedPads.Reset();
+
+	ForEachTouchedVolume(capsules, [&speedPads] (const FPadVolume& volume)
+		{
+			if (volume.SpeedPad != nullptr)
+			{
+				speedPads.Emplace(volume.SpeedPad);
+			}
+		});
+}
+
+/**
+* Clear the index.
+***********************************************************************************/
+
+void FPadProximityIndex::Reset()
+{
+	Volumes.Reset();
+
+	MaxSizeX = 0.0f;
+	NumPickupPads = -1;
+	NumSpeedPads = -1;
+}
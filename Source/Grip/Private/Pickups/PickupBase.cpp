@@ -51,7 +51,7 @@ void APickupBase::ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlot,
 }
 
 /**
-* Destroy the pickup.
+* Destroy the pickup, releasing it back into the object pool if it came from there.
 ***********************************************************************************/
 
 void APickupBase::DestroyPickup()
@@ -62,7 +62,36 @@ void APickupBase::DestroyPickup()
 		PlayGameMode->RemovePickupType(PickupType);
 	}
 
-	Destroy();
+	if (PlayGameMode != nullptr &&
+		PlayGameMode->ObjectPool.IsPooled(this) == true)
+	{
+		// Make sure the launch vehicle doesn't still think it's using the pickup
+		// before it goes back into the pool, as it'll remain valid while it's there.
+
+		if (LaunchVehicle != nullptr)
+		{
+			LaunchVehicle->ForgetPickup(this);
+		}
+
+		ResetPickup();
+
+		PlayGameMode->ObjectPool.ReleaseActor(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+/**
+* Reset the pickup to its initial state, ready to be reused from the object pool.
+***********************************************************************************/
+
+void APickupBase::ResetPickup()
+{
+	LaunchVehicle = nullptr;
+	PickupSlot = 0;
+	Charged = false;
 }
 
 /**
@@ -187,6 +187,50 @@ void AShield::Tick(float deltaSeconds)
 	}
 }
 
+/**
+* Reset the pickup to its initial state, ready to be reused from the object pool.
+***********************************************************************************/
+
+void AShield::ResetPickup()
+{
+	Super::ResetPickup();
+
+	if (GRIP_OBJECT_VALID(ActiveAudio) == true)
+	{
+		ActiveAudio->Stop();
+
+		GRIP_DETACH(ActiveAudio);
+
+		// Activation made the rear effect the root component, so hand that back to the
+		// audio component before the effects are destroyed.
+
+		SetRootComponent(ActiveAudio);
+	}
+
+	// The effects are created for the launch vehicle on activation so they can't be
+	// reused, just as if the shield had been destroyed.
+
+	UParticleSystemComponent* effects[] = { ActiveEffectFront, ActiveEffectRear, DestroyedEffectFront, DestroyedEffectRear };
+
+	for (UParticleSystemComponent* effect : effects)
+	{
+		if (GRIP_OBJECT_VALID(effect) == true)
+		{
+			effect->DestroyComponent();
+		}
+	}
+
+	ActiveEffectFront = nullptr;
+	ActiveEffectRear = nullptr;
+	DestroyedEffectFront = nullptr;
+	DestroyedEffectRear = nullptr;
+
+	Timer = 0.0f;
+	DestroyedAt = 0.0f;
+	OriginalHitPoints = 0;
+	HitPoints = GetClass()->GetDefaultObject<AShield>()->HitPoints;
+}
+
 /**
 * Spawn a new shield effect.
 ***********************************************************************************/
@@ -62,6 +62,24 @@ void ATurbo::ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlot, EPick
 	launchVehicle->TurboEngaged();
 }
 
+/**
+* Reset the pickup to its initial state, ready to be reused from the object pool.
+***********************************************************************************/
+
+void ATurbo::ResetPickup()
+{
+	Super::ResetPickup();
+
+	if (GRIP_OBJECT_VALID(ActiveAudio) == true)
+	{
+		ActiveAudio->Stop();
+		ActiveAudio->SetVolumeMultiplier(0.0f);
+	}
+
+	Timer = 0.0f;
+	ActivateSoundPlayed = false;
+}
+
 /**
 * Do the regular update tick.
 ***********************************************************************************/
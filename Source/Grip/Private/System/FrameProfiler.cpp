@@ -0,0 +1,406 @@
+/**
+*
+* Per-subsystem frame-time profiler.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Break the game frame down into the time spent in each of the hot subsystems,
+* attributed to individual vehicles where that makes sense, and export the
+* results to CSV and Chrome trace JSON files.
+*
+***********************************************************************************/
+
+#include "system/frameprofiler.h"
+
+#if GRIP_FRAME_PROFILER
+
+#include "misc/filehelper.h"
+#include "misc/coredelegates.h"
+
+/**
+* FFrameProfiler statics.
+***********************************************************************************/
+
+// The maximum number of frames kept for export, five minutes at 60 frames per second.
+const int32 FFrameProfiler::MaxFrames = 60 * 60 * 5;
+
+// The number of frames that the rolling percentiles are calculated over.
+const int32 FFrameProfiler::RollingFrames = 600;
+
+// The maximum number of scopes recorded for a trace.
+const int32 FFrameProfiler::MaxTraceEvents = 1024 * 1024;
+
+// The names of the subsystems.
+const TCHAR* FFrameProfiler::CategoryNames[(int32)EFrameProfilerCategory::Num] = { TEXT("VehiclePhysics"), TEXT("ContactSensors"), TEXT("VehicleAI"), TEXT("RacePositions"), TEXT("CinematicsDirector"), TEXT("LightStreaks"), TEXT("HUD") };
+
+// The frame profiler for this process.
+FFrameProfiler FFrameProfiler::Instance;
+
+/**
+* Is a frame profile capture requested from the command line?
+***********************************************************************************/
+
+bool FFrameProfiler::IsRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("GripFrameProfiler"));
+}
+
+/**
+* Start capturing, optionally recording every timed scope for a trace.
+***********************************************************************************/
+
+void FFrameProfiler::Start(const FString& name, bool trace)
+{
+	if (Active == true)
+	{
+		UE_LOG(GripLog, Warning, TEXT("Frame profiler is already capturing"));
+		return;
+	}
+
+	Name = name;
+	Tracing = trace;
+	StartCycles = FPlatformTime::Cycles64();
+	FrameStartCycles = StartCycles;
+	NextFrame = 0;
+	NumFrames = 0;
+
+	FMemory::Memzero((void*)Costs, sizeof(Costs));
+	FMemory::Memzero((void*)Counts, sizeof(Counts));
+	FMemory::Memzero((void*)VehicleCosts, sizeof(VehicleCosts));
+
+	Frames.Reset();
+	Frames.Reserve(RollingFrames);
+
+	{
+		FScopeLock lock(&TraceLock);
+
+		TraceEvents.Reset();
+	}
+
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FFrameProfiler::EndFrame);
+
+	Active = true;
+
+	UE_LOG(GripLog, Display, TEXT("Frame profiler started%s"), (Tracing == true) ? TEXT(" with tracing") : TEXT(""));
+}
+
+/**
+* Stop capturing and export the results.
+***********************************************************************************/
+
+void FFrameProfiler::Stop()
+{
+	if (Active == false)
+	{
+		return;
+	}
+
+	Active = false;
+
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+	Report();
+
+	FString filename = FPaths::Combine(FPaths::ProfilingDir(), FString::Printf(TEXT("GripFrameProfile-%s-%s"), *Name, *FDateTime::Now().ToString()));
+
+	if (WriteCSV(filename + TEXT(".csv")) == true)
+	{
+		UE_LOG(GripLog, Display, TEXT("Frame profile written to %s.csv"), *filename);
+	}
+	else
+	{
+		UE_LOG(GripLog, Warning, TEXT("Failed to write frame profile to %s.csv"), *filename);
+	}
+
+	if (Tracing == true)
+	{
+		if (WriteTrace(filename + TEXT(".json")) == true)
+		{
+			UE_LOG(GripLog, Display, TEXT("Frame profile trace written to %s.json"), *filename);
+		}
+		else
+		{
+			UE_LOG(GripLog, Warning, TEXT("Failed to write frame profile trace to %s.json"), *filename);
+		}
+	}
+
+	Frames.Empty();
+
+	FScopeLock lock(&TraceLock);
+
+	TraceEvents.Empty();
+}
+
+/**
+* Add a timed sample for a subsystem, thread-safe as physics may be sub-stepped off
+* the game thread.
+***********************************************************************************/
+
+void FFrameProfiler::AddSample(EFrameProfilerCategory category, int32 vehicleIndex, uint64 startCycles, uint64 endCycles)
+{
+	if (Active == false)
+	{
+		return;
+	}
+
+	int64 cycles = (int64)(endCycles - startCycles);
+
+	FPlatformAtomics::InterlockedAdd(&Costs[(int32)category], cycles);
+	FPlatformAtomics::InterlockedIncrement(&Counts[(int32)category]);
+
+	// Contact sensors are nested within the vehicle physics, so don't attribute them
+	// to the vehicle a second time.
+
+	if (vehicleIndex >= 0 &&
+		vehicleIndex < GRIP_MAX_PLAYERS &&
+		category != EFrameProfilerCategory::ContactSensors)
+	{
+		FPlatformAtomics::InterlockedAdd(&VehicleCosts[vehicleIndex], cycles);
+	}
+
+	if (Tracing == true)
+	{
+		FTraceEvent event;
+
+		event.StartCycles = startCycles;
+		event.EndCycles = endCycles;
+		event.ThreadId = FPlatformTLS::GetCurrentThreadId();
+		event.Category = category;
+		event.VehicleIndex = (int8)FMath::Clamp(vehicleIndex, (int32)INDEX_NONE, 127);
+
+		FScopeLock lock(&TraceLock);
+
+		if (TraceEvents.Num() < MaxTraceEvents)
+		{
+			TraceEvents.Emplace(event);
+		}
+	}
+}
+
+/**
+* Close the current frame, called at the end of every engine frame while capturing.
+***********************************************************************************/
+
+void FFrameProfiler::EndFrame()
+{
+	if (Active == false)
+	{
+		return;
+	}
+
+	uint64 cycles = FPlatformTime::Cycles64();
+	double msPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+	FFrame frame;
+
+	frame.FrameTime = (float)((cycles - FrameStartCycles) * msPerCycle);
+
+	FrameStartCycles = cycles;
+
+	for (int32 i = 0; i < (int32)EFrameProfilerCategory::Num; i++)
+	{
+		frame.Costs[i] = (float)(FPlatformAtomics::InterlockedExchange(&Costs[i], 0) * msPerCycle);
+		frame.Counts[i] = (uint16)FMath::Min(FPlatformAtomics::InterlockedExchange(&Counts[i], 0), (int32)MAX_uint16);
+	}
+
+	for (int32 i = 0; i < GRIP_MAX_PLAYERS; i++)
+	{
+		frame.VehicleCosts[i] = (float)(FPlatformAtomics::InterlockedExchange(&VehicleCosts[i], 0) * msPerCycle);
+	}
+
+	if (Frames.Num() < MaxFrames)
+	{
+		Frames.Emplace(frame);
+	}
+	else
+	{
+		if (NextFrame == 0)
+		{
+			UE_LOG(GripLog, Warning, TEXT("Frame profiler is full, overwriting the oldest frames"));
+		}
+
+		Frames[NextFrame] = frame;
+	}
+
+	NextFrame = (NextFrame + 1) % MaxFrames;
+	NumFrames++;
+}
+
+/**
+* Log the rolling percentiles for each subsystem and the mean cost of each vehicle.
+***********************************************************************************/
+
+void FFrameProfiler::Report() const
+{
+	int32 numFrames = FMath::Min(Frames.Num(), RollingFrames);
+
+	if (numFrames == 0)
+	{
+		UE_LOG(GripLog, Display, TEXT("Frame profiler has no frames captured"));
+		return;
+	}
+
+	// Get the percentile of a sorted list of values.
+
+	auto percentile = [] (const TArray<float>& values, float ratio)
+	{
+		return values[FMath::Clamp(FMath::CeilToInt(ratio * values.Num()) - 1, 0, values.Num() - 1)];
+	};
+
+	TArray<float> values;
+
+	values.Reserve(numFrames);
+
+	UE_LOG(GripLog, Display, TEXT("Frame profile over the last %d frames (p50 / p90 / p99 / max ms, mean count):"), numFrames);
+
+	for (int32 i = -1; i < (int32)EFrameProfilerCategory::Num; i++)
+	{
+		float counts = 0.0f;
+
+		values.Reset();
+
+		for (int32 j = 0; j < numFrames; j++)
+		{
+			const FFrame& frame = GetFrame(j);
+
+			values.Emplace((i < 0) ? frame.FrameTime : frame.Costs[i]);
+			counts += (i < 0) ? 1.0f : frame.Counts[i];
+		}
+
+		values.Sort();
+
+		UE_LOG(GripLog, Display, TEXT("  %-20s %7.3f / %7.3f / %7.3f / %7.3f, %.1f"), (i < 0) ? TEXT("Frame") : CategoryNames[i], percentile(values, 0.5f), percentile(values, 0.9f), percentile(values, 0.99f), values.Last(), counts / numFrames);
+	}
+
+	for (int32 i = 0; i < GRIP_MAX_PLAYERS; i++)
+	{
+		float sum = 0.0f;
+
+		for (int32 j = 0; j < numFrames; j++)
+		{
+			sum += GetFrame(j).VehicleCosts[i];
+		}
+
+		if (sum > 0.0f)
+		{
+			UE_LOG(GripLog, Display, TEXT("  Vehicle %d mean %.3fms"), i, sum / numFrames);
+		}
+	}
+}
+
+/**
+* Write the CSV file of the frames captured.
+***********************************************************************************/
+
+bool FFrameProfiler::WriteCSV(const FString& filename) const
+{
+	FString csv = TEXT("Frame,FrameMs");
+
+	for (int32 i = 0; i < (int32)EFrameProfilerCategory::Num; i++)
+	{
+		csv += FString::Printf(TEXT(",%sMs,%sCount"), CategoryNames[i], CategoryNames[i]);
+	}
+
+	for (int32 i = 0; i < GRIP_MAX_PLAYERS; i++)
+	{
+		csv += FString::Printf(TEXT(",Vehicle%dMs"), i);
+	}
+
+	csv += TEXT("\n");
+
+	// Write the frames oldest first.
+
+	int32 firstFrame = NumFrames - Frames.Num();
+
+	for (int32 j = Frames.Num() - 1; j >= 0; j--)
+	{
+		const FFrame& frame = GetFrame(j);
+
+		csv += FString::Printf(TEXT("%d,%.4f"), firstFrame++, frame.FrameTime);
+
+		for (int32 i = 0; i < (int32)EFrameProfilerCategory::Num; i++)
+		{
+			csv += FString::Printf(TEXT(",%.4f,%d"), frame.Costs[i], frame.Counts[i]);
+		}
+
+		for (int32 i = 0; i < GRIP_MAX_PLAYERS; i++)
+		{
+			csv += FString::Printf(TEXT(",%.4f"), frame.VehicleCosts[i]);
+		}
+
+		csv += TEXT("\n");
+	}
+
+	return FFileHelper::SaveStringToFile(csv, *filename);
+}
+
+/**
+* Write the Chrome trace JSON file of the scopes captured, as complete events with
+* timestamps in microseconds from the start of the capture.
+***********************************************************************************/
+
+bool FFrameProfiler::WriteTrace(const FString& filename) const
+{
+	double usPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000000.0;
+	uint32 processId = FPlatformProcess::GetCurrentProcessId();
+	FString json = TEXT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	FScopeLock lock(&TraceLock);
+
+	for (int32 i = 0; i < TraceEvents.Num(); i++)
+	{
+		const FTraceEvent& event = TraceEvents[i];
+
+		json += FString::Printf(TEXT("{\"name\":\"%s\",\"cat\":\"grip\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%u,\"tid\":%u,\"args\":{\"vehicle\":%d}}%s\n"),
+			CategoryNames[(int32)event.Category],
+			(event.StartCycles - StartCycles) * usPerCycle,
+			(event.EndCycles - event.StartCycles) * usPerCycle,
+			processId, event.ThreadId, event.VehicleIndex,
+			(i < TraceEvents.Num() - 1) ? TEXT(",") : TEXT(""));
+	}
+
+	json += TEXT("]}\n");
+
+	return FFileHelper::SaveStringToFile(json, *filename);
+}
+
+/**
+* Console commands for controlling the frame profiler.
+***********************************************************************************/
+
+static void StartFrameProfiler(const TArray<FString>& args, UWorld* world)
+{
+	bool trace = (args.Num() > 0 && args[0] == TEXT("trace"));
+
+	FFrameProfiler::Get().Start((world != nullptr) ? world->GetMapName() : FString(TEXT("Unknown")), trace);
+}
+
+static void StopFrameProfiler(const TArray<FString>& args)
+{
+	FFrameProfiler::Get().Stop();
+}
+
+static void ReportFrameProfiler(const TArray<FString>& args)
+{
+	FFrameProfiler::Get().Report();
+}
+
+static FAutoConsoleCommand StartFrameProfilerCommand(
+	TEXT("grip.FrameProfiler.Start"),
+	TEXT("Start capturing the per-subsystem frame profile.\n")
+	TEXT("  Pass trace to also record a Chrome trace of every timed scope."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&StartFrameProfiler));
+
+static FAutoConsoleCommand StopFrameProfilerCommand(
+	TEXT("grip.FrameProfiler.Stop"),
+	TEXT("Stop capturing the per-subsystem frame profile and export it to the Saved/Profiling directory."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&StopFrameProfiler));
+
+static FAutoConsoleCommand ReportFrameProfilerCommand(
+	TEXT("grip.FrameProfiler.Report"),
+	TEXT("Log the rolling percentiles of the per-subsystem frame profile."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ReportFrameProfiler));
+
+#endif // GRIP_FRAME_PROFILER
@@ -0,0 +1,631 @@
+/**
+*
+* Deterministic race replay recording and playback.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Record the control inputs made to every vehicle in a race, along with the random
+* seed and a fixed timestep, into a compact binary stream. Playing that stream
+* back reproduces the race, so that laggy moments can be profiled repeatedly and
+* physics changes benchmarked against identical input traces.
+*
+***********************************************************************************/
+
+#include "system/racereplay.h"
+
+#if GRIP_RACE_REPLAY
+
+#include "gamemodes/playgamemode.h"
+#include "vehicle/basevehicle.h"
+#include "misc/filehelper.h"
+#include "serialization/memorywriter.h"
+#include "serialization/memoryreader.h"
+
+/**
+* FRaceReplay statics.
+***********************************************************************************/
+
+// The identifier at the start of a replay file.
+const uint32 FRaceReplay::FileMagic = 0x4c505247;
+
+// The version of the replay file format.
+const int32 FRaceReplay::FileVersion = 1;
+
+// The race replay for this process.
+FRaceReplay FRaceReplay::Instance;
+
+/**
+* Flags used to compact the inputs in the replay file.
+***********************************************************************************/
+
+static const uint8 ReplayInputTypeMask = 0x0f;
+static const uint8 ReplayInputInTick = 0x10;
+static const uint8 ReplayInputHasValue = 0x20;
+static const uint8 ReplayInputHasArgument = 0x40;
+
+/**
+* The smallest number of bytes that a frame and an input take in the replay file.
+***********************************************************************************/
+
+static const int64 ReplayFrameMinSize = sizeof(uint32) + 1;
+static const int64 ReplayInputMinSize = 2;
+
+/**
+* Is a race replay recording or playback requested from the command line?
+***********************************************************************************/
+
+bool FRaceReplay::IsRequested()
+{
+	const TCHAR* commandLine = FCommandLine::Get();
+	FString filename;
+
+	return (FParse::Param(commandLine, TEXT("GripRecordReplay")) == true ||
+		FParse::Value(commandLine, TEXT("GripRecordReplay="), filename) == true ||
+		FParse::Value(commandLine, TEXT("GripPlayReplay="), filename) == true);
+}
+
+/**
+* Start recording or playing back, called from the game mode once the level has
+* begun play.
+***********************************************************************************/
+
+void FRaceReplay::Start(APlayGameMode* gameMode)
+{
+	const TCHAR* commandLine = FCommandLine::Get();
+	UWorld* world = gameMode->GetWorld();
+
+	Frames.Reset();
+	TickCursors.Reset();
+
+	FrameIndex = 0;
+	InputDepth = 0;
+	Injecting = false;
+	TickingVehicle = nullptr;
+	InjectedFrameIndex = INDEX_NONE;
+	InputsDivergedFrame = INDEX_NONE;
+	StateDivergedFrame = INDEX_NONE;
+	NumPhysicsSubsteps = 0;
+
+	GameMode = gameMode;
+
+	if (FParse::Value(commandLine, TEXT("GripPlayReplay="), Filename) == true)
+	{
+		if (Load() == false)
+		{
+			Mode = EMode::None;
+
+			return;
+		}
+
+		if (MapName != world->GetMapName())
+		{
+			UE_LOG(GripLog, Warning, TEXT("Race replay %s was recorded on %s, not %s"), *Filename, *MapName, *world->GetMapName());
+		}
+
+		Mode = EMode::Playing;
+
+		if (PreActorTickHandle.IsValid() == false)
+		{
+			PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddRaw(this, &FRaceReplay::InjectPlayerInputs);
+		}
+	}
+	else
+	{
+		Mode = EMode::Recording;
+		MapName = world->GetMapName();
+		Seed = (int32)FDateTime::Now().ToUnixTimestamp();
+
+#if GRIP_FIXED_TIMING
+		FramesPerSecond = GRIP_TIMING_FPS;
+#else // GRIP_FIXED_TIMING
+		FramesPerSecond = 60.0f;
+#endif // GRIP_FIXED_TIMING
+
+		FParse::Value(commandLine, TEXT("GripReplayFPS="), FramesPerSecond);
+		FParse::Value(commandLine, TEXT("GripReplaySeed="), Seed);
+
+		FramesPerSecond = FMath::Clamp(FramesPerSecond, 10.0f, 1000.0f);
+
+		Filename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Replays"), FString::Printf(TEXT("%s-%s.gripreplay"), *MapName, *FDateTime::Now().ToString()));
+
+		FParse::Value(commandLine, TEXT("GripRecordReplay="), Filename);
+
+		Frames.AddDefaulted();
+	}
+
+	// Seed the simulation's random number stream and fix the timestep so that the race
+	// can be reproduced. The physics sub-step size is already fixed in ABaseGameMode.
+	// The global random number generators are left alone, as the cameras, effects and
+	// HUD draw from them a varying number of times per frame.
+
+	APlayGameMode::SimulationRandom.Initialize(Seed);
+
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / FramesPerSecond);
+
+	UE_LOG(GripLog, Display, TEXT("Race replay %s %s on %s at %d FPS with seed %d"), (Mode == EMode::Recording) ? TEXT("recording to") : TEXT("playing from"), *Filename, *MapName, (int32)FramesPerSecond, Seed);
+}
+
+/**
+* Tick the race replay, called from the game mode at the end of every frame, after
+* all of the vehicles have ticked.
+***********************************************************************************/
+
+void FRaceReplay::Tick(APlayGameMode* gameMode)
+{
+	if (gameMode->GetWorld()->IsPaused() == true)
+	{
+		// The vehicles don't tick while paused, so neither do the frames.
+
+		return;
+	}
+
+	if (Mode == EMode::Recording)
+	{
+		Frames[FrameIndex].Checksum = CalculateChecksum(gameMode);
+		Frames.AddDefaulted();
+	}
+	else if (Mode == EMode::Playing)
+	{
+		const FRaceReplayFrame& frame = Frames[FrameIndex];
+
+		// Check that all of the in-tick inputs for the frame were consumed.
+
+		if (InputsDivergedFrame == INDEX_NONE)
+		{
+			for (int32 i = 0; i < frame.Inputs.Num(); i++)
+			{
+				const FRaceReplayInput& input = frame.Inputs[i];
+
+				if (input.InTick == true &&
+					(TickCursors.IsValidIndex(input.VehicleIndex) == false || TickCursors[input.VehicleIndex] <= i))
+				{
+					InputsDivergedFrame = FrameIndex;
+
+					UE_LOG(GripLog, Warning, TEXT("Race replay inputs diverged at frame %d, vehicle %d didn't make all of its recorded inputs"), FrameIndex, input.VehicleIndex);
+
+					break;
+				}
+			}
+		}
+
+		if (StateDivergedFrame == INDEX_NONE &&
+			frame.Checksum != CalculateChecksum(gameMode))
+		{
+			StateDivergedFrame = FrameIndex;
+
+			UE_LOG(GripLog, Warning, TEXT("Race replay vehicle state diverged at frame %d"), FrameIndex);
+		}
+
+		if (FrameIndex + 1 >= Frames.Num())
+		{
+			// We've run out of frames so hand control back to the players and AI.
+
+			ReportPlayback();
+
+			Mode = EMode::None;
+		}
+	}
+
+	TickCursors.Reset();
+
+	FrameIndex++;
+	NumPhysicsSubsteps = 0;
+}
+
+/**
+* Stop recording or playing back when the level is unloaded, writing the replay
+* file if recording.
+***********************************************************************************/
+
+void FRaceReplay::Stop()
+{
+	if (Mode == EMode::Recording)
+	{
+		// The last frame is incomplete, so drop it.
+
+		Frames.Pop();
+
+		Save();
+	}
+	else if (Mode == EMode::Playing)
+	{
+		ReportPlayback();
+	}
+
+	Mode = EMode::None;
+	TickingVehicle = nullptr;
+	GameMode.Reset();
+
+	if (PreActorTickHandle.IsValid() == true)
+	{
+		FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+		PreActorTickHandle.Reset();
+	}
+
+	Frames.Empty();
+	TickCursors.Empty();
+}
+
+/**
+* Inject the inputs made outside of vehicle ticks for the current frame when
+* playing back, called before the world's actors tick.
+*
+* These are normally player inputs, processed by the player controllers in the
+* pre-physics tick group when recording, so they're injected before that tick
+* group here so that the physics sees them in the same frame as it did then.
+***********************************************************************************/
+
+void FRaceReplay::InjectPlayerInputs(UWorld* world, ELevelTick tickType, float deltaSeconds)
+{
+	APlayGameMode* gameMode = GameMode.Get();
+
+	if (Mode != EMode::Playing ||
+		gameMode == nullptr ||
+		gameMode->GetWorld() != world ||
+		world->IsPaused() == true ||
+		InjectedFrameIndex == FrameIndex)
+	{
+		return;
+	}
+
+	InjectedFrameIndex = FrameIndex;
+	Injecting = true;
+
+	for (const FRaceReplayInput& input : Frames[FrameIndex].Inputs)
+	{
+		if (input.InTick == false)
+		{
+			for (ABaseVehicle* vehicle : gameMode->GetVehicles())
+			{
+				if (vehicle->GetVehicleIndex() == input.VehicleIndex)
+				{
+					vehicle->InjectReplayInput(input.Type, input.Value, input.Argument);
+
+					break;
+				}
+			}
+		}
+	}
+
+	Injecting = false;
+}
+
+/**
+* Begin an input to a vehicle, recording it or substituting the recorded input,
+* returning false if it should be blocked.
+***********************************************************************************/
+
+bool FRaceReplay::BeginInput(ABaseVehicle* vehicle, ERaceReplayInput type, float* value, int32* argument)
+{
+	if (InputDepth++ > 0 ||
+		Mode == EMode::None)
+	{
+		// Nested inputs are the result of an outer input that has already been handled.
+
+		return true;
+	}
+
+	int32 vehicleIndex = vehicle->GetVehicleIndex();
+	bool inTick = (TickingVehicle != nullptr);
+
+	if (Mode == EMode::Recording)
+	{
+		FRaceReplayInput& input = Frames[FrameIndex].Inputs.AddDefaulted_GetRef();
+
+		input.VehicleIndex = (uint8)vehicleIndex;
+		input.Type = type;
+		input.InTick = inTick;
+		input.Argument = (argument != nullptr) ? *argument : 0;
+		input.Value = (value != nullptr) ? *value : 0.0f;
+
+		return true;
+	}
+
+	if (Injecting == true)
+	{
+		return true;
+	}
+
+	if (inTick == false)
+	{
+		// Block inputs from outside of vehicle ticks, the recorded ones having
+		// already been injected at the start of the frame.
+
+		return false;
+	}
+
+	if (InputsDivergedFrame == INDEX_NONE)
+	{
+		// Substitute the next recorded in-tick input for this vehicle.
+
+		const TArray<FRaceReplayInput>& inputs = Frames[FrameIndex].Inputs;
+
+		if (TickCursors.Num() <= vehicleIndex)
+		{
+			TickCursors.AddZeroed(vehicleIndex + 1 - TickCursors.Num());
+		}
+
+		int32& cursor = TickCursors[vehicleIndex];
+
+		while (cursor < inputs.Num() &&
+			(inputs[cursor].VehicleIndex != vehicleIndex || inputs[cursor].InTick == false))
+		{
+			cursor++;
+		}
+
+		if (cursor < inputs.Num() &&
+			inputs[cursor].Type == type)
+		{
+			if (value != nullptr)
+			{
+				*value = inputs[cursor].Value;
+			}
+
+			if (argument != nullptr)
+			{
+				*argument = inputs[cursor].Argument;
+			}
+
+			cursor++;
+		}
+		else
+		{
+			InputsDivergedFrame = FrameIndex;
+
+			UE_LOG(GripLog, Warning, TEXT("Race replay inputs diverged at frame %d, vehicle %d made an unexpected input"), FrameIndex, vehicleIndex);
+		}
+	}
+
+	return true;
+}
+
+/**
+* Calculate the checksum of the state of all of the vehicles, along with the
+* number of physics sub-steps that were run to get there.
+***********************************************************************************/
+
+uint32 FRaceReplay::CalculateChecksum(APlayGameMode* gameMode) const
+{
+	uint32 checksum = FCrc::MemCrc32((const void*)&NumPhysicsSubsteps, sizeof(int32));
+
+	for (ABaseVehicle* vehicle : gameMode->GetVehicles())
+	{
+		FVector location = vehicle->GetActorLocation();
+		FQuat rotation = vehicle->GetActorQuat();
+		FVector velocity = vehicle->GetVelocity();
+
+		checksum = FCrc::MemCrc32(&location, sizeof(location), checksum);
+		checksum = FCrc::MemCrc32(&rotation, sizeof(rotation), checksum);
+		checksum = FCrc::MemCrc32(&velocity, sizeof(velocity), checksum);
+	}
+
+	return checksum;
+}
+
+/**
+* Save the recorded frames to the replay file.
+*
+* Inputs are stored as a vehicle index and a flags byte, followed by the value only
+* if it has changed since the last input of the same type to the same vehicle, and
+* the argument only if it's non-zero. Most inputs therefore take just two bytes.
+***********************************************************************************/
+
+bool FRaceReplay::Save() const
+{
+	TArray<uint8> data;
+	FMemoryWriter writer(data);
+	uint32 magic = FileMagic;
+	int32 version = FileVersion;
+	FString mapName = MapName;
+	int32 seed = Seed;
+	float framesPerSecond = FramesPerSecond;
+	int32 numFrames = Frames.Num();
+	TArray<float> lastValues;
+
+	writer << magic << version << mapName << seed << framesPerSecond << numFrames;
+
+	for (const FRaceReplayFrame& frame : Frames)
+	{
+		uint32 checksum = frame.Checksum;
+		int32 numInputs = frame.Inputs.Num();
+
+		writer << checksum;
+		writer.SerializeIntPacked((uint32&)numInputs);
+
+		for (const FRaceReplayInput& input : frame.Inputs)
+		{
+			int32 valueIndex = (input.VehicleIndex * (int32)ERaceReplayInput::Num) + (int32)input.Type;
+
+			if (lastValues.Num() <= valueIndex)
+			{
+				lastValues.AddZeroed(valueIndex + 1 - lastValues.Num());
+			}
+
+			uint8 vehicleIndex = input.VehicleIndex;
+			uint8 flags = (uint8)input.Type;
+
+			flags |= (input.InTick == true) ? ReplayInputInTick : 0;
+			flags |= (input.Value != lastValues[valueIndex]) ? ReplayInputHasValue : 0;
+			flags |= (input.Argument != 0) ? ReplayInputHasArgument : 0;
+
+			writer << vehicleIndex << flags;
+
+			if ((flags & ReplayInputHasValue) != 0)
+			{
+				float value = input.Value;
+
+				writer << value;
+
+				lastValues[valueIndex] = value;
+			}
+
+			if ((flags & ReplayInputHasArgument) != 0)
+			{
+				uint8 argument = (uint8)input.Argument;
+
+				writer << argument;
+			}
+		}
+	}
+
+	if (FFileHelper::SaveArrayToFile(data, *Filename) == true)
+	{
+		UE_LOG(GripLog, Display, TEXT("Race replay of %d frames written to %s, %d bytes"), Frames.Num(), *Filename, data.Num());
+
+		return true;
+	}
+	else
+	{
+		UE_LOG(GripLog, Error, TEXT("Race replay could not be written to %s"), *Filename);
+
+		return false;
+	}
+}
+
+/**
+* Load the frames to play back from the replay file.
+***********************************************************************************/
+
+bool FRaceReplay::Load()
+{
+	TArray<uint8> data;
+
+	if (FFileHelper::LoadFileToArray(data, *Filename) == false)
+	{
+		UE_LOG(GripLog, Error, TEXT("Race replay %s could not be read"), *Filename);
+
+		return false;
+	}
+
+	FMemoryReader reader(data);
+	uint32 magic = 0;
+	int32 version = 0;
+	int32 numFrames = 0;
+	TArray<float> lastValues;
+
+	reader << magic << version;
+
+	if (magic != FileMagic ||
+		version != FileVersion)
+	{
+		UE_LOG(GripLog, Error, TEXT("Race replay %s isn't a replay file of version %d"), *Filename, FileVersion);
+
+		return false;
+	}
+
+	reader << MapName << Seed << FramesPerSecond << numFrames;
+
+	// Every frame takes at least a checksum and an input count, and every input at
+	// least a vehicle index and a flags byte, so counts that couldn't fit in the rest
+	// of the file mean it's corrupt and mustn't be used to size any allocations.
+
+	if (reader.IsError() == true ||
+		numFrames < 0 ||
+		numFrames > (reader.TotalSize() - reader.Tell()) / ReplayFrameMinSize)
+	{
+		UE_LOG(GripLog, Error, TEXT("Race replay %s is corrupt"), *Filename);
+
+		return false;
+	}
+
+	Frames.Reset(numFrames);
+
+	for (int32 i = 0; i < numFrames && reader.IsError() == false; i++)
+	{
+		FRaceReplayFrame& frame = Frames.AddDefaulted_GetRef();
+		int32 numInputs = 0;
+
+		reader << frame.Checksum;
+		reader.SerializeIntPacked((uint32&)numInputs);
+
+		if (numInputs < 0 ||
+			numInputs > (reader.TotalSize() - reader.Tell()) / ReplayInputMinSize)
+		{
+			UE_LOG(GripLog, Error, TEXT("Race replay %s is corrupt"), *Filename);
+
+			Frames.Empty();
+
+			return false;
+		}
+
+		frame.Inputs.Reserve(numInputs);
+
+		for (int32 j = 0; j < numInputs && reader.IsError() == false; j++)
+		{
+			FRaceReplayInput& input = frame.Inputs.AddDefaulted_GetRef();
+			uint8 flags = 0;
+
+			reader << input.VehicleIndex << flags;
+
+			input.Type = (ERaceReplayInput)(flags & ReplayInputTypeMask);
+			input.InTick = ((flags & ReplayInputInTick) != 0);
+
+			if (input.Type >= ERaceReplayInput::Num)
+			{
+				UE_LOG(GripLog, Error, TEXT("Race replay %s is corrupt"), *Filename);
+
+				Frames.Empty();
+
+				return false;
+			}
+
+			int32 valueIndex = (input.VehicleIndex * (int32)ERaceReplayInput::Num) + (int32)input.Type;
+
+			if (lastValues.Num() <= valueIndex)
+			{
+				lastValues.AddZeroed(valueIndex + 1 - lastValues.Num());
+			}
+
+			if ((flags & ReplayInputHasValue) != 0)
+			{
+				reader << lastValues[valueIndex];
+			}
+
+			input.Value = lastValues[valueIndex];
+
+			if ((flags & ReplayInputHasArgument) != 0)
+			{
+				uint8 argument = 0;
+
+				reader << argument;
+
+				input.Argument = argument;
+			}
+		}
+	}
+
+	if (reader.IsError() == true ||
+		Frames.Num() == 0)
+	{
+		UE_LOG(GripLog, Error, TEXT("Race replay %s is truncated or empty"), *Filename);
+
+		Frames.Empty();
+
+		return false;
+	}
+
+	return true;
+}
+
+/**
+* Report the outcome of a playback.
+***********************************************************************************/
+
+void FRaceReplay::ReportPlayback() const
+{
+	if (InputsDivergedFrame == INDEX_NONE &&
+		StateDivergedFrame == INDEX_NONE)
+	{
+		UE_LOG(GripLog, Display, TEXT("Race replay played back %d of %d frames identically"), FMath::Min(FrameIndex + 1, Frames.Num()), Frames.Num());
+	}
+	else
+	{
+		UE_LOG(GripLog, Warning, TEXT("Race replay played back %d of %d frames, inputs diverged at frame %d and vehicle state at frame %d"), FMath::Min(FrameIndex + 1, Frames.Num()), Frames.Num(), InputsDivergedFrame, StateDivergedFrame);
+	}
+}
+
+#endif // GRIP_RACE_REPLAY
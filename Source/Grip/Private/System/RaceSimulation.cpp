@@ -0,0 +1,250 @@
+/**
+*
+* Headless race simulation harness.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Run complete races with only AI drivers, no viewport, no audio and no HUD, as
+* fast as the CPU allows under a fixed timestep. This is used for regression and
+* throughput testing of the vehicle physics and AI on machines without a GPU.
+*
+***********************************************************************************/
+
+#include "system/racesimulation.h"
+
+#if GRIP_RACE_SIMULATION
+
+#include "gamemodes/playgamemode.h"
+#include "vehicle/basevehicle.h"
+#include "game/globalgamestate.h"
+#include "misc/filehelper.h"
+#include "dom/jsonobject.h"
+#include "serialization/jsonwriter.h"
+#include "serialization/jsonserializer.h"
+
+/**
+* FRaceSimulation statics.
+***********************************************************************************/
+
+// The race simulation for this process.
+FRaceSimulation FRaceSimulation::Instance;
+
+/**
+* Is a race simulation requested from the command line?
+***********************************************************************************/
+
+bool FRaceSimulation::IsRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("GripSimulate"));
+}
+
+/**
+* Start the race simulation, called from the game mode once the level has begun play.
+***********************************************************************************/
+
+void FRaceSimulation::Start(APlayGameMode* gameMode)
+{
+	const TCHAR* commandLine = FCommandLine::Get();
+
+	Active = true;
+	Seed = (int32)FDateTime::Now().ToUnixTimestamp();
+
+	FParse::Value(commandLine, TEXT("GripSimulateFPS="), FramesPerSecond);
+	FParse::Value(commandLine, TEXT("GripSimulateTimeLimit="), TimeLimit);
+	FParse::Value(commandLine, TEXT("GripSimulateSeed="), Seed);
+
+	FramesPerSecond = FMath::Clamp(FramesPerSecond, 10.0f, 1000.0f);
+
+	ReportFilename = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RaceSimulation"), FString::Printf(TEXT("%s-%s.json"), *gameMode->GetWorld()->GetMapName(), *FDateTime::Now().ToString()));
+
+	FParse::Value(commandLine, TEXT("GripSimulateReport="), ReportFilename);
+
+	UGlobalGameState* gameState = UGlobalGameState::GetGlobalGameState(gameMode);
+	int32 numLaps = 0;
+
+	if (FParse::Value(commandLine, TEXT("GripSimulateLaps="), numLaps) == true &&
+		numLaps > 0 &&
+		gameState != nullptr)
+	{
+		gameState->GeneralOptions.NumberOfLaps = numLaps;
+	}
+
+	// Seed the simulation's random number stream so that races can be repeated.
+
+	APlayGameMode::SimulationRandom.Initialize(Seed);
+
+	// Run with a fixed timestep and don't wait around between frames, so that we go
+	// as fast as the CPU allows.
+
+	FApp::SetBenchmarking(true);
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(1.0 / FramesPerSecond);
+
+	GEngine->bSmoothFrameRate = false;
+	GEngine->bUseFixedFrameRate = false;
+
+	UWorld* world = gameMode->GetWorld();
+
+	world->bAllowAudioPlayback = false;
+
+	if (world->GetGameViewport() != nullptr)
+	{
+		world->GetGameViewport()->bDisableWorldRendering = true;
+	}
+
+	if (FApp::CanEverRender() == true)
+	{
+		UE_LOG(GripLog, Warning, TEXT("Race simulation is running with a renderer, use -nullrhi for a headless simulation"));
+	}
+
+	NumFrames = 0;
+	SimulatedSeconds = 0.0;
+	MaxFrameCost = 0.0;
+	StartTime = LastFrameTime = FPlatformTime::Seconds();
+
+	for (int64& cost : Costs)
+	{
+		cost = 0;
+	}
+
+	UE_LOG(GripLog, Display, TEXT("Race simulation started on %s at %d FPS with seed %d"), *world->GetMapName(), (int32)FramesPerSecond, Seed);
+}
+
+/**
+* Tick the race simulation, called from the game mode once every frame.
+***********************************************************************************/
+
+void FRaceSimulation::Tick(APlayGameMode* gameMode, float deltaSeconds)
+{
+	if (Active == true)
+	{
+		double time = FPlatformTime::Seconds();
+		double frameCost = time - LastFrameTime;
+
+		AddCost(ERaceSimulationCost::Frame, (uint64)(frameCost / FPlatformTime::GetSecondsPerCycle64()));
+
+		MaxFrameCost = FMath::Max(MaxFrameCost, frameCost);
+		LastFrameTime = time;
+		SimulatedSeconds += deltaSeconds;
+		NumFrames++;
+
+		if (gameMode->GameHasEnded() == true)
+		{
+			Finish(gameMode, false);
+		}
+		else if (SimulatedSeconds > TimeLimit)
+		{
+			Finish(gameMode, true);
+		}
+	}
+}
+
+/**
+* Finish the race simulation, writing the report and exiting the process.
+***********************************************************************************/
+
+void FRaceSimulation::Finish(APlayGameMode* gameMode, bool timedOut)
+{
+	double wallSeconds = FPlatformTime::Seconds() - StartTime;
+	double secondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+	int32 numFrames = FMath::Max(NumFrames, 1);
+
+	UE_LOG(GripLog, Display, TEXT("Race simulation %s after %d frames, %.1f simulated seconds in %.1f wall seconds (%.1fx real-time)"), (timedOut == true) ? TEXT("timed out") : TEXT("complete"), NumFrames, SimulatedSeconds, wallSeconds, SimulatedSeconds / FMath::Max(wallSeconds, 0.001));
+	UE_LOG(GripLog, Display, TEXT("Frame %.3fms mean, %.3fms max, game mode %.3fms, vehicles %.3fms, physics %.3fms, AI %.3fms"),
+		(Costs[(int32)ERaceSimulationCost::Frame] * secondsPerCycle * 1000.0) / numFrames,
+		MaxFrameCost * 1000.0,
+		(Costs[(int32)ERaceSimulationCost::GameMode] * secondsPerCycle * 1000.0) / numFrames,
+		(Costs[(int32)ERaceSimulationCost::Vehicle] * secondsPerCycle * 1000.0) / numFrames,
+		(Costs[(int32)ERaceSimulationCost::VehiclePhysics] * secondsPerCycle * 1000.0) / numFrames,
+		(Costs[(int32)ERaceSimulationCost::VehicleAI] * secondsPerCycle * 1000.0) / numFrames);
+
+	for (ABaseVehicle* vehicle : gameMode->Vehicles)
+	{
+		const FPlayerRaceState& raceState = vehicle->GetRaceState();
+
+		UE_LOG(GripLog, Display, TEXT("  Position %d vehicle %d %s, %d laps, race time %.3f, best lap %.3f"), raceState.RacePosition + 1, vehicle->GetVehicleIndex(), *vehicle->GetName(), FMath::Max(raceState.MaxLapNumber, 0), raceState.RaceTime, raceState.BestLapTime);
+	}
+
+	WriteReport(gameMode, timedOut, wallSeconds);
+
+	Active = false;
+
+	FPlatformMisc::RequestExit(false);
+}
+
+/**
+* Write the JSON report for the race.
+***********************************************************************************/
+
+void FRaceSimulation::WriteReport(APlayGameMode* gameMode, bool timedOut, double wallSeconds) const
+{
+	double secondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+	int32 numFrames = FMath::Max(NumFrames, 1);
+	UGlobalGameState* gameState = UGlobalGameState::GetGlobalGameState(gameMode);
+	TSharedRef<FJsonObject> report = MakeShared<FJsonObject>();
+
+	report->SetStringField(TEXT("map"), gameMode->GetWorld()->GetMapName());
+	report->SetNumberField(TEXT("seed"), Seed);
+	report->SetNumberField(TEXT("framesPerSecond"), FramesPerSecond);
+	report->SetNumberField(TEXT("laps"), (gameState != nullptr) ? gameState->GeneralOptions.NumberOfLaps : 0);
+	report->SetBoolField(TEXT("timedOut"), timedOut);
+	report->SetNumberField(TEXT("frames"), NumFrames);
+	report->SetNumberField(TEXT("simulatedSeconds"), SimulatedSeconds);
+	report->SetNumberField(TEXT("wallSeconds"), wallSeconds);
+	report->SetNumberField(TEXT("realTimeFactor"), SimulatedSeconds / FMath::Max(wallSeconds, 0.001));
+	report->SetNumberField(TEXT("maxFrameMs"), MaxFrameCost * 1000.0);
+
+	// The mean cost per frame in milliseconds for each category.
+
+	static const TCHAR* costNames[] = { TEXT("frame"), TEXT("gameMode"), TEXT("vehicle"), TEXT("vehiclePhysics"), TEXT("vehicleAI") };
+
+	static_assert(GRIP_NUM_ELEMENTS(costNames) == (int32)ERaceSimulationCost::Num, "Race simulation cost names are out of step");
+
+	TSharedRef<FJsonObject> costs = MakeShared<FJsonObject>();
+
+	for (int32 i = 0; i < (int32)ERaceSimulationCost::Num; i++)
+	{
+		costs->SetNumberField(costNames[i], (Costs[i] * secondsPerCycle * 1000.0) / numFrames);
+	}
+
+	report->SetObjectField(TEXT("meanFrameCostMs"), costs);
+
+	TArray<TSharedPtr<FJsonValue>> vehicles;
+
+	for (ABaseVehicle* vehicle : gameMode->Vehicles)
+	{
+		const FPlayerRaceState& raceState = vehicle->GetRaceState();
+		TSharedRef<FJsonObject> entry = MakeShared<FJsonObject>();
+
+		entry->SetNumberField(TEXT("vehicleIndex"), vehicle->GetVehicleIndex());
+		entry->SetStringField(TEXT("name"), vehicle->GetName());
+		entry->SetNumberField(TEXT("position"), raceState.RacePosition + 1);
+		entry->SetNumberField(TEXT("laps"), FMath::Max(raceState.MaxLapNumber, 0));
+		entry->SetNumberField(TEXT("raceTime"), raceState.RaceTime);
+		entry->SetNumberField(TEXT("bestLapTime"), raceState.BestLapTime);
+		entry->SetNumberField(TEXT("raceDistance"), raceState.RaceDistance);
+		entry->SetBoolField(TEXT("complete"), raceState.PlayerCompletionState == EPlayerCompletionState::Complete);
+
+		vehicles.Emplace(MakeShared<FJsonValueObject>(entry));
+	}
+
+	report->SetArrayField(TEXT("vehicles"), vehicles);
+
+	FString json;
+	TSharedRef<TJsonWriter<>> writer = TJsonWriterFactory<>::Create(&json);
+
+	if (FJsonSerializer::Serialize(report, writer) == true &&
+		FFileHelper::SaveStringToFile(json, *ReportFilename) == true)
+	{
+		UE_LOG(GripLog, Display, TEXT("Race simulation report written to %s"), *ReportFilename);
+	}
+	else
+	{
+		UE_LOG(GripLog, Error, TEXT("Race simulation report could not be written to %s"), *ReportFilename);
+	}
+}
+
+#endif // GRIP_RACE_SIMULATION
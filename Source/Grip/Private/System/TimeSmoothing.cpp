@@ -0,0 +1,116 @@
+/**
+*
+* List of values against time and common operations.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A micro-benchmark comparing TTimedValueList with FRunningTimedFloatList, across
+* the list configurations that are actually used in the game. Run it with the
+* grip.BenchmarkTimedLists console command, optionally passing the number of
+* frames to simulate.
+*
+***********************************************************************************/
+
+#include "system/timesmoothing.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+* Run the common queries used by the game against a timed list, recording the results.
+***********************************************************************************/
+
+template<typename ListType>
+static double BenchmarkTimedList(ListType& list, int32 numFrames, float frameSeconds, TArray<float>& results)
+{
+	FRandomStream random(1);
+	float clock = 0.0f;
+
+	results.Reset(numFrames * 6);
+
+	double startTime = FPlatformTime::Seconds();
+
+	for (int32 i = 0; i < numFrames; i++)
+	{
+		clock += frameSeconds;
+
+		list.AddValue(clock, random.FRandRange(-100.0f, 100.0f));
+
+		results.Emplace(list.GetMeanValue());
+		results.Emplace(list.GetMeanValue(clock - 0.5f));
+		results.Emplace(list.GetAbsMeanValue(clock - 5.0f));
+		results.Emplace(list.GetSumValue(clock - 2.0f));
+		results.Emplace(list.GetMinValue(clock - 10.0f));
+		results.Emplace(list.GetMaxValue(clock - 10.0f));
+	}
+
+	return FPlatformTime::Seconds() - startTime;
+}
+
+/**
+* Benchmark TTimedValueList against FRunningTimedFloatList.
+***********************************************************************************/
+
+static void BenchmarkTimedLists(const TArray<FString>& args)
+{
+	struct FListConfiguration
+	{
+		const TCHAR* Name;
+		int32 MaxSeconds;
+		int32 SamplesPerSecond;
+		bool AverageSamples;
+		bool SumSamples;
+	};
+
+	// The list configurations used in VehiclePhysics.h, VehicleContactSensor.h and PlayerAIContext.h.
+
+	static const FListConfiguration configurations[] =
+	{
+		{ TEXT("GroundedList / AirborneList"), 5, 10, true, false },
+		{ TEXT("AngularPitchList"), 5, 25, true, false },
+		{ TEXT("VelocityPitchList"), 5, 200, false, false },
+		{ TEXT("PitchChangeList"), 10, 25, false, true },
+		{ TEXT("CompressionList"), 1, 10, true, false },
+		{ TEXT("ThrottleList / FrameTimes"), 1, 30, true, false },
+		{ TEXT("AI Thrust"), 21, 30, true, false },
+		{ TEXT("AI Speed / RaceDistances etc."), 21, 10, true, false }
+	};
+
+	int32 numFrames = (args.Num() > 0) ? FMath::Max(FCString::Atoi(*args[0]), 1) : 100000;
+	float frameSeconds = 1.0f / 120.0f;
+	TArray<float> timedResults;
+	TArray<float> runningResults;
+
+	UE_LOG(GripLog, Display, TEXT("Benchmarking timed lists over %d frames"), numFrames);
+
+	for (const FListConfiguration& configuration : configurations)
+	{
+		FTimedFloatList timedList(configuration.MaxSeconds, configuration.SamplesPerSecond, configuration.AverageSamples, configuration.SumSamples);
+		FRunningTimedFloatList runningList(configuration.MaxSeconds, configuration.SamplesPerSecond, configuration.AverageSamples, configuration.SumSamples);
+
+		double timedSeconds = BenchmarkTimedList(timedList, numFrames, frameSeconds, timedResults);
+		double runningSeconds = BenchmarkTimedList(runningList, numFrames, frameSeconds, runningResults);
+
+		// Check that both lists produce the same results, within float tolerance as
+		// the running list sums in double precision.
+
+		float maxError = 0.0f;
+
+		for (int32 i = 0; i < timedResults.Num(); i++)
+		{
+			maxError = FMath::Max(maxError, FMath::Abs(timedResults[i] - runningResults[i]) / FMath::Max(1.0f, FMath::Abs(timedResults[i])));
+		}
+
+		UE_LOG(GripLog, Display, TEXT("%s (%d, %d): TTimedValueList %.3fms, FRunningTimedFloatList %.3fms, %.2fx, max relative error %g"), configuration.Name, configuration.MaxSeconds, configuration.SamplesPerSecond, timedSeconds * 1000.0, runningSeconds * 1000.0, timedSeconds / FMath::Max(runningSeconds, 0.000001), maxError);
+	}
+}
+
+static FAutoConsoleCommand BenchmarkTimedListsCommand(
+	TEXT("grip.BenchmarkTimedLists"),
+	TEXT("Benchmark TTimedValueList against FRunningTimedFloatList.\n")
+	TEXT("  Optionally pass the number of frames to simulate."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkTimedLists));
+
+#endif // !UE_BUILD_SHIPPING
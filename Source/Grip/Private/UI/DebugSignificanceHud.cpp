@@ -0,0 +1,64 @@
+/**
+*
+* Vehicle significance debugging HUD.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+***********************************************************************************/
+
+#include "ui/debugsignificancehud.h"
+#include "vehicle/flippablevehicle.h"
+
+/**
+* Draw the HUD.
+***********************************************************************************/
+
+void ADebugSignificanceHUD::DrawHUD()
+{
+	Super::DrawHUD();
+
+	HorizontalOffset = 200.0f;
+
+	APlayGameMode* gameMode = APlayGameMode::Get(GetWorld());
+
+	if (gameMode != nullptr)
+	{
+		const FVehicleSignificance& significance = gameMode->VehicleSignificance;
+
+		AddBool(TEXT("Enabled"), FVehicleSignificance::IsEnabled());
+		AddFloat(TEXT("Cosmetic ms / frame"), significance.GetSpentTime());
+		AddFloat(TEXT("Saved ms / frame"), significance.GetSavedTime());
+
+		for (int32 i = 0; i < (int32)EVehicleSignificanceTier::Num; i++)
+		{
+			EVehicleSignificanceTier tier = (EVehicleSignificanceTier)i;
+
+			AddInt(FVehicleSignificance::GetTierName(tier), significance.GetNumVehicles(tier));
+		}
+
+		GRIP_GAME_MODE_LIST_FROM(GetVehicles(), vehicles, gameMode);
+
+		Y += LineHeight;
+
+		AddText(TEXT(""), FText::FromString(TEXT("Tier      Sig   Dist  Vis")));
+
+		for (ABaseVehicle* vehicle : vehicles)
+		{
+			int32 index = vehicle->VehicleIndex;
+
+			if (index >= 0 &&
+				index < GRIP_MAX_PLAYERS)
+			{
+				EVehicleSignificanceTier tier = significance.GetTier(index);
+				FString string = FString::Printf(TEXT("%-8s  %0.2f  %4d  %1d"), FVehicleSignificance::GetTierName(tier), significance.GetSignificance(index), FMath::RoundToInt(significance.GetDistance(index) / 100.0f), (significance.IsVisible(index) == true) ? 1 : 0);
+
+				AddText(*vehicle->GetPlayerName(false, false), FText::FromString(string));
+
+				AddTextIntAt(FVehicleSignificance::GetTierName(tier), (int32)tier, vehicle->GetCenterLocation(), -10.0f, 0.0f);
+			}
+		}
+	}
+}
@@ -0,0 +1,200 @@
+/**
+*
+* HUD view-model implementation.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* The values shown on a player HUD for a vehicle, refreshed at most once per frame
+* and with the text for each only formatted when the value behind it changes.
+*
+***********************************************************************************/
+
+#include "ui/hudviewmodel.h"
+#include "vehicle/basevehicle.h"
+#include "gamemodes/playgamemode.h"
+
+#pragma region VehicleHUD
+
+/**
+* Refresh the view-model from the vehicle if it hasn't already been refreshed this
+* frame.
+***********************************************************************************/
+
+void FHUDViewModel::Refresh(ABaseVehicle* vehicle, UGlobalGameState* gameState, APlayGameMode* playGameMode)
+{
+	if (RefreshFrame == GFrameCounter ||
+		gameState == nullptr ||
+		playGameMode == nullptr)
+	{
+		return;
+	}
+
+	RefreshFrame = GFrameCounter;
+	ChangedFields = EHUDViewModelField::None;
+
+	auto changed = [this] (bool updated, EHUDViewModelField field)
+	{
+		if (updated == true)
+		{
+			ChangedFields |= field;
+		}
+	};
+
+	const FPlayerRaceState& raceState = vehicle->GetRaceState();
+	ESpeedDisplayUnit speedUnit = gameState->GeneralOptions.SpeedUnit;
+	bool mach = (speedUnit == ESpeedDisplayUnit::MACH);
+
+	PointsLabelText.Update(vehicle->LocalPlayerIndex, [vehicle] ()
+		{
+			return FText::FromString(FString::Printf(TEXT("%dUP"), vehicle->LocalPlayerIndex + 1));
+		});
+
+	// The speed unit is mixed into the speed keys as the format of the speed depends upon it.
+
+	for (int32 i = 0; i < 2; i++)
+	{
+		int32 speed = vehicle->GetDisplaySpeed(i);
+
+		changed(SpeedoText[i].Update(((int64)speed << 8) | (int64)speedUnit, [mach, i, speed] ()
+			{
+				return FText::FromString(FString::Printf((mach == false) ? TEXT("%03d") : ((i == 0) ? TEXT("%01d") : TEXT("%02d")), speed));
+			}), EHUDViewModelField::Speed);
+	}
+
+	changed(KPHText.Update((int64)speedUnit, [speedUnit] ()
+		{
+			switch (speedUnit)
+			{
+			case ESpeedDisplayUnit::MPH:
+				return NSLOCTEXT("GripScoreboard", "mph", "mph");
+			case ESpeedDisplayUnit::KPH:
+				return NSLOCTEXT("GripScoreboard", "kph", "kph");
+			default:
+				return NSLOCTEXT("GripScoreboard", "mach", "mach");
+			}
+		}), EHUDViewModelField::SpeedUnit);
+
+	// A key of -1 is used for values that aren't yet shown.
+
+	int32 position = (raceState.LapNumber < 0 && gameState->GamePlaySetup.DrivingMode != EDrivingMode::Elimination) ? -1 : ((gameState->IsGameModeRanked() == true) ? raceState.RaceRank + 1 : raceState.RacePosition + 1);
+
+	changed(PositionTextLeft.Update(position, [position] ()
+		{
+			return (position < 0) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), position));
+		}), EHUDViewModelField::Position);
+
+	int32 numOpponentsLeft = playGameMode->GetNumOpponentsLeft();
+
+	changed(PositionTextRight.Update(numOpponentsLeft, [numOpponentsLeft] ()
+		{
+			return FText::FromString(FString::Printf(TEXT("/%d"), numOpponentsLeft));
+		}), EHUDViewModelField::Position);
+
+	int32 rank = raceState.RaceRank + 1;
+
+	changed(RankTextLeft.Update(rank, [rank] ()
+		{
+			return FText::FromString(FString::Printf(TEXT("%d"), rank));
+		}), EHUDViewModelField::Rank);
+
+	int32 lap = (raceState.LapNumber < 0) ? -1 : raceState.LapNumber + 1;
+
+	changed(LapTextLeft.Update(lap, [lap] ()
+		{
+			return (lap < 0) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), lap));
+		}), EHUDViewModelField::Lap);
+
+	int32 numLaps = (int32)gameState->GeneralOptions.NumberOfLaps;
+
+	changed(LapTextRight.Update(numLaps, [numLaps] ()
+		{
+			return FText::FromString(FString::Printf(TEXT("/%d"), numLaps));
+		}), EHUDViewModelField::Lap);
+
+	int32 points = raceState.NumInGamePoints;
+
+	changed(PointsText.Update(points, [points] ()
+		{
+			return FText::FromString(FString::Printf(TEXT("%d"), points));
+		}), EHUDViewModelField::Points);
+
+	int32 kills = (int32)raceState.NumKills;
+
+	changed(KillsText.Update(kills, [kills] ()
+		{
+			return FText::FromString(FString::Printf(TEXT("%d"), kills));
+		}), EHUDViewModelField::Kills);
+
+	int32 deaths = (int32)raceState.NumDeaths;
+
+	changed(DeathsText.Update(deaths, [deaths] ()
+		{
+			return FText::FromString(FString::Printf(TEXT("/%d"), deaths));
+		}), EHUDViewModelField::Deaths);
+
+	int32 damage = (int32)((float)(raceState.MaxHitPoints - raceState.HitPoints) / (float)raceState.MaxHitPoints * 100);
+
+	changed(DamageText.Update(damage, [damage] ()
+		{
+			return FText::FromString(FString::Printf(TEXT("%d%%"), damage));
+		}), EHUDViewModelField::Damage);
+
+	changed(RaceTimeText.Update(TimeKey(raceState.RaceTime), [vehicle] ()
+		{
+			return FText::FromString(vehicle->GetFormattedRaceTime());
+		}), EHUDViewModelField::RaceTime);
+
+	changed(BestLapTimeText.Update(TimeKey(raceState.BestLapTime), [vehicle] ()
+		{
+			return FText::FromString(vehicle->GetFormattedBestLapTime());
+		}), EHUDViewModelField::BestLapTime);
+
+	bool lastLap = (raceState.LapNumber >= 1 && raceState.LapTime < 5);
+
+	changed(LapTimeText.Update(((lastLap == true) ? (1ll << 32) : 0ll) | TimeKey((lastLap == true) ? raceState.LastLapTime : raceState.LapTime), [vehicle, lastLap] ()
+		{
+			return FText::FromString((lastLap == true) ? vehicle->GetFormattedLastLapTime() : vehicle->GetFormattedLapTime());
+		}), EHUDViewModelField::LapTime);
+
+	int32 eliminationSeconds = (playGameMode->GetEliminationTimer() >= 0.0f) ? FMath::CeilToInt(GRIP_ELIMINATION_SECONDS - playGameMode->GetEliminationTimer()) : -1;
+
+	changed(EliminationTimerText.Update(eliminationSeconds, [eliminationSeconds] ()
+		{
+			return (eliminationSeconds >= 0) ? FText::FromString(FString::Printf(TEXT("%02d"), eliminationSeconds)) : FText::FromString("--");
+		}), EHUDViewModelField::EliminationTimer);
+
+	// Calculate the scale for rendering the race positions, which is the distance
+	// to the furthest player from this vehicle, within limits.
+
+	float maxDistance = 0.0f;
+
+	for (ABaseVehicle* other : playGameMode->GetVehicles())
+	{
+		if (other != vehicle &&
+			other->IsVehicleDestroyed() == false)
+		{
+			maxDistance = FMath::Max(maxDistance, FMath::Abs(other->GetRaceState().RaceDistance - raceState.RaceDistance));
+		}
+	}
+
+	RacePositionScale = (int32)(FMath::Clamp(maxDistance, 500.0f * 100.0f, 2000.0f * 100.0f) / 100.0f);
+
+	for (int32 i = 0; i < 2; i++)
+	{
+		int32 distance = (i == 0) ? RacePositionScale : -RacePositionScale;
+
+		changed(((i == 0) ? RacePositionScaleForeText : RacePositionScaleRearText).Update(distance, [distance] ()
+			{
+				FFormatNamedArguments arguments;
+
+				arguments.Add(TEXT("Distance"), FText::AsNumber(distance));
+
+				return FText::Format(NSLOCTEXT("GripHUD", "RaceDistance", "{Distance} m"), arguments);
+			}), EHUDViewModelField::RacePositionScale);
+	}
+}
+
+#pragma endregion VehicleHUD
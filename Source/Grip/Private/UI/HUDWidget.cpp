@@ -44,6 +44,11 @@ void UHUDWidgetComponent::PostInitProperties()
 		PlayGameMode = APlayGameMode::Get(this);
 		GameState = UGlobalGameState::GetGlobalGameState(GetWorld());
 
+		if (PlayGameMode != nullptr)
+		{
+			NextWeaponEvent = PlayGameMode->GameEvents.Num();
+		}
+
 		APlayerController* owningPlayer = GetOwningPlayer();
 
 		if (owningPlayer != nullptr)
@@ -294,10 +299,16 @@ FText UHUDWidgetComponent::GetEventPositionText(int32 position, bool oneBased)
 
 FText UHUDWidgetComponent::GetKPHText() const
 {
+	ABaseVehicle* vehicle = GetTargetVehicle();
+
 	if (GameState == nullptr)
 	{
 		return FText::FromString("kph");
 	}
+	else if (vehicle != nullptr)
+	{
+		return vehicle->GetHUDViewModel().KPHText.Get();
+	}
 	else
 	{
 		switch (GameState->GeneralOptions.SpeedUnit)
@@ -520,19 +531,56 @@ bool UHUDWidgetComponent::IsWeaponEventOfInterest(int32 index) const
 	{
 		FGameEvent& event = events[index];
 
-		if (event.EventType == EGameEventType::Blocked ||
-			event.EventType == EGameEventType::Destroyed ||
-			event.EventType == EGameEventType::ChatMessage)
-		{
-			return true;
-		}
+		return IsWeaponEventOfInterest(event.EventType, event.PickupUsed);
+	}
 
-		if (event.EventType == EGameEventType::Impacted &&
-			(event.PickupUsed == EPickupType::HomingMissile))
+	return false;
+}
+
+/**
+* Get the indices of the weapon events of interest to the HUD that have happened
+* since this was last called, so that the HUD only looks at new events rather
+* than scanning through all of them.
+***********************************************************************************/
+
+void UHUDWidgetComponent::GetNewWeaponEventsOfInterest(TArray<int32>& indices)
+{
+	indices.Reset();
+
+	if (PlayGameMode != nullptr)
+	{
+		TArray<FGameEvent>& events = PlayGameMode->GameEvents;
+
+		for (; NextWeaponEvent < events.Num(); NextWeaponEvent++)
 		{
-			return true;
+			FGameEvent& event = events[NextWeaponEvent];
+
+			if (IsWeaponEventOfInterest(event.EventType, event.PickupUsed) == true)
+			{
+				indices.Emplace(NextWeaponEvent);
+			}
 		}
 	}
+}
+
+/**
+* Is a weapon event of a particular type of interest to the HUD?
+***********************************************************************************/
+
+bool UHUDWidgetComponent::IsWeaponEventOfInterest(EGameEventType eventType, EPickupType pickupUsed)
+{
+	if (eventType == EGameEventType::Blocked ||
+		eventType == EGameEventType::Destroyed ||
+		eventType == EGameEventType::ChatMessage)
+	{
+		return true;
+	}
+
+	if (eventType == EGameEventType::Impacted &&
+		(pickupUsed == EPickupType::HomingMissile))
+	{
+		return true;
+	}
 
 	return false;
 }
@@ -695,32 +743,9 @@ FText UHUDWidgetComponent::GetRacePositionScaleText(int32 distance) const
 
 int32 UHUDWidgetComponent::GetRacePositionScale() const
 {
-	if (GetTargetVehicle() != nullptr)
-	{
-		float maxDistance = 0.0f;
-		ABaseVehicle* yourVehicle = GetTargetVehicle();
-
-		if (yourVehicle != nullptr)
-		{
-			int32 you = GetTargetVehicle()->VehicleIndex;
-			TArray<ABaseVehicle*>& vehicles = PlayGameMode->GetVehicles();
-
-			for (ABaseVehicle* vehicle : vehicles)
-			{
-				if (vehicle->VehicleIndex != you &&
-					vehicle->IsVehicleDestroyed() == false)
-				{
-					maxDistance = FMath::Max(maxDistance, FMath::Abs(vehicle->GetRaceState().RaceDistance - yourVehicle->GetRaceState().RaceDistance));
-				}
-			}
-
-			float packLength = FMath::Clamp(maxDistance, 500.0f * 100.0f, 2000.0f * 100.0f);
-
-			return (int32)(packLength / 100.0f);
-		}
-	}
+	ABaseVehicle* vehicle = GetTargetVehicle();
 
-	return 0;
+	return (vehicle == nullptr) ? 0 : vehicle->GetHUDViewModel().RacePositionScale;
 }
 
 /**
@@ -1074,6 +1099,8 @@ void UHUDWidget::SetupComponents(UCanvasPanel* mainPanel) const
 
 void UHUDWidget::Update(float deltaSeconds)
 {
+	GRIP_FRAME_PROFILER_SCOPE(HUD, INDEX_NONE);
+
 	if (PlayGameMode->GetClock() > 0.0f &&
 		PlayGameMode->GetClock() - PlayGameMode->LastOptionsResetTime < 10.0f)
 	{
@@ -1131,6 +1158,8 @@ void UHUDWidget::Ignite()
 
 void UHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
+	GRIP_FRAME_PROFILER_SCOPE(HUD, INDEX_NONE);
+
 	Super::NativeTick(MyGeometry, InDeltaTime);
 
 	ABaseVehicle* vehicle = GetOwningVehicle();
@@ -1145,4 +1174,19 @@ void UHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 
 		LastLapCompleted = vehicle->GetRaceState().LapNumber;
 	}
+
+	// Push the values that have changed to the widget blueprint, the view-model
+	// having been refreshed at most once this frame for all HUDs looking at it.
+
+	vehicle = GetTargetVehicle();
+
+	if (vehicle != nullptr)
+	{
+		EHUDViewModelField changedFields = vehicle->GetHUDViewModel().GetChangedFields();
+
+		if (changedFields != EHUDViewModelField::None)
+		{
+			ViewModelChanged((int32)changedFields);
+		}
+	}
 }
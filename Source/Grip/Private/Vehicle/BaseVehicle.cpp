@@ -60,6 +60,7 @@ USoundCue* FVehicleElimination::AlertSound = nullptr;
 #pragma endregion BlueprintAssets
 
 float ABaseVehicle::PickupHookTime = 0.5f;
+const float ABaseVehicle::MaxPadCollectionSweep = 50.0f * 100.0f;
 bool ABaseVehicle::ProbabilitiesInitialized = false;
 
 #pragma region Vehicle
@@ -814,6 +815,9 @@ void ABaseVehicle::EndPlay(const EEndPlayReason::Type endPlayReason)
 
 void ABaseVehicle::Tick(float deltaSeconds)
 {
+	GRIP_RACE_SIMULATION_SCOPE(Vehicle);
+	GRIP_RACE_REPLAY_TICK_SCOPE();
+
 	Super::Tick(deltaSeconds);
 
 	const FTransform& transform = VehicleMesh->GetComponentTransform();
@@ -831,6 +835,17 @@ void ABaseVehicle::Tick(float deltaSeconds)
 		return;
 	}
 
+	// Determine how much of the cosmetic work to do this frame, from the significance
+	// of the vehicle to the local cameras. The work skipped is caught up with on the
+	// next frame it's done, except for dormant vehicles where the visual work is
+	// suspended altogether.
+
+	FVehicleSignificance& significance = PlayGameMode->VehicleSignificance;
+	float visualDeltaSeconds = significance.GetVisualDeltaSeconds(VehicleIndex, deltaSeconds);
+	float audioDeltaSeconds = significance.GetAudioDeltaSeconds(VehicleIndex, deltaSeconds);
+	uint64 visualCycles = 0;
+	uint64 audioCycles = 0;
+
 #pragma region VehicleCatchup
 
 	UpdateCatchup();
@@ -839,7 +854,12 @@ void ABaseVehicle::Tick(float deltaSeconds)
 
 #pragma region VehicleSpringArm
 
-	UpdateCockpitMaterials();
+	if (visualDeltaSeconds != 0.0f)
+	{
+		FVehicleSignificanceCycleScope cycleScope(visualCycles);
+
+		UpdateCockpitMaterials();
+	}
 
 #pragma endregion VehicleSpringArm
 
@@ -881,7 +901,12 @@ void ABaseVehicle::Tick(float deltaSeconds)
 
 #pragma region VehicleHUD
 
-	UpdateHUDAnimation(deltaSeconds);
+	if (visualDeltaSeconds != 0.0f)
+	{
+		FVehicleSignificanceCycleScope cycleScope(visualCycles);
+
+		UpdateHUDAnimation(visualDeltaSeconds);
+	}
 
 #pragma endregion VehicleHUD
 
@@ -911,7 +936,14 @@ void ABaseVehicle::Tick(float deltaSeconds)
 
 #pragma region PickupTurbo
 
-	UpdateLightStreaks(deltaSeconds);
+	SuspendLightStreaks(significance.GetTier(VehicleIndex) == EVehicleSignificanceTier::Dormant);
+
+	if (visualDeltaSeconds != 0.0f)
+	{
+		FVehicleSignificanceCycleScope cycleScope(visualCycles);
+
+		UpdateLightStreaks(visualDeltaSeconds);
+	}
 
 #pragma endregion PickupTurbo
 
@@ -926,7 +958,12 @@ void ABaseVehicle::Tick(float deltaSeconds)
 	// Update the animated bones, mostly related to having the wheels animate with rolling,
 	// steering and suspension movement.
 
-	UpdateAnimatedBones(deltaSeconds, xdirection, ydirection);
+	if (visualDeltaSeconds != 0.0f)
+	{
+		FVehicleSignificanceCycleScope cycleScope(visualCycles);
+
+		UpdateAnimatedBones(visualDeltaSeconds, xdirection, ydirection);
+	}
 
 #pragma endregion VehicleAnimation
 
@@ -938,6 +975,7 @@ void ABaseVehicle::Tick(float deltaSeconds)
 
 #pragma region PickupPads
 
+	UpdatePadCollectionCapsules();
 	CollectPickups();
 
 #pragma endregion PickupPads
@@ -950,7 +988,12 @@ void ABaseVehicle::Tick(float deltaSeconds)
 
 #pragma region VehicleAudio
 
-	UpdateSkidAudio(deltaSeconds);
+	if (audioDeltaSeconds != 0.0f)
+	{
+		FVehicleSignificanceCycleScope cycleScope(audioCycles);
+
+		UpdateSkidAudio(audioDeltaSeconds);
+	}
 
 #pragma endregion VehicleAudio
 
@@ -962,7 +1005,14 @@ void ABaseVehicle::Tick(float deltaSeconds)
 
 #pragma region VehicleSurfaceEffects
 
-	UpdateSurfaceEffects(deltaSeconds);
+	SuspendSurfaceEffects(significance.GetTier(VehicleIndex) == EVehicleSignificanceTier::Dormant);
+
+	if (visualDeltaSeconds != 0.0f)
+	{
+		FVehicleSignificanceCycleScope cycleScope(visualCycles);
+
+		UpdateSurfaceEffects(visualDeltaSeconds);
+	}
 
 #pragma endregion VehicleSurfaceEffects
 
@@ -1001,6 +1051,8 @@ void ABaseVehicle::Tick(float deltaSeconds)
 	AI.VehicleContacts = VehicleUnblocked;
 	AI.CollisionBlockage = VehicleUnblocked;
 	AI.HardCollisionBlockage = VehicleUnblocked;
+
+	significance.AddCycles(VehicleIndex, visualCycles, audioCycles);
 }
 
 /**
@@ -2392,6 +2444,8 @@ void ABaseVehicle::Throttle(float value, bool bot)
 {
 	if (bot == AI.BotDriver)
 	{
+		GRIP_RACE_REPLAY_INPUT(ERaceReplayInput::Throttle, &value, nullptr);
+
 		bool paused = false;
 
 		if (PlayGameMode != nullptr)
@@ -2438,6 +2492,8 @@ void ABaseVehicle::Steering(float value, bool analog, bool bot)
 {
 	if (bot == AI.BotDriver)
 	{
+		GRIP_RACE_REPLAY_INPUT((analog == true) ? ERaceReplayInput::AnalogSteering : ERaceReplayInput::DigitalSteering, &value, nullptr);
+
 		bool paused = false;
 
 		if (PlayGameMode != nullptr)
@@ -2503,6 +2559,8 @@ void ABaseVehicle::HandbrakePressed(bool bot)
 {
 	if (bot == AI.BotDriver)
 	{
+		GRIP_RACE_REPLAY_INPUT(ERaceReplayInput::HandbrakePressed, nullptr, nullptr);
+
 		if (Control.BrakeInput < 0.1f)
 		{
 			// Determine the braking bias only when the brake is off, and maintain
@@ -2527,6 +2585,8 @@ void ABaseVehicle::HandbrakeReleased(bool bot)
 {
 	if (bot == AI.BotDriver)
 	{
+		GRIP_RACE_REPLAY_INPUT(ERaceReplayInput::HandbrakeReleased, nullptr, nullptr);
+
 		if (Control.BrakeInput != 0.0f)
 		{
 			Control.BrakeInput = 0.0f;
@@ -2552,6 +2612,55 @@ void ABaseVehicle::HandbrakeReleased(bool bot)
 	}
 }
 
+#if GRIP_RACE_REPLAY
+
+/**
+* Inject a control input into the vehicle from a race replay.
+***********************************************************************************/
+
+void ABaseVehicle::InjectReplayInput(ERaceReplayInput type, float value, int32 argument)
+{
+	bool bot = AI.BotDriver;
+
+	switch (type)
+	{
+	case ERaceReplayInput::Throttle:
+		Throttle(value, bot);
+		break;
+	case ERaceReplayInput::AnalogSteering:
+		Steering(value, true, bot);
+		break;
+	case ERaceReplayInput::DigitalSteering:
+		Steering(value, false, bot);
+		break;
+	case ERaceReplayInput::HandbrakePressed:
+		HandbrakePressed(bot);
+		break;
+	case ERaceReplayInput::HandbrakeReleased:
+		HandbrakeReleased(bot);
+		break;
+	case ERaceReplayInput::BeginUsePickup:
+		BeginUsePickup(argument, bot, value != 0.0f);
+		break;
+	case ERaceReplayInput::UsePickup:
+		UsePickup(argument, (EPickupActivation)(int32)value, bot);
+		break;
+	case ERaceReplayInput::BoostOn:
+		BoostOn(value != 0.0f);
+		break;
+	case ERaceReplayInput::BoostOff:
+		BoostOff(value != 0.0f);
+		break;
+	case ERaceReplayInput::PitchControl:
+		PitchControl(value);
+		break;
+	default:
+		break;
+	}
+}
+
+#endif // GRIP_RACE_REPLAY
+
 /**
 * Handle the use of automatic braking to assist the driver.
 ***********************************************************************************/
@@ -2896,6 +3005,8 @@ void ABaseVehicle::UpdateSteering(float deltaSeconds, const FVector& xdirection,
 
 void ABaseVehicle::PitchControl(float value)
 {
+	GRIP_RACE_REPLAY_INPUT(ERaceReplayInput::PitchControl, &value, nullptr);
+
 	if (AI.BotDriver == false &&
 		GameState->InputControllerOptions.IsValidIndex(LocalPlayerIndex) == true)
 	{
@@ -2920,13 +3031,14 @@ void ABaseVehicle::PitchControl(float value)
 
 UParticleSystemComponent* ABaseVehicle::SpawnDrivingSurfaceEffect(const FVehicleWheel& wheel, UParticleSystem* particleSystem)
 {
-	UParticleSystemComponent* component = NewObject<UParticleSystemComponent>(this);
+	// We don't auto-destroy components at this point because they often get reused
+	// quickly after they are apparently finished with. They're released back into
+	// the object pool when they're discarded instead, where there is one.
+
+	UParticleSystemComponent* component = (PlayGameMode != nullptr) ? PlayGameMode->ObjectPool.AcquireParticleSystem(this, UParticleSystemComponent::StaticClass(), false) : NewObject<UParticleSystemComponent>(this);
 
 	if (component != nullptr)
 	{
-		// We don't auto-destroy components at this point because they often get reused
-		// quickly after they are apparently finished with.
-
 		component->bAutoActivate = true;
 		component->bAutoDestroy = false;
 
@@ -2958,18 +3070,48 @@ UParticleSystemComponent* ABaseVehicle::SpawnDrivingSurfaceEffect(const FVehicle
 		component->SetTemplate(particleSystem);
 		component->SetOwnerNoSee(IsCockpitView());
 
-		// Don't forget to register the component.
+		// Don't forget to register the component, if it's not been pooled.
 
-		component->RegisterComponent();
+		if (component->IsRegistered() == false)
+		{
+			component->RegisterComponent();
+		}
 
-		// And now activate it.
+		// And now activate it, resetting it in case it's been pooled.
 
-		component->Activate();
+		component->Activate(true);
 	}
 
 	return component;
 }
 
+/**
+* Suspend or resume the surface effects from the wheels, when the vehicle is
+* dormant and can't be seen.
+*
+* UpdateSurfaceEffects isn't called while the vehicle is dormant, so the effects
+* would otherwise be left emitting with whatever parameters they last had. They're
+* discarded instead, letting their particles die naturally, and new effects are
+* spawned by UpdateSurfaceEffects once the vehicle is no longer dormant.
+***********************************************************************************/
+
+void ABaseVehicle::SuspendSurfaceEffects(bool suspend)
+{
+	if (SurfaceEffectsSuspended != suspend)
+	{
+		SurfaceEffectsSuspended = suspend;
+
+		if (suspend == true)
+		{
+			for (FVehicleWheel& wheel : Wheels.Wheels)
+			{
+				wheel.SurfaceComponents.DiscardComponents();
+				wheel.FixedSurfaceComponents.DiscardComponents();
+			}
+		}
+	}
+}
+
 /**
 * Update the surface effects from the wheels.
 ***********************************************************************************/
@@ -4240,6 +4382,10 @@ void ABaseVehicle::UpdateTeleportation(float deltaSeconds)
 
 				TeleportAudio = UGameplayStatics::SpawnSoundAttached(TeleportSound, VehicleMesh, NAME_None, FVector(ForceInit), EAttachLocation::KeepRelativeOffset, false, GlobalVolume);
 
+				// The reset effects aren't pooled as they're moved, faded and deactivated
+				// through the teleport sequence, and so must never be reclaimed for another
+				// effect while we still hold onto them.
+
 				if (ResetEffectBlueprint != nullptr)
 				{
 					ResetEffectIn = NewObject<UParticleSystemComponent>(this);
@@ -4592,6 +4738,10 @@ void ABaseVehicle::Teleport(FRouteFollower& routeFollower, FVector location, FRo
 
 		SetActorLocationAndRotation(location, rotation, false, nullptr, ETeleportType::TeleportPhysics, true);
 
+		// Don't collect the pads between where we were and where we've been teleported to.
+
+		PadCollectionLocationValid = false;
+
 		if (RaceState.RaceTime < 10.0f)
 		{
 			VehicleMesh->SetPhysicsLinearVelocity(FVector::ZeroVector);
@@ -4836,6 +4986,15 @@ void ABaseVehicle::UpdateBoost(float deltaSeconds)
 
 void ABaseVehicle::BoostOn(bool force)
 {
+
+#if GRIP_RACE_REPLAY
+	float forceValue = (force == true) ? 1.0f : 0.0f;
+
+	GRIP_RACE_REPLAY_INPUT(ERaceReplayInput::BoostOn, &forceValue, nullptr);
+
+	force = (forceValue != 0.0f);
+#endif // GRIP_RACE_REPLAY
+
 	if ((Propulsion.AutoBoostState == EAutoBoostState::Charging) &&
 		(force == true || Propulsion.AutoBoost > 0.17f))
 	{
@@ -4852,6 +5011,10 @@ void ABaseVehicle::BoostOn(bool force)
 		EngineBoostAudio->SetVolumeMultiplier(GlobalVolume);
 		GRIP_PLAY_IF_NOT_PLAYING(EngineBoostAudio);
 
+		// The boost effects aren't pooled as we hold onto them after they've completed,
+		// in BoostEffectComponents, and they could otherwise be reclaimed for another
+		// effect that BoostOff would then deactivate.
+
 		BoostEffectComponents.Empty();
 
 		if (BoostEffectBoneNames.Num() == 0)
@@ -4882,6 +5045,15 @@ void ABaseVehicle::BoostOn(bool force)
 
 void ABaseVehicle::BoostOff(bool force)
 {
+
+#if GRIP_RACE_REPLAY
+	float forceValue = (force == true) ? 1.0f : 0.0f;
+
+	GRIP_RACE_REPLAY_INPUT(ERaceReplayInput::BoostOff, &forceValue, nullptr);
+
+	force = (forceValue != 0.0f);
+#endif // GRIP_RACE_REPLAY
+
 	if (Propulsion.AutoBoostState == EAutoBoostState::Discharging)
 	{
 		Propulsion.AutoBoostState = EAutoBoostState::Charging;
@@ -4981,6 +5153,24 @@ void ABaseVehicle::UpdateLightStreaks(float deltaSeconds)
 	}
 }
 
+/**
+* Suspend or resume the addition of points to the light streaks, when the vehicle
+* is dormant and can't be seen.
+***********************************************************************************/
+
+void ABaseVehicle::SuspendLightStreaks(bool suspend)
+{
+	if (LightStreaksSuspended != suspend)
+	{
+		LightStreaksSuspended = suspend;
+
+		for (ULightStreakComponent* lightStreak : LightStreaks)
+		{
+			lightStreak->SetAddPoints(suspend == false);
+		}
+	}
+}
+
 #pragma endregion PickupTurbo
 
 #pragma region VehicleSpringArm
@@ -5336,11 +5526,28 @@ void ABaseVehicle::PlayDeniedSound()
 ***********************************************************************************/
 
 FString ABaseVehicle::GetFormattedSpeedKPH(int32 index) const
+{
+	if (GameState->GeneralOptions.SpeedUnit == ESpeedDisplayUnit::MACH)
+	{
+		return FString::Printf((index == 0) ? TEXT("%01d") : TEXT("%02d"), GetDisplaySpeed(index));
+	}
+	else
+	{
+		return FString::Printf(TEXT("%03d"), GetDisplaySpeed(index));
+	}
+}
+
+/**
+* Get the speed of the vehicle as displayed on the HUD, in kilometers / miles per
+* hour, or the whole or fractional part of the mach number.
+***********************************************************************************/
+
+int32 ABaseVehicle::GetDisplaySpeed(int32 index) const
 {
 	if (GameState->TransientGameState.ShowFPS == true &&
 		GameState->GeneralOptions.SpeedUnit != ESpeedDisplayUnit::MACH)
 	{
-		return FString::Printf(TEXT("%03d"), FMath::RoundToInt(1.0f / PlayGameMode->FrameTimes.GetScaledMeanValue()));
+		return FMath::RoundToInt(1.0f / PlayGameMode->FrameTimes.GetScaledMeanValue());
 	}
 	else
 	{
@@ -5349,17 +5556,17 @@ FString ABaseVehicle::GetFormattedSpeedKPH(int32 index) const
 		switch (GameState->GeneralOptions.SpeedUnit)
 		{
 		case ESpeedDisplayUnit::MPH:
-			return FString::Printf(TEXT("%03d"), FMath::FloorToInt(speed * 0.621371f));
+			return FMath::FloorToInt(speed * 0.621371f);
 		case ESpeedDisplayUnit::KPH:
-			return FString::Printf(TEXT("%03d"), FMath::FloorToInt(speed));
+			return FMath::FloorToInt(speed);
 		default:
 			if (index == 0)
 			{
-				return FString::Printf(TEXT("%01d"), FMath::FloorToInt(speed * 0.000809848f));
+				return FMath::FloorToInt(speed * 0.000809848f);
 			}
 			else
 			{
-				return FString::Printf(TEXT("%02d"), FMath::FloorToInt(FMath::Frac(speed * 0.000809848f) * 100.0f));
+				return FMath::FloorToInt(FMath::Frac(speed * 0.000809848f) * 100.0f);
 			}
 		}
 	}
@@ -5449,6 +5656,8 @@ float ABaseVehicle::GetWrongWayAlpha()
 
 void ABaseVehicle::UpdateHUDAnimation(float deltaSeconds)
 {
+	GRIP_FRAME_PROFILER_SCOPE(HUD, VehicleIndex);
+
 	if (HUDWidget != nullptr)
 	{
 		float maxAlpha = GameState->GeneralOptions.HUDBrightnessLevel;
@@ -5627,7 +5836,7 @@ void ABaseVehicle::UpdateLaunchControl()
 			if (Control.LaunchControl == 0)
 			{
 				int32 level = GameState->GetDifficultyLevel();
-				int32 random = FMath::Rand() % PlayGameMode->GetNumOpponents();
+				int32 random = APlayGameMode::SimulationRandom.RandHelper(PlayGameMode->GetNumOpponents());
 
 				if (level == 0 || random < PlayGameMode->GetNumOpponents() / (1 << level))
 				{
@@ -5685,7 +5894,7 @@ void ABaseVehicle::ResetAttackTimer()
 
 	attackDelay = FMath::Max(attackDelay, FMath::Lerp(attackDelay, 50.0f, FMath::Min(1.0f, PlayGameMode->LastLapRatio * 1.5f)));
 
-	AttackAfter = VehicleClock + FMath::FRandRange(attackDelay, attackDelay * 1.25f);
+	AttackAfter = VehicleClock + APlayGameMode::SimulationRandom.FRandRange(attackDelay, attackDelay * 1.25f);
 }
 
 #pragma endregion ClocksAndTime
@@ -6020,13 +6229,17 @@ void ABaseVehicle::CompletePostSpawn()
 
 #pragma region VehicleHUD
 
-		HookupPlayerHUD();
+		if (PlayGameMode == nullptr ||
+			PlayGameMode->IsSimulatingRace() == false)
+		{
+			HookupPlayerHUD();
+		}
 
 #pragma endregion VehicleHUD
 
 #pragma region AIVehicleControl
 
-		AI.WheelplayStartTime = (FMath::FRand() * 3.0f);
+		AI.WheelplayStartTime = (APlayGameMode::SimulationRandom.FRand() * 3.0f);
 
 #pragma endregion AIVehicleControl
 
@@ -6136,6 +6349,9 @@ const FString& ABaseVehicle::GetPlayerName(bool shortened, bool full)
 
 /**
 * Spawn an appropriately scaled particle system on the vehicle.
+*
+* This is never pooled, as Blueprints are free to hold onto the component after its
+* effect has completed.
 ***********************************************************************************/
 
 UParticleSystemComponent* ABaseVehicle::SpawnParticleSystem(UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, EAttachLocation::Type locationType, float scale, bool autoDestroy)
@@ -6147,36 +6363,83 @@ UParticleSystemComponent* ABaseVehicle::SpawnParticleSystem(UParticleSystem* emi
 		component = NewObject<UParticleSystemComponent>(RootComponent->GetOwner());
 
 		component->bAutoDestroy = autoDestroy;
-		component->bAllowAnyoneToDestroyMe = true;
-		component->SecondsBeforeInactive = 0.0f;
-		component->bAutoActivate = false;
-		component->SetTemplate(emitterTemplate);
-		component->bOverrideLODMethod = false;
 
-		GRIP_ATTACH(component, RootComponent, attachPointName);
+		SetupSpawnedParticleSystem(component, emitterTemplate, attachPointName, location, rotation, locationType, scale);
+	}
+
+	return component;
+}
+
+/**
+* Spawn an appropriately scaled, transient particle system on the vehicle, recycled
+* through the object pool rather than being destroyed once it's completed.
+*
+* Only use this where the component isn't referenced once its effect has completed,
+* as it may then be reused for another effect.
+***********************************************************************************/
 
-		if (locationType == EAttachLocation::KeepWorldPosition)
+UParticleSystemComponent* ABaseVehicle::SpawnPooledParticleSystem(UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, EAttachLocation::Type locationType, float scale)
+{
+	UParticleSystemComponent* component = nullptr;
+
+	if (emitterTemplate != nullptr)
+	{
+		if (PlayGameMode != nullptr)
 		{
-			component->SetWorldLocationAndRotation(location, rotation);
+			component = PlayGameMode->ObjectPool.AcquireParticleSystem(RootComponent->GetOwner(), UParticleSystemComponent::StaticClass(), true);
 		}
 		else
 		{
-			component->SetRelativeLocationAndRotation(location, rotation);
-		}
+			component = NewObject<UParticleSystemComponent>(RootComponent->GetOwner());
 
-		if (scale < KINDA_SMALL_NUMBER)
-		{
-			scale = 1.0f;
+			component->bAutoDestroy = true;
 		}
 
-		component->SetRelativeScale3D(AttachedEffectsScale * scale);
-		component->RegisterComponent();
-		component->ActivateSystem(true);
+		SetupSpawnedParticleSystem(component, emitterTemplate, attachPointName, location, rotation, locationType, scale);
 	}
 
 	return component;
 }
 
+/**
+* Setup a particle system component that's just been spawned on the vehicle, and
+* activate it.
+***********************************************************************************/
+
+void ABaseVehicle::SetupSpawnedParticleSystem(UParticleSystemComponent* component, UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, EAttachLocation::Type locationType, float scale)
+{
+	component->bAllowAnyoneToDestroyMe = true;
+	component->SecondsBeforeInactive = 0.0f;
+	component->bAutoActivate = false;
+	component->SetTemplate(emitterTemplate);
+	component->bOverrideLODMethod = false;
+
+	GRIP_ATTACH(component, RootComponent, attachPointName);
+
+	if (locationType == EAttachLocation::KeepWorldPosition)
+	{
+		component->SetWorldLocationAndRotation(location, rotation);
+	}
+	else
+	{
+		component->SetRelativeLocationAndRotation(location, rotation);
+	}
+
+	if (scale < KINDA_SMALL_NUMBER)
+	{
+		scale = 1.0f;
+	}
+
+	component->SetRelativeScale3D(AttachedEffectsScale * scale);
+
+	if (component->IsRegistered() == false)
+	{
+		component->RegisterComponent();
+	}
+
+	component->ActivateSystem(true);
+}
+
 /**
 * Shakes the user GamePad, according to strength and duration.
 ***********************************************************************************/
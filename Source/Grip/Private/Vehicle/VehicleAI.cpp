@@ -65,7 +65,7 @@ bool ABaseVehicle::AIVehicleGoodForLaunch(float probability, float minimumSpeedK
 
 	if (AI.BotDriver == true)
 	{
-		if (FMath::FRand() <= probability &&
+		if (APlayGameMode::SimulationRandom.FRand() <= probability &&
 			GetSpeedKPH() > minimumSpeedKPH)
 		{
 			FVector vehicleHeading = GetTargetHeading();
@@ -112,6 +112,9 @@ int32 ABaseVehicle::GetPursuitSplineDirection() const
 
 void ABaseVehicle::UpdateAI(float deltaSeconds)
 {
+	GRIP_RACE_SIMULATION_SCOPE(VehicleAI);
+	GRIP_FRAME_PROFILER_SCOPE(VehicleAI, VehicleIndex);
+
 	bool gameStartedForThisVehicle = (PlayGameMode->PastGameSequenceStart() == true);
 	FVector location = GetActorLocation();
 	const FTransform& transform = VehicleMesh->GetComponentTransform();
@@ -144,7 +147,7 @@ void ABaseVehicle::UpdateAI(float deltaSeconds)
 
 		float movementSize = FMath::Max(100.0f, movement.Size());
 
-		AIFollowSpline(location, wasHeadingTo, movement, movementSize, deltaSeconds, numIterations, accuracy);
+		AIFollowSpline(location, wasHeadingTo, movement, movementSize, deltaSeconds, accuracy);
 
 		// See if we should be driving carefully at this point along the spline.
 
@@ -665,7 +668,7 @@ void ABaseVehicle::AIResetSplineFollowing(bool beginPlay, bool allowDeadEnds, bo
 * Follow the current spline, and switch over to the next if necessary.
 ***********************************************************************************/
 
-void ABaseVehicle::AIFollowSpline(const FVector& location, const FVector& wasHeadingTo, const FVector& movement, float movementSize, float deltaSeconds, int32 numIterations, float accuracy)
+void ABaseVehicle::AIFollowSpline(const FVector& location, const FVector& wasHeadingTo, const FVector& movement, float movementSize, float deltaSeconds, float accuracy)
 {
 	if (IsVehicleDestroyed() == false)
 	{
@@ -673,11 +676,11 @@ void ABaseVehicle::AIFollowSpline(const FVector& location, const FVector& wasHea
 
 		if (Clock0p25.ShouldTickNow() == true)
 		{
-			AI.RouteFollower.DetermineThis(location, movementSize, numIterations, accuracy);
+			AI.RouteFollower.DetermineThis(location, movementSize, accuracy);
 		}
 		else
 		{
-			AI.RouteFollower.EstimateThis(location, movement, movementSize, numIterations, accuracy);
+			AI.RouteFollower.EstimateThis(location, movement, movementSize, accuracy);
 		}
 
 		if ((AI.RouteFollower.ThisSpline->DeadEnd == true) &&
@@ -954,7 +957,7 @@ void ABaseVehicle::AIUpdateSplineWeaving(const FVector& location)
 				AI.PursuitSplineWidthTime = FMath::Asin(ratio) * side;
 			}
 
-			if (FMath::RandBool() == true)
+			if (APlayGameMode::SimulationRandom.RandHelper(2) == 0)
 			{
 				// Randomize the two times on the Sin arc that equate to this width, to try to randomize
 				// the weaving vehicles will exhibit from hereon in.
@@ -1041,7 +1044,7 @@ void FVehicleAI::SetDrivingMode(EVehicleAIDrivingMode mode)
 		switch (DifficultyLevel)
 		{
 		case 2:
-			UseProRecovery = (FMath::Rand() & 1) == 0;
+			UseProRecovery = APlayGameMode::SimulationRandom.RandHelper(2) == 0;
 			break;
 		case 3:
 			UseProRecovery = true;
@@ -1073,20 +1076,20 @@ void FVehicleAI::UpdateRevving(float deltaSeconds, bool gameStarted)
 			{
 				if (WillBurnoutOnStartLine == true)
 				{
-					RevvingTime = FMath::FRandRange(1.5f, 2.5f);
+					RevvingTime = APlayGameMode::SimulationRandom.FRandRange(1.5f, 2.5f);
 				}
-				else if (FMath::Rand() & 1)
+				else if (APlayGameMode::SimulationRandom.RandHelper(2) != 0)
 				{
-					RevvingTime = FMath::FRandRange(0.25f, 0.5f);
+					RevvingTime = APlayGameMode::SimulationRandom.FRandRange(0.25f, 0.5f);
 				}
 				else
 				{
-					RevvingTime = FMath::FRandRange(1.0f, 1.5f);
+					RevvingTime = APlayGameMode::SimulationRandom.FRandRange(1.0f, 1.5f);
 				}
 			}
 			else
 			{
-				RevvingTime = FMath::FRandRange(0.5f, 0.75f);
+				RevvingTime = APlayGameMode::SimulationRandom.FRandRange(0.5f, 0.75f);
 			}
 		}
 	}
@@ -1205,12 +1208,12 @@ void ABaseVehicle::AIUpdateTargetsOfOpportunity(const FVector& location, const F
 			{
 				float leastAngle = 0.0f;
 
-				for (auto& element : PlayGameMode->Attractables)
+				auto considerAttractable = [this, &location, &direction, &leastAngle] (AActor* actor, IAttractableInterface* attractable)
 				{
 
 #pragma region VehiclePickups
 
-					APickup* pickup = Cast<APickup>(element.Key);
+					APickup* pickup = Cast<APickup>(actor);
 
 					if (pickup != nullptr)
 					{
@@ -1218,7 +1221,7 @@ void ABaseVehicle::AIUpdateTargetsOfOpportunity(const FVector& location, const F
 
 						if (ArePickupSlotsFilled() == true)
 						{
-							continue;
+							return;
 						}
 
 						// If we have some linked-spline rule then ensure we meet it.
@@ -1227,14 +1230,12 @@ void ABaseVehicle::AIUpdateTargetsOfOpportunity(const FVector& location, const F
 							AI.RouteFollower.ThisSpline != pickup->NearestPursuitSpline &&
 							AI.RouteFollower.NextSpline != pickup->NearestPursuitSpline)
 						{
-							continue;
+							return;
 						}
 					}
 
 #pragma endregion VehiclePickups
 
-					IAttractableInterface* attractable = element.Value;
-
 					if (attractable != nullptr)
 					{
 						if (attractable->IsAttractionActive() == true &&
@@ -1252,10 +1253,35 @@ void ABaseVehicle::AIUpdateTargetsOfOpportunity(const FVector& location, const F
 								leastAngle = FMath::Abs(angle);
 
 								AI.AttractedTo = attractable;
-								AI.AttractedToActor = element.Key;
+								AI.AttractedToActor = actor;
 							}
 						}
 					}
+				};
+
+				const FAttractableIndex& attractableIndex = PlayGameMode->GetAttractableIndex();
+
+				if (FAttractableIndex::IsEnabled() == true &&
+					attractableIndex.IsBuilt() == true)
+				{
+					// Only look at the attractables in a window around our distance along
+					// the master racing spline, as they don't move.
+
+					TArray<FAttractableIndex::FAttractable, TInlineAllocator<16>> attractables;
+
+					attractableIndex.FindAttractables(RaceState.DistanceAlongMasterRacingSpline, attractables);
+
+					for (const FAttractableIndex::FAttractable& element : attractables)
+					{
+						considerAttractable(element.Key, element.Value);
+					}
+				}
+				else
+				{
+					for (auto& element : PlayGameMode->Attractables)
+					{
+						considerAttractable(element.Key, element.Value);
+					}
 				}
 
 				if (GRIP_POINTER_VALID(AI.AttractedToActor) == true)
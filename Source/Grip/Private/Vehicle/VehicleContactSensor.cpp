@@ -37,11 +37,67 @@ void FVehicleContactSensor::Setup(ABaseVehicle* vehicle, int32 alignment, float
 }
 
 /**
-* Sweeps along sensor direction to see if the suspension spring needs to compress.
-* Returned collision time is normalized.
+* Does the sensor require a sweep to determine whether the suspension spring needs
+* to compress, or can it be estimated from the last contact?
 ***********************************************************************************/
 
-bool FVehicleContactSensor::GetCollision(UWorld* world, const FVector& start, const FVector& end, float& time, FHitResult& hitResult, bool estimate)
+bool FVehicleContactSensor::RequiresSweep(const FVector& start, const FVector& end, bool estimate) const
+{
+	FVector rayDirection = end - start;
+	float lineLengthSqr = rayDirection.SizeSquared();
+	FVector contactPointOnPlane = FVector::ZeroVector;
+
+	rayDirection.Normalize();
+
+	if (IntersectEstimatePlane(start, rayDirection, estimate, contactPointOnPlane) == true)
+	{
+		return false;
+	}
+
+	return (lineLengthSqr > SMALL_NUMBER);
+}
+
+/**
+* Intersect the sensor with the plane of the last genuine contact, if we're
+* allowed to estimate from it, so that a sweep can be avoided.
+***********************************************************************************/
+
+bool FVehicleContactSensor::IntersectEstimatePlane(const FVector& start, const FVector& rayDirection, bool estimate, FVector& contactPointOnPlane) const
+{
+	return (estimate == true &&
+		EstimateContact == true &&
+		FMathEx::RayIntersectsPlane(start, rayDirection, EstimateContactPoint, EstimateContactNormal, contactPointOnPlane) == true);
+}
+
+/**
+* Perform the sweep requested by PrepareTick.
+***********************************************************************************/
+
+void FVehicleContactSensor::Sweep(UWorld* world)
+{
+	SweepHit = world->SweepSingleByChannel(HitResult, SweepStart, SweepEnd, FQuat::Identity, ABaseGameMode::ECC_VehicleSpring, SweepShape, Vehicle->ContactSensorQueryParams);
+}
+
+/**
+* Perform the sweeps requested by PrepareTick for a batch of sensors, together
+* rather than interleaved with the rest of the sensor calculations.
+***********************************************************************************/
+
+void FVehicleContactSensor::SweepBatch(UWorld* world, TArrayView<FVehicleContactSensor*> sensors)
+{
+	for (FVehicleContactSensor* sensor : sensors)
+	{
+		sensor->Sweep(world);
+	}
+}
+
+/**
+* Determine whether the suspension spring needs to compress, from the sweep made
+* for it or an estimate from the last contact. Returned collision time is
+* normalized.
+***********************************************************************************/
+
+bool FVehicleContactSensor::GetCollision(const FVector& start, const FVector& end, float& time, bool estimate)
 {
 	FVector rayDirection = end - start;
 	float lineLengthSqr = rayDirection.SizeSquared();
@@ -53,9 +109,7 @@ bool FVehicleContactSensor::GetCollision(UWorld* world, const FVector& start, co
 
 	rayDirection.Normalize();
 
-	if (estimate == true &&
-		EstimateContact == true &&
-		FMathEx::RayIntersectsPlane(start, rayDirection, EstimateContactPoint, EstimateContactNormal, contactPointOnPlane) == true)
+	if (IntersectEstimatePlane(start, rayDirection, estimate, contactPointOnPlane) == true)
 	{
 		// Estimation based on sensor / plane intersection. Assuming the last genuine contact
 		// point is still valid the original point and normal of the intersection can be used
@@ -81,9 +135,11 @@ bool FVehicleContactSensor::GetCollision(UWorld* world, const FVector& start, co
 
 		if (lineLengthSqr > SMALL_NUMBER)
 		{
-			// Perform a sweep to determine nearest surface contacts.
+			// Use the sweep that was made to determine nearest surface contacts.
+
+			check(SweepRequired == true);
 
-			if (world->SweepSingleByChannel(hitResult, start, end, FQuat::Identity, ABaseGameMode::ECC_VehicleSpring, SweepShape, Vehicle->ContactSensorQueryParams) == true)
+			if (SweepHit == true)
 			{
 				// If we detected a surface then determine the surface type.
 
@@ -93,12 +149,12 @@ bool FVehicleContactSensor::GetCollision(UWorld* world, const FVector& start, co
 				{
 					// If the surface isn't tractionless then process the result of the sweep.
 
-					EstimateContactPoint = hitResult.ImpactPoint;
-					EstimateContactNormal = hitResult.ImpactNormal;
-					EstimateTime = hitResult.GetComponent() ? HitResult.Time : 1.f;
+					EstimateContactPoint = HitResult.ImpactPoint;
+					EstimateContactNormal = HitResult.ImpactNormal;
+					EstimateTime = HitResult.GetComponent() ? HitResult.Time : 1.f;
 
-					check(hitResult.ImpactPoint.ContainsNaN() == false);
-					check(hitResult.ImpactNormal.ContainsNaN() == false);
+					check(HitResult.ImpactPoint.ContainsNaN() == false);
+					check(HitResult.ImpactNormal.ContainsNaN() == false);
 					check(rayDirection.ContainsNaN() == false);
 
 					if (FVector::DotProduct(rayDirection, EstimateContactNormal) < 0.0f &&
@@ -179,21 +235,15 @@ FVector FVehicleContactSensor::ComputeNewSpringCompressionAndForce(const FVector
 }
 
 /**
-* Calculate the nearest contact point of the spring in world space.
+* Calculate the nearest contact point of the spring in world space, from the sweep
+* requested by PrepareTick.
 ***********************************************************************************/
 
-void FVehicleContactSensor::CalculateContactPoint(float deltaTime, UWorld* world, const FVector& startPoint, const FVector& direction, bool updatePhysics, bool estimate)
+void FVehicleContactSensor::CalculateContactPoint(float deltaTime, bool updatePhysics, bool estimate)
 {
 	// updatePhysics is only true if the sensor is part of the "active" set for a flippable vehicle -
 	// either the top or bottom set depending on where we've detected a driving surface.
 
-	FVector startPointOffset = startPoint + (direction * StartOffset * GetAlignment());
-
-	StartPoint = startPointOffset;
-	Direction = direction;
-
-	// direction is the Z direction of the vehicle for reference.
-
 	FVector end = SensorPositionFromLength(WheelRadius + HoverDistance);
 
 	if (updatePhysics == true)
@@ -206,7 +256,7 @@ void FVehicleContactSensor::CalculateContactPoint(float deltaTime, UWorld* world
 		float sweepLength = GetSensorLength();
 		FVector extent = SensorPositionFromLength(sweepLength);
 
-		if (GetCollision(world, StartPoint, extent, time, HitResult, estimate) == true)
+		if (GetCollision(StartPoint, extent, time, estimate) == true)
 		{
 			// If we have a collision with the scene geometry then compute the contact point
 			// and other related data from it.
@@ -272,11 +322,18 @@ void FVehicleContactSensor::CalculateContactPoint(float deltaTime, UWorld* world
 }
 
 /**
-* Do the regular update tick.
+* Prepare the regular update tick, returning whether a sweep is required before
+* the tick can be completed.
+*
+* The tick is split in this way so that the sweeps for all of the sensors of a
+* vehicle can be batched together by the caller between PrepareTick and
+* CompleteTick.
 ***********************************************************************************/
 
-void FVehicleContactSensor::Tick(float deltaTime, UWorld* world, const FTransform& transform, const FVector& startPoint, const FVector& direction, bool updatePhysics, bool estimate, bool calculateIfUpward)
+bool FVehicleContactSensor::PrepareTick(float deltaTime, const FTransform& transform, const FVector& startPoint, const FVector& direction, bool updatePhysics, bool estimate, bool calculateIfUpward)
 {
+	SweepRequired = false;
+
 	if (calculateIfUpward == true ||
 		GetAlignment() < 0.0f)
 	{
@@ -287,12 +344,36 @@ void FVehicleContactSensor::Tick(float deltaTime, UWorld* world, const FTransfor
 
 #pragma endregion VehicleAntiGravity
 
+		// direction is the Z direction of the vehicle for reference.
+
+		StartPoint = startPoint + (direction * StartOffset * GetAlignment());
+		Direction = direction;
+
 		// updatePhysics is only true if the sensor is part of the "active" set for a flippable vehicle -
 		// either the top or bottom set depending on where we've detected a driving surface.
 
-		// direction is the Z direction of the vehicle for reference.
+		if (updatePhysics == true)
+		{
+			SweepStart = StartPoint;
+			SweepEnd = SensorPositionFromLength(GetSensorLength());
+			SweepRequired = RequiresSweep(SweepStart, SweepEnd, estimate);
+		}
+	}
+
+	return SweepRequired;
+}
 
-		CalculateContactPoint(deltaTime, world, startPoint, direction, updatePhysics, estimate);
+/**
+* Complete the regular update tick, once any sweep requested by PrepareTick has
+* been performed.
+***********************************************************************************/
+
+void FVehicleContactSensor::CompleteTick(float deltaTime, bool updatePhysics, bool estimate, bool calculateIfUpward)
+{
+	if (calculateIfUpward == true ||
+		GetAlignment() < 0.0f)
+	{
+		CalculateContactPoint(deltaTime, updatePhysics, estimate);
 
 		if (updatePhysics == true)
 		{
@@ -44,6 +44,10 @@
 
 void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstance)
 {
+	GRIP_RACE_SIMULATION_SCOPE(VehiclePhysics);
+	GRIP_FRAME_PROFILER_SCOPE(VehiclePhysics, VehicleIndex);
+	GRIP_RACE_REPLAY_SUBSTEP();
+
 	if (World == nullptr)
 	{
 		return;
@@ -1357,7 +1361,7 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 							for (int32 j = numAirborneValues - 1; j >= 0; j--)
 							{
-								auto& j0 = Physics.ContactData.AirborneList[j];
+								const auto j0 = Physics.ContactData.AirborneList[j];
 								float jtime = j0.Time;
 
 								if (jtime < t2)
@@ -1473,6 +1477,8 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& transform, const FVector& xdirection, const FVector& ydirection, const FVector& zdirection)
 {
+	GRIP_FRAME_PROFILER_SCOPE(ContactSensors, VehicleIndex);
+
 	static FName noSurface("None");
 
 	Wheels.SurfaceName = noSurface;
@@ -1516,6 +1522,12 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 #define SHOULD_ESTIMATE (((wheelIndex++ >> 1) % numAxles) != (Physics.Timing.TickCount % numAxles))
 #endif
 
+		// Each set of sensors is ticked in two halves, with all of the sweeps required by
+		// the set performed together in between, rather than one sweep at a time.
+
+		TArray<FVehicleContactSensor*, TInlineAllocator<16>> sweeps;
+		TArray<bool, TInlineAllocator<16>> estimates;
+
 		if (Physics.ContactData.Grounded == true)
 		{
 			// If the vehicle is grounded then we can do less work, by ticking the contact sensors
@@ -1529,12 +1541,30 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 			{
 				FVehicleContactSensor& sensor = wheel.Sensors[Wheels.GroundedSensorSet];
 				FVector springTop = GetWheelBoneLocation(wheel, transform, true);
+				bool estimateSensor = (estimate == true && SHOULD_ESTIMATE);
+
+				estimates.Emplace(estimateSensor);
+
+				if (sensor.PrepareTick(deltaSeconds, transform, springTop, zdirection, true, estimateSensor, IsFlippable()) == true)
+				{
+					sweeps.Emplace(&sensor);
+				}
+			}
+
+			FVehicleContactSensor::SweepBatch(World, sweeps);
 
-				sensor.Tick(deltaSeconds, World, transform, springTop, zdirection, true, estimate == true && SHOULD_ESTIMATE, IsFlippable());
+			wheelIndex = 0;
+
+			for (FVehicleWheel& wheel : Wheels.Wheels)
+			{
+				FVehicleContactSensor& sensor = wheel.Sensors[Wheels.GroundedSensorSet];
+
+				sensor.CompleteTick(deltaSeconds, true, estimates[wheelIndex++], IsFlippable());
 
 				allInContact &= sensor.IsInContact();
 			}
 
+			sweeps.Reset();
 			wheelIndex = 0;
 
 			for (FVehicleWheel& wheel : Wheels.Wheels)
@@ -1542,7 +1572,21 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 				FVehicleContactSensor& sensor = wheel.Sensors[Wheels.GroundedSensorSet ^ 1];
 				FVector springTop = GetWheelBoneLocation(wheel, transform, true);
 
-				sensor.Tick(deltaSeconds, World, transform, springTop, zdirection, (allInContact == false), estimate == true && SHOULD_ESTIMATE, IsFlippable());
+				if (sensor.PrepareTick(deltaSeconds, transform, springTop, zdirection, (allInContact == false), estimates[wheelIndex++], IsFlippable()) == true)
+				{
+					sweeps.Emplace(&sensor);
+				}
+			}
+
+			FVehicleContactSensor::SweepBatch(World, sweeps);
+
+			wheelIndex = 0;
+
+			for (FVehicleWheel& wheel : Wheels.Wheels)
+			{
+				FVehicleContactSensor& sensor = wheel.Sensors[Wheels.GroundedSensorSet ^ 1];
+
+				sensor.CompleteTick(deltaSeconds, (allInContact == false), estimates[wheelIndex++], IsFlippable());
 			}
 		}
 		else
@@ -1556,8 +1600,26 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 				for (FVehicleContactSensor& sensor : wheel.Sensors)
 				{
 					FVector springTop = GetWheelBoneLocation(wheel, transform, true);
+					bool estimateSensor = (estimate == true && SHOULD_ESTIMATE);
+
+					estimates.Emplace(estimateSensor);
 
-					sensor.Tick(deltaSeconds, World, transform, springTop, zdirection, true, estimate == true && SHOULD_ESTIMATE, IsFlippable());
+					if (sensor.PrepareTick(deltaSeconds, transform, springTop, zdirection, true, estimateSensor, IsFlippable()) == true)
+					{
+						sweeps.Emplace(&sensor);
+					}
+				}
+			}
+
+			FVehicleContactSensor::SweepBatch(World, sweeps);
+
+			int32 sensorIndex = 0;
+
+			for (FVehicleWheel& wheel : Wheels.Wheels)
+			{
+				for (FVehicleContactSensor& sensor : wheel.Sensors)
+				{
+					sensor.CompleteTick(deltaSeconds, true, estimates[sensorIndex++], IsFlippable());
 				}
 			}
 		}
@@ -61,9 +61,9 @@ int32 ABaseVehicle::GivePickup(EPickupType type, int32 pickupSlot, bool fromTrac
 	FDifficultyCharacteristics& difficulty = PlayGameMode->GetDifficultyCharacteristics();
 	FPickupUseCharacteristics& useCharacteristics = difficulty.PickupUseCharacteristics.Race;
 
-	float useDelay = useCharacteristics.PickupUseAfter + FMath::RandRange(-useCharacteristics.PickupUseAfter * 0.25f, useCharacteristics.PickupUseAfter * 0.25f);
-	float useBefore = useCharacteristics.PickupUseBefore + FMath::RandRange(-useCharacteristics.PickupUseBefore * 0.25f, useCharacteristics.PickupUseBefore * 0.25f);
-	float dumpAfter = useCharacteristics.PickupDumpAfter + FMath::RandRange(-useCharacteristics.PickupDumpAfter * 0.25f, useCharacteristics.PickupDumpAfter * 0.25f);
+	float useDelay = useCharacteristics.PickupUseAfter + APlayGameMode::SimulationRandom.FRandRange(-useCharacteristics.PickupUseAfter * 0.25f, useCharacteristics.PickupUseAfter * 0.25f);
+	float useBefore = useCharacteristics.PickupUseBefore + APlayGameMode::SimulationRandom.FRandRange(-useCharacteristics.PickupUseBefore * 0.25f, useCharacteristics.PickupUseBefore * 0.25f);
+	float dumpAfter = useCharacteristics.PickupDumpAfter + APlayGameMode::SimulationRandom.FRandRange(-useCharacteristics.PickupDumpAfter * 0.25f, useCharacteristics.PickupDumpAfter * 0.25f);
 
 	if (useBefore < KINDA_SMALL_NUMBER)
 	{
@@ -125,13 +125,13 @@ int32 ABaseVehicle::GivePickup(EPickupType type, int32 pickupSlot, bool fromTrac
 			switch (difficultyLevel)
 			{
 			case 1:
-				playerPickupSlot.BotWillCharge = (FMath::Rand() % 7) == 0;
+				playerPickupSlot.BotWillCharge = APlayGameMode::SimulationRandom.RandHelper(7) == 0;
 				break;
 			case 2:
-				playerPickupSlot.BotWillCharge = (FMath::Rand() % 3) == 0;
+				playerPickupSlot.BotWillCharge = APlayGameMode::SimulationRandom.RandHelper(3) == 0;
 				break;
 			case 3:
-				playerPickupSlot.BotWillCharge = (FMath::Rand() % 2) == 0;
+				playerPickupSlot.BotWillCharge = APlayGameMode::SimulationRandom.RandHelper(2) == 0;
 				break;
 			case 0:
 				break;
@@ -153,7 +153,7 @@ int32 ABaseVehicle::GivePickup(EPickupType type, int32 pickupSlot, bool fromTrac
 				{
 					float p0 = (float)PlayGameMode->GetNumOpponents(true) / (float)PlayGameMode->GetNumOpponents();
 
-					playerPickupSlot.BotWillTargetHuman = FMath::FRand() < FMath::Lerp(p0, 1.0f, bias);
+					playerPickupSlot.BotWillTargetHuman = APlayGameMode::SimulationRandom.FRand() < FMath::Lerp(p0, 1.0f, bias);
 				}
 			}
 		}
@@ -188,38 +188,39 @@ bool FPlayerPickupSlot::IsCharging(bool confirmed) const
 
 void ABaseVehicle::CollectSpeedPads()
 {
-	if (GRIP_OBJECT_VALID(VehicleCollision) == true)
+	if (PlayGameMode != nullptr &&
+		PadCollectionCapsules.Num() > 0)
 	{
-		// Determine which speed pad actors are currently overlapping with this
-		// vehicle's collision shell.
+		// Determine which speed pads the vehicle's collision shell has passed over
+		// since the last frame.
 
-		TSet<AActor*> collectedActors;
+		TArray<ASpeedPad*, TInlineAllocator<4>> collectedSpeedPads;
 
-		VehicleCollision->GetOverlappingActors(collectedActors, ASpeedPad::StaticClass());
+		PlayGameMode->GetPadProximityIndex().FindSpeedPads(PadCollectionCapsules, collectedSpeedPads);
 
-		if (collectedActors.Num() > 0)
+		if (collectedSpeedPads.Num() > 0)
 		{
 			// If we have any overlapping speed pads then find the closest one to the vehicle.
 
 			float minDistance = 0.0f;
-			AActor* closestSpeedpad = nullptr;
+			ASpeedPad* closestSpeedpad = nullptr;
 			FVector location = GetActorLocation();
 
-			for (AActor* actor : collectedActors)
+			for (ASpeedPad* speedPad : collectedSpeedPads)
 			{
-				float distance = (actor->GetActorLocation() - location).SizeSquared();
+				float distance = (speedPad->GetActorLocation() - location).SizeSquared();
 
 				if (minDistance > distance ||
 					closestSpeedpad == nullptr)
 				{
 					minDistance = distance;
-					closestSpeedpad = actor;
+					closestSpeedpad = speedPad;
 				}
 			}
 
 			// Collect the closest speed pad from this vehicle.
 
-			(Cast<ASpeedPad>(closestSpeedpad))->OnSpeedPadCollected(this);
+			closestSpeedpad->OnSpeedPadCollected(this);
 		}
 	}
 }
@@ -290,21 +291,61 @@ bool ABaseVehicle::SpeedBoost(ASpeedPad* speedpad, float amount, float duration,
 #pragma region PickupPads
 
 /**
-* Collect the pickups overlapping with a vehicle.
+* Update the capsules used to collect the pickup pads and speed pads this frame.
+*
+* The collision shell of the vehicle is approximated by a capsule along its length
+* and as wide as it is. Another capsule of the same width is swept along the path of
+* the shell since the last frame, so that pads aren't jumped over at high speed.
 ***********************************************************************************/
 
-void ABaseVehicle::CollectPickups()
+void ABaseVehicle::UpdatePadCollectionCapsules()
 {
+	PadCollectionCapsules.Reset();
+
 	if (GRIP_OBJECT_VALID(VehicleCollision) == true)
 	{
-		TSet<AActor*> collectedActors;
+		const FTransform& transform = VehicleCollision->GetComponentTransform();
+		FVector location = transform.GetLocation();
+		FVector extent = VehicleCollision->GetScaledBoxExtent();
+		FVector halfLength = transform.GetUnitAxis(EAxis::X) * FMath::Max(extent.X - extent.Y, 0.0f);
+
+		PadCollectionCapsules.Emplace(FPadProximityCapsule(location - halfLength, location + halfLength, extent.Y));
 
-		VehicleCollision->GetOverlappingActors(collectedActors, APickup::StaticClass());
+		// Don't sweep across a teleport or respawn.
 
-		for (AActor* actor : collectedActors)
+		if (PadCollectionLocationValid == true &&
+			(location - PadCollectionLocation).SizeSquared() < FMath::Square(MaxPadCollectionSweep))
 		{
-			APickup* pickup = Cast<APickup>(actor);
+			PadCollectionCapsules.Emplace(FPadProximityCapsule(PadCollectionLocation, location, extent.Y));
+		}
 
+		PadCollectionLocation = location;
+		PadCollectionLocationValid = true;
+	}
+	else
+	{
+		PadCollectionLocationValid = false;
+	}
+}
+
+/**
+* Collect the pickups overlapping with a vehicle.
+***********************************************************************************/
+
+void ABaseVehicle::CollectPickups()
+{
+	if (PlayGameMode != nullptr &&
+		PadCollectionCapsules.Num() > 0)
+	{
+		// Determine which pickup pads the vehicle's collision shell has passed over
+		// since the last frame.
+
+		TArray<APickup*, TInlineAllocator<4>> collectedPickups;
+
+		PlayGameMode->GetPadProximityIndex().FindPickupPads(PadCollectionCapsules, collectedPickups);
+
+		for (APickup* pickup : collectedPickups)
+		{
 			if (pickup->IsCollectible() == true)
 			{
 				if (pickup->Class == EPickupClass::Pickup)
@@ -507,15 +548,24 @@ void ABaseVehicle::UpdatePickupSlots(float deltaSeconds)
 
 void ABaseVehicle::BeginUsePickup(int32 pickupSlot, bool bot, bool force)
 {
-	if ((pickupSlot >= 0) &&
-		(force == true || (PlayGameMode != nullptr && PlayGameMode->PastGameSequenceStart() == true)))
+	if (pickupSlot < 0 ||
+		bot != AI.BotDriver ||
+		IsVehicleDestroyed() == true)
 	{
-		if (bot != AI.BotDriver ||
-			IsVehicleDestroyed() == true)
-		{
-			return;
-		}
+		return;
+	}
 
+#if GRIP_RACE_REPLAY
+	float forceValue = (force == true) ? 1.0f : 0.0f;
+
+	GRIP_RACE_REPLAY_INPUT(ERaceReplayInput::BeginUsePickup, &forceValue, &pickupSlot);
+
+	force = (forceValue != 0.0f);
+#endif // GRIP_RACE_REPLAY
+
+	if (force == true ||
+		(PlayGameMode != nullptr && PlayGameMode->PastGameSequenceStart() == true))
+	{
 		FPlayerPickupSlot& playerPickupSlot = PickupSlots[pickupSlot];
 
 		if (playerPickupSlot.State == EPickupSlotState::Idle &&
@@ -555,6 +605,14 @@ void ABaseVehicle::UsePickup(int32 pickupSlot, EPickupActivation activation, boo
 		return;
 	}
 
+#if GRIP_RACE_REPLAY
+	float activationValue = (float)(int32)activation;
+
+	GRIP_RACE_REPLAY_INPUT(ERaceReplayInput::UsePickup, &activationValue, &pickupSlot);
+
+	activation = (EPickupActivation)(int32)activationValue;
+#endif // GRIP_RACE_REPLAY
+
 	FPlayerPickupSlot& playerPickupSlot = PickupSlots[pickupSlot];
 
 	if (IsVehicleDestroyed() == true)
@@ -652,14 +710,14 @@ void ABaseVehicle::UsePickup(int32 pickupSlot, EPickupActivation activation, boo
 					{
 						if (Level2TurboBlueprint != nullptr)
 						{
-							turbo = GetWorld()->SpawnActor<ATurbo>(Level2TurboBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
+							turbo = PlayGameMode->ObjectPool.AcquireActor<ATurbo>(GetWorld(), Level2TurboBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
 						}
 					}
 					else
 					{
 						if (Level1TurboBlueprint != nullptr)
 						{
-							turbo = GetWorld()->SpawnActor<ATurbo>(Level1TurboBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
+							turbo = PlayGameMode->ObjectPool.AcquireActor<ATurbo>(GetWorld(), Level1TurboBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
 						}
 					}
 
@@ -708,14 +766,14 @@ void ABaseVehicle::UsePickup(int32 pickupSlot, EPickupActivation activation, boo
 					{
 						if (Level2GatlingGunBlueprint != nullptr)
 						{
-							gatlingGun = GetWorld()->SpawnActor<AGatlingGun>(Level2GatlingGunBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
+							gatlingGun = PlayGameMode->ObjectPool.AcquireActor<AGatlingGun>(GetWorld(), Level2GatlingGunBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
 						}
 					}
 					else
 					{
 						if (Level1GatlingGunBlueprint != nullptr)
 						{
-							gatlingGun = GetWorld()->SpawnActor<AGatlingGun>(Level1GatlingGunBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
+							gatlingGun = PlayGameMode->ObjectPool.AcquireActor<AGatlingGun>(GetWorld(), Level1GatlingGunBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
 						}
 					}
 
@@ -810,14 +868,14 @@ void ABaseVehicle::UsePickup(int32 pickupSlot, EPickupActivation activation, boo
 					{
 						if (Level2ShieldBlueprint != nullptr)
 						{
-							Shield = GetWorld()->SpawnActor<AShield>(Level2ShieldBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
+							Shield = PlayGameMode->ObjectPool.AcquireActor<AShield>(GetWorld(), Level2ShieldBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
 						}
 					}
 					else
 					{
 						if (Level1ShieldBlueprint != nullptr)
 						{
-							Shield = GetWorld()->SpawnActor<AShield>(Level1ShieldBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
+							Shield = PlayGameMode->ObjectPool.AcquireActor<AShield>(GetWorld(), Level1ShieldBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
 						}
 					}
 
@@ -1009,7 +1067,7 @@ EPickupType ABaseVehicle::DeterminePickup(APickup* pickup)
 
 				while (orderedPickups.Num() > 0)
 				{
-					int32 index = FMath::Rand() % orderedPickups.Num();
+					int32 index = APlayGameMode::SimulationRandom.RandHelper(orderedPickups.Num());
 
 					queuedPickups.Emplace(orderedPickups[index]);
 
@@ -1511,6 +1569,45 @@ void ABaseVehicle::ReleasePickupSlot(int32 pickupSlot, bool animate)
 	}
 }
 
+/**
+* Forget any references to a pickup that's being released back into the object
+* pool, as it'll remain valid while it's there.
+***********************************************************************************/
+
+void ABaseVehicle::ForgetPickup(APickupBase* pickup)
+{
+	for (FPlayerPickupSlot& pickupSlot : PickupSlots)
+	{
+		if (pickupSlot.Pickup.Get() == pickup)
+		{
+			pickupSlot.Pickup.Reset();
+		}
+	}
+
+	if (Shield.Get() == pickup)
+	{
+		Shield.Reset();
+	}
+}
+
+/**
+* Create the pickups that can be pooled ahead of time, a number of each for the
+* object pool.
+*
+* Missiles aren't pooled, as they tear down their components when they explode
+* and their references are held for some time afterwards by the cameras and HUDs.
+***********************************************************************************/
+
+void ABaseVehicle::PrewarmPickups(UWorld* world, FObjectPool& pool, int32 count)
+{
+	pool.PrewarmActors(world, Level1TurboBlueprint, count);
+	pool.PrewarmActors(world, Level2TurboBlueprint, count);
+	pool.PrewarmActors(world, Level1GatlingGunBlueprint, count);
+	pool.PrewarmActors(world, Level2GatlingGunBlueprint, count);
+	pool.PrewarmActors(world, Level1ShieldBlueprint, count);
+	pool.PrewarmActors(world, Level2ShieldBlueprint, count);
+}
+
 /**
 * Switch the target for a pickup slot.
 ***********************************************************************************/
@@ -1717,7 +1814,7 @@ bool ABaseVehicle::BulletRound(float strength, int32 hitPoints, int32 aggressorV
 
 	FVector direction(0.0f, 1000000.0f * strength, 0.0f);
 
-	if (FMath::RandBool() == true)
+	if (APlayGameMode::SimulationRandom.RandHelper(2) == 0)
 	{
 		direction *= -1.0f;
 	}
@@ -1752,19 +1849,19 @@ bool ABaseVehicle::BulletRound(float strength, int32 hitPoints, int32 aggressorV
 	// Now spin it around a bit.
 
 	if (charged == true &&
-		(FMath::Rand() & 3) != 0)
+		APlayGameMode::SimulationRandom.RandHelper(4) != 0)
 	{
 		// For charged bullets, let 3 out of 4 rounds all hit on one side to promote a strong spin.
 
 		// Just add some random left/right angular velocity (Z is yaw), and a little pitch (Y is pitch).
 
-		direction = FVector(0.0f, FMath::FRandRange(-0.15f, 0.15f), FMath::FRandRange(0.1f, 0.15f) * spinSide);
+		direction = FVector(0.0f, APlayGameMode::SimulationRandom.FRandRange(-0.15f, 0.15f), APlayGameMode::SimulationRandom.FRandRange(0.1f, 0.15f) * spinSide);
 	}
 	else
 	{
 		// Just add some random left/right angular velocity (Z is yaw), and a little pitch (Y is pitch).
 
-		direction = FVector(0.0f, FMath::FRandRange(-0.25f, 0.25f), FMath::FRandRange(-0.25f, 0.25f));
+		direction = FVector(0.0f, APlayGameMode::SimulationRandom.FRandRange(-0.25f, 0.25f), APlayGameMode::SimulationRandom.FRandRange(-0.25f, 0.25f));
 
 		if (IsAirborne() == false)
 		{
@@ -1844,7 +1941,7 @@ FVector ABaseVehicle::EjectGunRound(int32 roundLocation, bool charged)
 
 	FName muzzleLocation = ((roundLocation == 0) ? "MachineGun_L" : "MachineGun_R");
 
-	UParticleSystemComponent* muzzleFlash = SpawnParticleSystem(VehicleGun->MuzzleFlashEffect, muzzleLocation, FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::KeepRelativeOffset, (charged == true) ? 2.0f : 1.0f);
+	UParticleSystemComponent* muzzleFlash = SpawnPooledParticleSystem(VehicleGun->MuzzleFlashEffect, muzzleLocation, FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::KeepRelativeOffset, (charged == true) ? 2.0f : 1.0f);
 
 	muzzleFlash->SetOwnerNoSee(IsCockpitView());
 
@@ -1862,7 +1959,7 @@ FVector ABaseVehicle::EjectGunRound(int32 roundLocation, bool charged)
 
 	velocity += GetVelocity() * 0.9f;
 
-	UParticleSystemComponent* shellEjection = SpawnParticleSystem(VehicleGun->ShellEjectEffect, shellLocation, FVector::ZeroVector, FRotator(0.0f, -90.0f, 0.0f), EAttachLocation::KeepRelativeOffset, 1.0f);
+	UParticleSystemComponent* shellEjection = SpawnPooledParticleSystem(VehicleGun->ShellEjectEffect, shellLocation, FVector::ZeroVector, FRotator(0.0f, -90.0f, 0.0f), EAttachLocation::KeepRelativeOffset, 1.0f);
 
 	shellEjection->SetVectorParameter(FName("ShellVelocity"), velocity);
 
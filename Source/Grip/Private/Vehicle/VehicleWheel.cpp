@@ -12,6 +12,7 @@
 ***********************************************************************************/
 
 #include "vehicle/vehiclewheel.h"
+#include "gamemodes/playgamemode.h"
 
 #pragma region VehicleSurfaceEffects
 
@@ -83,13 +84,23 @@ void FWheelDrivingSurfaces::DiscardComponent(FWheelDrivingSurface& surface)
 	if (GRIP_POINTER_VALID(surface.Surface) == true)
 	{
 		surface.Surface->Deactivate();
-		surface.Surface->bAutoDestroy = true;
 
 		GRIP_DETACH(surface.Surface);
 
-		if (surface.Surface->bWasCompleted == true)
+		// Pooled components are reclaimed by the pool once they've completed rather
+		// than destroying themselves.
+
+		APlayGameMode* gameMode = APlayGameMode::Get(surface.Surface.Get());
+
+		if (gameMode == nullptr ||
+			gameMode->ObjectPool.ReleaseParticleSystem(surface.Surface.Get()) == false)
 		{
-			surface.Surface->DestroyComponent();
+			surface.Surface->bAutoDestroy = true;
+
+			if (surface.Surface->bWasCompleted == true)
+			{
+				surface.Surface->DestroyComponent();
+			}
 		}
 
 		surface.Surface.Reset();
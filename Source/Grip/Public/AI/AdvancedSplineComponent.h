@@ -12,6 +12,12 @@
 * on splines, including GetNearestDistance which returns the nearest position on a
 * spline for a given position in space.
 *
+* For the frequent nearest position queries made at run-time, each spline also
+* has a precomputed polyline in local space, with its segments grouped into
+* bounding boxes. FindNearestDistance searches this polyline within the range
+* given, normally around the last result as objects only move a little per
+* frame, and then refines the result against the spline itself.
+*
 ***********************************************************************************/
 
 #pragma once
@@ -47,6 +53,116 @@ public:
 	float EndDistance = 0.0f;
 };
 
+/**
+* Structure for a query of the nearest distance along a spline to a world location,
+* used for resolving the queries of many objects against a single spline at once.
+***********************************************************************************/
+
+struct FSplineNearestQuery
+{
+public:
+
+	FSplineNearestQuery() = default;
+
+	FSplineNearestQuery(const FVector& location, float distance, float range)
+		: Location(location)
+		, Distance(distance)
+		, Range(range)
+	{ }
+
+	// The world location to find the nearest distance along the spline to.
+	FVector Location = FVector::ZeroVector;
+
+	// The distance along the spline to search around, normally the last result, and the nearest distance on return.
+	float Distance = 0.0f;
+
+	// The distance either side of Distance to search within.
+	float Range = 0.0f;
+};
+
+/**
+* Structure for one of a batch of searches along a spline polyline.
+***********************************************************************************/
+
+template <typename Metric>
+struct FSplinePolylineSearch
+{
+public:
+
+	FSplinePolylineSearch(const Metric& metric, float startDistance, float endDistance)
+		: SearchMetric(metric)
+		, StartDistance(startDistance)
+		, EndDistance(endDistance)
+	{ }
+
+	// The metric to search with.
+	Metric SearchMetric;
+
+	// The distance along the polyline to search from, unwrapped for closed loops.
+	float StartDistance = 0.0f;
+
+	// The distance along the polyline to search to, unwrapped for closed loops.
+	float EndDistance = 0.0f;
+
+	// The first segment to search, unwrapped for closed loops.
+	int32 FirstSegment = 0;
+
+	// The last segment to search, unwrapped for closed loops.
+	int32 LastSegment = 0;
+
+	// The nearest distance found, unwrapped for closed loops.
+	float NearestDistance = 0.0f;
+
+	// The value of the metric at the nearest distance found, or -1 if none found yet.
+	float NearestValue = -1.0f;
+};
+
+/**
+* Structure for a polyline approximation of a spline in local space, used for
+* quickly finding the nearest distance along a spline.
+***********************************************************************************/
+
+struct FSplinePolyline
+{
+public:
+
+	// Is the polyline valid for a spline of the given length?
+	bool IsValidFor(float length) const
+	{ return (Points.Num() > 1 && Length == length); }
+
+	// Find the nearest distance along the polyline between startDistance and endDistance, using a metric for a point, segment or box.
+	template <typename Metric>
+	float FindNearestDistance(const Metric& metric, float startDistance, float endDistance, bool closedLoop, float& nearestValue) const;
+
+	// Find the nearest distances along the polyline for a batch of searches in a single walk along it, using a metric for a point, segment or box.
+	template <typename Metric>
+	void FindNearestDistances(TArrayView<FSplinePolylineSearch<Metric>> searches, bool closedLoop) const;
+
+	// The length of the spline that the polyline was built from.
+	float Length = 0.0f;
+
+	// The length along the spline of each segment of the polyline.
+	float SegmentLength = 0.0f;
+
+	// The points of the polyline in local space, evenly spaced along the spline and including both ends.
+	TArray<FVector> Points;
+
+	// The bounds of each group of segments of the polyline.
+	TArray<FBox> GroupBounds;
+
+	// The number of segments in each group.
+	static const int32 SegmentsPerGroup = 16;
+
+private:
+
+	// Get the range of segments, unwrapped for closed loops, that lie between startDistance and endDistance.
+	void GetSegmentRange(float startDistance, float endDistance, bool closedLoop, int32& firstSegment, int32& lastSegment) const;
+
+	// Find the nearest point on a run of segments within a single group to a metric, if it's nearer than that already found.
+	template <typename Metric>
+	void SearchSegments(const Metric& metric, int32 firstSegment, int32 lastSegment, float startDistance, float endDistance, float& nearestDistance, float& nearestValue) const;
+};
+
 #pragma endregion NavigationSplines
 
 /**
@@ -112,6 +228,17 @@ public:
 	// and endDistance the more accurate the result will be.
 	float GetNearestDistance(FVector planeLocation, FVector planeDirection, float startDistance = 0.0f, float endDistance = 0.0f, int32 numIterations = 4, int32 numSamples = 50, float earlyExitDistance = 10.0f) const;
 
+	// Find the nearest distance along a spline to a given world location, to within accuracy, using the precomputed polyline.
+	// The smaller the difference between startDistance and endDistance the faster it will be.
+	float FindNearestDistance(const FVector& location, float startDistance = 0.0f, float endDistance = 0.0f, float accuracy = 1.0f) const;
+
+	// Find the nearest distance along a spline to a given plane location and direction, to within accuracy, using the precomputed polyline.
+	// The smaller the difference between startDistance and endDistance the faster it will be.
+	float FindNearestDistance(const FVector& planeLocation, const FVector& planeDirection, float startDistance, float endDistance, float accuracy = 1.0f) const;
+
+	// Find the nearest distances along a spline for a batch of queries in a single pass, to within accuracy, using the precomputed polyline.
+	void FindNearestDistances(TArrayView<FSplineNearestQuery> queries, float accuracy = 1.0f) const;
+
 	// Get the distance between two points on a spline (accounting for looped splines).
 	float GetDistanceDifference(float distance0, float distance1, float length = 0.0f, bool signedDifference = false) const;
 
@@ -146,9 +273,29 @@ protected:
 	// Calculate the sections of the spline.
 	virtual void CalculateSections();
 
+	// Build the polyline used for finding the nearest distance along the spline.
+	void BuildPolyline();
+
+	// Search for the nearest distance along the spline using a metric for a point, segment or box in local space.
+	template <typename Metric>
+	float SearchNearestDistance(const Metric& metric, float startDistance, float endDistance, float accuracy) const;
+
+	// Clamp the distances to search between along the spline, accounting for whether it's open or closed.
+	void ClampSearchRange(float& startDistance, float& endDistance) const;
+
+	// Refine a nearest distance found on the polyline against the spline itself, using a metric for a point in local space.
+	template <typename Metric>
+	float RefineNearestDistance(const Metric& metric, float nearestDistance, float startDistance, float endDistance, float accuracy) const;
+
+	// The polyline used for finding the nearest distance along the spline.
+	FSplinePolyline Polyline;
+
 	// The distance at which extended points are laid out along a spline.
 	static const int32 ExtendedPointMeters = 10;
 
+	// The distance at which the points of the polyline are laid out along a spline.
+	static const int32 PolylinePointMeters = 5;
+
 #pragma region AIVehicleControl
 
 public:
@@ -0,0 +1,104 @@
+/**
+*
+* Attractable index.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* An index of the attractables in a level ordered by their distance along the
+* master racing spline, used by the AI bots to look for targets of opportunity.
+* The pickup pads and speed pads that are attractable never move, so their
+* distances are measured once when the index is built, through their nearest
+* pursuit splines in the same way as the vehicles measure theirs, and a bot then
+* only examines the attractables within a window around its own distance along the
+* master racing spline rather than all of them.
+*
+* The index is controlled with grip.AttractableIndex.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class UPursuitSplineComponent;
+class IAttractableInterface;
+
+/**
+* The attractable index.
+***********************************************************************************/
+
+class FAttractableIndex
+{
+public:
+
+	// An attractable found by the index.
+	typedef TPair<AActor*, IAttractableInterface*> FAttractable;
+
+	// Is the index to be used rather than examining every attractable?
+	static bool IsEnabled();
+
+	// Refresh the index from the attractables if they've changed since it was built.
+	void Refresh(const TMap<AActor*, IAttractableInterface*>& attractables, UPursuitSplineComponent* masterRacingSpline);
+
+	// Mark the index as needing to be rebuilt on its next refresh, normally because an attractable has been added or removed.
+	void Invalidate()
+	{ Dirty = true; }
+
+	// Has the index been built?
+	bool IsBuilt() const
+	{ return MasterRacingSpline != nullptr; }
+
+	// Get the attractables that may be in range of a distance along the master racing spline.
+	void FindAttractables(float distanceAlong, TArray<FAttractable, TInlineAllocator<16>>& attractables) const;
+
+	// Clear the index.
+	void Reset();
+
+private:
+
+	/**
+	* An attractable in the index.
+	***********************************************************************************/
+
+	struct FEntry
+	{
+		// The actor that is attractable.
+		AActor* Actor = nullptr;
+
+		// The attractable interface of the actor.
+		IAttractableInterface* Attractable = nullptr;
+
+		// The distance of the attraction location along the master racing spline.
+		float DistanceAlong = 0.0f;
+
+		// The attraction distance range.
+		float Range = 0.0f;
+	};
+
+	// Get the distance of an attractable along the master racing spline.
+	float GetMasterDistance(AActor* actor, const FVector& location) const;
+
+	// Add the entries with distances between two points along the master racing spline, without wrapping.
+	void AddEntriesBetween(float fromDistance, float toDistance, float distanceAlong, TArray<FAttractable, TInlineAllocator<16>>& attractables) const;
+
+	// The attractables, sorted on their distance along the master racing spline.
+	TArray<FEntry> Entries;
+
+	// The master racing spline the index was built from.
+	UPursuitSplineComponent* MasterRacingSpline = nullptr;
+
+	// The length of the master racing spline.
+	float SplineLength = 0.0f;
+
+	// Is the master racing spline a closed loop?
+	bool ClosedLoop = false;
+
+	// The largest attraction distance range of any of the attractables.
+	float MaxRange = 0.0f;
+
+	// Does the index need to be rebuilt?
+	bool Dirty = true;
+};
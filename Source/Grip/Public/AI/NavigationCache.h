@@ -0,0 +1,193 @@
+/**
+*
+* Navigation cache.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A compact, versioned binary file of the navigation data that's otherwise derived
+* from the pursuit splines every time a level is started. That's the orientation
+* of each extended point, the curvature sums packed from them, the straight and
+* drone sections used by the cinematic cameras and the master spline distances.
+*
+* The file is written per map with the grip.BuildNavigationCache console command
+* from an Editor build, once the level has started, and is memory-mapped when the
+* level is next loaded. Each spline has a checksum of the source data that its
+* derived data was computed from, along with a checksum of the derived data itself,
+* and any spline that doesn't match falls back to computing its data as normal.
+* The master spline distances also depend on which spline is the master racing
+* spline and how the splines link to one another, so the header has a checksum of
+* those too.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+#if GRIP_NAVIGATION_CACHE
+
+class UPursuitSplineComponent;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+* The header at the start of a navigation cache file.
+***********************************************************************************/
+
+struct FNavigationCacheHeader
+{
+	// The identifier at the start of the file.
+	uint32 Magic = 0;
+
+	// The version of the file format.
+	int32 Version = 0;
+
+	// The size of the file in bytes.
+	uint32 FileSize = 0;
+
+	// The checksum of the table of entries following the header.
+	uint32 EntriesCrc = 0;
+
+	// The number of splines in the file.
+	int32 NumSplines = 0;
+
+	// The number of splines in the file with master spline distances.
+	int32 NumMasteredSplines = 0;
+
+	// The checksum of the name of the navigation layer the master spline distances were computed for.
+	uint32 NavigationLayerCrc = 0;
+
+	// The checksum of the master racing spline and the links between the splines the master spline distances were computed for.
+	uint32 NetworkChecksum = 0;
+};
+
+/**
+* The entry for a single spline in a navigation cache file, sorted by key in the
+* table following the header.
+***********************************************************************************/
+
+struct FNavigationCacheEntry
+{
+	// The key identifying the spline from its actor and component names.
+	uint32 Key = 0;
+
+	// The checksum of the source data the derived data was computed from.
+	uint32 SourceChecksum = 0;
+
+	// The checksum of the payload of derived data.
+	uint32 PayloadCrc = 0;
+
+	// The offset of the payload from the start of the file.
+	uint32 PayloadOffset = 0;
+
+	// The size of the payload in bytes.
+	uint32 PayloadSize = 0;
+
+	// The number of extended points on the spline.
+	int32 NumPoints = 0;
+
+	// The number of straight sections on the spline.
+	int32 NumStraightSections = 0;
+
+	// The number of drone sections on the spline.
+	int32 NumDroneSections = 0;
+
+	// The class that the master distances were found for the spline.
+	int32 MasterDistanceClass = 0;
+
+	// Does the payload contain master spline distances?
+	uint32 HasMasterDistances = 0;
+
+	// Unused, pads the entry to 48 bytes.
+	uint32 Reserved[2] = { 0, 0 };
+};
+
+/**
+* The navigation cache, a single instance of which is used per process.
+***********************************************************************************/
+
+class FNavigationCache
+{
+public:
+
+	// Get the navigation cache for this process.
+	static FNavigationCache& Get()
+	{ return Instance; }
+
+	// Restore the derived data of a pursuit spline from the cache, returning false if it's not present or out of date.
+	bool Restore(UPursuitSplineComponent* spline);
+
+	// Restore the master spline distances of a complete set of pursuit splines from the cache, returning false if they're not all present or up to date.
+	bool RestoreMasterSplineDistances(const TArray<UPursuitSplineComponent*>& splines, const UPursuitSplineComponent* masterRacingSpline, const FString& navigationLayer);
+
+	// Close the cache, unmapping its file.
+	void Close();
+
+#if WITH_EDITOR
+
+	// Write the cache file for the map loaded into a world, from its pursuit splines once the level has started.
+	static bool Write(UWorld* world);
+
+#endif // WITH_EDITOR
+
+private:
+
+	// Open the cache file for the map loaded into a world, if it's not already open.
+	void Open(UWorld* world);
+
+	// Find the entry for a key, or nullptr if there isn't one.
+	const FNavigationCacheEntry* FindEntry(uint32 key) const;
+
+	// Get the payload for an entry, or nullptr if it fails its checksum.
+	const uint8* GetPayload(const FNavigationCacheEntry& entry) const;
+
+	// Get the filename of the cache file for the map loaded into a world.
+	static FString GetFilename(UWorld* world);
+
+	// Get the key identifying a spline from its actor and component names.
+	static uint32 CalculateKey(const UPursuitSplineComponent* spline);
+
+	// Calculate the checksum of the source data the derived data of a spline is computed from.
+	static uint32 CalculateSourceChecksum(const UPursuitSplineComponent* spline);
+
+	// Calculate the checksum of the master racing spline and the links between a set of splines that master spline distances are computed from.
+	static uint32 CalculateNetworkChecksum(const TArray<UPursuitSplineComponent*>& splines, const UPursuitSplineComponent* masterRacingSpline);
+
+	// The filename of the cache file currently open.
+	FString Filename;
+
+	// The handle of the mapped cache file.
+	IMappedFileHandle* MappedHandle = nullptr;
+
+	// The mapped region of the cache file.
+	IMappedFileRegion* MappedRegion = nullptr;
+
+	// The contents of the cache file, read into memory on platforms that can't map it.
+	TArray<uint8> Contents;
+
+	// The start of the cache file in memory, or nullptr if it's not available.
+	const uint8* Data = nullptr;
+
+	// The header of the cache file, within Data.
+	const FNavigationCacheHeader* Header = nullptr;
+
+	// The entries of the cache file sorted by key, within Data.
+	const FNavigationCacheEntry* Entries = nullptr;
+
+	// The keys of the splines whose derived data has been restored from the cache.
+	TSet<uint32> RestoredKeys;
+
+	// The identifier at the start of a cache file.
+	static const uint32 FileMagic;
+
+	// The version of the cache file format.
+	static const int32 FileVersion;
+
+	// The navigation cache for this process.
+	static FNavigationCache Instance;
+};
+
+#endif // GRIP_NAVIGATION_CACHE
@@ -321,31 +321,31 @@ public:
 	float FishtailRecovery = 0.0f;
 
 	// Record of thrust values (VehicleClock).
-	FTimedFloatList Thrust = FTimedFloatList(21, 30);
+	FRunningTimedFloatList Thrust = FRunningTimedFloatList(21, 30);
 
 	// Record of speed values over time (VehicleClock).
-	FTimedFloatList Speed = FTimedFloatList(21, 10);
+	FRunningTimedFloatList Speed = FRunningTimedFloatList(21, 10);
 
 	// Record of forward speed values over time (VehicleClock).
-	FTimedFloatList ForwardSpeed = FTimedFloatList(21, 10);
+	FRunningTimedFloatList ForwardSpeed = FRunningTimedFloatList(21, 10);
 
 	// Record of backward speed values over time (VehicleClock).
-	FTimedFloatList BackwardSpeed = FTimedFloatList(21, 10);
+	FRunningTimedFloatList BackwardSpeed = FRunningTimedFloatList(21, 10);
 
 	// Record of distance traveled when vaguely moving forwards over time (VehicleClock).
-	FTimedFloatList ForwardDistanceTraveled = FTimedFloatList(21, 10);
+	FRunningTimedFloatList ForwardDistanceTraveled = FRunningTimedFloatList(21, 10);
 
 	// Record of distance traveled when vaguely moving backwards over time (VehicleClock).
-	FTimedFloatList BackwardDistanceTraveled = FTimedFloatList(21, 10);
+	FRunningTimedFloatList BackwardDistanceTraveled = FRunningTimedFloatList(21, 10);
 
 	// Record of the race distances over time (VehicleClock).
-	FTimedFloatList RaceDistances = FTimedFloatList(21, 10);
+	FRunningTimedFloatList RaceDistances = FRunningTimedFloatList(21, 10);
 
 	// Record of the facing direction being valid over time (VehicleClock).
-	FTimedFloatList FacingDirectionValid = FTimedFloatList(21, 10);
+	FRunningTimedFloatList FacingDirectionValid = FRunningTimedFloatList(21, 10);
 
 	// Record of the yaw direction away from velocity vector over time (VehicleClock).
-	FTimedFloatList YawDirectionVsVelocity = FTimedFloatList(21, 10);
+	FRunningTimedFloatList YawDirectionVsVelocity = FRunningTimedFloatList(21, 10);
 
 	// The driving stage of reorienting the vehicle.
 	// 0 gathering speed, 1 turning, 2 braking
@@ -21,6 +21,83 @@
 #include "ai/advancedsplineactor.h"
 #include "pursuitsplineactor.generated.h"
 
+/**
+* A link from a pursuit spline to another, saved with the level.
+***********************************************************************************/
+
+USTRUCT()
+struct FSavedSplineLink
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	// The spline to link to.
+	UPROPERTY()
+		UPursuitSplineComponent* Spline = nullptr;
+
+	// The distance at which Spline can be found on the parent spline.
+	UPROPERTY()
+		float ThisDistance = 0.0f;
+
+	// The distance of the junction on Spline itself.
+	UPROPERTY()
+		float NextDistance = 0.0f;
+
+	// Is this a forward link onto Spline?
+	UPROPERTY()
+		bool ForwardLink = false;
+};
+
+/**
+* The links from a pursuit spline to others, saved with the level.
+***********************************************************************************/
+
+USTRUCT()
+struct FSavedSplineLinks
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	// The spline that the links are from.
+	UPROPERTY()
+		UPursuitSplineComponent* Spline = nullptr;
+
+	// The links to other splines along the spline.
+	UPROPERTY()
+		TArray<FSavedSplineLink> Links;
+
+	// Is the spline a dead-start?
+	UPROPERTY()
+		bool DeadStart = false;
+
+	// Is the spline a dead-end?
+	UPROPERTY()
+		bool DeadEnd = false;
+};
+
+/**
+* How the end points of a spline were found to link onto a target spline.
+***********************************************************************************/
+
+struct FSplineLinkCandidate
+{
+public:
+
+	// Is the start of the spline connected to the target spline?
+	bool StartConnected = false;
+
+	// Is the end of the spline connected to the target spline?
+	bool EndConnected = false;
+
+	// The distance along the target spline of the start of the spline.
+	float StartDistance = 0.0f;
+
+	// The distance along the target spline of the end of the spline.
+	float EndDistance = 0.0f;
+};
+
 /**
 * Class for an pursuit spline actor, normally containing a single spline component.
 ***********************************************************************************/
@@ -40,9 +117,30 @@ public:
 		TArray<FPursuitPointData> PointData;
 
 	// The point extended data specific to the pursuit spline.
+	// This is the form the data is saved with the level in, and is read and written by the setup code that
+	// calculates master spline distances and the navigation cache checksums. Outside of the Editor it's
+	// released once the game mode has set up the splines, leaving just the packed data.
 	UPROPERTY()
 		TArray<FPursuitPointExtendedData> PointExtendedData;
 
+	// The point extended data packed for querying at run-time, built from PointExtendedData.
+	FPursuitPointExtendedPacked PackedExtendedData;
+
+	// Release the point extended data now that only the packed data is needed.
+	void ReleasePointExtendedData()
+	{ PointExtendedData.Empty(); }
+
+	// The optimum speed at each point for querying at run-time, built from PointData.
+	FRangeMinimumTable OptimumSpeedTable;
+
+	// The links from the splines of this actor to others, saved with the level from grip.SavePursuitSplineLinks so they needn't be established at run-time.
+	UPROPERTY()
+		TArray<FSavedSplineLinks> SavedSplineLinks;
+
+	// The hash of the spline data that the saved spline links were established from, or 0 if none.
+	UPROPERTY()
+		uint32 SavedSplineLinksHash = 0;
+
 	// Is this pursuit spline currently selected in the Editor?
 	UPROPERTY(Transient, BlueprintReadOnly, Category = Pursuit)
 		bool Selected;
@@ -71,6 +169,27 @@ public:
 	// Determine any splines that this actor has which can link onto the given spline.
 	bool EstablishPursuitSplineLinks(UPursuitSplineComponent* spline) const;
 
+	// Find how the end points of a spline link onto a target spline, only reading the splines so it's thread-safe.
+	static FSplineLinkCandidate FindSplineLink(const UPursuitSplineComponent* splineComponent, const UPursuitSplineComponent* targetSpline, bool testStart, bool testEnd);
+
+	// Add the links found between the end points of a spline and a target spline.
+	static void AddSplineLinks(UPursuitSplineComponent* splineComponent, UPursuitSplineComponent* targetSpline, const FSplineLinkCandidate& candidate);
+
+	// Calculate the bounds of the sections of a spline, for quickly rejecting end points that can't link onto it.
+	static void CalculateSplineLinkBounds(const UPursuitSplineComponent* spline, TArray<FBox>& bounds);
+
+	// Is a location close enough to a spline to possibly link onto it, given the bounds of its sections?
+	static bool IsWithinSplineLinkRange(const FVector& location, const TArray<FBox>& bounds);
+
+	// Calculate a hash of the spline data that the links between splines are established from.
+	static uint32 CalculateSplineLinksHash(const TArray<APursuitSplineActor*>& splineActors, const UPursuitSplineComponent* masterRacingSpline);
+
+	// Save the links from the splines of this actor with the level.
+	void SaveSplineLinks(uint32 hash);
+
+	// Restore the links from the splines of this actor that were saved with the level.
+	void RestoreSplineLinks() const;
+
 	// Calculate the extended point data by examining the scene around the spline.
 	bool Build(bool fromMenu);
 
@@ -195,6 +195,120 @@ public:
 	static const int32 NumDistances = 32;
 };
 
+/**
+* Structure for the extended point data of a pursuit spline, packed into contiguous
+* arrays for fast querying at run-time.
+*
+* This mirrors the serialized FPursuitPointExtendedData array, with just the fields
+* that are queried during play. That array is authoritative while the splines are
+* set up, and is released afterwards outside of the Editor, leaving just this. The
+* environment distances for each point are stored in a fixed, aligned block of
+* NumDistances floats rather than in a separate heap allocation per point.
+***********************************************************************************/
+
+struct FPursuitPointExtendedPacked
+{
+public:
+
+	// Pack the extended point data into this structure, optionally without summing the curvature.
+	void Pack(const TArray<FPursuitPointExtendedData>& pointData, bool sumCurvature = true);
+
+	// Pack just the master spline distances from the extended point data.
+	void PackMasterSplineDistances(const TArray<FPursuitPointExtendedData>& pointData);
+
+	// Get the number of points packed.
+	int32 Num() const
+	{ return Distances.Num(); }
+
+	// Get the block of NumDistances environment distances for a point.
+	const float* GetEnvironmentDistances(int32 index) const
+	{ return EnvironmentDistances.GetData() + (index * FPursuitPointExtendedData::NumDistances); }
+
+	// Get the environment distance in the direction of the ground for a point.
+	float GetGroundDistance(int32 index) const
+	{ return GetEnvironmentDistances(index)[UseGroundIndices[index]]; }
+
+	// Get the sum of the degrees difference between each point and the next over a number of points from a starting point.
+	FRotator GetCurvatureOverPoints(int32 index, int32 numPoints, bool closedLoop, bool absolute) const;
+
+	/**
+	* A running sum of degrees, kept in double precision as long splines can sum to
+	* large numbers of degrees and we subtract one sum from another to use them.
+	***********************************************************************************/
+
+	struct FDegreesSum
+	{
+		double Pitch = 0.0;
+		double Yaw = 0.0;
+		double Roll = 0.0;
+	};
+
+	// The distance along the spline at which each point is found.
+	TArray<float> Distances;
+
+	// The distance around the master spline that each point matches.
+	TArray<float> MasterSplineDistances;
+
+	// The maximum diameter of the tunnel at each point, if inside a tunnel.
+	TArray<float> MaxTunnelDiameters;
+
+	// The filtered exterior weather allowed to be rendered at each point.
+	TArray<float> UseWeatherAllowed;
+
+	// The filtered ground index into the environment distances for each point.
+	TArray<uint8> UseGroundIndices;
+
+	// Does the driving surface have an open edge on either side at each point?
+	TArray<bool> OpenEdges;
+
+	// Where is the raw ground relative to each point, in world space?
+	TArray<FVector> RawGroundOffsets;
+
+	// Where is the filtered ground relative to each point, in world space?
+	TArray<FVector> UseGroundOffsets;
+
+	// The orientation at each point.
+	TArray<FQuat> Quaternions;
+
+	// The running sums of the signed degrees difference between each point and the next, wrapping around to the first point at the end.
+	TArray<FDegreesSum> SignedCurvatureSums;
+
+	// The running sums of the unsigned degrees difference between each point and the next, wrapping around to the first point at the end.
+	TArray<FDegreesSum> UnsignedCurvatureSums;
+
+	// The environment distances for all of the points, NumDistances per point.
+	TArray<float, TAlignedHeapAllocator<16>> EnvironmentDistances;
+};
+
+/**
+* A sparse table for finding the minimum of any range of a list of values in
+* constant time, at the cost of n log n storage.
+***********************************************************************************/
+
+struct FRangeMinimumTable
+{
+public:
+
+	// Build the table from a list of values.
+	void Build(const TArray<float>& values);
+
+	// Get the number of values in the table.
+	int32 Num() const
+	{ return NumValues; }
+
+	// Get the minimum of the values between two indices inclusive.
+	float GetMinimum(int32 first, int32 last) const
+	{ int32 level = FMath::FloorLog2(last - first + 1); const float* minimums = Minimums.GetData() + (level * NumValues); return FMath::Min(minimums[first], minimums[last - (1 << level) + 1]); }
+
+private:
+
+	// The number of values in the table.
+	int32 NumValues = 0;
+
+	// The minimums of each run of 2^level values from each index, NumValues per level.
+	TArray<float> Minimums;
+};
+
 #pragma region NavigationSplines
 
 /**
@@ -301,10 +415,10 @@ public:
 #pragma region AINavigation
 
 	// Estimate where we are along the current spline, faster than DetermineThis.
-	void EstimateThis(const FVector& position, const FVector& movement, float movementSize, int32 numIterations, float accuracy);
+	void EstimateThis(const FVector& position, const FVector& movement, float movementSize, float accuracy);
 
 	// Determine where we are along the current spline.
-	void DetermineThis(const FVector& position, float movementSize, int32 numIterations, float accuracy);
+	void DetermineThis(const FVector& position, float movementSize, float accuracy);
 
 	// Determine where we are aiming for along the current or next spline, switching splines at branches if necessary.
 	void DetermineNext(float ahead, float movementSize, UPursuitSplineComponent* preferSpline, bool forMissile, bool wantPickups, bool highOptimumSpeed, float fastPathways);
@@ -316,7 +430,7 @@ public:
 	bool ChooseNextSpline(TWeakObjectPtr<UPursuitSplineComponent>& pursuitSpline, float distanceAlong, float& thisSwitchDistance, float& nextSwitchDistance, const FRouteChoice& choice, float movementSize, UPursuitSplineComponent* preferSpline, bool forMissile, bool wantPickups, bool highOptimumSpeed, float fastPathways) const;
 
 	// Switch to a new spline if we've passed the switch distance for it.
-	void SwitchSplineAtJunction(const FVector& position, float movementSize, int32 numIterations, float accuracy);
+	void SwitchSplineAtJunction(const FVector& position, float movementSize, float accuracy);
 
 	// Get the minimum optimum speed of the spline in kph over distance.
 	float GetMinimumOptimumSpeedOverDistance(float distance, float& overDistance, int32 direction) const;
@@ -463,16 +577,12 @@ public:
 
 	// Have we calculated the master spline distances for this particular spline?
 	bool HasMasterSplineDistances() const
-	{ const auto& pointData = GetPursuitPointExtendedData(); return (pointData.Num() == 0 || pointData[0].MasterSplineDistance >= 0.0f); }
+	{ const FPursuitPointExtendedPacked& packedData = GetPackedExtendedData(); return (packedData.Num() == 0 || packedData.MasterSplineDistances[0] >= 0.0f); }
 
 	// Get the spline point data at a particular point index.
 	FPursuitPointData& GetPursuitPoint(int32 index) const
 	{ auto& pointData = GetPursuitPointData(); return pointData[index]; }
 
-	// Get the extended spline point data at a particular point index.
-	FPursuitPointExtendedData& GetPursuitPointExtended(int32 index) const
-	{ auto& pointData = GetPursuitPointExtendedData(); return pointData[index]; }
-
 	// Clear all of the links along this spline.
 	void ClearSplineLinks()
 	{ SplineLinks.Empty(); }
@@ -530,18 +640,18 @@ private:
 	{ return ThisKey(key, direction * -1); }
 
 	// Bind an extended point index key to fall within the spline.
-	int32 BindExtendedKey(TArray<FPursuitPointExtendedData>& pointData, int32 key) const
+	int32 BindExtendedKey(int32 numPoints, int32 key) const
 	{ return (IsClosedLoop()
-		? ((key < 0) ? pointData.Num() + key : ((key >= pointData.Num()) ? key % pointData.Num() : key))
-		: FMath::Clamp(key, 0, pointData.Num() - 1)); }
+		? ((key < 0) ? numPoints + key : ((key >= numPoints) ? key % numPoints : key))
+		: FMath::Clamp(key, 0, numPoints - 1)); }
 
 	// Find the "this" extended point index key that falls within the spline.
-	int32 ThisExtendedKey(TArray<FPursuitPointExtendedData>& pointData, float key, int32 direction = 1) const
-	{ return BindExtendedKey(pointData, (direction >= 0) ? FMath::FloorToInt(key) : FMath::CeilToInt(key)); }
+	int32 ThisExtendedKey(int32 numPoints, float key, int32 direction = 1) const
+	{ return BindExtendedKey(numPoints, (direction >= 0) ? FMath::FloorToInt(key) : FMath::CeilToInt(key)); }
 
 	// Find the "next" extended point index key that falls within the spline.
-	int32 NextExtendedKey(TArray<FPursuitPointExtendedData>& pointData, float key, int32 direction = 1) const
-	{ return ThisExtendedKey(pointData, key, direction * -1); }
+	int32 NextExtendedKey(int32 numPoints, float key, int32 direction = 1) const
+	{ return ThisExtendedKey(numPoints, key, direction * -1); }
 
 	// Get the extended point keys bounding a distance along the spline.
 	void GetExtendedPointKeys(float distance, int32& key0, int32& key1, float& ratio) const;
@@ -549,14 +659,26 @@ private:
 	// The class that the master distances were found for this spline.
 	int32 MasterDistanceClass = 0;
 
+	// Was the derived data for this spline restored from the navigation cache?
+	bool NavigationCached = false;
+
 	// The parent actor for this spline.
 	APursuitSplineActor* PursuitSplineParent = nullptr;
 
 	// The point data, referenced from the parent actor.
 	TArray<FPursuitPointData>& GetPursuitPointData() const;
 
-	// The extended point data, referenced from the parent actor.
-	TArray<FPursuitPointExtendedData>& GetPursuitPointExtendedData() const;
+	// The packed extended point data for querying at run-time, referenced from the parent actor.
+	const FPursuitPointExtendedPacked& GetPackedExtendedData() const;
+
+	// The table of optimum speeds at each point for querying at run-time, referenced from the parent actor.
+	const FRangeMinimumTable& GetOptimumSpeedTable() const;
+
+	// Build the table of optimum speeds at each point.
+	void BuildOptimumSpeedTable();
+
+	// Get the minimum optimum speed of the spline in kph between two distances, where the start is before the end.
+	float GetMinimumOptimumSpeedBetweenDistances(float startDistance, float endDistance) const;
 
 #pragma endregion NavigationSplines
 
@@ -674,6 +796,13 @@ public:
 
 #pragma endregion CameraCinematics
 
+#pragma region FriendClasses
+
+	friend class FNavigationCache;
+	friend class APursuitSplineActor;
+
+#pragma endregion FriendClasses
+
 };
 
 /**
@@ -0,0 +1,137 @@
+/**
+*
+* Pursuit spline spatial index.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A uniform grid over the segments of all of the pursuit splines in a level, used
+* to quickly reduce the number of splines that need to be examined when looking
+* for the nearest spline to a point in space. It also caches line of sight tests
+* between small cells in world space and segments of the splines, which makes the
+* cached results approximate to within the size of those cells and segments.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class UPursuitSplineComponent;
+class APursuitSplineActor;
+
+/**
+* A spatial index for the pursuit splines in a level.
+***********************************************************************************/
+
+class FPursuitSplineIndex
+{
+public:
+
+	// Build the index from the pursuit spline actors in a level.
+	void Build(const TArray<APursuitSplineActor*>& splineActors);
+
+	// Clear the index.
+	void Clear();
+
+	// Has the index been built?
+	bool IsBuilt() const
+	{ return Splines.Num() > 0; }
+
+	// Get the number of splines in the index.
+	int32 GetNumSplines() const
+	{ return Splines.Num(); }
+
+	// Get a spline from the index.
+	UPursuitSplineComponent* GetSpline(int32 index) const
+	{ return Splines[index]; }
+
+	// Gather the indices of the splines that have a segment within a radius of a location, that haven't
+	// already been gathered. No spline that isn't gathered will be closer to the location than the radius.
+	void GatherSplinesWithinRange(const FVector& location, float radius, TArray<bool>& gathered, TArray<int32>& splines) const;
+
+	// Is a distance along a spline visible from a location, using the line of sight cache where possible.
+	// A cached result is approximate, having been tested from anywhere within the same small cell to anywhere within the same segment.
+	bool IsSplineVisible(UWorld* world, const FVector& location, int32 splineIndex, float distanceAlong, const FVector& splineLocation);
+
+	// The size of the cells in the index grid, in centimeters.
+	static const float CellSize;
+
+	// The largest radius to query the index with before falling back to examining every spline.
+	static const float MaxQueryRadius;
+
+private:
+
+	/**
+	* A segment of a spline, between two extended points.
+	***********************************************************************************/
+
+	struct FSegment
+	{
+		FSegment(const FBox& bounds, int32 splineIndex)
+			: Bounds(bounds)
+			, SplineIndex(splineIndex)
+		{ }
+
+		// The world space bounds of the segment.
+		FBox Bounds;
+
+		// The index of the spline that the segment belongs to.
+		int32 SplineIndex = 0;
+	};
+
+	/**
+	* The key for a line of sight test in the cache.
+	***********************************************************************************/
+
+	struct FLineOfSightKey
+	{
+		FLineOfSightKey(const FIntVector& cell, int32 splineIndex, int32 splineSegment)
+			: Cell(cell)
+			, SplineIndex(splineIndex)
+			, SplineSegment(splineSegment)
+		{ }
+
+		bool operator == (const FLineOfSightKey& other) const
+		{ return Cell == other.Cell && SplineIndex == other.SplineIndex && SplineSegment == other.SplineSegment; }
+
+		friend uint32 GetTypeHash(const FLineOfSightKey& key)
+		{ return HashCombine(GetTypeHash(key.Cell), HashCombine(GetTypeHash(key.SplineIndex), GetTypeHash(key.SplineSegment))); }
+
+		// The cell in world space that the test was made from.
+		FIntVector Cell;
+
+		// The index of the spline that the test was made to.
+		int32 SplineIndex = 0;
+
+		// The segment of the spline that the test was made to.
+		int32 SplineSegment = 0;
+	};
+
+	// Get the grid cell for a world location.
+	static FIntPoint GetCell(const FVector& location)
+	{ return FIntPoint(FMath::FloorToInt(location.X / CellSize), FMath::FloorToInt(location.Y / CellSize)); }
+
+	// The splines in the index.
+	TArray<UPursuitSplineComponent*> Splines;
+
+	// The segments of all of the splines in the index.
+	TArray<FSegment> Segments;
+
+	// The segments overlapping each of the grid cells, in the XY plane only as tracks are largely flat.
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	// The cached results of line of sight tests.
+	TMap<FLineOfSightKey, bool> LineOfSightCache;
+
+	// The lock guarding the line of sight cache, which may be used from worker threads.
+	FCriticalSection LineOfSightLock;
+
+	// The size of the cells used for caching line of sight tests, in centimeters.
+	static const float LineOfSightCellSize;
+
+	// The maximum number of line of sight tests to cache before flushing the cache.
+	static const int32 MaxLineOfSightTests;
+};
@@ -0,0 +1,73 @@
+/**
+*
+* Camera clip index.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A per-frame index of the camera clipping boxes of all of the vehicles, shared by
+* every camera that needs to be kept out of the vehicles. The world-space bounds of
+* each box are sorted along X so that a segment query only visits the vehicles that
+* overlap it along that axis, rather than every vehicle for every camera.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class ABaseVehicle;
+
+/**
+* The camera clip index.
+***********************************************************************************/
+
+class FCameraClipIndex
+{
+public:
+
+	// Refresh the index from the vehicles if it's not already been refreshed this frame.
+	void Refresh(const TArray<ABaseVehicle*>& vehicles);
+
+	// Clip a segment against the camera clipping boxes of the vehicles, moving its end to the first hit along it.
+	bool ClipSegment(const FVector& start, FVector& end, const ABaseVehicle* ignoreVehicle) const;
+
+	// Does a segment intersect the camera clipping box of any of the vehicles?
+	bool IntersectsSegment(const FVector& start, const FVector& end, const ABaseVehicle* ignoreVehicle) const
+	{ FVector clipped = end; return ClipSegment(start, clipped, ignoreVehicle); }
+
+	// Clear the index.
+	void Reset();
+
+private:
+
+	/**
+	* The camera clipping box of a vehicle.
+	***********************************************************************************/
+
+	struct FClipBox
+	{
+		// The bounds of the clipping box in world space.
+		FBox WorldBounds;
+
+		// The clipping box in the space of the vehicle.
+		FBox LocalBox;
+
+		// The transform of the vehicle.
+		FTransform Transform;
+
+		// The vehicle the clipping box belongs to.
+		const ABaseVehicle* Vehicle = nullptr;
+	};
+
+	// The clipping boxes of the vehicles, sorted on the minimum X of their world bounds.
+	TArray<FClipBox> Boxes;
+
+	// The maximum X extent of the world bounds of any of the clipping boxes.
+	float MaxSizeX = 0.0f;
+
+	// The frame the index was last refreshed on.
+	uint64 RefreshFrame = 0;
+};
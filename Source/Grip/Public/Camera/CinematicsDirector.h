@@ -424,6 +424,9 @@ private:
 	// Identify a potential weapon launch from the currently observed vehicle.
 	bool IdentifyWeaponLaunches();
 
+	// Update the recent weapon events from the game events recorded since the last update.
+	void UpdateRecentWeaponEvents(APlayGameMode* gameMode);
+
 	// Identify a potential impact event.
 	float IdentifyImpactEvent(ABaseVehicle* vehicle, TWeakObjectPtr<AActor>& impactingActor, float maxImpactTime, bool missilesOnly = false) const;
 
@@ -505,6 +508,12 @@ private:
 	// Has the current weapon event been concluded?
 	bool WeaponEventConcluded = false;
 
+	// The index of the next event to read from the game mode's game events.
+	int32 NextGameEvent = 0;
+
+	// The indices of the weapon use events recorded within the last quarter of a second, oldest first.
+	TArray<int32, TInlineAllocator<16>> RecentWeaponEvents;
+
 	// The last time a particular view was in use.
 	float LastViewTimes[(int32)ECinematicCameraMode::Num];
 
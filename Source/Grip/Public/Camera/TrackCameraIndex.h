@@ -0,0 +1,145 @@
+/**
+*
+* Track camera index.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* An index of the static track cameras in a level ordered by their distance along
+* the master racing spline, used by the cinematics director to find cameras that
+* have vehicles approaching them. The cameras never move, so their distances and
+* the time windows in which they look for vehicles are measured once when the
+* index is built. The vehicles that are fast enough to be filmed are then sorted
+* on their own distances each time a camera is looked for, and the two sorted
+* lists merged so that each camera only examines the vehicles within its window
+* rather than all of them.
+*
+* The index is controlled with grip.TrackCameraIndex.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class ABaseVehicle;
+class AStaticTrackCamera;
+class UPursuitSplineComponent;
+
+/**
+* The track camera index.
+***********************************************************************************/
+
+class FTrackCameraIndex
+{
+public:
+
+	/**
+	* A vehicle that may be approaching a track camera.
+	***********************************************************************************/
+
+	struct FVehicle
+	{
+		FVehicle() = default;
+
+		FVehicle(ABaseVehicle* vehicle, float distanceAlong, float speed)
+			: Vehicle(vehicle)
+			, DistanceAlong(distanceAlong)
+			, Speed(speed)
+		{ }
+
+		// The vehicle.
+		ABaseVehicle* Vehicle = nullptr;
+
+		// The distance of the vehicle along the master racing spline.
+		float DistanceAlong = 0.0f;
+
+		// The speed of the vehicle in centimeters per second.
+		float Speed = 0.0f;
+	};
+
+	// The vehicles that may be approaching track cameras.
+	typedef TArray<FVehicle, TInlineAllocator<GRIP_MAX_PLAYERS>> FVehicles;
+
+	/**
+	* A track camera and the vehicles that may be approaching it.
+	***********************************************************************************/
+
+	struct FCandidate
+	{
+		// The track camera.
+		AStaticTrackCamera* Camera = nullptr;
+
+		// The index of the camera in the list of track cameras the index was built from.
+		int32 Order = 0;
+
+		// The indices of the vehicles that may be approaching the camera, in the order they were given.
+		TArray<int32, TInlineAllocator<GRIP_MAX_PLAYERS>> Vehicles;
+	};
+
+	// Is the index to be used rather than examining every camera against every vehicle?
+	static bool IsEnabled();
+
+	// Refresh the index from the track cameras if they've changed since it was built.
+	void Refresh(const TArray<AStaticTrackCamera*>& cameras, UPursuitSplineComponent* masterRacingSpline);
+
+	// Has the index been built?
+	bool IsBuilt() const
+	{ return MasterRacingSpline != nullptr; }
+
+	// Get the track cameras that may have enough vehicles approaching them, in the order of the track cameras the index was built from.
+	void FindCandidates(const FVehicles& vehicles, TArray<FCandidate>& candidates) const;
+
+	// Clear the index.
+	void Reset();
+
+private:
+
+	/**
+	* A track camera in the index.
+	***********************************************************************************/
+
+	struct FEntry
+	{
+		// The track camera.
+		AStaticTrackCamera* Camera = nullptr;
+
+		// The index of the camera in the list of track cameras the index was built from.
+		int32 Order = 0;
+
+		// The distance of the camera along the master racing spline.
+		float DistanceAlong = 0.0f;
+
+		// The time behind the camera in which it looks for vehicles, in seconds.
+		float TimeBehind = 0.0f;
+
+		// The time ahead of the camera in which it looks for vehicles, in seconds.
+		float TimeAhead = 0.0f;
+
+		// The number of vehicles that must be approaching the camera for it to be used.
+		int32 NumberOfVehicles = 0;
+	};
+
+	// The track cameras, sorted on their distance along the master racing spline.
+	TArray<FEntry> Entries;
+
+	// The number of track cameras the index was built from.
+	int32 NumCameras = 0;
+
+	// The master racing spline the index was built from.
+	UPursuitSplineComponent* MasterRacingSpline = nullptr;
+
+	// The length of the master racing spline.
+	float SplineLength = 0.0f;
+
+	// Is the master racing spline a closed loop?
+	bool ClosedLoop = false;
+
+	// The longest time behind any of the cameras in which they look for vehicles, in seconds.
+	float MaxTimeBehind = 0.0f;
+
+	// The longest time ahead of any of the cameras in which they look for vehicles, in seconds.
+	float MaxTimeAhead = 0.0f;
+};
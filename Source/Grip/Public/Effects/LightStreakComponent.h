@@ -18,6 +18,7 @@
 #include "system/gameconfiguration.h"
 #include "system/mathhelpers.h"
 #include "proceduralmeshcomponent.h"
+#include "effects/streakmeshcomponent.h"
 #include "components/pointlightcomponent.h"
 #include "lightstreakcomponent.generated.h"
 
@@ -205,17 +206,21 @@ public:
 	// Add a new point to the streak.
 	void AddPoint(float alpha, bool force = false);
 
-	// Get the geometry used to render this visual effect.
+	// Get the geometry used to render the flares of this visual effect.
 	UProceduralMeshComponent* GetGeometry() const
 	{ return Geometry; }
 
+	// Get the geometry used to render the streak of this visual effect.
+	UStreakMeshComponent* GetStreakGeometry() const
+	{ return StreakGeometry; }
+
 	// Set whether a component (and its children) can be seen by their owner.
 	void SetOwnerNoSee(bool bNewOwnerNoSee) const
-	{ if (Geometry != nullptr) Geometry->SetOwnerNoSee(bNewOwnerNoSee); }
+	{ if (Geometry != nullptr) Geometry->SetOwnerNoSee(bNewOwnerNoSee); if (StreakGeometry != nullptr) StreakGeometry->SetOwnerNoSee(bNewOwnerNoSee); }
 
 	// Set whether a component (and its children) can be seen only by their owner.
 	void SetOnlyOwnerSee(bool bNewOwnerNoSee) const
-	{ if (Geometry != nullptr) Geometry->SetOnlyOwnerSee(bNewOwnerNoSee); }
+	{ if (Geometry != nullptr) Geometry->SetOnlyOwnerSee(bNewOwnerNoSee); if (StreakGeometry != nullptr) StreakGeometry->SetOnlyOwnerSee(bNewOwnerNoSee); }
 
 	// Is this light streak awake and currently visible?
 	bool IsAwake() const
@@ -223,8 +228,8 @@ public:
 
 protected:
 
-	// Switch to a new section for adding new points.
-	void SwitchSection(bool reset, bool empty);
+	// Build a vertex joint for the streak.
+	void BuildStreakJoint(FStreakMeshVertex* vertices, const FVector& location, FVector direction, const FVector& horizontalAxis, float alpha) const;
 
 	// Calculate the alpha value for a point.
 	float CalculateAlpha() const;
@@ -250,14 +255,6 @@ protected:
 	FMathEx::FMaterialScalarParameterSetter SetCentreFlareAspectRatio;
 	FMathEx::FMaterialScalarParameterSetter SetCentreFlareRotate;
 
-	// Geometry for the streak.
-	TArray<FVector> Vertices;
-	TArray<int32> Triangles;
-	TArray<FVector> Normals;
-	TArray<FVector2D> UV0;
-	TArray<FColor> Colours;
-	TArray<FProcMeshTangent> Tangents;
-
 	// Geometry for the flare.
 	TArray<FVector> FlareVertices;
 	TArray<int32> FlareTriangles;
@@ -281,33 +278,18 @@ protected:
 	// Last locations used for computing the geometry.
 	FVector LastLocations[3];
 
-	// The number of points added to the current geometry section.
+	// The number of points added to the streak since it was last reset.
 	int32 NumPointsAdded = 0;
 
 	// The time the last point was added.
 	float LastPointAdded = 0.0f;
 
-	// The current index number into the current geometry section.
-	int32 StartIndex = 0;
-
-	// The maximum number of vertices in a geometry section.
-	int32 MaxVertices = 0;
-
-	// The index into the current geometry section that we're adding points at.
-	int32 SectionIndex = 0;
-
 	// The distance the parent of this light streak has traveled while it's been adding points.
 	float DistanceTraveled = 0.0f;
 
 	// Noise function for generating random chaos to the game.
 	FPerlinNoise PerlinNoise;
 
-	// The time when a section was marked as no longer being updated, or < 0 if ready to be reused.
-	TArray<float> SectionsDisusedAt;
-
-	// The index number of the current streak section being used.
-	int32 StreakSectionIndex = 0;
-
 	// How long the streak has been dormant for.
 	float DormantTimer = 0.0f;
 
@@ -320,15 +302,19 @@ protected:
 	// The number of vertices used at each joint to render electrical streaks.
 	static const int32 NumJointVertices = 2;
 
-	// The number of joints per geometry section.
-	static const int32 NumJointsPerSection = 64;
+	// The number of joints in the ring buffer of the streak geometry, beyond which the oldest joints are overwritten.
+	static const int32 MaxJoints = 128;
 
 #pragma endregion VehicleLightStreaks
 
-	// The particle system for the effect.
+	// The geometry for the flares of the effect.
 	UPROPERTY(Transient)
 		UProceduralMeshComponent* Geometry = nullptr;
 
+	// The geometry for the streak of the effect.
+	UPROPERTY(Transient)
+		UStreakMeshComponent* StreakGeometry = nullptr;
+
 	// The dynamic material used for streaks.
 	UPROPERTY(Transient)
 		UMaterialInstanceDynamic* DynamicStreakMaterial = nullptr;
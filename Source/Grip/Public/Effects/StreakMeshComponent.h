@@ -0,0 +1,176 @@
+/**
+*
+* Streak mesh implementation.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* The geometry for light streaks, held in a fixed-capacity ring buffer of joints.
+* A procedural mesh component uploads every vertex of a section whenever any of
+* it changes, whereas here only the joint appended or extended is written to the
+* GPU, along with the indices of the two quads either side of it. This works on a
+* stock engine, with no engine modifications required.
+*
+* The number of bytes uploaded per frame can be logged with the console variable
+* grip.StreakMeshStats.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+#include "components/meshcomponent.h"
+#include "streakmeshcomponent.generated.h"
+
+/**
+* A vertex of a streak mesh, of which there are a number at each joint.
+***********************************************************************************/
+
+struct FStreakMeshVertex
+{
+	// The location of the vertex in world space.
+	FVector Position = FVector::ZeroVector;
+
+	// The sideways vector of the streak in world space.
+	FVector Normal = FVector(0.0f, 1.0f, 0.0f);
+
+	// The U coordinate combined with the time the joint was emitted.
+	FVector2D UV = FVector2D::ZeroVector;
+
+	// The forwards direction of the streak in world space, along with its alpha.
+	FColor Colour = FColor(255, 255, 255, 0);
+};
+
+/**
+* A streak mesh component, rendering a ribbon of joints from a ring buffer.
+***********************************************************************************/
+
+UCLASS(ClassGroup = Rendering)
+class GRIP_API UStreakMeshComponent : public UMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	// Construct a streak mesh component.
+	UStreakMeshComponent();
+
+#pragma region VehicleLightStreaks
+
+	// Initialize the ring buffer, with every joint collapsed onto a location.
+	void Initialize(int32 maxJoints, int32 numJointVertices, float width, const FVector& location);
+
+	// Reset the streak, collapsing every joint onto a location.
+	void Reset(const FVector& location);
+
+	// Append a joint to the head of the streak, connecting it to the last head if requested.
+	void AddJoint(const FStreakMeshVertex* vertices, bool connect);
+
+	// Replace the joint at the head of the streak.
+	void UpdateHeadJoint(const FStreakMeshVertex* vertices);
+
+	// Set whether the streak is drawn at all, to skip it once it has completely faded.
+	void SetDrawn(bool drawn);
+
+	// Get the number of joints in the ring buffer.
+	int32 GetMaxJoints() const
+	{ return MaxJoints; }
+
+	// Get the number of vertices at each joint.
+	int32 GetNumJointVertices() const
+	{ return NumJointVertices; }
+
+	// Get the vertices of the ring buffer.
+	const TArray<FStreakMeshVertex>& GetVertices() const
+	{ return Vertices; }
+
+	// Is a quad connecting a joint to the joint before it?
+	bool IsJointConnected(int32 joint) const
+	{ return Connected[joint]; }
+
+	// Is the streak currently being drawn?
+	bool IsDrawn() const
+	{ return Drawn; }
+
+	// Get the number of bytes uploaded to the GPU for all streak meshes in the last complete frame.
+	static int64 GetBytesUploadedLastFrame()
+	{ return BytesUploadedLastFrame; }
+
+	// Count bytes uploaded to the GPU, thread-safe as uploads are made on the render thread.
+	static void CountUpload(int64 numBytes)
+	{ FPlatformAtomics::InterlockedAdd(&TotalBytesUploaded, numBytes); }
+
+	// Create the scene proxy for rendering the streak.
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+
+	// Get the number of materials used by the streak.
+	virtual int32 GetNumMaterials() const override
+	{ return 1; }
+
+	// Calculate the bounds of the streak.
+	virtual FBoxSphereBounds CalcBounds(const FTransform& localToWorld) const override;
+
+private:
+
+	// Send the given joint to the render thread, optionally along with the quads either side of it.
+	void SendJoint(int32 joint, bool withQuads);
+
+	// Update the bounds of the streak.
+	void UpdateStreakBounds();
+
+	// Roll the upload counters over to a new frame if necessary, and log them if requested.
+	static void UpdateUploadStats();
+
+	// The vertices of every joint in the ring buffer.
+	TArray<FStreakMeshVertex> Vertices;
+
+	// Whether each joint is connected by a quad to the joint before it in the ring buffer.
+	TArray<bool> Connected;
+
+	// The number of joints in the ring buffer.
+	int32 MaxJoints = 0;
+
+	// The number of vertices at each joint.
+	int32 NumJointVertices = 0;
+
+	// The joint at the head of the streak.
+	int32 HeadJoint = 0;
+
+	// The width of the streak, used to expand its bounds.
+	float Width = 0.0f;
+
+	// Is the streak currently being drawn?
+	bool Drawn = true;
+
+	// The local bounds of the streak.
+	FBox LocalBounds = FBox(ForceInit);
+
+	// The total number of bytes uploaded to the GPU for all streak meshes.
+	static volatile int64 TotalBytesUploaded;
+
+	// The total number of bytes uploaded at the start of the current frame.
+	static int64 TotalBytesAtFrameStart;
+
+	// The number of bytes uploaded in the last complete frame.
+	static int64 BytesUploadedLastFrame;
+
+	// The maximum number of bytes uploaded in a frame since the stats were last logged.
+	static int64 MaxBytesUploadedSinceLog;
+
+	// The total number of bytes uploaded when the stats were last logged.
+	static int64 TotalBytesAtLastLog;
+
+	// The frame that the upload counters are currently counting.
+	static uint64 UploadFrame;
+
+	// The number of frames since the stats were last logged.
+	static int32 FramesSinceLog;
+
+	// The time the stats were last logged.
+	static double LastLogTime;
+
+#pragma endregion VehicleLightStreaks
+
+};
@@ -0,0 +1,141 @@
+/**
+*
+* Object pool.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A pool of the actors and particle system components that are otherwise spawned
+* and destroyed over and over again during a game, so that heavy combat doesn't
+* cause spawn hitches or garbage collection pressure.
+*
+* Actors are pooled by class, and can be created ahead of time when the level
+* starts. A pooled actor is hidden with its tick and collision disabled while it's
+* in the pool, and it's up to the actor to reset its own state before it's released
+* back into it, see APickupBase::ResetPickup.
+*
+* Particle system components are pooled by class and owner, as they're owned by
+* the actors they're spawned for. A transient component is reclaimed automatically
+* once its effect has completed, rather than being destroyed. Only effects that
+* nothing references after they've completed can be pooled, so the vehicle boost
+* and teleport effects, which are held onto and driven long after they're spawned,
+* are not, and neither is anything spawned from Blueprints.
+*
+* The pool isn't a UObject, so it only holds weak pointers to the objects in it and
+* forgets about any that are destroyed from elsewhere, as when their owners are.
+*
+* Pooling is controlled with grip.ObjectPool, and the hits, misses and peak usage
+* of each pooled class can be logged with grip.ObjectPoolStats.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+/**
+* The object pool.
+***********************************************************************************/
+
+class FObjectPool
+{
+public:
+
+	// Is pooling enabled?
+	static bool IsEnabled();
+
+	// Create a number of actors of a class ahead of time, ready to be acquired from the pool.
+	void PrewarmActors(UWorld* world, UClass* actorClass, int32 count);
+
+	// Acquire an actor of a class from the pool, spawning a new one if there are none free.
+	AActor* AcquireActor(UWorld* world, UClass* actorClass, const FVector& location, const FRotator& rotation, const FActorSpawnParameters& spawnParams);
+
+	// Acquire an actor of a class from the pool, spawning a new one if there are none free.
+	template <typename T>
+	T* AcquireActor(UWorld* world, UClass* actorClass, const FVector& location, const FRotator& rotation, const FActorSpawnParameters& spawnParams)
+	{ return Cast<T>(AcquireActor(world, actorClass, location, rotation, spawnParams)); }
+
+	// Is an actor one that belongs to the pool?
+	bool IsPooled(AActor* actor) const
+	{ return PooledActors.Contains(actor); }
+
+	// Release an actor back into the pool, it should already have reset its own state.
+	void ReleaseActor(AActor* actor);
+
+	// Acquire a particle system component for an owner from the pool, creating a new one if there are none free.
+	// A transient component is reclaimed automatically once its effect has completed, otherwise it must be released.
+	UParticleSystemComponent* AcquireParticleSystem(AActor* owner, UClass* componentClass, bool transient);
+
+	// Acquire a particle system component for an owner from the pool, creating a new one if there are none free.
+	template <typename T>
+	T* AcquireParticleSystem(AActor* owner, bool transient)
+	{ return Cast<T>(AcquireParticleSystem(owner, T::StaticClass(), transient)); }
+
+	// Release a particle system component to be reclaimed once its effect has completed, returning false if it doesn't belong to the pool.
+	bool ReleaseParticleSystem(UParticleSystemComponent* component);
+
+	// Reclaim the particle system components whose effects have completed, called once per frame.
+	void Tick();
+
+	// Log the statistics for each pooled class.
+	void LogStats() const;
+
+	// Clear the pool.
+	void Reset();
+
+private:
+
+	/**
+	* The usage statistics for a pooled class.
+	***********************************************************************************/
+
+	struct FPoolStats
+	{
+		// The number of objects created ahead of time.
+		int32 NumPrewarmed = 0;
+
+		// The number of objects acquired that were already free in the pool.
+		int32 NumHits = 0;
+
+		// The number of objects acquired that had to be created.
+		int32 NumMisses = 0;
+
+		// The number of objects currently in use.
+		int32 NumInUse = 0;
+
+		// The largest number of objects in use at any one time.
+		int32 PeakInUse = 0;
+	};
+
+	// The key for the particle system components of a class for a particular owner.
+	typedef TPair<TWeakObjectPtr<AActor>, TWeakObjectPtr<UClass>> FParticleSystemKey;
+
+	// Record the acquisition of an object from the pool.
+	void RecordAcquisition(UClass* objectClass, bool hit);
+
+	// Reclaim a particle system component that's completed its effect, ready for reuse.
+	void ReclaimParticleSystem(UParticleSystemComponent* component);
+
+	// Hide an actor and stop it from ticking or colliding while it's in the pool.
+	static void Deactivate(AActor* actor);
+
+	// The free actors for each pooled class.
+	TMap<TWeakObjectPtr<UClass>, TArray<TWeakObjectPtr<AActor>>> FreeActors;
+
+	// All of the actors that belong to the pool, whether free or in use.
+	TSet<TWeakObjectPtr<AActor>> PooledActors;
+
+	// The free particle system components for each pooled class and owner.
+	TMap<FParticleSystemKey, TArray<TWeakObjectPtr<UParticleSystemComponent>>> FreeParticleSystems;
+
+	// All of the particle system components that belong to the pool, whether free or in use.
+	TSet<TWeakObjectPtr<UParticleSystemComponent>> PooledParticleSystems;
+
+	// The particle system components released and waiting for their effects to complete before they're reclaimed.
+	TArray<TWeakObjectPtr<UParticleSystemComponent>> ReleasedParticleSystems;
+
+	// The usage statistics for each pooled class.
+	TMap<TWeakObjectPtr<UClass>, FPoolStats> Stats;
+};
@@ -0,0 +1,93 @@
+/**
+*
+* Race ranking.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Incrementally maintained orderings of the players in a race, by race distance
+* for race positions and by eternal race distance for catchup. The order from the
+* last frame is nearly always sorted already, or very nearly so, and so each
+* ordering is maintained with an insertion sort, where every swap made represents
+* one player passing another. These are exposed as overtake events along with race
+* position change events so that the HUD and cinematics don't need to poll for them.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+struct FPlayerRaceState;
+class ABaseVehicle;
+
+// Event for when a vehicle overtakes another, passing the overtaking vehicle and the overtaken vehicle.
+DECLARE_MULTICAST_DELEGATE_TwoParams(FVehicleOvertakenEvent, ABaseVehicle*, ABaseVehicle*);
+
+// Event for when the race position of a vehicle changes, passing the vehicle and its old and new race positions.
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FRacePositionChangedEvent, ABaseVehicle*, int32, int32);
+
+/**
+* The incrementally maintained race ranking.
+***********************************************************************************/
+
+class FRaceRanking
+{
+public:
+
+	// The players in a ranking, normally small enough to avoid allocation.
+	typedef TArray<FPlayerRaceState*, TInlineAllocator<GRIP_MAX_PLAYERS>> FRaceStates;
+
+	// The overtakes found when ordering by race distance.
+	typedef TArray<TPair<FPlayerRaceState*, FPlayerRaceState*>, TInlineAllocator<GRIP_MAX_PLAYERS>> FOvertakes;
+
+	// Order the incomplete players by race distance, returning the overtakes made since the last frame.
+	const FRaceStates& UpdateRaceOrder(const TArray<ABaseVehicle*>& vehicles, FOvertakes& overtakes);
+
+	// Order all of the players by eternal race distance, caching the median, minimum and maximum distances.
+	const FRaceStates& UpdateEternalOrder(const TArray<ABaseVehicle*>& vehicles);
+
+	// Clear the rankings.
+	void Reset();
+
+	// Get the median eternal race distance of all of the players.
+	float GetMedianEternalDistance() const
+	{ return MedianEternalDistance; }
+
+	// Get the minimum eternal race distance of all of the players.
+	float GetMinEternalDistance() const
+	{ return MinEternalDistance; }
+
+	// Get the maximum eternal race distance of all of the players.
+	float GetMaxEternalDistance() const
+	{ return MaxEternalDistance; }
+
+	// Broadcast when a vehicle overtakes another.
+	FVehicleOvertakenEvent OnVehicleOvertaken;
+
+	// Broadcast when the race position of a vehicle changes.
+	FRacePositionChangedEvent OnRacePositionChanged;
+
+private:
+
+	// Bring an ordering up to date with the players that should be in it, keeping the existing order where possible.
+	template <typename Predicate>
+	static void UpdateMembership(FRaceStates& order, const TArray<ABaseVehicle*>& vehicles, Predicate include);
+
+	// The incomplete players ordered by race distance.
+	FRaceStates RaceOrder;
+
+	// All of the players ordered by eternal race distance.
+	FRaceStates EternalOrder;
+
+	// The median eternal race distance of all of the players.
+	float MedianEternalDistance = 0.0f;
+
+	// The minimum eternal race distance of all of the players.
+	float MinEternalDistance = 0.0f;
+
+	// The maximum eternal race distance of all of the players.
+	float MaxEternalDistance = 0.0f;
+};
@@ -0,0 +1,117 @@
+/**
+*
+* Targeting service.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Shared per-frame vehicle targeting data, for selecting the targets of pickups.
+* Every human player selects targets every frame for the HUD, for each pickup slot,
+* and the bots do the same when weighing up the use of their pickups, with each of
+* them otherwise weighting all of the vehicles and tracing lines of sight to them.
+* Here, the distances between all of the vehicles are calculated once per frame and
+* lines of sight are cached for a few frames, shared by all of the consumers.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class ABaseVehicle;
+
+/**
+* The kinds of line of sight that can be cached, as they're traced between different
+* points on the vehicles.
+***********************************************************************************/
+
+enum class ETargetingSightLine : uint8
+{
+	// From the missile launch point to the bulls-eye of the target.
+	MissileSelection,
+
+	// From beneath the center of the launch vehicle to beneath the center of the target.
+	GunVisibility,
+
+	Num
+};
+
+/**
+* The targeting service.
+***********************************************************************************/
+
+class FTargetingService
+{
+public:
+
+	// Refresh the distances between the vehicles if they've not already been refreshed this frame.
+	void Refresh(const TArray<ABaseVehicle*>& vehicles);
+
+	// Is a vehicle beyond a distance from another vehicle, between their bulls-eyes, this frame?
+	bool IsBeyond(const ABaseVehicle* from, const ABaseVehicle* to, float distance) const;
+
+	// Is there a line of sight between two vehicles, cached for a few frames?
+	bool HasLineOfSight(ETargetingSightLine sightLine, ABaseVehicle* from, ABaseVehicle* to, const FVector& fromLocation, const FVector& toLocation);
+
+	// Clear the service, normally when the vehicles change.
+	void Reset();
+
+	// Get the number of line of sight queries made in the last complete frame.
+	int32 GetNumSightQueriesLastFrame() const
+	{ return NumSightQueriesLastFrame; }
+
+	// Get the number of line of sight traces made in the last complete frame.
+	int32 GetNumSightTracesLastFrame() const
+	{ return NumSightTracesLastFrame; }
+
+	// The number of frames that a line of sight is cached for.
+	static const int32 SightLineFrames = 4;
+
+private:
+
+	/**
+	* The targeting data between a pair of vehicles.
+	***********************************************************************************/
+
+	struct FTargetingPair
+	{
+		// The distance between the bulls-eyes of the vehicles.
+		float Distance = 0.0f;
+
+		// The frame that each line of sight was traced on.
+		uint64 SightFrame[(int32)ETargetingSightLine::Num] = { 0, 0 };
+
+		// Was each line of sight clear?
+		bool Sight[(int32)ETargetingSightLine::Num] = { false, false };
+	};
+
+	// Get the pair of vehicles, if the vehicles are known to the service.
+	FTargetingPair* GetPair(const ABaseVehicle* from, const ABaseVehicle* to);
+
+	// Get the pair of vehicles, if the vehicles are known to the service.
+	const FTargetingPair* GetPair(const ABaseVehicle* from, const ABaseVehicle* to) const
+	{ return const_cast<FTargetingService*>(this)->GetPair(from, to); }
+
+	// The targeting data between each pair of vehicles, indexed by vehicle index.
+	TArray<FTargetingPair> Pairs;
+
+	// The number of vehicles in the pair table.
+	int32 NumVehicles = 0;
+
+	// The frame the distances were last refreshed on.
+	uint64 RefreshFrame = 0;
+
+	// The number of line of sight queries made in the current frame.
+	int32 NumSightQueries = 0;
+
+	// The number of line of sight traces made in the current frame.
+	int32 NumSightTraces = 0;
+
+	// The number of line of sight queries made in the last complete frame.
+	int32 NumSightQueriesLastFrame = 0;
+
+	// The number of line of sight traces made in the last complete frame.
+	int32 NumSightTracesLastFrame = 0;
+};
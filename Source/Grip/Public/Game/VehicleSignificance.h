@@ -0,0 +1,233 @@
+/**
+*
+* Vehicle significance.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Rank the vehicles each frame by how significant they are to the local cameras,
+* from their distance to the nearest camera and whether they're in view of any of
+* them, and assign each a tier that throttles or suspends its cosmetic work. That
+* is the animated bones, light streaks, surface effects, cockpit materials and HUD
+* animation on the visual side, and the audio parameter updates on the audio side.
+* None of this work affects the game simulation, so it's safe to update it less
+* often, with the time since it was last updated, for vehicles that can't be seen
+* clearly.
+*
+* Local players and the vehicles being watched by a camera are always updated in
+* full. The significance is controlled with grip.VehicleSignificance, and shown on
+* ADebugSignificanceHUD along with an estimate of the time saved.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class ABaseVehicle;
+
+/**
+* The tiers of significance of a vehicle, from most to least significant.
+***********************************************************************************/
+
+enum class EVehicleSignificanceTier : uint8
+{
+	// Update all cosmetic work every frame.
+	Full,
+
+	// Update cosmetic work every other frame.
+	Reduced,
+
+	// Update cosmetic work every fourth frame.
+	Minimal,
+
+	// Suspend visual work and update audio every eighth frame.
+	Dormant,
+
+	Num
+};
+
+/**
+* A view from a local camera, used to determine vehicle significance.
+***********************************************************************************/
+
+struct FVehicleSignificanceView
+{
+	FVehicleSignificanceView() = default;
+
+	FVehicleSignificanceView(const FVector& location, const FVector& direction, float fov)
+		: Location(location)
+		, Direction(direction)
+		, FOV(fov)
+	{ }
+
+	// The location of the camera.
+	FVector Location = FVector::ZeroVector;
+
+	// The normalized direction the camera is facing.
+	FVector Direction = FVector::ForwardVector;
+
+	// The horizontal field of view of the camera in degrees.
+	float FOV = 90.0f;
+};
+
+/**
+* A scope that adds the CPU cycles spent within it to a counter, used to measure
+* the cost of cosmetic work.
+***********************************************************************************/
+
+struct FVehicleSignificanceCycleScope
+{
+	FVehicleSignificanceCycleScope(uint64& cycles)
+		: Cycles(cycles)
+		, StartCycles(FPlatformTime::Cycles64())
+	{ }
+
+	~FVehicleSignificanceCycleScope()
+	{ Cycles += FPlatformTime::Cycles64() - StartCycles; }
+
+private:
+
+	// The counter to add the cycles to.
+	uint64& Cycles;
+
+	// The CPU cycles when the scope was entered.
+	uint64 StartCycles = 0;
+};
+
+/**
+* The vehicle significance manager.
+***********************************************************************************/
+
+class FVehicleSignificance
+{
+public:
+
+	// Is vehicle significance enabled?
+	static bool IsEnabled();
+
+	// Rank the vehicles against the local camera views and assign their tiers for the next frame.
+	void Update(const TArray<ABaseVehicle*>& vehicles, TArrayView<const FVehicleSignificanceView> views, const TArray<ABaseVehicle*>& watchedVehicles);
+
+	// Get the time to update a vehicle's visual work by this frame, or 0 if it's to be skipped.
+	float GetVisualDeltaSeconds(int32 vehicleIndex, float deltaSeconds)
+	{ return Vehicles[vehicleIndex].Visual.Advance(deltaSeconds, GetVisualInterval(Vehicles[vehicleIndex].Tier), FrameNumber + vehicleIndex); }
+
+	// Get the time to update a vehicle's audio work by this frame, or 0 if it's to be skipped.
+	float GetAudioDeltaSeconds(int32 vehicleIndex, float deltaSeconds)
+	{ return Vehicles[vehicleIndex].Audio.Advance(deltaSeconds, GetAudioInterval(Vehicles[vehicleIndex].Tier), FrameNumber + vehicleIndex); }
+
+	// Add the CPU cycles spent on a vehicle's visual and audio work this frame.
+	void AddCycles(int32 vehicleIndex, uint64 visualCycles, uint64 audioCycles)
+	{ Vehicles[vehicleIndex].Visual.Cycles += visualCycles; Vehicles[vehicleIndex].Audio.Cycles += audioCycles; }
+
+	// Get the tier assigned to a vehicle.
+	EVehicleSignificanceTier GetTier(int32 vehicleIndex) const
+	{ return Vehicles[vehicleIndex].Tier; }
+
+	// Get the significance of a vehicle, between 0 and 1.
+	float GetSignificance(int32 vehicleIndex) const
+	{ return Vehicles[vehicleIndex].Significance; }
+
+	// Get the distance of a vehicle to the nearest local camera.
+	float GetDistance(int32 vehicleIndex) const
+	{ return Vehicles[vehicleIndex].Distance; }
+
+	// Is a vehicle in view of any of the local cameras?
+	bool IsVisible(int32 vehicleIndex) const
+	{ return Vehicles[vehicleIndex].Visible; }
+
+	// Get the number of vehicles assigned to a tier.
+	int32 GetNumVehicles(EVehicleSignificanceTier tier) const
+	{ return NumVehicles[(int32)tier]; }
+
+	// Get the smoothed time spent on cosmetic work per frame, in milliseconds.
+	float GetSpentTime() const
+	{ return SpentTime; }
+
+	// Get the smoothed estimate of the time saved on cosmetic work per frame, in milliseconds.
+	float GetSavedTime() const
+	{ return SavedTime; }
+
+	// Clear the significance of all vehicles.
+	void Reset();
+
+	// Get the name of a tier.
+	static const TCHAR* GetTierName(EVehicleSignificanceTier tier);
+
+private:
+
+	/**
+	* The throttling of a channel of cosmetic work for a vehicle.
+	***********************************************************************************/
+
+	struct FChannel
+	{
+		// Advance the channel by a frame, returning the time to update it by or 0 if it's to be skipped.
+		// The phase staggers the updates of different vehicles across frames.
+		float Advance(float deltaSeconds, int32 interval, uint32 phase);
+
+		// Update the cost of the channel at the end of a frame, returning the estimated CPU cycles saved.
+		float UpdateCost();
+
+		// The time accumulated since the channel was last updated.
+		float Time = 0.0f;
+
+		// Was the update of the channel skipped this frame?
+		bool Skipped = false;
+
+		// The CPU cycles spent on the channel this frame.
+		uint64 Cycles = 0;
+
+		// The average CPU cycles spent on an update of the channel.
+		float AverageCycles = 0.0f;
+	};
+
+	/**
+	* The significance of a vehicle.
+	***********************************************************************************/
+
+	struct FVehicleState
+	{
+		// The tier assigned to the vehicle.
+		EVehicleSignificanceTier Tier = EVehicleSignificanceTier::Full;
+
+		// The significance of the vehicle, between 0 and 1.
+		float Significance = 1.0f;
+
+		// The distance of the vehicle to the nearest local camera.
+		float Distance = 0.0f;
+
+		// Is the vehicle in view of any of the local cameras?
+		bool Visible = true;
+
+		// The visual work of the vehicle.
+		FChannel Visual;
+
+		// The audio work of the vehicle.
+		FChannel Audio;
+	};
+
+	// Get the number of frames between visual updates for a tier, or 0 if suspended.
+	static int32 GetVisualInterval(EVehicleSignificanceTier tier);
+
+	// Get the number of frames between audio updates for a tier.
+	static int32 GetAudioInterval(EVehicleSignificanceTier tier);
+
+	// The significance of each vehicle, by vehicle index.
+	FVehicleState Vehicles[GRIP_MAX_PLAYERS];
+
+	// The number of vehicles assigned to each tier.
+	int32 NumVehicles[(int32)EVehicleSignificanceTier::Num] = { 0 };
+
+	// The smoothed time spent on cosmetic work per frame, in milliseconds.
+	float SpentTime = 0.0f;
+
+	// The smoothed estimate of the time saved on cosmetic work per frame, in milliseconds.
+	float SavedTime = 0.0f;
+
+	// The number of frames the significance has been updated for, used to stagger the vehicle updates.
+	uint32 FrameNumber = 0;
+};
@@ -16,10 +16,23 @@
 
 #include "system/gameconfiguration.h"
 #include "ai/trackcheckpoint.h"
+#include "ai/pursuitsplineindex.h"
 #include "system/timesmoothing.h"
 #include "system/mathhelpers.h"
 #include "system/timeshareclock.h"
 #include "system/avoidable.h"
+#include "system/racesimulation.h"
+#include "system/racereplay.h"
+#include "system/frameprofiler.h"
+#include "game/raceranking.h"
+#include "game/targetingservice.h"
+#include "camera/cameraclipindex.h"
+#include "camera/trackcameraindex.h"
+#include "pickups/padproximityindex.h"
+#include "ai/attractableindex.h"
+#include "pickups/gunroundbatch.h"
+#include "game/objectpool.h"
+#include "game/vehiclesignificance.h"
 #include "gamemodes/basegamemode.h"
 #include "effects/drivingsurfacecharacteristics.h"
 #include "pickups/pickup.h"
@@ -486,6 +499,10 @@ public:
 	UPROPERTY(EditAnywhere, Category = "System")
 		UGameStateOverrides* GameStateOverrides = nullptr;
 
+	// The number of each pooled pickup to create ahead of time when the level starts.
+	UPROPERTY(EditAnywhere, Category = "System", meta = (UIMin = "0", UIMax = "16", ClampMin = "0", ClampMax = "16"))
+		int32 ObjectPoolPrewarmCount = 4;
+
 	// The difficulty characteristics for easy mode.
 	UPROPERTY(EditAnywhere, Category = "Difficulty")
 		FDifficultyCharacteristics DifficultyEasy;
@@ -514,7 +531,8 @@ public:
 	UPROPERTY(Transient, BlueprintReadWrite, Category = "System")
 		bool StopWhatYouDoing = false;
 
-	// The events that have occurred during this particular game event.
+	// The events that have occurred during this particular game event, only ever appended to so
+	// that consumers can keep the index of the next event to read rather than rescanning them.
 	UPROPERTY(Transient, BlueprintReadOnly, Category = "System")
 		TArray<FGameEvent> GameEvents;
 
@@ -530,11 +548,11 @@ public:
 	UPROPERTY(Transient)
 		TArray<AStaticTrackCamera*> TrackCameras;
 
-	// The speed pads contained in the current level. Currently unused, but left in any way.
+	// The speed pads contained in the current level.
 	UPROPERTY(Transient)
 		TArray<ASpeedPad*> SpeedPads;
 
-	// The pickup pads contained in the current level. Currently unused, but left in any way.
+	// The pickup pads contained in the current level.
 	UPROPERTY(Transient)
 		TArray<APickup*> PickupPads;
 
@@ -592,6 +610,14 @@ public:
 	bool GameHasEnded() const
 	{ return (GameSequence >= EGameSequence::End); }
 
+	// Is this game a headless race simulation, with only AI drivers and no HUD?
+	bool IsSimulatingRace() const
+#if GRIP_RACE_SIMULATION
+	{ return FRaceSimulation::Get().IsActive(); }
+#else // GRIP_RACE_SIMULATION
+	{ return false; }
+#endif // GRIP_RACE_SIMULATION
+
 	// Get the countdown opacity for the text at the start of a race.
 	float GetCountdownOpacity() const;
 
@@ -676,11 +702,11 @@ public:
 
 	// Add an attractable to the list of attractables present in the current level.
 	void AddAttractable(AActor* actor)
-	{ if (Attractables.Contains(actor) == false) Attractables.Emplace(actor, Cast<IAttractableInterface>(actor)); }
+	{ if (Attractables.Contains(actor) == false) { Attractables.Emplace(actor, Cast<IAttractableInterface>(actor)); AttractableIndex.Invalidate(); } }
 
 	// Remove an attractable from the list of attractables present in the current level.
 	void RemoveAttractable(AActor* actor)
-	{ if (Attractables.Contains(actor) == true) { Attractables.Remove(actor); Attractables.Compact(); } }
+	{ if (Attractables.Contains(actor) == true) { Attractables.Remove(actor); Attractables.Compact(); AttractableIndex.Invalidate(); } }
 
 	// Determine the vehicles that are currently present in the level.
 	void DetermineVehicles();
@@ -700,8 +726,8 @@ public:
 	// Build all of the pursuit splines.
 	static void BuildPursuitSplines(bool check, const FName& navigationLayer, UWorld* world, UGlobalGameState* gameState, UPursuitSplineComponent* masterRacingSpline);
 
-	// Establish all of the links between pursuit splines.
-	static void EstablishPursuitSplineLinks(bool check, const FName& navigationLayer, UWorld* world, UGlobalGameState* gameState, UPursuitSplineComponent* masterRacingSpline);
+	// Establish all of the links between pursuit splines, optionally saving them with the level when in the Editor.
+	static void EstablishPursuitSplineLinks(bool check, const FName& navigationLayer, UWorld* world, UGlobalGameState* gameState, UPursuitSplineComponent* masterRacingSpline, bool saveLinks);
 
 	// List of the last few frame times, used to determine an average, recent frame rate.
 	FTimedFloatList FrameTimes = FTimedFloatList(1, 30);
@@ -717,6 +743,60 @@ public:
 	// The length of the master racing spline in centimeters.
 	float MasterRacingSplineLength = 0.0f;
 
+	// The spatial index of the pursuit splines, used to find the nearest spline to a location quickly.
+	FPursuitSplineIndex PursuitSplineIndex;
+
+	// The incrementally maintained race ranking, with events for overtakes and race position changes.
+	FRaceRanking RaceRanking;
+
+	// Get the targeting service, shared by all pickup target selection, refreshing it if it's not already been refreshed this frame.
+	FTargetingService& GetTargeting()
+	{ Targeting.Refresh(Vehicles); return Targeting; }
+
+	// The targeting service, shared by all pickup target selection.
+	FTargetingService Targeting;
+
+	// Get the camera clip index, shared by all cameras, refreshing it if it's not already been refreshed this frame.
+	const FCameraClipIndex& GetCameraClipIndex()
+	{ CameraClipIndex.Refresh(Vehicles); return CameraClipIndex; }
+
+	// The camera clip index, shared by all cameras.
+	FCameraClipIndex CameraClipIndex;
+
+	// Get the pad proximity index, used by the vehicles to collect the pickup pads and speed pads.
+	const FPadProximityIndex& GetPadProximityIndex()
+	{ PadProximityIndex.Refresh(PickupPads, SpeedPads); return PadProximityIndex; }
+
+	// The pad proximity index, used by the vehicles to collect the pickup pads and speed pads.
+	FPadProximityIndex PadProximityIndex;
+
+	// Get the attractable index, used by the bots to look for targets of opportunity, refreshing it if the attractables have changed.
+	const FAttractableIndex& GetAttractableIndex()
+	{ AttractableIndex.Refresh(Attractables, MasterRacingSpline.Get()); return AttractableIndex; }
+
+	// The attractable index, used by the bots to look for targets of opportunity.
+	FAttractableIndex AttractableIndex;
+
+	// Get the track camera index, used by the cinematics director to find static cameras with vehicles approaching them.
+	const FTrackCameraIndex& GetTrackCameraIndex()
+	{ TrackCameraIndex.Refresh(TrackCameras, MasterRacingSpline.Get()); return TrackCameraIndex; }
+
+	// The track camera index, used by the cinematics director to find static cameras with vehicles approaching them.
+	FTrackCameraIndex TrackCameraIndex;
+
+	// The batch of rounds fired by all of the Gatling guns this frame, resolved together in the game mode's tick.
+	FGunRoundBatch GunRounds;
+
+	// The pool of pickup actors and transient particle system components, recycled rather than spawned and destroyed.
+	FObjectPool ObjectPool;
+
+	// The significance of each vehicle to the local cameras, used to throttle their cosmetic work.
+	FVehicleSignificance VehicleSignificance;
+
+	// The random number stream for everything that affects the simulation of a race, kept apart from the global
+	// one that the cameras, effects and HUD draw from so that a race can be reproduced from its seed alone.
+	static FRandomStream SimulationRandom;
+
 	// The distance around the master racing spline of the start line.
 	float MasterRacingSplineStartDistance = 0.0f;
 
@@ -759,7 +839,7 @@ private:
 
 public:
 
-	// Update vehicle sound volumes for the local player(s).
+	// Update vehicle sound volumes and significance for the local player(s).
 	void UpdateVehicleVolumes(float deltaSeconds);
 
 private:
@@ -19,6 +19,7 @@
 #include "gatlinggun.generated.h"
 
 struct FPlayerPickupSlot;
+struct FGunRound;
 
 /**
 * Boilerplate class for the GunHostInterface.
@@ -173,6 +174,9 @@ public:
 	// Sweep along projectile direction to see if it hits something along the way.
 	bool GetCollision(UWorld* world, const FVector& start, const FVector& end, float& time, AActor* ignoreTarget);
 
+	// Resolve a round fired from the gun, applying the result of its trace.
+	void ResolveRound(const FGunRound& round);
+
 	// Is the gun currently active?
 	bool IsActive() const
 	{ return Timer < Duration + WindUpTime + WindDownTime; }
@@ -199,6 +203,9 @@ protected:
 	// Do the regular update tick.
 	virtual void Tick(float deltaSeconds) override;
 
+	// Reset the pickup to its initial state, ready to be reused from the object pool.
+	virtual void ResetPickup() override;
+
 private:
 
 	// The launch platform for the gun, not necessarily a vehicle, could be a defense turret also.
@@ -0,0 +1,123 @@
+/**
+*
+* Gun round batch.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A batch of the hitscan rounds fired by all of the Gatling guns in a frame. Each
+* gun aims its rounds as it ticks and adds them to the batch rather than tracing
+* them there and then. The game mode then traces the whole batch together, in
+* parallel on the worker threads, and hands the results back to each gun to apply
+* later in the same frame.
+*
+* Batching is controlled with grip.BatchedGunRounds, and the number of traces and
+* target selections made per second can be logged with grip.GunRoundStats to
+* compare the batched and unbatched costs.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class AGatlingGun;
+
+/**
+* A single round fired from a gun, and the result of its trace once resolved.
+***********************************************************************************/
+
+struct FGunRound
+{
+	// The gun that fired the round.
+	AGatlingGun* Gun = nullptr;
+
+	// The launch platform of the gun, ignored by the round's trace.
+	AActor* LaunchPlatform = nullptr;
+
+	// The world location the round was fired from.
+	FVector Start = FVector::ZeroVector;
+
+	// The world location at the end of the round's range.
+	FVector End = FVector::ZeroVector;
+
+	// The normalized direction the round was fired in.
+	FVector Direction = FVector::ZeroVector;
+
+	// The target the gun was aiming for when the round was fired.
+	AActor* Target = nullptr;
+
+	// The target that the round has been told to miss, if any.
+	AActor* IgnoreTarget = nullptr;
+
+	// The index of the vehicle that fired the round, or -1 if fired from a launch platform that isn't a vehicle.
+	int32 LaunchVehicleIndex = -1;
+
+	// Did the round hit something?
+	bool Hit = false;
+
+	// The normalized time along the trace of the hit.
+	float Time = 0.0f;
+
+	// The hit result of the trace.
+	FHitResult HitResult;
+};
+
+/**
+* The gun round batch.
+***********************************************************************************/
+
+class FGunRoundBatch
+{
+public:
+
+	// Are gun rounds to be added to the batch rather than traced as they're fired?
+	static bool IsEnabled();
+
+	// Add a round to the batch to be resolved later in the frame.
+	void AddRound(const FGunRound& round)
+	{ Rounds.Emplace(round); }
+
+	// Trace all of the rounds in the batch and apply their results to the guns that fired them.
+	void Resolve(UWorld* world);
+
+	// Remove any unresolved rounds fired by a gun, normally because it's being destroyed.
+	void RemoveRounds(AGatlingGun* gun);
+
+	// Clear the batch.
+	void Reset()
+	{ Rounds.Reset(); }
+
+	// Count a trace made for a round, whether batched or not.
+	void AddTraces(int32 numTraces)
+	{ NumTraces += numTraces; }
+
+	// Count a target selection made for firing rounds.
+	void AddTargetSelection()
+	{ NumTargetSelections++; }
+
+private:
+
+	// Trace a round, thread-safe so that rounds can be traced in parallel.
+	static void Trace(UWorld* world, FGunRound& round);
+
+	// Roll the counters over and log them once per second if requested.
+	void UpdateStats();
+
+	// The rounds waiting to be resolved.
+	TArray<FGunRound> Rounds;
+
+	// The number of traces made since the counters were last logged.
+	int32 NumTraces = 0;
+
+	// The number of target selections made since the counters were last logged.
+	int32 NumTargetSelections = 0;
+
+	// The number of batches resolved since the counters were last logged.
+	int32 NumBatches = 0;
+
+	// The time at which the counters were last logged.
+	double LastLogTime = 0.0;
+};
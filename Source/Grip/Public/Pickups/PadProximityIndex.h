@@ -0,0 +1,119 @@
+/**
+*
+* Pad proximity index.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A static index of the collision volumes of the pickup pads and speed pads, for
+* the vehicles to collect them from. The pads never move, so their volumes are
+* captured once and sorted along X so that a query only visits the pads that are
+* near to it along that axis. A vehicle queries with a capsule swept along its path
+* since the last frame, so that pads aren't missed at very high speed, rather than
+* asking the physics engine for its overlapping actors every frame.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class APickup;
+class ASpeedPad;
+class UShapeComponent;
+
+/**
+* A capsule swept along a path, used to query the pad proximity index.
+***********************************************************************************/
+
+struct FPadProximityCapsule
+{
+	FPadProximityCapsule() = default;
+
+	FPadProximityCapsule(const FVector& start, const FVector& end, float radius)
+		: Start(start)
+		, End(end)
+		, Radius(radius)
+	{ }
+
+	// The start of the axis of the capsule in world space.
+	FVector Start = FVector::ZeroVector;
+
+	// The end of the axis of the capsule in world space.
+	FVector End = FVector::ZeroVector;
+
+	// The radius of the capsule.
+	float Radius = 0.0f;
+};
+
+/**
+* The pad proximity index.
+***********************************************************************************/
+
+class FPadProximityIndex
+{
+public:
+
+	// Refresh the index from the pads if they've changed since it was built.
+	void Refresh(const TArray<APickup*>& pickupPads, const TArray<ASpeedPad*>& speedPads);
+
+	// Get the pickup pads touched by any of a set of capsules.
+	void FindPickupPads(TArrayView<const FPadProximityCapsule> capsules, TArray<APickup*, TInlineAllocator<4>>& pickupPads) const;
+
+	// Get the speed pads touched by any of a set of capsules.
+	void FindSpeedPads(TArrayView<const FPadProximityCapsule> capsules, TArray<ASpeedPad*, TInlineAllocator<4>>& speedPads) const;
+
+	// Clear the index.
+	void Reset();
+
+private:
+
+	/**
+	* The collision volume of a pad.
+	***********************************************************************************/
+
+	struct FPadVolume
+	{
+		// The bounds of the volume in world space.
+		FBox WorldBounds;
+
+		// The transform of the volume, without scale.
+		FTransform Transform;
+
+		// The extent of a box volume, or the radius of a sphere volume in X.
+		FVector Extent = FVector::ZeroVector;
+
+		// Is the volume a sphere rather than a box?
+		bool Sphere = false;
+
+		// The pickup pad the volume belongs to.
+		APickup* PickupPad = nullptr;
+
+		// The speed pad the volume belongs to.
+		ASpeedPad* SpeedPad = nullptr;
+	};
+
+	// Add the volume of a pad from its collision shape.
+	void AddVolume(UShapeComponent* shape, APickup* pickupPad, ASpeedPad* speedPad);
+
+	// Does a capsule touch a volume?
+	static bool Touches(const FPadVolume& volume, const FPadProximityCapsule& capsule);
+
+	// Call a function for each volume touched by any of a set of capsules.
+	template <typename F>
+	void ForEachTouchedVolume(TArrayView<const FPadProximityCapsule> capsules, F function) const;
+
+	// The volumes of the pads, sorted on the minimum X of their world bounds.
+	TArray<FPadVolume> Volumes;
+
+	// The maximum X extent of the world bounds of any of the volumes.
+	float MaxSizeX = 0.0f;
+
+	// The number of pickup pads the index was built from.
+	int32 NumPickupPads = -1;
+
+	// The number of speed pads the index was built from.
+	int32 NumSpeedPads = -1;
+};
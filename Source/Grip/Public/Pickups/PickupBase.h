@@ -60,7 +60,7 @@ public:
 	// Activate the pickup.
 	virtual void ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlot, EPickupActivation activation, bool charged);
 
-	// Destroy the pickup.
+	// Destroy the pickup, releasing it back into the object pool if it came from there.
 	virtual void DestroyPickup();
 
 	// What type is this pickup?
@@ -85,6 +85,9 @@ protected:
 	// Do some post initialization just before the game is ready to play.
 	virtual void PostInitializeComponents() override;
 
+	// Reset the pickup to its initial state, ready to be reused from the object pool.
+	virtual void ResetPickup();
+
 	// Which slot in the launch vehicle this pickup is assigned to.
 	int32 PickupSlot = 0;
 
@@ -95,6 +95,9 @@ protected:
 	// Do the regular update tick.
 	virtual void Tick(float deltaSeconds) override;
 
+	// Reset the pickup to its initial state, ready to be reused from the object pool.
+	virtual void ResetPickup() override;
+
 private:
 
 	// Timer used for the lifetime of the turbo.
@@ -0,0 +1,252 @@
+/**
+*
+* Per-subsystem frame-time profiler.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Break the game frame down into the time spent in each of the hot subsystems,
+* attributed to individual vehicles where that makes sense, so that we can see
+* exactly which subsystem blows the frame budget as the number of vehicles in a
+* race increases.
+*
+* Capture is started and stopped with console commands:
+*
+*   grip.FrameProfiler.Start [trace]   Start capturing, optionally with a trace.
+*   grip.FrameProfiler.Stop            Stop capturing and export the results.
+*   grip.FrameProfiler.Report          Log the rolling percentiles for each subsystem.
+*
+* Or from the command line with the -GripFrameProfiler switch, optionally along
+* with -GripFrameProfilerTrace, in which case the capture runs for the whole of
+* the level.
+*
+* On stopping, a CSV file with a row for every frame captured is written to the
+* Saved/Profiling directory, along with a Chrome trace JSON file of every timed
+* scope if a trace was requested. The trace can be loaded into chrome://tracing
+* or Perfetto.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+#if GRIP_FRAME_PROFILER
+
+/**
+* The subsystems that are timed by the frame profiler. Timings are inclusive, so
+* contact sensors are also included in the vehicle physics for example.
+***********************************************************************************/
+
+enum class EFrameProfilerCategory : uint8
+{
+	// The vehicle physics sub-steps.
+	VehiclePhysics,
+
+	// The contact sensor updates within the vehicle physics sub-steps.
+	ContactSensors,
+
+	// The vehicle AI update.
+	VehicleAI,
+
+	// The race position calculation in the game mode.
+	RacePositions,
+
+	// The cinematic camera director.
+	CinematicsDirector,
+
+	// The light streak updates.
+	LightStreaks,
+
+	// The HUD widget and HUD animation updates.
+	HUD,
+
+	Num
+};
+
+/**
+* The frame profiler, a single instance of which is used per process.
+***********************************************************************************/
+
+class FFrameProfiler
+{
+public:
+
+	// Is a frame profile capture requested from the command line?
+	static bool IsRequested();
+
+	// Get the frame profiler for this process.
+	static FFrameProfiler& Get()
+	{ return Instance; }
+
+	// Is the frame profiler currently capturing?
+	bool IsActive() const
+	{ return Active; }
+
+	// Start capturing, optionally recording every timed scope for a trace.
+	void Start(const FString& name, bool trace);
+
+	// Stop capturing and export the results.
+	void Stop();
+
+	// Log the rolling percentiles for each subsystem and the mean cost of each vehicle.
+	void Report() const;
+
+	// Add a timed sample for a subsystem, thread-safe as physics may be sub-stepped off the game thread.
+	void AddSample(EFrameProfilerCategory category, int32 vehicleIndex, uint64 startCycles, uint64 endCycles);
+
+private:
+
+	/**
+	* The costs captured for a single frame.
+	***********************************************************************************/
+
+	struct FFrame
+	{
+		// The complete frame time in milliseconds.
+		float FrameTime = 0.0f;
+
+		// The time spent in each subsystem in milliseconds.
+		float Costs[(int32)EFrameProfilerCategory::Num] = { 0.0f };
+
+		// The number of times each subsystem was entered.
+		uint16 Counts[(int32)EFrameProfilerCategory::Num] = { 0 };
+
+		// The time attributed to each vehicle in milliseconds, excluding the nested contact sensors.
+		float VehicleCosts[GRIP_MAX_PLAYERS] = { 0.0f };
+	};
+
+	/**
+	* A single timed scope recorded for a trace.
+	***********************************************************************************/
+
+	struct FTraceEvent
+	{
+		// The CPU cycles when the scope was entered.
+		uint64 StartCycles = 0;
+
+		// The CPU cycles when the scope was exited.
+		uint64 EndCycles = 0;
+
+		// The thread that the scope was executed on.
+		uint32 ThreadId = 0;
+
+		// The category of the scope.
+		EFrameProfilerCategory Category = EFrameProfilerCategory::Num;
+
+		// The vehicle that the scope was attributed to, or INDEX_NONE.
+		int8 VehicleIndex = INDEX_NONE;
+	};
+
+	// Close the current frame, called at the end of every engine frame while capturing.
+	void EndFrame();
+
+	// Get a captured frame by its age, where 0 is the most recent.
+	const FFrame& GetFrame(int32 age) const
+	{ return Frames[(NextFrame - 1 - age + Frames.Num()) % Frames.Num()]; }
+
+	// Write the CSV file of the frames captured.
+	bool WriteCSV(const FString& filename) const;
+
+	// Write the Chrome trace JSON file of the scopes captured.
+	bool WriteTrace(const FString& filename) const;
+
+	// Is the frame profiler currently capturing?
+	volatile bool Active = false;
+
+	// Is every timed scope being recorded for a trace?
+	bool Tracing = false;
+
+	// The name of the capture, normally the map name.
+	FString Name;
+
+	// The CPU cycles when the capture started.
+	uint64 StartCycles = 0;
+
+	// The CPU cycles when the last frame ended.
+	uint64 FrameStartCycles = 0;
+
+	// The handle for the end of frame delegate.
+	FDelegateHandle EndFrameHandle;
+
+	// The CPU cycles accumulated for each subsystem in the current frame.
+	volatile int64 Costs[(int32)EFrameProfilerCategory::Num] = { 0 };
+
+	// The number of times each subsystem has been entered in the current frame.
+	volatile int32 Counts[(int32)EFrameProfilerCategory::Num] = { 0 };
+
+	// The CPU cycles accumulated for each vehicle in the current frame.
+	volatile int64 VehicleCosts[GRIP_MAX_PLAYERS] = { 0 };
+
+	// The frames captured, used as a ring buffer once full.
+	TArray<FFrame> Frames;
+
+	// The index in the frames of where the next frame will be written.
+	int32 NextFrame = 0;
+
+	// The total number of frames captured.
+	int32 NumFrames = 0;
+
+	// The scopes recorded for a trace.
+	TArray<FTraceEvent> TraceEvents;
+
+	// Critical section for adding to the trace events.
+	FCriticalSection TraceLock;
+
+	// The maximum number of frames kept for export, after which the oldest are overwritten.
+	static const int32 MaxFrames;
+
+	// The number of frames that the rolling percentiles are calculated over.
+	static const int32 RollingFrames;
+
+	// The maximum number of scopes recorded for a trace.
+	static const int32 MaxTraceEvents;
+
+	// The names of the subsystems.
+	static const TCHAR* CategoryNames[(int32)EFrameProfilerCategory::Num];
+
+	// The frame profiler for this process.
+	static FFrameProfiler Instance;
+};
+
+/**
+* A scoped timer for adding a sample to the frame profiler.
+***********************************************************************************/
+
+struct FFrameProfilerScope
+{
+public:
+
+	FFrameProfilerScope(EFrameProfilerCategory category, int32 vehicleIndex)
+		: Category(category)
+		, VehicleIndex(vehicleIndex)
+		, Active(FFrameProfiler::Get().IsActive())
+	{ if (Active == true) StartCycles = FPlatformTime::Cycles64(); }
+
+	~FFrameProfilerScope()
+	{ if (Active == true) FFrameProfiler::Get().AddSample(Category, VehicleIndex, StartCycles, FPlatformTime::Cycles64()); }
+
+private:
+
+	// The category to add the sample to.
+	EFrameProfilerCategory Category;
+
+	// The vehicle to attribute the sample to, or INDEX_NONE.
+	int32 VehicleIndex = INDEX_NONE;
+
+	// Was the profiler active when the scope was entered?
+	bool Active = false;
+
+	// The CPU cycles when the scope was entered.
+	uint64 StartCycles = 0;
+};
+
+#define GRIP_FRAME_PROFILER_SCOPE(category, vehicleIndex) FFrameProfilerScope frameProfilerScope(EFrameProfilerCategory::category, vehicleIndex)
+
+#else // GRIP_FRAME_PROFILER
+
+#define GRIP_FRAME_PROFILER_SCOPE(category, vehicleIndex)
+
+#endif // GRIP_FRAME_PROFILER
@@ -83,6 +83,11 @@ DECLARE_LOG_CATEGORY_EXTERN(GripTeleportationLog, Log, All);
 #define GRIP_PHYSICS_SUBSTEPS 2									// If fixed timing, then how many physics sub-steps per frame
 #endif
 
+#define GRIP_RACE_SIMULATION !UE_BUILD_SHIPPING					// Allow headless, AI-only races to be simulated with the -GripSimulate command line switch
+#define GRIP_RACE_REPLAY !UE_BUILD_SHIPPING						// Allow races to be recorded and played back with the -GripRecordReplay and -GripPlayReplay command line switches
+#define GRIP_FRAME_PROFILER !UE_BUILD_SHIPPING					// Allow the frame time to be broken down by subsystem with the grip.FrameProfiler console commands
+#define GRIP_NAVIGATION_CACHE 1									// Restore the navigation data derived from pursuit splines from a cache file written with the grip.BuildNavigationCache console command
+
 #define GRIP_CYCLE_SUSPENSION_NONE 0							// No suspension cycling
 #define GRIP_CYCLE_SUSPENSION_BY_AXLE 1							// Axle suspension cycling
 #define GRIP_CYCLE_SUSPENSION GRIP_CYCLE_SUSPENSION_BY_AXLE		// The type of suspension cycling to be performed
@@ -0,0 +1,284 @@
+/**
+*
+* Deterministic race replay recording and playback.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Record the control inputs made to every vehicle in a race, along with the random
+* seed and a fixed timestep, into a compact binary stream. Playing that stream
+* back reproduces the race, so that laggy moments can be profiled repeatedly and
+* physics changes benchmarked against identical input traces.
+*
+* Launch the game on a race map with one of these switches:
+*
+*   -GripRecordReplay[=<file>]   Record the race into a replay file.
+*   -GripPlayReplay=<file>       Play a race back from a replay file.
+*
+* Optional switches when recording are:
+*
+*   -GripReplayFPS=60            The fixed frame rate to record at.
+*   -GripReplaySeed=1            The random seed to use.
+*
+* Inputs made to a vehicle from within a vehicle tick, normally by the AI, are
+* substituted in the order they were recorded during playback, and everything
+* else, normally player input, is blocked and injected again at the start of the
+* same frame, before the pre-physics tick group, so that the physics sees it in
+* the same frame it was recorded in. A checksum of the vehicle states is recorded
+* for each frame so that playback can report the first frame that diverges.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+#if GRIP_RACE_REPLAY
+
+class APlayGameMode;
+class ABaseVehicle;
+
+/**
+* The types of control input to a vehicle that are recorded.
+***********************************************************************************/
+
+enum class ERaceReplayInput : uint8
+{
+	Throttle,
+	AnalogSteering,
+	DigitalSteering,
+	HandbrakePressed,
+	HandbrakeReleased,
+	BeginUsePickup,
+	UsePickup,
+	BoostOn,
+	BoostOff,
+	PitchControl,
+	Num
+};
+
+/**
+* A single control input to a vehicle.
+***********************************************************************************/
+
+struct FRaceReplayInput
+{
+	// The index of the vehicle that the input was made to.
+	uint8 VehicleIndex = 0;
+
+	// The type of the input.
+	ERaceReplayInput Type = ERaceReplayInput::Throttle;
+
+	// Was the input made from within a vehicle tick, rather than from a player controller?
+	bool InTick = false;
+
+	// The integer argument to the input, normally a pickup slot.
+	int32 Argument = 0;
+
+	// The value of the input.
+	float Value = 0.0f;
+};
+
+/**
+* The inputs made during a single frame of a race.
+***********************************************************************************/
+
+struct FRaceReplayFrame
+{
+	// The checksum of the state of all of the vehicles at the end of the frame.
+	uint32 Checksum = 0;
+
+	// The inputs made during the frame, in the order that they were made.
+	TArray<FRaceReplayInput> Inputs;
+};
+
+/**
+* The race replay recorder and player, a single instance of which is used per process.
+***********************************************************************************/
+
+class FRaceReplay
+{
+public:
+
+	// Is a race replay recording or playback requested from the command line?
+	static bool IsRequested();
+
+	// Get the race replay for this process.
+	static FRaceReplay& Get()
+	{ return Instance; }
+
+	// Is a race currently being recorded?
+	bool IsRecording() const
+	{ return Mode == EMode::Recording; }
+
+	// Is a race currently being played back?
+	bool IsPlaying() const
+	{ return Mode == EMode::Playing; }
+
+	// Start recording or playing back, called from the game mode once the level has begun play.
+	void Start(APlayGameMode* gameMode);
+
+	// Tick the race replay, called from the game mode at the end of every frame.
+	void Tick(APlayGameMode* gameMode);
+
+	// Stop recording or playing back when the level is unloaded, writing the replay file if recording.
+	void Stop();
+
+	// Note the start of a vehicle tick.
+	void BeginVehicleTick(ABaseVehicle* vehicle)
+	{ TickingVehicle = vehicle; }
+
+	// Note the end of a vehicle tick.
+	void EndVehicleTick()
+	{ TickingVehicle = nullptr; }
+
+	// Begin an input to a vehicle, recording it or substituting the recorded input, returning false if it should be blocked.
+	bool BeginInput(ABaseVehicle* vehicle, ERaceReplayInput type, float* value, int32* argument);
+
+	// End an input to a vehicle.
+	void EndInput()
+	{ InputDepth--; }
+
+	// Add a physics sub-step to the checksum for the frame, thread-safe as physics may be sub-stepped off the game thread.
+	void AddPhysicsSubstep()
+	{ if (Mode != EMode::None) FPlatformAtomics::InterlockedIncrement(&NumPhysicsSubsteps); }
+
+private:
+
+	enum class EMode : uint8
+	{
+		None,
+		Recording,
+		Playing
+	};
+
+	// Calculate the checksum of the state of all of the vehicles.
+	uint32 CalculateChecksum(APlayGameMode* gameMode) const;
+
+	// Save the recorded frames to the replay file.
+	bool Save() const;
+
+	// Load the frames to play back from the replay file.
+	bool Load();
+
+	// Report the outcome of a playback.
+	void ReportPlayback() const;
+
+	// Inject the inputs made outside of vehicle ticks for the current frame when playing back, called before the world's actors tick.
+	void InjectPlayerInputs(UWorld* world, ELevelTick tickType, float deltaSeconds);
+
+	// The mode the replay is in.
+	EMode Mode = EMode::None;
+
+	// The replay file.
+	FString Filename;
+
+	// The name of the map the replay was recorded on.
+	FString MapName;
+
+	// The random seed used for the race.
+	int32 Seed = 0;
+
+	// The fixed frame rate used for the race.
+	float FramesPerSecond = 60.0f;
+
+	// The frames recorded or being played back.
+	TArray<FRaceReplayFrame> Frames;
+
+	// The index of the current frame.
+	int32 FrameIndex = 0;
+
+	// How deeply nested the current input to a vehicle is, as some inputs call others.
+	int32 InputDepth = 0;
+
+	// Are we injecting recorded inputs into a vehicle right now?
+	bool Injecting = false;
+
+	// The vehicle that is currently ticking, if any.
+	ABaseVehicle* TickingVehicle = nullptr;
+
+	// The game mode the replay was started for.
+	TWeakObjectPtr<APlayGameMode> GameMode;
+
+	// The handle for the world pre-actor tick delegate used to inject inputs.
+	FDelegateHandle PreActorTickHandle;
+
+	// The index of the last frame whose inputs made outside of vehicle ticks were injected.
+	int32 InjectedFrameIndex = INDEX_NONE;
+
+	// The position of each vehicle in the in-tick inputs of the current frame when playing back.
+	TArray<int32> TickCursors;
+
+	// The first frame at which the inputs diverged from the recording, or INDEX_NONE.
+	int32 InputsDivergedFrame = INDEX_NONE;
+
+	// The first frame at which the vehicle state diverged from the recording, or INDEX_NONE.
+	int32 StateDivergedFrame = INDEX_NONE;
+
+	// The number of physics sub-steps run in the current frame.
+	volatile int32 NumPhysicsSubsteps = 0;
+
+	// The identifier at the start of a replay file.
+	static const uint32 FileMagic;
+
+	// The version of the replay file format.
+	static const int32 FileVersion;
+
+	// The race replay for this process.
+	static FRaceReplay Instance;
+};
+
+/**
+* A scope for an input to a vehicle, so that only the outermost of any nested inputs
+* is recorded.
+***********************************************************************************/
+
+struct FRaceReplayInputScope
+{
+public:
+
+	FRaceReplayInputScope(ABaseVehicle* vehicle, ERaceReplayInput type, float* value, int32* argument)
+		: Allowed(FRaceReplay::Get().BeginInput(vehicle, type, value, argument))
+	{ }
+
+	~FRaceReplayInputScope()
+	{ FRaceReplay::Get().EndInput(); }
+
+	// Should the input be processed?
+	bool IsAllowed() const
+	{ return Allowed; }
+
+private:
+
+	// Should the input be processed?
+	bool Allowed = true;
+};
+
+/**
+* A scope for a vehicle tick.
+***********************************************************************************/
+
+struct FRaceReplayTickScope
+{
+public:
+
+	FRaceReplayTickScope(ABaseVehicle* vehicle)
+	{ FRaceReplay::Get().BeginVehicleTick(vehicle); }
+
+	~FRaceReplayTickScope()
+	{ FRaceReplay::Get().EndVehicleTick(); }
+};
+
+#define GRIP_RACE_REPLAY_INPUT(type, value, argument) FRaceReplayInputScope raceReplayInputScope(this, type, value, argument); if (raceReplayInputScope.IsAllowed() == false) return
+#define GRIP_RACE_REPLAY_TICK_SCOPE() FRaceReplayTickScope raceReplayTickScope(this)
+#define GRIP_RACE_REPLAY_SUBSTEP() FRaceReplay::Get().AddPhysicsSubstep()
+
+#else // GRIP_RACE_REPLAY
+
+#define GRIP_RACE_REPLAY_INPUT(type, value, argument)
+#define GRIP_RACE_REPLAY_TICK_SCOPE()
+#define GRIP_RACE_REPLAY_SUBSTEP()
+
+#endif // GRIP_RACE_REPLAY
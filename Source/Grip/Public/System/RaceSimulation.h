@@ -0,0 +1,173 @@
+/**
+*
+* Headless race simulation harness.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Run complete races with only AI drivers, no viewport, no audio and no HUD, as
+* fast as the CPU allows under a fixed timestep. This is used for regression and
+* throughput testing of the vehicle physics and AI on machines without a GPU.
+*
+* Launch the game on a race map with the -GripSimulate switch, normally along
+* with -nullrhi -nosound -unattended, for example:
+*
+*   Grip <MapName> -game -GripSimulate -nullrhi -nosound -unattended -log
+*
+* Optional switches are:
+*
+*   -GripSimulateFPS=60          The fixed frame rate to simulate at.
+*   -GripSimulateLaps=3          Override the number of laps in the race.
+*   -GripSimulateTimeLimit=1200  The maximum number of simulated seconds to run for.
+*   -GripSimulateSeed=1          The random seed to use, for repeatable races.
+*   -GripSimulateReport=<file>   Where to write the JSON report for the race.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+#if GRIP_RACE_SIMULATION
+
+class APlayGameMode;
+
+/**
+* The categories of CPU cost that are measured by the race simulation.
+***********************************************************************************/
+
+enum class ERaceSimulationCost : uint8
+{
+	// The complete game frame, measured between game mode ticks.
+	Frame,
+
+	// The play game mode tick, including race positions and catchup.
+	GameMode,
+
+	// The vehicle ticks, including the AI but excluding the physics sub-steps.
+	Vehicle,
+
+	// The vehicle physics sub-steps.
+	VehiclePhysics,
+
+	// The vehicle AI update.
+	VehicleAI,
+
+	Num
+};
+
+/**
+* The race simulation harness, a single instance of which is used per process.
+***********************************************************************************/
+
+class FRaceSimulation
+{
+public:
+
+	// Is a race simulation requested from the command line?
+	static bool IsRequested();
+
+	// Get the race simulation for this process.
+	static FRaceSimulation& Get()
+	{ return Instance; }
+
+	// Is a race simulation currently running?
+	bool IsActive() const
+	{ return Active; }
+
+	// Start the race simulation, called from the game mode once the level has begun play.
+	void Start(APlayGameMode* gameMode);
+
+	// Tick the race simulation, called from the game mode once every frame.
+	void Tick(APlayGameMode* gameMode, float deltaSeconds);
+
+	// Stop the race simulation without reporting, when the level is unloaded.
+	void Stop()
+	{ Active = false; }
+
+	// Add some CPU cost for a given category, thread-safe as physics may be sub-stepped off the game thread.
+	void AddCost(ERaceSimulationCost cost, uint64 cycles)
+	{ FPlatformAtomics::InterlockedAdd(&Costs[(int32)cost], (int64)cycles); }
+
+private:
+
+	// Finish the race simulation, writing the report and exiting the process.
+	void Finish(APlayGameMode* gameMode, bool timedOut);
+
+	// Write the JSON report for the race.
+	void WriteReport(APlayGameMode* gameMode, bool timedOut, double wallSeconds) const;
+
+	// Is a race simulation currently running?
+	bool Active = false;
+
+	// The fixed frame rate that we're simulating at.
+	float FramesPerSecond = 60.0f;
+
+	// The maximum number of simulated seconds to run for.
+	float TimeLimit = 20.0f * 60.0f;
+
+	// The random seed used for the race.
+	int32 Seed = 0;
+
+	// The file that the report is written to.
+	FString ReportFilename;
+
+	// The number of frames simulated.
+	int32 NumFrames = 0;
+
+	// The number of seconds simulated.
+	double SimulatedSeconds = 0.0;
+
+	// The wall clock time at which the simulation started.
+	double StartTime = 0.0;
+
+	// The wall clock time of the last frame.
+	double LastFrameTime = 0.0;
+
+	// The most expensive frame in seconds.
+	double MaxFrameCost = 0.0;
+
+	// The accumulated CPU cycles for each cost category.
+	int64 Costs[(int32)ERaceSimulationCost::Num] = { 0 };
+
+	// The race simulation for this process.
+	static FRaceSimulation Instance;
+};
+
+/**
+* A scoped timer for adding CPU cost to the race simulation.
+***********************************************************************************/
+
+struct FRaceSimulationScope
+{
+public:
+
+	FRaceSimulationScope(ERaceSimulationCost cost)
+		: Cost(cost)
+		, Active(FRaceSimulation::Get().IsActive())
+	{ if (Active == true) StartCycles = FPlatformTime::Cycles64(); }
+
+	~FRaceSimulationScope()
+	{ if (Active == true) FRaceSimulation::Get().AddCost(Cost, FPlatformTime::Cycles64() - StartCycles); }
+
+private:
+
+	// The category to add the cost to.
+	ERaceSimulationCost Cost;
+
+	// Was the simulation active when the scope was entered?
+	bool Active = false;
+
+	// The CPU cycles when the scope was entered.
+	uint64 StartCycles = 0;
+};
+
+#define GRIP_RACE_SIMULATION_SCOPE(cost) FRaceSimulationScope raceSimulationScope(ERaceSimulationCost::cost)
+
+#else // GRIP_RACE_SIMULATION
+
+#define GRIP_RACE_SIMULATION_SCOPE(cost)
+
+#endif // GRIP_RACE_SIMULATION
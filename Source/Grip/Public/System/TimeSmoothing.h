@@ -684,3 +684,507 @@ typedef TTimedValueList<float> FTimedFloatList;
 
 // A timed value list for the FVector type.
 typedef TTimedValueList<FVector> FTimedVectorList;
+
+/**
+* An incrementally maintained version of FTimedFloatList, with the same interface.
+*
+* The times and values are held in separate arrays, running and prefix sums are
+* maintained as values are added so that sum and mean queries are constant time, and
+* monotonic queues of sample sequence numbers are maintained so that minimum and
+* maximum queries only need a binary search to find their answer. "since" queries
+* find their starting point with a binary search of the times rather than walking
+* the list, so the times added must be non-decreasing, which is always the case for
+* the game and physics clocks that these lists are used with.
+*
+* Use this in preference to FTimedFloatList for lists that are queried frequently,
+* especially with "since" queries over a small part of a long list.
+***********************************************************************************/
+
+class GRIP_API FRunningTimedFloatList
+{
+public:
+
+	struct FTimeValue
+	{
+		FTimeValue(float time = 0.0f, float value = 0.0f)
+			: Time(time)
+			, Value(value)
+		{ }
+
+		float Time;
+		float Value;
+	};
+
+	// Construct a running timed valued list.
+	FRunningTimedFloatList(int32 maxSeconds = 1, int32 samplesPerSecond = 60, bool averageSamples = true, bool sumSamples = false)
+	{ Reset(maxSeconds, samplesPerSecond, averageSamples, sumSamples); }
+
+	// Reset a running timed valued list, effectively constructing it.
+	void Reset(int32 maxSeconds = 1, int32 samplesPerSecond = 60, bool averageSamples = true, bool sumSamples = false)
+	{
+		MaxSeconds = maxSeconds;
+		MaxValues = maxSeconds * ((samplesPerSecond > 0) ? samplesPerSecond : 1000);
+		IndexMask = FMathEx::GetPower2(MaxValues);
+		SecondsPerSample = (samplesPerSecond > 0) ? 1.0f / samplesPerSecond : -1.0f;
+		LastTime = 0.0f;
+		LastValue = 0.0f;
+		SumStart = -1.0f;
+		SumValues = 0.0f;
+		NumSumValues = 0;
+		AverageSamples = averageSamples;
+		SumSamples = sumSamples;
+
+		Times.SetNumZeroed(IndexMask);
+		Values.SetNumZeroed(IndexMask);
+		SumsBefore.SetNumZeroed(IndexMask);
+		AbsSumsBefore.SetNumZeroed(IndexMask);
+		MinQueue.SetNumZeroed(IndexMask);
+		MaxQueue.SetNumZeroed(IndexMask);
+
+		IndexMask--;
+
+		Clear();
+	}
+
+	// Add a value to the value list.
+	void AddValue(float time, float value)
+	{
+		LastTime = time;
+		LastValue = value;
+
+		if (SumStart < 0)
+		{
+			SumStart = time;
+			SumValues = 0.0f;
+			NumSumValues = 0;
+		}
+
+		SumValues += value;
+		NumSumValues++;
+
+		do
+		{
+			if (SecondsPerSample <= 0 ||
+				time > SumStart + SecondsPerSample)
+			{
+				if (SecondsPerSample > 0)
+				{
+					if (GetNumValues() >= MaxValues)
+					{
+						Full = true;
+						RemoveOldestValue();
+					}
+				}
+				else
+				{
+					while (GetNumValues() > 0 &&
+						(time - Times[HeadSequence & IndexMask] > MaxSeconds || GetNumValues() > IndexMask))
+					{
+						Full = true;
+						RemoveOldestValue();
+					}
+				}
+
+				if (SumSamples == true)
+				{
+					CommitValue(time, SumValues);
+				}
+				else if (AverageSamples == true &&
+					NumSumValues > 0)
+				{
+					CommitValue(SumStart, SumValues * (1.0f / NumSumValues));
+				}
+				else
+				{
+					CommitValue(time, value);
+				}
+
+				SumValues = 0.0f;
+				NumSumValues = 0;
+				SumStart += SecondsPerSample;
+			}
+		}
+		while (SecondsPerSample > 0 && time > SumStart + SecondsPerSample);
+	}
+
+	// Get the last time added to the list.
+	float GetLastTime() const
+	{ return LastTime; }
+
+	// Get the last value added to the list.
+	float GetLastValue() const
+	{ return LastValue; }
+
+	// Get the minimum value of all the values in the list.
+	float GetMinValue(float since = -1.0f) const
+	{
+		int32 position = FindQueuePosition(MinQueue, MinQueueFront, MinQueueBack, HeadSequence + FindSince(since));
+
+		return (position < MinQueueBack) ? Values[MinQueue[position & IndexMask] & IndexMask] : 0.0f;
+	}
+
+	// Get the maximum value of all the values in the list.
+	float GetMaxValue(float since = -1.0f) const
+	{
+		int32 position = FindQueuePosition(MaxQueue, MaxQueueFront, MaxQueueBack, HeadSequence + FindSince(since));
+
+		return (position < MaxQueueBack) ? Values[MaxQueue[position & IndexMask] & IndexMask] : 0.0f;
+	}
+
+	// Get the mean average value of all the values in the list.
+	float GetMeanValue(float since = -1.0f) const
+	{
+		int32 from = FindSince(since);
+		int32 numSummed = GetNumValues() - from;
+
+		return (numSummed > 0) ? (float)((Sum - SumsBefore[(HeadSequence + from) & IndexMask]) / numSummed) : 0.0f;
+	}
+
+	// Get the unfluttered value of all the values in the list.
+	// This attempts to remove any hysteresis recorded in the values in the list and smooth out the result.
+	float GetUnflutteredValue(float since = -1.0f, bool higher = false) const
+	{
+		float sumLow = 0.0f, sumHigh = 0.0f;
+		int32 numSummedLow = 0, numSummedHigh = 0, numSwitches = 0;
+		int32 from = FindSince(since);
+		int32 numValues = GetNumValues();
+
+		for (int32 i = from; i < numValues; i++)
+		{
+			float value = Values[(HeadSequence + i) & IndexMask];
+
+			if (value < 0.0f)
+			{
+				sumLow += value; numSummedLow++;
+			}
+			else
+			{
+				sumHigh += value; numSummedHigh++;
+			}
+
+			if (i > from &&
+				(value < 0.0f) != (Values[(HeadSequence + i - 1) & IndexMask] < 0.0f))
+			{
+				numSwitches++;
+			}
+		}
+
+		if (numSwitches == 0)
+		{
+			return ((numSummedHigh > 0) ? sumHigh / numSummedHigh : 0.0f) + ((numSummedLow > 0) ? sumLow / numSummedLow : 0.0f);
+		}
+		else if (higher == true)
+		{
+			return (numSummedHigh > 0) ? sumHigh / numSummedHigh : 0.0f;
+		}
+		else
+		{
+			return (numSummedLow > 0) ? sumLow / numSummedLow : 0.0f;
+		}
+	}
+
+	// Get the mean average value of all the values in the list.
+	float GetAbsMeanValue(float since = -1.0f) const
+	{
+		int32 from = FindSince(since);
+		int32 numSummed = GetNumValues() - from;
+
+		return (numSummed > 0) ? (float)((AbsSum - AbsSumsBefore[(HeadSequence + from) & IndexMask]) / numSummed) : 0.0f;
+	}
+
+	// Get the mean average value of all the values in the list scaled by the number of
+	// values recorded in the list vs its maximum size.
+	float GetScaledMeanValue() const
+	{ return (MaxValues > 0) ? GetSumValue() / (float)MaxValues : 0.0f; }
+
+	// Get the mean average value of all the values in the list scaled by the number of
+	// values recorded in the list vs its maximum size.
+	float GetAbsScaledMeanValue() const
+	{ return (MaxValues > 0) ? GetAbsSumValue() / (float)MaxValues : 0.0f; }
+
+	// Get the sum value of all the values in the list.
+	float GetSumValue(float since = -1.0f) const
+	{
+		int32 from = FindSince(since);
+
+		return (from < GetNumValues()) ? (float)(Sum - SumsBefore[(HeadSequence + from) & IndexMask]) : 0.0f;
+	}
+
+	// Get the sum value of all the values in the list.
+	float GetAbsSumValue(float since = -1.0f) const
+	{
+		int32 from = FindSince(since);
+
+		return (from < GetNumValues()) ? (float)(AbsSum - AbsSumsBefore[(HeadSequence + from) & IndexMask]) : 0.0f;
+	}
+
+	// Get the value at a particular time in the list.
+	float GetValueAt(float at) const
+	{
+		int32 i = FindFirstAtOrAfter(at);
+
+		if (i < 2)
+		{
+			i = 0;
+		}
+
+		return (i < GetNumValues()) ? Values[(HeadSequence + i) & IndexMask] : 0.0f;
+	}
+
+	// Get the difference between the value given and the value stored at at, and divide that
+	// by the time difference between the clock given and time stored at at, thus the change
+	// in the values that would occur over one second of time, regardless of how much time
+	// we're examining.
+	float DifferenceFromPerSecond(float at, float clock, float value) const
+	{
+		int32 i = FindFirstAtOrAfter(at);
+		float time = LastTime;
+		float lastValue = LastValue;
+
+		if (i < GetNumValues())
+		{
+			time = Times[(HeadSequence + i) & IndexMask];
+			lastValue = Values[(HeadSequence + i) & IndexMask];
+		}
+
+		float timeDifference = (clock - time);
+
+		if (timeDifference > KINDA_SMALL_NUMBER)
+		{
+			return (value - lastValue) / timeDifference;
+		}
+		else
+		{
+			return value - lastValue;
+		}
+	}
+
+	// Get the time range of the values in the list.
+	float TimeRange() const
+	{
+		if (GetNumValues() > 0)
+		{
+			return Times[(NextSequence - 1) & IndexMask] - Times[HeadSequence & IndexMask];
+		}
+		else
+		{
+			return 0.0f;
+		}
+	}
+
+	// Clear the list of all recorded values.
+	void Clear()
+	{
+		Full = false;
+		HeadSequence = NextSequence = 0;
+		MinQueueFront = MinQueueBack = 0;
+		MaxQueueFront = MaxQueueBack = 0;
+		Sum = AbsSum = 0.0;
+	}
+
+	// Clear the list of all recorded values with a Time < time.
+	void Clear(float time)
+	{
+		while (GetNumValues() > 0 &&
+			Times[HeadSequence & IndexMask] < time)
+		{
+			Full = false;
+			RemoveOldestValue();
+		}
+
+		if (GetNumValues() == 0)
+		{
+			// Rebase the running sums while we can to keep them accurate.
+
+			Sum = AbsSum = 0.0;
+		}
+	}
+
+	// Get the number of values in the list.
+	int32 GetNumValues() const
+	{ return NextSequence - HeadSequence; }
+
+	// Get the maximum number of values in the list.
+	int32 GetMaxValues() const
+	{ return MaxValues; }
+
+	// Is the list full? Meaning is it storing its maximum capacity of of values yet?
+	bool IsFull() const
+	{ return Full; }
+
+	// Note that index 0 is the oldest value in the list and GetNumValues() - 1 is the most recent.
+	FTimeValue operator [] (int32 index) const
+	{ int32 slot = (HeadSequence + index) & IndexMask; return FTimeValue(Times[slot], Values[slot]); }
+
+private:
+
+	// Commit a value into the list, updating the running sums and the minimum and maximum queues.
+	void CommitValue(float time, float value)
+	{
+		int32 slot = NextSequence & IndexMask;
+
+		Times[slot] = time;
+		Values[slot] = value;
+		SumsBefore[slot] = Sum;
+		AbsSumsBefore[slot] = AbsSum;
+
+		Sum += value;
+		AbsSum += FMath::Abs(value);
+
+		// The minimum queue holds increasing values and the maximum queue decreasing values,
+		// so the oldest entry in the queue with a sequence in range is the answer to a query.
+
+		while (MinQueueBack != MinQueueFront &&
+			Values[MinQueue[(MinQueueBack - 1) & IndexMask] & IndexMask] >= value)
+		{
+			MinQueueBack--;
+		}
+
+		MinQueue[(MinQueueBack++) & IndexMask] = NextSequence;
+
+		while (MaxQueueBack != MaxQueueFront &&
+			Values[MaxQueue[(MaxQueueBack - 1) & IndexMask] & IndexMask] <= value)
+		{
+			MaxQueueBack--;
+		}
+
+		MaxQueue[(MaxQueueBack++) & IndexMask] = NextSequence;
+
+		NextSequence++;
+	}
+
+	// Remove the oldest value from the list.
+	void RemoveOldestValue()
+	{
+		if (MinQueueBack != MinQueueFront &&
+			MinQueue[MinQueueFront & IndexMask] == HeadSequence)
+		{
+			MinQueueFront++;
+		}
+
+		if (MaxQueueBack != MaxQueueFront &&
+			MaxQueue[MaxQueueFront & IndexMask] == HeadSequence)
+		{
+			MaxQueueFront++;
+		}
+
+		HeadSequence++;
+	}
+
+	// Find the index of the first value with a time at or after the time given.
+	int32 FindFirstAtOrAfter(float time) const
+	{
+		int32 lo = 0;
+		int32 hi = GetNumValues();
+
+		while (lo < hi)
+		{
+			int32 mid = (lo + hi) >> 1;
+
+			if (Times[(HeadSequence + mid) & IndexMask] < time)
+			{
+				lo = mid + 1;
+			}
+			else
+			{
+				hi = mid;
+			}
+		}
+
+		return lo;
+	}
+
+	// Find the index of the first value to consider for a "since" query.
+	int32 FindSince(float since) const
+	{ return (since < 0.0f) ? 0 : FindFirstAtOrAfter(since); }
+
+	// Find the position of the first entry in a minimum or maximum queue with a sequence at or after the one given.
+	int32 FindQueuePosition(const TArray<int32>& queue, int32 front, int32 back, int32 sequence) const
+	{
+		while (front < back)
+		{
+			int32 mid = front + ((back - front) >> 1);
+
+			if (queue[mid & IndexMask] < sequence)
+			{
+				front = mid + 1;
+			}
+			else
+			{
+				back = mid;
+			}
+		}
+
+		return front;
+	}
+
+	float MaxSeconds = 0.0f;
+
+	int32 IndexMask = 0;
+
+	// The capacity of the list.
+	int32 MaxValues = 0;
+
+	// The sequence number of the oldest value in the list.
+	int32 HeadSequence = 0;
+
+	// The sequence number of the next value to be written to the list.
+	int32 NextSequence = 0;
+
+	// How many seconds there is in a sample in the buffer.
+	float SecondsPerSample = 0.0f;
+
+	// The last time passed to AddValue.
+	float LastTime = 0.0f;
+
+	// The last value passed to AddValue.
+	float LastValue = 0.0f;
+
+	// The time at which accruing started before storing into the list.
+	float SumStart = -1.0f;
+
+	// The sum of the values we're accruing before storing into the list.
+	float SumValues = 0.0f;
+
+	// The number of summed values we're accruing before storing into the list.
+	int32 NumSumValues = 0;
+
+	// Are we averaging samples that we're accruing before adding them to the list?
+	bool AverageSamples = true;
+
+	// Are we summing samples that we're accruing before adding them to the list?
+	bool SumSamples = false;
+
+	// Is the list full? Meaning is it storing its maximum capacity of of values yet?
+	bool Full = false;
+
+	// The running sum of all the values committed to the list.
+	double Sum = 0.0;
+
+	// The running sum of all the absolute values committed to the list.
+	double AbsSum = 0.0;
+
+	// The positions of the minimum and maximum queues.
+	int32 MinQueueFront = 0;
+	int32 MinQueueBack = 0;
+	int32 MaxQueueFront = 0;
+	int32 MaxQueueBack = 0;
+
+	// The circular buffer of times, indexed by sequence number.
+	TArray<float> Times;
+
+	// The circular buffer of values, indexed by sequence number.
+	TArray<float> Values;
+
+	// The running sum just before each value was committed, indexed by sequence number.
+	TArray<double> SumsBefore;
+
+	// The running absolute sum just before each value was committed, indexed by sequence number.
+	TArray<double> AbsSumsBefore;
+
+	// The sequence numbers of the values that are candidates for the minimum value.
+	TArray<int32> MinQueue;
+
+	// The sequence numbers of the values that are candidates for the maximum value.
+	TArray<int32> MaxQueue;
+};
@@ -0,0 +1,31 @@
+/**
+*
+* Vehicle significance debugging HUD.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+#include "debughud.h"
+#include "debugsignificancehud.generated.h"
+
+/**
+* The debugging HUD for vehicle significance.
+***********************************************************************************/
+
+UCLASS()
+class ADebugSignificanceHUD : public ADebugHUD
+{
+	GENERATED_BODY()
+
+public:
+
+	// Draw the HUD.
+	virtual void DrawHUD() override;
+};
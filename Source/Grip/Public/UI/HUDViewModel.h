@@ -0,0 +1,167 @@
+/**
+*
+* HUD view-model implementation.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* The values shown on a player HUD for a vehicle, refreshed at most once per frame
+* and with the text for each only formatted when the value behind it changes. The
+* UMG property bindings of every HUD looking at a vehicle, of which there are up to
+* four in split-screen, all read from the one view-model. As unchanged values hand
+* back the same FText, Slate doesn't need to measure or lay out that text again.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class ABaseVehicle;
+class UGlobalGameState;
+class APlayGameMode;
+
+#pragma region VehicleHUD
+
+/**
+* The fields of the HUD view-model, used to signal which values have changed.
+***********************************************************************************/
+
+enum class EHUDViewModelField : uint32
+{
+	None = 0,
+	Speed = 1 << 0,
+	SpeedUnit = 1 << 1,
+	Position = 1 << 2,
+	Rank = 1 << 3,
+	Lap = 1 << 4,
+	Points = 1 << 5,
+	Kills = 1 << 6,
+	Deaths = 1 << 7,
+	Damage = 1 << 8,
+	RaceTime = 1 << 9,
+	BestLapTime = 1 << 10,
+	LapTime = 1 << 11,
+	EliminationTimer = 1 << 12,
+	RacePositionScale = 1 << 13
+};
+
+ENUM_CLASS_FLAGS(EHUDViewModelField);
+
+/**
+* A text value cached against the key of the value it was formatted from.
+***********************************************************************************/
+
+struct FHUDCachedText
+{
+public:
+
+	// Update the text for a key, only formatting it if the key has changed, returning whether it did.
+	template <typename Formatter>
+	bool Update(int64 key, Formatter format)
+	{ if (Valid == false || Key != key) { Key = key; Valid = true; Text = format(); return true; } return false; }
+
+	// Get the cached text.
+	const FText& Get() const
+	{ return Text; }
+
+private:
+
+	// The key of the value that the text was formatted from.
+	int64 Key = 0;
+
+	// Has the text been formatted yet?
+	bool Valid = false;
+
+	// The cached text.
+	FText Text;
+};
+
+/**
+* The view-model for the HUD of a vehicle.
+***********************************************************************************/
+
+struct FHUDViewModel
+{
+public:
+
+	// Refresh the view-model from the vehicle if it hasn't already been refreshed this frame.
+	void Refresh(ABaseVehicle* vehicle, UGlobalGameState* gameState, APlayGameMode* playGameMode);
+
+	// Get the fields that changed in the last refresh.
+	EHUDViewModelField GetChangedFields() const
+	{ return ChangedFields; }
+
+	// The label text for the player points.
+	FHUDCachedText PointsLabelText;
+
+	// The speedo text, in two portions for rendering.
+	FHUDCachedText SpeedoText[2];
+
+	// The speed measurement text.
+	FHUDCachedText KPHText;
+
+	// The left text for the player position.
+	FHUDCachedText PositionTextLeft;
+
+	// The right text for the player position.
+	FHUDCachedText PositionTextRight;
+
+	// The left text for the player rank.
+	FHUDCachedText RankTextLeft;
+
+	// The left text for the player lap.
+	FHUDCachedText LapTextLeft;
+
+	// The right text for the player lap.
+	FHUDCachedText LapTextRight;
+
+	// The text for the player points.
+	FHUDCachedText PointsText;
+
+	// The text for the player kills.
+	FHUDCachedText KillsText;
+
+	// The text for the player deaths.
+	FHUDCachedText DeathsText;
+
+	// The text for the player damage.
+	FHUDCachedText DamageText;
+
+	// The race time text.
+	FHUDCachedText RaceTimeText;
+
+	// The best lap time text.
+	FHUDCachedText BestLapTimeText;
+
+	// The lap time text, showing the last lap time for a few seconds after a lap is completed.
+	FHUDCachedText LapTimeText;
+
+	// The elimination timer text.
+	FHUDCachedText EliminationTimerText;
+
+	// The text for the leading players distance ahead of the player.
+	FHUDCachedText RacePositionScaleForeText;
+
+	// The text for the trailing players distance behind the player.
+	FHUDCachedText RacePositionScaleRearText;
+
+	// The scale for rendering the race positions for the players, in meters.
+	int32 RacePositionScale = 0;
+
+private:
+
+	// Get the key for a time at the precision it's displayed at, thousandths of a second, split the same way as ABaseVehicle::GetFormattedTime.
+	static int64 TimeKey(float seconds)
+	{ float minutes = FMath::FloorToFloat(seconds / 60.0f); seconds -= minutes * 60.0f; return (int64)(uint32)((FMath::FloorToInt(minutes) * 60000) + (FMath::FloorToInt(seconds) * 1000) + FMath::FloorToInt(FMath::Frac(seconds) * 1000.0f)); }
+
+	// The frame the view-model was last refreshed on.
+	uint64 RefreshFrame = ~0ull;
+
+	// The fields that changed in the last refresh.
+	EHUDViewModelField ChangedFields = EHUDViewModelField::None;
+};
+
+#pragma endregion VehicleHUD
@@ -144,22 +144,22 @@ public:
 	// Get the label text for the player points.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetPointsLabelText() const
-	{ return ((OwningVehicle == nullptr) ? FText::FromString("1UP") : FText::FromString(FString::Printf(TEXT("%dUP"), OwningVehicle->LocalPlayerIndex + 1))); }
+	{ return ((OwningVehicle == nullptr) ? FText::FromString("1UP") : OwningVehicle->GetHUDViewModel().PointsLabelText.Get()); }
 
 	// Get the speedo text.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetSpeedoText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("000") : FText::FromString(vehicle->GetFormattedSpeedKPH(0))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("000") : vehicle->GetHUDViewModel().SpeedoText[0].Get()); }
 
 	// Get the speedo text for the first portion of the rendering.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetSpeedoText1() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("000") : FText::FromString(vehicle->GetFormattedSpeedKPH(0))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("000") : vehicle->GetHUDViewModel().SpeedoText[0].Get()); }
 
 	// Get the speedo text for the second portion of the rendering.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetSpeedoText2() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("000") : FText::FromString(vehicle->GetFormattedSpeedKPH(1))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("000") : vehicle->GetHUDViewModel().SpeedoText[1].Get()); }
 
 	// Get the speed measurement text.
 	UFUNCTION(BlueprintCallable, Category = HUD)
@@ -168,52 +168,52 @@ public:
 	// Get the left text for the player position.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetPositionTextLeft() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr || (vehicle->GetRaceState().LapNumber < 0 && GameState->GamePlaySetup.DrivingMode != EDrivingMode::Elimination)) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), ((GameState->IsGameModeRanked() == true) ? vehicle->GetRaceState().RaceRank + 1 : vehicle->GetRaceState().RacePosition + 1)))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().PositionTextLeft.Get()); }
 
 	// Get the right text for the player position.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetPositionTextRight() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("/%d"), PlayGameMode->GetNumOpponentsLeft()))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().PositionTextRight.Get()); }
 
 	// Get the left text for the player rank.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetRankTextLeft() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), vehicle->GetRaceState().RaceRank + 1))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().RankTextLeft.Get()); }
 
 	// Get the left text for the player lap.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetLapTextLeft() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr || vehicle->GetRaceState().LapNumber < 0) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), vehicle->GetRaceState().LapNumber + 1))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().LapTextLeft.Get()); }
 
 	// Get the right text for the player lap.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetLapTextRight() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("/%d"), (int32)GameState->GeneralOptions.NumberOfLaps))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().LapTextRight.Get()); }
 
 	// Get the text for the player points.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetPointsText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), vehicle->GetRaceState().NumInGamePoints))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().PointsText.Get()); }
 
 	// Get the text for the player kills.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetKillsText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), (int32)vehicle->GetRaceState().NumKills))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().KillsText.Get()); }
 
 	// Get the text for the player deaths.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetDeathsText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("/%d"), (int32)vehicle->GetRaceState().NumDeaths))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().DeathsText.Get()); }
 
 	// Get the text for the player damage.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetDamageText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d%%"), (int32)((float)(vehicle->GetRaceState().MaxHitPoints - vehicle->GetRaceState().HitPoints) / (float)vehicle->GetRaceState().MaxHitPoints * 100)))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().DamageText.Get()); }
 
 	// Get the text for the elimination timer.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetEliminationTimerText() const
-	{ return (PlayGameMode->GetEliminationTimer() >= 0.0f) ? FText::FromString(FString::Printf(TEXT("%02d"), FMath::CeilToInt(GRIP_ELIMINATION_SECONDS - PlayGameMode->GetEliminationTimer()))) : FText::FromString("--"); }
+	{ return ((OwningVehicle == nullptr) ? ((PlayGameMode->GetEliminationTimer() >= 0.0f) ? FText::FromString(FString::Printf(TEXT("%02d"), FMath::CeilToInt(GRIP_ELIMINATION_SECONDS - PlayGameMode->GetEliminationTimer()))) : FText::FromString("--")) : OwningVehicle->GetHUDViewModel().EliminationTimerText.Get()); }
 
 	// Get the text for the elimination percentage.
 	UFUNCTION(BlueprintCallable, Category = HUD)
@@ -233,7 +233,7 @@ public:
 	// Get the race time of the vehicle.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetRaceTimeText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(vehicle->GetFormattedRaceTime())); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().RaceTimeText.Get()); }
 
 	// Get the number of seconds left in a race
 	UFUNCTION(BlueprintCallable, Category = HUD)
@@ -243,12 +243,12 @@ public:
 	// Get the best lap time of the vehicle.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetBestLapTimeText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(vehicle->GetFormattedBestLapTime())); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().BestLapTimeText.Get()); }
 
 	// Get the lap time of the vehicle.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetLapTimeText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : ((vehicle->GetRaceState().LapNumber >= 1 && vehicle->GetRaceState().LapTime < 5) ? FText::FromString(vehicle->GetFormattedLastLapTime()) : FText::FromString(vehicle->GetFormattedLapTime()))); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : vehicle->GetHUDViewModel().LapTimeText.Get()); }
 
 	// Get the lap time opacity of the vehicle.
 	UFUNCTION(BlueprintCallable, Category = HUD)
@@ -411,6 +411,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		bool IsWeaponEventOfInterest(int32 index) const;
 
+	// Get the indices of the weapon events of interest to the HUD that have happened since this was last called.
+	UFUNCTION(BlueprintCallable, Category = HUD)
+		void GetNewWeaponEventsOfInterest(TArray<int32>& indices);
+
 	// Get the left-hand text for a weapon event.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetWeaponEventLeftText(int32 index) const;
@@ -439,12 +443,12 @@ public:
 	// Get the text for the leading players distance ahead of the player.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetRacePositionScaleForeText() const
-	{ return GetRacePositionScaleText(GetRacePositionScale()); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? GetRacePositionScaleText(0) : vehicle->GetHUDViewModel().RacePositionScaleForeText.Get()); }
 
 	// Get the text for the trailing players distance behind the player.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetRacePositionScaleRearText() const
-	{ return GetRacePositionScaleText(-GetRacePositionScale()); }
+	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? GetRacePositionScaleText(0) : vehicle->GetHUDViewModel().RacePositionScaleRearText.Get()); }
 
 	// Get the text describing a race distance.
 	UFUNCTION(BlueprintCallable, Category = HUD)
@@ -505,6 +509,9 @@ protected:
 	// Refresh all of the widgets that can be ignited for a particular panel.
 	void RefreshIgnitionWidgets(FHUDPanelIgnition& ignition, UPanelWidget* mainPanel);
 
+	// Is a weapon event of a particular type of interest to the HUD?
+	static bool IsWeaponEventOfInterest(EGameEventType eventType, EPickupType pickupUsed);
+
 	// Draw a vehicle diagnostics chart.
 	static void DrawVehicleDiagnosticsChart(UPARAM(ref) FPaintContext& context, USlateBrushAsset* brush, const ABaseVehicle* vehicle, float x, float y, float width, float height, const FTimedFloatList& list, float scale, bool angles, bool calculateDifference, const FString& title);
 
@@ -519,6 +526,9 @@ private:
 
 	// The widgets in this panel that require ignition.
 	TArray<FHUDPanelIgnition> IgnitionWidgets;
+
+	// The index of the next event to read from the game mode's game events for weapon events of interest.
+	int32 NextWeaponEvent = 0;
 };
 
 /**
@@ -569,6 +579,10 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = HUD)
 		void LapCompleted(bool startFinalLap);
 
+	// Signal to the HUD widget blueprint which values of the HUD view-model have changed, as an EHUDViewModelField mask.
+	UFUNCTION(BlueprintImplementableEvent, Category = HUD)
+		void ViewModelChanged(int32 changedFields);
+
 	// Tick the HUD widget.
 	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 
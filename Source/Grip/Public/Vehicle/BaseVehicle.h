@@ -1326,6 +1326,13 @@ public:
 	const FVehicleControl& GetVehicleControl() const
 	{ return Control; }
 
+#if GRIP_RACE_REPLAY
+
+	// Inject a control input into the vehicle from a race replay.
+	void InjectReplayInput(ERaceReplayInput type, float value, int32 argument);
+
+#endif // GRIP_RACE_REPLAY
+
 private:
 
 	// Control the forwards / backwards motion, the value will be somewhere between -1 and +1, often at 0 or the extremes.
@@ -1594,6 +1601,12 @@ private:
 	// Compute a timer to co-ordinate the concurrent use of effects across vehicles.
 	void ComputeSurfaceEffectsTimer();
 
+	// Suspend or resume the surface effects from the wheels, when the vehicle is dormant.
+	void SuspendSurfaceEffects(bool suspend);
+
+	// Are the surface effects from the wheels currently suspended?
+	bool SurfaceEffectsSuspended = false;
+
 	// Get a noise value.
 	float Noise(float value) const;
 
@@ -1696,7 +1709,7 @@ private:
 	void AIResetSplineFollowing(bool beginPlay, bool allowDeadEnds = true, bool keepCurrentSpline = false, bool retainLapPosition = true, float minMatchingDistance = 0.0f);
 
 	// Follow the current spline, and switch over to the next if necessary.
-	void AIFollowSpline(const FVector& location, const FVector& wasHeadingTo, const FVector& movement, float movementSize, float deltaSeconds, int32 numIterations = 5, float accuracy = 1.0f);
+	void AIFollowSpline(const FVector& location, const FVector& wasHeadingTo, const FVector& movement, float movementSize, float deltaSeconds, float accuracy = 1.0f);
 
 	// Switch splines if the current one looks suspect.
 	bool AICheckSplineValidity(const FVector& location, float checkCycle, bool testOnly);
@@ -1935,9 +1948,24 @@ private:
 
 private:
 
+	// Update the capsules used to collect the pickup pads and speed pads this frame.
+	void UpdatePadCollectionCapsules();
+
 	// Collect the pickups overlapping with a vehicle.
 	void CollectPickups();
 
+	// The capsules used to collect the pickup pads and speed pads this frame.
+	TArray<FPadProximityCapsule, TInlineAllocator<2>> PadCollectionCapsules;
+
+	// The location of the vehicle shell when the pads were last collected.
+	FVector PadCollectionLocation = FVector::ZeroVector;
+
+	// Is PadCollectionLocation valid?
+	bool PadCollectionLocationValid = false;
+
+	// The maximum distance the vehicle shell is swept through between frames when collecting pads, beyond which it's considered to have been teleported.
+	static const float MaxPadCollectionSweep;
+
 #pragma endregion PickupPads
 
 #pragma region VehiclePickups
@@ -1963,6 +1991,12 @@ public:
 	// Release the pickup in a particular slot.
 	void ReleasePickupSlot(int32 pickupSlot, bool animate = true);
 
+	// Forget any references to a pickup that's being released back into the object pool.
+	void ForgetPickup(APickupBase* pickup);
+
+	// Create the pickups that can be pooled ahead of time, a number of each for the object pool.
+	static void PrewarmPickups(UWorld* world, FObjectPool& pool, int32 count);
+
 	// Get the alpha for a pickup slot.
 	float GetPickupSlotAlpha(int32 pickupSlot) const;
 
@@ -2056,6 +2090,12 @@ private:
 	// The last alpha value used to render the vehicle's light streaks.
 	float LastTurboAlpha = -1.0f;
 
+	// Suspend or resume the addition of points to the light streaks, when the vehicle is dormant.
+	void SuspendLightStreaks(bool suspend);
+
+	// Is the addition of points to the light streaks currently suspended?
+	bool LightStreaksSuspended = false;
+
 #pragma endregion PickupTurbo
 
 #pragma region PickupGun
@@ -2346,6 +2386,9 @@ public:
 	// Get the speed of the vehicle, in kilometers / miles per hour.
 	FString GetFormattedSpeedKPH(int32 index) const;
 
+	// Get the speed of the vehicle as displayed on the HUD, in kilometers / miles per hour, or the whole or fractional part of the mach number.
+	int32 GetDisplaySpeed(int32 index) const;
+
 	// Get the race time of the vehicle.
 	FString GetFormattedRaceTime() const
 	{ return GetFormattedTime(RaceState.RaceTime); }
@@ -2444,6 +2487,10 @@ public:
 	FVehicleHUD& GetHUD()
 	{ return HUD; }
 
+	// Get the HUD view-model for the vehicle, refreshing it if it's not already been refreshed this frame.
+	const FHUDViewModel& GetHUDViewModel()
+	{ HUD.ViewModel.Refresh(this, GameState, PlayGameMode); return HUD.ViewModel; }
+
 private:
 
 	// The HUD properties for the vehicle.
@@ -2764,6 +2811,12 @@ private:
 	// Complete the post spawn sequence.
 	void CompletePostSpawn();
 
+	// Spawn an appropriately scaled, transient particle system on the vehicle, recycled through the object pool.
+	UParticleSystemComponent* SpawnPooledParticleSystem(UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, EAttachLocation::Type locationType, float scale = 1.0f);
+
+	// Setup a particle system component that's just been spawned on the vehicle, and activate it.
+	void SetupSpawnedParticleSystem(UParticleSystemComponent* component, UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, EAttachLocation::Type locationType, float scale);
+
 	// Has the post spawn sequence started?
 	bool PostSpawnStarted = false;
 
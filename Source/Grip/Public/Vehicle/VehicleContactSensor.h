@@ -37,11 +37,17 @@ public:
 	// Setup a new sensor.
 	void Setup(ABaseVehicle* vehicle, int32 alignment, float side, float startOffset, float wheelWidth, float wheelRadius, float restingCompression);
 
-	// Do the regular update tick.
-	void Tick(float deltaTime, UWorld* world, const FTransform& transform, const FVector& startPoint, const FVector& direction, bool updatePhysics, bool estimate, bool calculateIfUpward);
+	// Prepare the regular update tick, returning whether a sweep is required before the tick can be completed.
+	bool PrepareTick(float deltaTime, const FTransform& transform, const FVector& startPoint, const FVector& direction, bool updatePhysics, bool estimate, bool calculateIfUpward);
 
-	// Calculate the nearest contact point of the sensor in world space.
-	void CalculateContactPoint(float deltaTime, UWorld* world, const FVector& startPoint, const FVector& direction, bool updatePhysics, bool estimate);
+	// Perform the sweep requested by PrepareTick.
+	void Sweep(UWorld* world);
+
+	// Complete the regular update tick, once any sweep requested by PrepareTick has been performed.
+	void CompleteTick(float deltaTime, bool updatePhysics, bool estimate, bool calculateIfUpward);
+
+	// Perform the sweeps requested by PrepareTick for a batch of sensors.
+	static void SweepBatch(UWorld* world, TArrayView<FVehicleContactSensor*> sensors);
 
 	// Get the end point (the outer edge of the wheel) in world space.
 	FVector GetEndPoint() const
@@ -142,9 +148,15 @@ public:
 	// Has the sensor detected a valid driving surface?
 	bool HasValidDrivingSurface(const FVector& wheelVelocity, float contactSeconds) const;
 
-	// Sweeps along sensor direction to see if the suspension spring needs to compress.
+	// Does the sensor require a sweep to determine whether the suspension spring needs to compress?
+	bool RequiresSweep(const FVector& start, const FVector& end, bool estimate) const;
+
+	// Intersect the sensor with the plane of the last genuine contact, if we're allowed to estimate from it.
+	bool IntersectEstimatePlane(const FVector& start, const FVector& rayDirection, bool estimate, FVector& contactPointOnPlane) const;
+
+	// Determine whether the suspension spring needs to compress, from the sweep made for it or an estimate.
 	// Returned collision time is normalized.
-	bool GetCollision(UWorld * world, const FVector & start, const FVector & end, float& time, FHitResult & hitResult, bool estimate);
+	bool GetCollision(const FVector& start, const FVector& end, float& time, bool estimate);
 
 	// Apply the suspension spring force to the vehicle.
 	void ApplyForce(const FVector& atPoint) const;
@@ -185,6 +197,9 @@ public:
 
 private:
 
+	// Calculate the nearest contact point of the sensor in world space, from the sweep requested by PrepareTick.
+	void CalculateContactPoint(float deltaTime, bool updatePhysics, bool estimate);
+
 	// Computes new suspension spring compression and force.
 	FVector ComputeNewSpringCompressionAndForce(const FVector& end, float deltaTime);
 
@@ -286,11 +301,23 @@ private:
 	float HoverContactDistance = 0.0f;
 
 	// Values for suspension compression over time.
-	FTimedFloatList CompressionList = FTimedFloatList(1, 10);
+	FRunningTimedFloatList CompressionList = FRunningTimedFloatList(1, 10);
 
 	// The shape to be used for performing a sensor sweep.
 	FCollisionShape SweepShape;
 
+	// Is a sweep required to complete the current tick?
+	bool SweepRequired = false;
+
+	// Did the sweep for the current tick hit anything?
+	bool SweepHit = false;
+
+	// The start point of the sweep for the current tick in world space.
+	FVector SweepStart = FVector::ZeroVector;
+
+	// The end point of the sweep for the current tick in world space.
+	FVector SweepEnd = FVector::ZeroVector;
+
 #pragma region VehicleAntiGravity
 
 public:
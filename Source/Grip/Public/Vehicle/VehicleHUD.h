@@ -14,6 +14,7 @@
 #pragma once
 
 #include "system/gameconfiguration.h"
+#include "ui/hudviewmodel.h"
 #include "vehiclehud.generated.h"
 
 class ABaseVehicle;
@@ -188,6 +189,9 @@ public:
 	// The last targets for each pickup slot.
 	TWeakObjectPtr<AActor> LastTarget[2];
 
+	// The values shown on the HUD, shared by every HUD looking at this vehicle.
+	FHUDViewModel ViewModel;
+
 	// The size of the HUD widget.
 	FVector2D WidgetPositionSize = FVector2D(1.0f, 1.0f);
 
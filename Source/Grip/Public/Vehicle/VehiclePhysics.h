@@ -207,10 +207,10 @@ struct FPhysicsContactData
 	float FallingTime = 0.0f;
 
 	// Record of grounded value values.
-	FTimedFloatList GroundedList = FTimedFloatList(5, 10);
+	FRunningTimedFloatList GroundedList = FRunningTimedFloatList(5, 10);
 
 	// Record of airborne value values.
-	FTimedFloatList AirborneList = FTimedFloatList(5, 10);
+	FRunningTimedFloatList AirborneList = FRunningTimedFloatList(5, 10);
 };
 
 /**
@@ -319,7 +319,7 @@ struct FVehiclePhysics
 	FTimedFloatList VelocityPitchList = FTimedFloatList(5, 200, false);
 
 	// Record of angular velocity pitch values.
-	FTimedFloatList AngularPitchList = FTimedFloatList(5, 25);
+	FRunningTimedFloatList AngularPitchList = FRunningTimedFloatList(5, 25);
 
 	// Used for measuring how different a vehicle's direction is compared to its velocity vector.
 	// This helps us to determine future path more effectively.
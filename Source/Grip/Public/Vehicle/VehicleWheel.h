@@ -69,6 +69,10 @@ struct FWheelDrivingSurfaces
 	// Destroy the last component, called whenever it's clearly faded out.
 	void DestroyLastComponent();
 
+	// Discard both components, letting them die naturally.
+	void DiscardComponents()
+	{ DiscardComponent(Surfaces[0]); DiscardComponent(Surfaces[1]); }
+
 	// Discard a component, letting it die naturally one it has completed its visual effect.
 	static void DiscardComponent(FWheelDrivingSurface& surface);
 